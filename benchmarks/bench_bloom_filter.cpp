@@ -0,0 +1,84 @@
+//
+// Бенчмарк фильтра Блума перед Set и Map: n запросов contains, из которых
+// 95% - промахи, с фильтром и без него. Ключи дерева - четные числа, промахи
+// - нечетные, поэтому без фильтра каждый промах спускается до листа.
+//
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// 19 промахов на одно попадание, в случайном порядке
+std::vector<int> queries(std::size_t n) {
+  std::vector<int> keys = bench::randomKeys(n, 7);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = 2 * keys[i] + (i % 20 != 0);
+  }
+  return keys;
+}
+
+void printStats(const s21::BloomFilterStats& stats) {
+  std::printf("    filtered %zu of %zu, false positives %zu (%.2f%%), "
+              "%zu bits, %zu rebuilds\n",
+              stats.filtered, stats.lookups, stats.false_positives,
+              100.0 * stats.false_positive_rate(), stats.bits,
+              stats.rebuilds);
+}
+
+template <typename Key>
+void insert(s21::Set<Key>& set, const Key& key) {
+  set.insert(key);
+}
+
+template <typename Key>
+void insert(s21::Map<Key, int>& map, const Key& key) {
+  map.insert(key, 0);
+}
+
+template <typename Tree, typename MakeKey>
+void run(const std::string& name, std::size_t n, MakeKey make_key) {
+  Tree tree;
+  for (int key : bench::randomKeys(n)) insert(tree, make_key(2 * key));
+  std::vector<typename Tree::key_type> probes;
+  for (int key : queries(n)) probes.push_back(make_key(key));
+
+  std::size_t found = 0;
+  double ms = bench::measureMs([&] {
+    for (const auto& key : probes) found += tree.contains(key);
+  });
+  bench::report((name + " contains, 95% misses").c_str(), n, ms);
+
+  tree.enable_filter();
+  ms = bench::measureMs([&] {
+    for (const auto& key : probes) found += tree.contains(key);
+  });
+  bench::report((name + " + filter").c_str(), n, ms);
+  printStats(tree.filter_stats());
+  bench::doNotOptimize(found);
+}
+
+struct IntKey {
+  int operator()(int key) const { return key; }
+};
+
+struct StringKey {
+  std::string operator()(int key) const {
+    return "user:" + std::to_string(key);
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  run<s21::Set<int>>("s21::Set<int>", n, IntKey());
+  run<s21::Set<std::string>>("s21::Set<std::string>", n, StringKey());
+  run<s21::Map<std::string, int>>("s21::Map<std::string, int>", n,
+                                  StringKey());
+  return 0;
+}
@@ -0,0 +1,54 @@
+//
+// Бенчмарк B+-дерева: вставка, поиск и удаление в s21::BTreeMap против
+// s21::Map и std::map на случайных и отсортированных ключах.
+//
+
+#include <map>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename MapType>
+void run(const std::string& name, const std::vector<int>& keys,
+         const std::vector<int>& lookups) {
+  std::size_t n = keys.size();
+  MapType map;
+  bench::report((name + " insert").c_str(), n, bench::measureMs([&] {
+                  for (int key : keys) map.insert({key, key});
+                }));
+
+  std::size_t found = 0;
+  bench::report((name + " find").c_str(), n, bench::measureMs([&] {
+                  for (int key : lookups) found += map.find(key) != map.end();
+                }));
+  bench::doNotOptimize(found);
+
+  bench::report((name + " erase").c_str(), n, bench::measureMs([&] {
+                  for (int key : lookups) map.erase(map.find(key));
+                }));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> random = bench::randomKeys(n);
+  const std::vector<int> sorted = bench::sortedKeys(n);
+
+  // Поиск по случайным ключам в обоих случаях, чтобы не мерить предсказание
+  // переходов на монотонных обращениях
+  run<std::map<int, int>>("std::map random", random, random);
+  run<s21::Map<int, int>>("s21::Map random", random, random);
+  run<s21::BTreeMap<int, int>>("s21::BTreeMap random", random, random);
+  run<s21::BTreeMap<int, int, 512>>("s21::BTreeMap<512> random", random,
+                                    random);
+
+  run<std::map<int, int>>("std::map sorted", sorted, random);
+  run<s21::Map<int, int>>("s21::Map sorted", sorted, random);
+  run<s21::BTreeMap<int, int>>("s21::BTreeMap sorted", sorted, random);
+  return 0;
+}
@@ -0,0 +1,57 @@
+//
+// Бенчмарк построения упорядоченных контейнеров: поэлементная вставка против
+// assign_sorted из отсортированного диапазона.
+//
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> sorted = bench::sortedKeys(n);
+  // Set и Multiset не балансируются, поэтому поэлементная вставка
+  // измеряется на перемешанных ключах
+  const std::vector<int> shuffled = bench::randomKeys(n);
+  std::vector<std::pair<int, int>> pairs;
+  for (int key : sorted) {
+    pairs.push_back({key, key});
+  }
+
+  {
+    s21::Map<int, int> map;
+    bench::report("s21::Map insert (sorted keys)", n, bench::measureMs([&] {
+                    for (const auto& item : pairs) map.insert(item);
+                  }));
+    s21::Map<int, int> bulk;
+    bench::report("s21::Map assign_sorted", n, bench::measureMs([&] {
+                    bulk.assign_sorted(pairs.begin(), pairs.end());
+                  }));
+    bench::report("s21::Map assign_sorted (checked)", n,
+                  bench::measureMs([&] {
+                    bulk.assign_sorted(pairs.begin(), pairs.end(), true);
+                  }));
+  }
+  {
+    s21::Set<int> set;
+    bench::report("s21::Set insert (random keys)", n, bench::measureMs([&] {
+                    for (int key : shuffled) set.insert(key);
+                  }));
+    s21::Set<int> bulk;
+    bench::report("s21::Set assign_sorted", n, bench::measureMs([&] {
+                    bulk.assign_sorted(sorted.begin(), sorted.end());
+                  }));
+  }
+  {
+    s21::Multiset<int> ms;
+    bench::report("s21::Multiset insert (random keys)", n,
+                  bench::measureMs([&] {
+                    for (int key : shuffled) ms.insert(key);
+                  }));
+    s21::Multiset<int> bulk;
+    bench::report("s21::Multiset assign_sorted", n, bench::measureMs([&] {
+                    bulk.assign_sorted(sorted.begin(), sorted.end());
+                  }));
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+//
+// Общие утилиты для бенчмарков контейнеров.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_BENCH_COMMON_HPP
+#define CPP2_S21_CONTAINERS_1_BENCH_COMMON_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Размер задачи: первый аргумент командной строки или значение по умолчанию
+inline std::size_t problemSize(int argc, char** argv, std::size_t fallback) {
+  if (argc > 1) {
+    return static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+  }
+  return fallback;
+}
+
+// Выполняет func и возвращает время работы в миллисекундах
+template <typename Func>
+double measureMs(Func&& func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+inline void report(const char* name, std::size_t n, double ms) {
+  std::printf("%-44s n=%-10zu %10.2f ms  %8.1f ns/op\n", name, n, ms,
+              n ? ms * 1e6 / static_cast<double>(n) : 0.0);
+}
+
+inline std::vector<int> sortedKeys(std::size_t n) {
+  std::vector<int> keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  return keys;
+}
+
+inline std::vector<int> reversedKeys(std::size_t n) {
+  std::vector<int> keys = sortedKeys(n);
+  std::reverse(keys.begin(), keys.end());
+  return keys;
+}
+
+inline std::vector<int> randomKeys(std::size_t n, unsigned seed = 42) {
+  std::vector<int> keys = sortedKeys(n);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+  return keys;
+}
+
+// Не дает компилятору выбросить вычисленное значение
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace bench
+
+#endif  // CPP2_S21_CONTAINERS_1_BENCH_COMMON_HPP
@@ -0,0 +1,78 @@
+//
+// Бенчмарк компактных узлов: прирост RSS на элемент, вставка и поиск в
+// s21::CompactMap и s21::CompactSet против s21::Map, s21::Set и std::map.
+//
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// Резидентная память процесса в байтах по /proc/self/statm
+std::size_t residentBytes() {
+  std::size_t total = 0;
+  std::size_t resident = 0;
+  if (FILE* file = std::fopen("/proc/self/statm", "r")) {
+    if (std::fscanf(file, "%zu %zu", &total, &resident) != 2) resident = 0;
+    std::fclose(file);
+  }
+  return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// Каждый контейнер строится в отдельном дочернем процессе, иначе куча,
+// освобожденная предыдущим контейнером, скрыла бы прирост RSS следующего
+template <typename Container, typename Insert>
+void run(const std::string& name, const std::vector<int>& keys,
+         Insert insert) {
+  std::fflush(stdout);
+  pid_t child = fork();
+  if (child != 0) {
+    waitpid(child, nullptr, 0);
+    return;
+  }
+  std::size_t n = keys.size();
+  Container container;
+  std::size_t before = residentBytes();
+  double insert_ms = bench::measureMs([&] {
+    for (int key : keys) insert(container, key);
+  });
+  std::size_t after = residentBytes();
+
+  std::size_t found = 0;
+  double find_ms = bench::measureMs([&] {
+    for (int key : keys) found += container.find(key) != container.end();
+  });
+  bench::doNotOptimize(found);
+
+  bench::report((name + " insert").c_str(), n, insert_ms);
+  bench::report((name + " find").c_str(), n, find_ms);
+  std::printf("%-44s %.1f B/elem RSS\n", "",
+              n ? static_cast<double>(after - before) / n : 0.0);
+  std::fflush(stdout);
+  _exit(0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> keys = bench::randomKeys(n);
+
+  auto insert_pair = [](auto& map, int key) { map.insert({key, key}); };
+  auto insert_key = [](auto& set, int key) { set.insert(key); };
+  run<std::map<int, int>>("std::map<int, int>", keys, insert_pair);
+  run<s21::Map<int, int>>("s21::Map<int, int>", keys, insert_pair);
+  run<s21::CompactMap<int, int>>("s21::CompactMap<int, int>", keys,
+                                 insert_pair);
+  run<s21::Set<int>>("s21::Set<int>", keys, insert_key);
+  run<s21::CompactSet<int>>("s21::CompactSet<int>", keys, insert_key);
+  return 0;
+}
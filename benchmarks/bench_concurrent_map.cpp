@@ -0,0 +1,117 @@
+//
+// Бенчмарк пропускной способности s21::ConcurrentMap против s21::Map под
+// одним мьютексом при разном числе потоков. Смесь операций: 80% поиска,
+// 15% вставки с заменой и 5% удаления по случайным ключам.
+//
+
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// Общий словарь под одним замком: исходная схема, которую заменяют шарды
+class LockedMap {
+ public:
+  bool find(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+  void insert_or_assign(int key, int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.insert_or_assign(key, value);
+  }
+  void erase(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it != map_.end()) map_.erase(it);
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::Map<int, int> map_;
+};
+
+class ShardedMap {
+ public:
+  explicit ShardedMap(std::size_t shards) : map_(shards) {}
+
+  bool find(int key) { return map_.find(key).has_value(); }
+  void insert_or_assign(int key, int value) {
+    map_.insert_or_assign(key, value);
+  }
+  void erase(int key) { map_.erase(key); }
+
+  const s21::ConcurrentMap<int, int>& map() const { return map_; }
+
+ private:
+  s21::ConcurrentMap<int, int> map_;
+};
+
+// Выполняет ops операций, поровну разделенных между threads потоками
+template <typename MapType>
+double runThreads(MapType& map, std::size_t threads, std::size_t ops,
+                  int key_space) {
+  return bench::measureMs([&] {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&map, t, threads, ops, key_space] {
+        std::mt19937 random(static_cast<unsigned>(t) + 1);
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < ops / threads; ++i) {
+          int key = static_cast<int>(random() % key_space);
+          unsigned kind = random() % 100;
+          if (kind < 80) {
+            found += map.find(key);
+          } else if (kind < 95) {
+            map.insert_or_assign(key, key);
+          } else {
+            map.erase(key);
+          }
+        }
+        bench::doNotOptimize(found);
+      });
+    }
+    for (auto& worker : workers) worker.join();
+  });
+}
+
+template <typename MapType>
+void fill(MapType& map, int key_space) {
+  for (int key = 0; key < key_space; key += 2) map.insert_or_assign(key, key);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  int key_space = static_cast<int>(std::max<std::size_t>(n / 4, 1));
+  const std::size_t thread_counts[] = {1, 2, 4, 8, 16, 32};
+
+  for (std::size_t threads : thread_counts) {
+    LockedMap locked;
+    fill(locked, key_space);
+    std::string name = "s21::Map + mutex, threads=" + std::to_string(threads);
+    bench::report(name.c_str(), n, runThreads(locked, threads, n, key_space));
+
+    for (std::size_t shards : {16, 64}) {
+      ShardedMap sharded(shards);
+      fill(sharded, key_space);
+      name = "ConcurrentMap<" + std::to_string(shards) +
+             ">, threads=" + std::to_string(threads);
+      bench::report(name.c_str(), n,
+                    runThreads(sharded, threads, n, key_space));
+      std::size_t waits = 0;
+      for (const auto& stats : sharded.map().shard_stats()) {
+        waits += stats.contended_reads + stats.contended_writes;
+      }
+      std::printf("%-44s contended locks: %zu\n", "", waits);
+    }
+  }
+  return 0;
+}
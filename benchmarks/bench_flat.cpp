@@ -0,0 +1,122 @@
+//
+// Бенчмарк плоских контейнеров: память на элемент и задержка поиска у
+// FlatMap и FlatSet против деревьев Map и Set, а также цена построения
+// таблицы пакетом и по одному ключу.
+//
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+std::size_t allocated_bytes = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocated_bytes += size;
+  if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+// Копия выделяет ровно ту память, которую занимает содержимое контейнера,
+// без запаса от удвоений при заполнении; накладные расходы malloc не
+// учитываются
+template <typename Container>
+void reportMemory(const std::string& name, const Container& container) {
+  std::size_t before = allocated_bytes;
+  Container copy(container);
+  std::size_t bytes = allocated_bytes - before;
+  std::printf("%-44s %8.1f bytes/element\n", (name + " memory").c_str(),
+              static_cast<double>(bytes) /
+                  static_cast<double>(container.size()));
+  bench::doNotOptimize(copy);
+}
+
+// Map::find и Set::find не константные, поэтому контейнер по ссылке
+template <typename Container>
+void reportLookups(const std::string& name, Container& container,
+                   const std::vector<int>& lookups) {
+  std::size_t found = 0;
+  bench::report((name + " find").c_str(), lookups.size(),
+                bench::measureMs([&] {
+                  for (int key : lookups) {
+                    found += container.find(key) != container.end();
+                  }
+                }));
+  bench::doNotOptimize(found);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> keys = bench::randomKeys(n);
+  const std::vector<int> lookups = bench::randomKeys(n, 7);
+  const std::vector<int> sorted = bench::sortedKeys(n);
+  std::vector<std::pair<const int, int>> sorted_pairs;
+  for (int key : sorted) sorted_pairs.emplace_back(key, key);
+
+  s21::Map<int, int> map;
+  bench::report("s21::Map insert", n, bench::measureMs([&] {
+                  for (int key : keys) map.insert({key, key});
+                }));
+  s21::FlatMap<int, int> flat_map;
+  bench::report("s21::FlatMap assign_sorted", n, bench::measureMs([&] {
+                  flat_map.assign_sorted(sorted_pairs.begin(),
+                                         sorted_pairs.end());
+                }));
+  // Одиночные вставки сдвигают хвост, поэтому их немного
+  std::size_t single = std::min<std::size_t>(n, 20000);
+  s21::FlatMap<int, int> incremental;
+  bench::report("s21::FlatMap insert one by one", single,
+                bench::measureMs([&] {
+                  for (std::size_t i = 0; i < single; ++i) {
+                    incremental.insert(keys[i], keys[i]);
+                  }
+                }));
+  // Те же ключи пакетами по 8: на пакет приходится одно слияние
+  s21::FlatMap<int, int> batched;
+  bench::report("s21::FlatMap insert_many by 8", single / 8 * 8,
+                bench::measureMs([&] {
+                  for (std::size_t i = 0; i + 8 <= single; i += 8) {
+                    const int* k = &keys[i];
+                    batched.insert_many(std::pair<const int, int>{k[0], 0},
+                                        std::pair<const int, int>{k[1], 0},
+                                        std::pair<const int, int>{k[2], 0},
+                                        std::pair<const int, int>{k[3], 0},
+                                        std::pair<const int, int>{k[4], 0},
+                                        std::pair<const int, int>{k[5], 0},
+                                        std::pair<const int, int>{k[6], 0},
+                                        std::pair<const int, int>{k[7], 0});
+                  }
+                }));
+
+  reportMemory("s21::Map<int, int>", map);
+  reportMemory("s21::FlatMap<int, int>", flat_map);
+  reportLookups("s21::Map<int, int>", map, lookups);
+  reportLookups("s21::FlatMap<int, int>", flat_map, lookups);
+
+  s21::Set<int> set;
+  for (int key : keys) set.insert(key);
+  s21::FlatSet<int> flat_set;
+  flat_set.assign_sorted(sorted.begin(), sorted.end());
+  reportMemory("s21::Set<int>", set);
+  reportMemory("s21::FlatSet<int>", flat_set);
+  reportLookups("s21::Set<int>", set, lookups);
+  reportLookups("s21::FlatSet<int>", flat_set, lookups);
+  return 0;
+}
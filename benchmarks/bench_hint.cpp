@@ -0,0 +1,92 @@
+//
+// Бенчмарк вставки почти упорядоченных ключей (временные ряды): обычная
+// вставка, вставка с подсказкой end() и с подсказкой - предыдущим элементом.
+//
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// Отметки времени с шагом 8 и дрожанием до 24: примерно треть ключей
+// приходит позже соседей, повторы отбрасываются контейнером
+std::vector<int> timeSeriesKeys(std::size_t n, unsigned seed = 42) {
+  std::mt19937 random(seed);
+  std::vector<int> keys(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = static_cast<int>(i * 8 + random() % 24);
+  }
+  return keys;
+}
+
+enum class Mode { kPlain, kHintEnd, kHintPrevious };
+
+// Каждый замер идет в отдельном дочернем процессе со свежей кучей: узлы,
+// освобожденные предыдущим контейнером, разбросаны и замедлили бы следующий
+template <typename Container, typename MakeValue>
+void run(const std::string& name, const std::vector<int>& keys, Mode mode,
+         MakeValue make_value) {
+  std::fflush(stdout);
+  pid_t child = fork();
+  if (child != 0) {
+    waitpid(child, nullptr, 0);
+    return;
+  }
+  Container container;
+  double ms = bench::measureMs([&] {
+    auto hint = container.end();
+    for (int key : keys) {
+      if (mode == Mode::kPlain) {
+        container.insert(make_value(key));
+      } else if (mode == Mode::kHintEnd) {
+        container.insert(container.end(), make_value(key));
+      } else {
+        hint = container.insert(hint, make_value(key));
+      }
+    }
+  });
+  bench::doNotOptimize(container.size());
+  bench::report(name.c_str(), keys.size(), ms);
+  std::fflush(stdout);
+  _exit(0);
+}
+
+template <typename Container, typename MakeValue>
+void runModes(const std::string& name, const std::vector<int>& keys,
+              MakeValue make_value) {
+  run<Container>(name + " insert", keys, Mode::kPlain, make_value);
+  run<Container>(name + " insert(end)", keys, Mode::kHintEnd, make_value);
+  run<Container>(name + " insert(previous)", keys, Mode::kHintPrevious,
+                 make_value);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  auto make_pair = [](int key) { return std::pair<const int, int>(key, key); };
+  auto make_key = [](int key) { return key; };
+
+  std::printf("time series keys\n");
+  const std::vector<int> series = timeSeriesKeys(n);
+  runModes<std::map<int, int>>("std::map", series, make_pair);
+  runModes<s21::Map<int, int>>("s21::Map", series, make_pair);
+
+  // Set не балансируется: почти упорядоченные ключи вырождают его в
+  // цепочку, поэтому для него только строго возрастающие ключи
+  std::printf("increasing keys\n");
+  const std::vector<int> sorted = bench::sortedKeys(n);
+  runModes<std::map<int, int>>("std::map", sorted, make_pair);
+  runModes<s21::Map<int, int>>("s21::Map", sorted, make_pair);
+  runModes<std::set<int>>("std::set", sorted, make_key);
+  runModes<s21::Set<int>>("s21::Set", sorted, make_key);
+  return 0;
+}
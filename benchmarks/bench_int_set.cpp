@@ -0,0 +1,158 @@
+//
+// Бенчмарк s21::IntSet против s21::Set<uint32_t> и std::set: прирост RSS
+// на ключ, вставка, поиск (половина - промахи) и обход для случайных
+// 32-битных ключей и для плотных ключей [0, 2n); затем объединение,
+// пересечение и размер пересечения двух IntSet.
+//
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// Резидентная память процесса в байтах по /proc/self/statm
+std::size_t residentBytes() {
+  std::size_t total = 0;
+  std::size_t resident = 0;
+  if (FILE* file = std::fopen("/proc/self/statm", "r")) {
+    if (std::fscanf(file, "%zu %zu", &total, &resident) != 2) resident = 0;
+    std::fclose(file);
+  }
+  return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::vector<std::uint32_t> randomIds(std::size_t n, unsigned seed) {
+  std::mt19937 random(seed);
+  std::vector<std::uint32_t> ids(n);
+  for (std::uint32_t& id : ids) id = random();
+  return ids;
+}
+
+// std::set получает contains только в C++20
+bool has(const std::set<std::uint32_t>& set, std::uint32_t key) {
+  return set.count(key) != 0;
+}
+
+template <typename Container>
+bool has(const Container& container, std::uint32_t key) {
+  return container.contains(key);
+}
+
+// Каждый контейнер строится в отдельном дочернем процессе, чтобы куча
+// предыдущего не скрыла прирост RSS следующего
+template <typename Container>
+void run(const std::string& name, const std::vector<std::uint32_t>& keys,
+         const std::vector<std::uint32_t>& probes) {
+  std::fflush(stdout);
+  pid_t child = fork();
+  if (child != 0) {
+    waitpid(child, nullptr, 0);
+    return;
+  }
+  std::size_t n = keys.size();
+  Container container;
+  std::size_t before = residentBytes();
+  double insert_ms = bench::measureMs([&] {
+    for (std::uint32_t key : keys) container.insert(key);
+  });
+  std::size_t after = residentBytes();
+
+  std::size_t found = 0;
+  double find_ms = bench::measureMs([&] {
+    for (std::uint32_t key : probes) found += has(container, key);
+  });
+  std::uint64_t sum = 0;
+  double iterate_ms = bench::measureMs([&] {
+    for (std::uint32_t key : container) sum += key;
+  });
+  bench::doNotOptimize(found + sum);
+
+  bench::report((name + " insert").c_str(), n, insert_ms);
+  bench::report((name + " contains").c_str(), probes.size(), find_ms);
+  bench::report((name + " iterate").c_str(), container.size(), iterate_ms);
+  std::printf("%-44s %.1f B/key RSS\n", "",
+              n ? static_cast<double>(after - before) / n : 0.0);
+  std::fflush(stdout);
+  _exit(0);
+}
+
+void runAll(const char* title, const std::vector<std::uint32_t>& keys,
+            const std::vector<std::uint32_t>& misses) {
+  std::printf("%s\n", title);
+  std::vector<std::uint32_t> probes(keys.begin(),
+                                    keys.begin() + keys.size() / 2);
+  probes.insert(probes.end(), misses.begin(),
+                misses.begin() + keys.size() / 2);
+  std::shuffle(probes.begin(), probes.end(), std::mt19937(3));
+  run<std::set<std::uint32_t>>("std::set<uint32_t>", keys, probes);
+  run<s21::Set<std::uint32_t>>("s21::Set<uint32_t>", keys, probes);
+  run<s21::IntSet>("s21::IntSet", keys, probes);
+}
+
+void runOperations(std::size_t n) {
+  std::printf("set operations\n");
+  s21::IntSet sparse_a;
+  s21::IntSet sparse_b;
+  for (std::uint32_t id : randomIds(n, 1)) sparse_a.insert(id);
+  for (std::uint32_t id : randomIds(n, 2)) sparse_b.insert(id);
+  // Плотные множества: корзины - битовые карты
+  s21::IntSet dense_a;
+  s21::IntSet dense_b;
+  for (std::uint32_t id : randomIds(n, 3)) dense_a.insert(id % (2 * n));
+  for (std::uint32_t id : randomIds(n, 4)) dense_b.insert(id % (2 * n));
+
+  std::size_t total = 0;
+  auto measure = [&](const char* name, std::size_t size, auto op) {
+    bench::report(name, size, bench::measureMs([&] { total += op(); }));
+  };
+  std::size_t sparse = sparse_a.size() + sparse_b.size();
+  std::size_t dense = dense_a.size() + dense_b.size();
+  measure("IntSet union, sparse", sparse,
+          [&] { return s21::set_union(sparse_a, sparse_b).size(); });
+  measure("IntSet intersection, sparse", sparse,
+          [&] { return s21::set_intersection(sparse_a, sparse_b).size(); });
+  measure("IntSet union, dense", dense,
+          [&] { return s21::set_union(dense_a, dense_b).size(); });
+  measure("IntSet intersection, dense", dense,
+          [&] { return s21::set_intersection(dense_a, dense_b).size(); });
+  measure("IntSet intersection_size, dense", dense,
+          [&] { return s21::intersection_size(dense_a, dense_b); });
+
+  s21::Set<std::uint32_t> set_a;
+  s21::Set<std::uint32_t> set_b;
+  set_a.assign_sorted(dense_a.begin(), dense_a.end());
+  set_b.assign_sorted(dense_b.begin(), dense_b.end());
+  measure("Set<uint32_t> set_union, dense", dense,
+          [&] { return s21::set_union(set_a, set_b).size(); });
+  measure("Set<uint32_t> set_intersection, dense", dense,
+          [&] { return s21::set_intersection(set_a, set_b).size(); });
+  bench::doNotOptimize(total);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  runAll("random 32-bit ids", randomIds(n, 42), randomIds(n, 43));
+
+  std::vector<std::uint32_t> dense = randomIds(n, 42);
+  std::vector<std::uint32_t> dense_misses = randomIds(n, 43);
+  for (std::uint32_t& id : dense) id %= 2 * n;
+  for (std::uint32_t& id : dense_misses) id = (id % (2 * n)) + 2 * n;
+  runAll("dense ids in [0, 2n)", dense, dense_misses);
+
+  runOperations(n);
+  return 0;
+}
@@ -0,0 +1,73 @@
+//
+// Бенчмарк s21::Map против std::map: вставка, поиск, копирование и слияние
+// на возрастающих, убывающих и случайных ключах.
+//
+
+#include <map>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename MapType>
+void run(const char* name, const std::vector<int>& keys) {
+  MapType map;
+  double insert_ms = bench::measureMs([&] {
+    for (int key : keys) {
+      map.insert({key, key});
+    }
+  });
+  bench::report((std::string(name) + " insert").c_str(), keys.size(),
+                insert_ms);
+
+  long long sum = 0;
+  double find_ms = bench::measureMs([&] {
+    for (int key : keys) {
+      sum += map.find(key)->second;
+    }
+  });
+  bench::doNotOptimize(sum);
+  bench::report((std::string(name) + " find").c_str(), keys.size(), find_ms);
+
+  double copy_ms = bench::measureMs([&] {
+    MapType copy(map);
+    bench::doNotOptimize(copy.size());
+  });
+  bench::report((std::string(name) + " copy").c_str(), keys.size(), copy_ms);
+
+  MapType target(map);
+  double assign_ms = bench::measureMs([&] { target = map; });
+  bench::report((std::string(name) + " copy-assign").c_str(), keys.size(),
+                assign_ms);
+
+  // Слияние восьми шардов: каждый ключ попадает в шард по остатку
+  std::vector<MapType> shards(8);
+  for (int key : keys) {
+    shards[static_cast<std::size_t>(key) % shards.size()].insert({key, key});
+  }
+  MapType merged;
+  double merge_ms = bench::measureMs([&] {
+    for (auto& shard : shards) merged.merge(shard);
+  });
+  bench::report((std::string(name) + " merge 8 shards").c_str(), keys.size(),
+                merge_ms);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+
+  const std::vector<int> sorted = bench::sortedKeys(n);
+  const std::vector<int> reversed = bench::reversedKeys(n);
+  const std::vector<int> shuffled = bench::randomKeys(n);
+
+  run<s21::Map<int, int>>("s21::Map sorted", sorted);
+  run<s21::Map<int, int>>("s21::Map reversed", reversed);
+  run<s21::Map<int, int>>("s21::Map random", shuffled);
+  run<std::map<int, int>>("std::map sorted", sorted);
+  run<std::map<int, int>>("std::map reversed", reversed);
+  run<std::map<int, int>>("std::map random", shuffled);
+  return 0;
+}
@@ -0,0 +1,81 @@
+//
+// Бенчмарк пула узлов: число обращений к operator new и время вставки и
+// очистки деревьев со стандартным аллокатором и с PoolAllocator.
+//
+
+#include <cstdlib>
+#include <new>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+std::size_t allocation_count = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++allocation_count;
+  if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+// Заполняет контейнер, затем очищает его; печатает время и число выделений
+template <typename Container, typename Fill>
+void run(const char* name, std::size_t n, bool reserve, Fill fill) {
+  Container container;
+  std::size_t before = allocation_count;
+  double fill_ms = bench::measureMs([&] {
+    if (reserve) container.reserve(n);
+    fill(container);
+  });
+  std::size_t allocations = allocation_count - before;
+  double clear_ms = bench::measureMs([&] { container.clear(); });
+
+  std::string label = std::string(name) + " insert";
+  bench::report(label.c_str(), n, fill_ms);
+  label = std::string(name) + " clear";
+  bench::report(label.c_str(), n, clear_ms);
+  std::printf("%-44s %zu\n", "  operator new calls", allocations);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> keys = bench::randomKeys(n);
+
+  auto fill_map = [&](auto& map) {
+    for (int key : keys) map.insert({key, key});
+  };
+  auto fill_set = [&](auto& set) {
+    for (int key : keys) set.insert(key);
+  };
+
+  using PoolMap = s21::Map<int, int, std::less<int>,
+                           s21::PoolAllocator<std::pair<const int, int>>>;
+  using PoolSet = s21::Set<int, std::less<int>, s21::PoolAllocator<int>>;
+  using PoolMultiset =
+      s21::Multiset<int, std::less<int>, s21::PoolAllocator<int>>;
+
+  run<s21::Map<int, int>>("s21::Map std::allocator", n, false, fill_map);
+  run<PoolMap>("s21::Map PoolAllocator", n, false, fill_map);
+  run<PoolMap>("s21::Map PoolAllocator + reserve", n, true, fill_map);
+  run<s21::Set<int>>("s21::Set std::allocator", n, false, fill_set);
+  run<PoolSet>("s21::Set PoolAllocator + reserve", n, true, fill_set);
+  run<s21::Multiset<int>>("s21::Multiset std::allocator", n, false,
+                          fill_set);
+  run<PoolMultiset>("s21::Multiset PoolAllocator + reserve", n, true,
+                    fill_set);
+  return 0;
+}
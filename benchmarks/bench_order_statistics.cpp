@@ -0,0 +1,83 @@
+//
+// Бенчмарк порядковых статистик: rank и select у RankedMap против прохода
+// итератором по s21::Map, а также цена поддержки размеров при вставке.
+// RankedSet не балансируется: после вставок по возрастанию вставка, rank и
+// select стоят O(n), а assign_sorted возвращает им O(log n).
+//
+
+#include <algorithm>
+#include <vector>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> keys = bench::randomKeys(n);
+  // Проход итератором стоит O(n), поэтому запросов немного
+  const std::size_t walks = 50;
+
+  s21::Map<int, int> map;
+  s21::RankedMap<int, int> ranked;
+  bench::report("s21::Map insert", n, bench::measureMs([&] {
+                  for (int key : keys) map.insert({key, key});
+                }));
+  bench::report("s21::RankedMap insert", n, bench::measureMs([&] {
+                  for (int key : keys) ranked.insert({key, key});
+                }));
+
+  std::size_t total = 0;
+  bench::report("s21::Map rank by iterator walk", walks, bench::measureMs([&] {
+                  for (std::size_t i = 0; i < walks; ++i) {
+                    int key = keys[i];
+                    for (auto it = map.begin(); it != map.end(); ++it) {
+                      if ((*it).first >= key) break;
+                      ++total;
+                    }
+                  }
+                }));
+  bench::report("s21::RankedMap rank", n, bench::measureMs([&] {
+                  for (int key : keys) total += ranked.rank(key);
+                }));
+  bench::report("s21::RankedMap select", n, bench::measureMs([&] {
+                  for (std::size_t i = 0; i < n; ++i) {
+                    total += static_cast<std::size_t>((*ranked.select(
+                        static_cast<std::size_t>(keys[i]))).second);
+                  }
+                }));
+  bench::doNotOptimize(total);
+
+  // Вставка по возрастанию в RankedSet обновляет размеры вдоль всей
+  // цепочки, то есть стоит O(n), поэтому ключей здесь не больше 20000
+  std::vector<int> sorted(keys.begin(),
+                          keys.begin() + std::min<std::size_t>(n, 20000));
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  s21::RankedSet<int> chain;
+  s21::RankedSet<int> balanced;
+  bench::report("s21::RankedSet sorted insert", sorted.size(),
+                bench::measureMs([&] {
+                  for (int key : sorted) chain.insert(key);
+                }));
+  bench::report("s21::RankedSet assign_sorted", sorted.size(),
+                bench::measureMs([&] {
+                  balanced.assign_sorted(sorted.begin(), sorted.end());
+                }));
+  bench::report("s21::RankedSet rank, sorted inserts", sorted.size(),
+                bench::measureMs([&] {
+                  for (int key : sorted) total += chain.rank(key);
+                }));
+  bench::report("s21::RankedSet rank, assign_sorted", sorted.size(),
+                bench::measureMs([&] {
+                  for (int key : sorted) total += balanced.rank(key);
+                }));
+  bench::doNotOptimize(total);
+
+  bench::report("s21::Map erase", n, bench::measureMs([&] {
+                  for (int key : keys) map.erase(map.find(key));
+                }));
+  bench::report("s21::RankedMap erase", n, bench::measureMs([&] {
+                  for (int key : keys) ranked.erase(ranked.find(key));
+                }));
+  return 0;
+}
@@ -0,0 +1,71 @@
+//
+// Бенчмарк построения Set и Map из неотсортированного вектора: вставка по
+// одному, сортировка с assign_sorted и assign_parallel на пулах разного
+// размера.
+//
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename Container, typename Item>
+void runParallel(const std::string& name, const s21::Vector<Item>& items) {
+  std::size_t max_threads = std::max<std::size_t>(
+      8, s21::ThreadPool::hardware_threads());
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    // Вызывающий поток тоже работает, поэтому в пуле на один поток меньше
+    s21::ThreadPool pool(threads - 1);
+    Container container;
+    double ms = bench::measureMs([&] {
+      container.assign_parallel(items.begin(), items.end(), pool);
+    });
+    bench::doNotOptimize(container.size());
+    bench::report((name + " assign_parallel x" + std::to_string(threads))
+                      .c_str(),
+                  items.size(), ms);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 2000000);
+  std::printf("hardware threads: %zu\n", s21::ThreadPool::hardware_threads());
+
+  s21::Vector<int> keys;
+  for (int key : bench::randomKeys(n)) keys.push_back(key);
+  {
+    s21::Set<int> set;
+    double ms = bench::measureMs([&] {
+      for (int key : keys) set.insert(key);
+    });
+    bench::report("s21::Set<int> insert", n, ms);
+  }
+  {
+    s21::Set<int> set;
+    double ms = bench::measureMs([&] {
+      std::vector<int> sorted(keys.begin(), keys.end());
+      std::sort(sorted.begin(), sorted.end());
+      set.assign_sorted(sorted.begin(), sorted.end());
+    });
+    bench::report("s21::Set<int> sort + assign_sorted", n, ms);
+  }
+  runParallel<s21::Set<int>>("s21::Set<int>", keys);
+
+  s21::Vector<std::pair<int, int>> items;
+  for (int key : keys) items.push_back({key, key});
+  {
+    s21::Map<int, int> map;
+    double ms = bench::measureMs([&] {
+      for (const auto& item : items) map.insert(item);
+    });
+    bench::report("s21::Map<int, int> insert", n, ms);
+  }
+  runParallel<s21::Map<int, int>>("s21::Map<int, int>", items);
+  return 0;
+}
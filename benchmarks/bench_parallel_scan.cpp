@@ -0,0 +1,74 @@
+//
+// Бенчмарк свертки Map и Set: последовательный обход итератором и
+// parallel::reduce / transform_reduce на пулах разного размера.
+//
+
+#include <algorithm>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename Tree, typename Reduce>
+void runParallel(const std::string& name, const Tree& tree, Reduce reduce) {
+  std::size_t max_threads = std::max<std::size_t>(
+      8, s21::ThreadPool::hardware_threads());
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    // Вызывающий поток тоже работает, поэтому в пуле на один поток меньше
+    s21::ThreadPool pool(threads - 1);
+    long total = 0;
+    double ms = bench::measureMs([&] { total = reduce(pool, tree); });
+    bench::doNotOptimize(total);
+    bench::report((name + " x" + std::to_string(threads)).c_str(),
+                  tree.size(), ms);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 2000000);
+  std::printf("hardware threads: %zu\n", s21::ThreadPool::hardware_threads());
+
+  s21::Vector<int> keys;
+  for (int key : bench::randomKeys(n)) keys.push_back(key);
+  auto sum = [](long a, long b) { return a + b; };
+
+  s21::Set<int> set;
+  for (int key : keys) set.insert(key);
+  {
+    long total = 0;
+    double ms = bench::measureMs([&] {
+      for (int key : set) total += key;
+    });
+    bench::doNotOptimize(total);
+    bench::report("s21::Set<int> iterator sum", set.size(), ms);
+  }
+  runParallel("s21::Set<int> parallel::reduce", set,
+              [&](s21::ThreadPool& pool, const s21::Set<int>& tree) {
+                return s21::parallel::reduce(pool, tree, 0L, sum);
+              });
+
+  s21::Map<int, int> map;
+  for (int key : keys) map.insert({key, key});
+  {
+    long total = 0;
+    double ms = bench::measureMs([&] {
+      for (const auto& item : map) total += item.second;
+    });
+    bench::doNotOptimize(total);
+    bench::report("s21::Map<int, int> iterator sum", map.size(), ms);
+  }
+  runParallel("s21::Map<int, int> parallel::transform_reduce", map,
+              [&](s21::ThreadPool& pool, const s21::Map<int, int>& tree) {
+                return s21::parallel::transform_reduce(
+                    pool, tree, 0L, sum,
+                    [](const std::pair<const int, int>& item) {
+                      return item.second;
+                    });
+              });
+  return 0;
+}
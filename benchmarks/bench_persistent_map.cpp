@@ -0,0 +1,67 @@
+//
+// Бенчмарк публикации версий: глубокая копия s21::Map на каждое изменение
+// против новой версии s21::PersistentMap и атомарной замены корня.
+//
+
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> keys = bench::randomKeys(n);
+  const std::size_t publishes = 1000;
+
+  s21::Map<int, int> map;
+  s21::PersistentMap<int, int> persistent;
+  for (int key : keys) {
+    map.insert(key, key);
+    persistent = persistent.insert(key, key);
+  }
+
+  // Копий полного словаря делается меньше, время приводится к одной
+  // публикации
+  std::size_t copies = std::max<std::size_t>(publishes / 100, 1);
+  std::size_t total = 0;
+  double copy_ms = bench::measureMs([&] {
+    for (std::size_t i = 0; i < copies; ++i) {
+      map.insert_or_assign(keys[i % n], static_cast<int>(i));
+      s21::Map<int, int> published(map);
+      total += published.size();
+    }
+  });
+  bench::report("s21::Map deep copy per publish", copies, copy_ms);
+
+  using Version = s21::PersistentMap<int, int>;
+  s21::AtomicPersistentMap<int, int> cell(persistent);
+  bench::report("PersistentMap update + publish", publishes,
+                bench::measureMs([&] {
+                  for (std::size_t i = 0; i < publishes; ++i) {
+                    int key = keys[i % n];
+                    int value = static_cast<int>(i);
+                    cell.update([key, value](const Version& current) {
+                      return current.insert_or_assign(key, value);
+                    });
+                  }
+                }));
+  bench::report("PersistentMap snapshot (load)", publishes,
+                bench::measureMs([&] {
+                  for (std::size_t i = 0; i < publishes; ++i) {
+                    total += cell.load().size();
+                  }
+                }));
+
+  Version snapshot = cell.load();
+  std::size_t found = 0;
+  bench::report("s21::Map find", n, bench::measureMs([&] {
+                  for (int key : keys) found += map.find(key) != map.end();
+                }));
+  bench::report("PersistentMap find", n, bench::measureMs([&] {
+                  for (int key : keys) found += snapshot.contains(key);
+                }));
+  bench::doNotOptimize(found);
+  bench::doNotOptimize(total);
+  return 0;
+}
@@ -0,0 +1,82 @@
+//
+// Бенчмарк Map со строковыми ключами, похожими на URL: обычные узлы и узлы
+// с префиксом ключа (PrefixMap).
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// Ключи вида <scheme><host>/<path>/<id>: хостов немного, пути длиннее SSO
+// std::string, поэтому строки лежат в куче
+std::vector<std::string> urlKeys(std::size_t n, const std::string& scheme) {
+  static const char* const kHosts[] = {
+      "api.example.com",  "cdn.example.net", "images.example.org",
+      "mail.example.com", "shop.example.io", "static.example.com",
+      "www.example.com",  "auth.example.dev"};
+  static const char* const kPaths[] = {"users", "orders", "items",
+                                       "search", "assets", "v2/profile"};
+  std::mt19937 random(3);
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys.push_back(scheme + kHosts[random() % 8] + "/" +
+                   kPaths[random() % 6] + "/" + std::to_string(random()));
+  }
+  return keys;
+}
+
+// Случайные токены из 24 символов: ключи расходятся уже в первых байтах
+std::vector<std::string> tokenKeys(std::size_t n) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+  std::mt19937 random(5);
+  std::vector<std::string> keys(n, std::string(24, ' '));
+  for (std::string& key : keys) {
+    for (char& c : key) c = kAlphabet[random() % 64];
+  }
+  return keys;
+}
+
+template <typename Map>
+void run(const std::string& name, const std::vector<std::string>& keys,
+         const std::vector<std::string>& queries) {
+  Map map;
+  double ms = bench::measureMs([&] {
+    for (const std::string& key : keys) map.insert(key, 0);
+  });
+  bench::report((name + " insert").c_str(), keys.size(), ms);
+
+  long found = 0;
+  ms = bench::measureMs([&] {
+    for (const std::string& key : queries) found += map.contains(key);
+  });
+  bench::doNotOptimize(found);
+  bench::report((name + " contains").c_str(), queries.size(), ms);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 500000);
+
+  // У полных URL первые 8 байт ("https://") общие: префикс ничего не
+  // отсекает, и это худший случай политики
+  const char* const labels[] = {"token", "host/path", "https://host/path"};
+  for (const char* label : labels) {
+    std::string name(label);
+    std::vector<std::string> keys =
+        name == "token" ? tokenKeys(n)
+                        : urlKeys(n, name == "host/path" ? "" : "https://");
+    std::vector<std::string> queries(keys);
+    std::shuffle(queries.begin(), queries.end(), std::mt19937(9));
+    run<s21::Map<std::string, int>>("s21::Map " + name, keys, queries);
+    run<s21::PrefixMap<int>>("s21::PrefixMap " + name, keys, queries);
+  }
+  return 0;
+}
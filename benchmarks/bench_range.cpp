@@ -0,0 +1,72 @@
+//
+// Бенчмарк диапазонных запросов: проход от begin() с фильтрацией против
+// range(lo, hi) на s21::Map и s21::Set.
+//
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+constexpr int kWidth = 100;
+
+// Сумма ключей из [lo, lo + kWidth) для queries случайных lo
+template <typename Container, typename KeyOf, typename Query>
+void run(const char* name, const Container& container, std::size_t n,
+         int queries, KeyOf key_of, Query query) {
+  const std::vector<int> starts = bench::randomKeys(n);
+  long long sum = 0;
+  double ms = bench::measureMs([&] {
+    for (int i = 0; i < queries; ++i) {
+      int lo = starts[static_cast<std::size_t>(i) % starts.size()];
+      for (const auto& item : query(container, lo, lo + kWidth)) {
+        sum += key_of(item);
+      }
+    }
+  });
+  bench::doNotOptimize(sum);
+  bench::report(name, static_cast<std::size_t>(queries), ms);
+}
+
+// Диапазон, который приходится искать линейным проходом от begin()
+template <typename Container, typename KeyOf>
+std::vector<int> scan(const Container& container, int lo, int hi,
+                      KeyOf key_of) {
+  std::vector<int> keys;
+  for (auto it = container.begin(); it != container.end(); ++it) {
+    int key = key_of(*it);
+    if (key >= lo && key < hi) keys.push_back(key);
+  }
+  return keys;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 100000);
+  const std::vector<int> keys = bench::randomKeys(n);
+
+  s21::Map<int, int> map;
+  s21::Set<int> set;
+  for (int key : keys) {
+    map.insert({key, key});
+    set.insert(key);
+  }
+
+  auto map_key = [](const auto& item) { return item.first; };
+  auto set_key = [](const auto& key) { return key; };
+  auto identity = [](int key) { return key; };
+  // Линейный проход на порядки медленнее, поэтому запросов меньше
+  const int scans = 20;
+  const int queries = 100000;
+
+  run("s21::Map scan from begin()", map, n, scans, identity,
+      [&](const auto& m, int lo, int hi) { return scan(m, lo, hi, map_key); });
+  run("s21::Map range(lo, hi)", map, n, queries, map_key,
+      [](const auto& m, int lo, int hi) { return m.range(lo, hi); });
+  run("s21::Set scan from begin()", set, n, scans, identity,
+      [&](const auto& s, int lo, int hi) { return scan(s, lo, hi, set_key); });
+  run("s21::Set range(lo, hi)", set, n, queries, set_key,
+      [](const auto& s, int lo, int hi) { return s.range(lo, hi); });
+  return 0;
+}
@@ -0,0 +1,114 @@
+//
+// Бенчмарк операций над множествами: s21::set_union и другие против
+// поэлементных вставок и std::set_union в std::set, merge с переносом
+// узлов против вставки по одному и параллельные версии.
+//
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename Tree>
+Tree makeTree(const std::vector<int>& keys) {
+  Tree tree;
+  for (int key : keys) tree.insert(key);
+  return tree;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  // Половина ключей b совпадает с ключами a
+  std::vector<int> keys_a = bench::randomKeys(n, 1);
+  std::vector<int> keys_b = bench::randomKeys(n, 2);
+  for (int& key : keys_b) key += static_cast<int>(n / 2);
+
+  std::set<int> std_a(keys_a.begin(), keys_a.end());
+  std::set<int> std_b(keys_b.begin(), keys_b.end());
+  double ms = bench::measureMs([&] {
+    std::set<int> result;
+    std::set_union(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                   std::inserter(result, result.end()));
+    bench::doNotOptimize(result.size());
+  });
+  bench::report("std::set_union into std::set", 2 * n, ms);
+
+  auto a = makeTree<s21::Set<int>>(keys_a);
+  auto b = makeTree<s21::Set<int>>(keys_b);
+  ms = bench::measureMs([&] {
+    s21::Set<int> result(a);
+    for (int key : b) result.insert(key);
+    bench::doNotOptimize(result.size());
+  });
+  bench::report("s21::Set copy + insert each", 2 * n, ms);
+  ms = bench::measureMs([&] {
+    bench::doNotOptimize(s21::set_union(a, b).size());
+  });
+  bench::report("s21::set_union", 2 * n, ms);
+  ms = bench::measureMs([&] {
+    bench::doNotOptimize(s21::set_intersection(a, b).size());
+  });
+  bench::report("s21::set_intersection", 2 * n, ms);
+  ms = bench::measureMs([&] {
+    bench::doNotOptimize(s21::symmetric_difference(a, b).size());
+  });
+  bench::report("s21::symmetric_difference", 2 * n, ms);
+
+  for (std::size_t threads = 2; threads <= 8; threads *= 2) {
+    s21::ThreadPool pool(threads - 1);
+    ms = bench::measureMs([&] {
+      bench::doNotOptimize(s21::set_union(pool, a, b).size());
+    });
+    bench::report(("s21::set_union x" + std::to_string(threads)).c_str(),
+                  2 * n, ms);
+  }
+
+  {
+    s21::Set<int> into(a);
+    s21::Set<int> from(b);
+    ms = bench::measureMs([&] {
+      for (int key : from) into.insert(key);
+      from.clear();
+    });
+    bench::report("s21::Set insert each + clear", 2 * n, ms);
+  }
+  {
+    s21::Set<int> into(a);
+    s21::Set<int> from(b);
+    ms = bench::measureMs([&] { into.merge(from); });
+    bench::report("s21::Set merge", 2 * n, ms);
+  }
+
+  auto ma = makeTree<s21::Multiset<int>>(keys_a);
+  auto mb = makeTree<s21::Multiset<int>>(keys_b);
+  ms = bench::measureMs([&] {
+    bench::doNotOptimize(s21::set_union(ma, mb).size());
+  });
+  bench::report("s21::set_union Multiset", 2 * n, ms);
+  {
+    // Ключи from вставляются по возрастанию, и их большая часть уходит в
+    // одну правую цепочку несбалансированного Multiset: время растет
+    // квадратично, поэтому этот вариант меряется на 20000 ключах
+    std::size_t small = std::min<std::size_t>(n, 20000);
+    auto into = makeTree<s21::Multiset<int>>(
+        std::vector<int>(keys_a.begin(), keys_a.begin() + small));
+    auto from = makeTree<s21::Multiset<int>>(
+        std::vector<int>(keys_b.begin(), keys_b.begin() + small));
+    ms = bench::measureMs([&] {
+      for (int key : from) into.insert(key);
+      from.clear();
+    });
+    bench::report("s21::Multiset insert each + clear", 2 * small, ms);
+  }
+  ms = bench::measureMs([&] { ma.merge(mb); });
+  bench::report("s21::Multiset merge", 2 * n, ms);
+  return 0;
+}
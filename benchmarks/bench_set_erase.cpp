@@ -0,0 +1,81 @@
+//
+// Бенчмарк удаления из s21::Set против std::set: удаление по ключу в
+// случайном порядке, чередование вставок и удалений, удаление диапазона и
+// копирование с разрушением вырожденного дерева.
+//
+
+#include <set>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename SetType, typename It>
+SetType makeSet(It first, It last) {
+  SetType set;
+  for (; first != last; ++first) set.insert(*first);
+  return set;
+}
+
+template <typename SetType>
+void run(const std::string& name, const std::vector<int>& keys) {
+  std::vector<int> order = bench::randomKeys(keys.size(), 7);
+  {
+    SetType set = makeSet<SetType>(keys.begin(), keys.end());
+    double ms = bench::measureMs([&] {
+      for (int key : order) set.erase(key);
+    });
+    bench::doNotOptimize(set.size());
+    bench::report((name + " erase(key)").c_str(), keys.size(), ms);
+  }
+  {
+    // Рабочий набор постоянного размера: каждый шаг удаляет старый ключ и
+    // вставляет новый
+    std::size_t window = keys.size() / 4;
+    SetType set = makeSet<SetType>(keys.begin(), keys.begin() + window);
+    double ms = bench::measureMs([&] {
+      for (std::size_t i = window; i < keys.size(); ++i) {
+        set.erase(keys[i - window]);
+        set.insert(keys[i]);
+      }
+    });
+    bench::doNotOptimize(set.size());
+    bench::report((name + " erase + insert").c_str(), keys.size() - window,
+                  ms);
+  }
+  {
+    SetType set = makeSet<SetType>(keys.begin(), keys.end());
+    double ms = bench::measureMs([&] {
+      set.erase(set.lower_bound(static_cast<int>(keys.size() / 4)),
+                set.lower_bound(static_cast<int>(keys.size() / 4 * 3)));
+    });
+    bench::doNotOptimize(set.size());
+    bench::report((name + " erase(first, last)").c_str(), keys.size() / 2,
+                  ms);
+  }
+  {
+    // Убывающие ключи: у s21::Set это цепочка левых ссылок
+    std::vector<int> chain = bench::reversedKeys(keys.size() / 100);
+    SetType set = makeSet<SetType>(chain.begin(), chain.end());
+    double ms = bench::measureMs([&] {
+      for (int i = 0; i < 100; ++i) {
+        SetType copy(set);
+        bench::doNotOptimize(copy.size());
+      }
+    });
+    bench::report((name + " copy + destroy chain").c_str(),
+                  100 * chain.size(), ms);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::randomKeys(n);
+  run<std::set<int>>("std::set<int>", keys);
+  run<s21::Set<int>>("s21::Set<int>", keys);
+  return 0;
+}
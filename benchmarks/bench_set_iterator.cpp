@@ -0,0 +1,67 @@
+//
+// Бенчмарк итераторов s21::Set против std::set: полный обход, обход в
+// обратном порядке, find и lower_bound, возвращающие итератор. Поиск в
+// маленьком наборе, который целиком лежит в кэше, показывает стоимость
+// построения самого итератора.
+//
+
+#include <set>
+#include <string>
+
+#include "../include/s21_containers.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename SetType>
+void run(const std::string& name, const std::vector<int>& keys) {
+  SetType set;
+  for (int key : keys) set.insert(key);
+
+  long long sum = 0;
+  double ms = bench::measureMs([&] {
+    for (int key : set) sum += key;
+  });
+  bench::report((name + " iterate").c_str(), keys.size(), ms);
+
+  ms = bench::measureMs([&] {
+    for (auto it = set.rbegin(); it != set.rend(); ++it) sum += *it;
+  });
+  bench::report((name + " reverse iterate").c_str(), keys.size(), ms);
+
+  ms = bench::measureMs([&] {
+    for (int key : keys) sum += *set.find(key);
+  });
+  bench::report((name + " find").c_str(), keys.size(), ms);
+
+  ms = bench::measureMs([&] {
+    for (int key : keys) {
+      auto it = set.lower_bound(key);
+      ++it;
+      sum += it != set.end() ? *it : 0;
+    }
+  });
+  bench::report((name + " lower_bound + next").c_str(), keys.size(), ms);
+
+  SetType small;
+  for (std::size_t i = 0; i < keys.size() && i < 1024; ++i) {
+    small.insert(keys[i]);
+  }
+  ms = bench::measureMs([&] {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      sum += *small.find(keys[i % 1024]);
+    }
+  });
+  bench::report((name + " find (1024 keys)").c_str(), keys.size(), ms);
+  bench::doNotOptimize(sum);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::randomKeys(n);
+  run<std::set<int>>("std::set<int>", keys);
+  run<s21::Set<int>>("s21::Set<int>", keys);
+  return 0;
+}
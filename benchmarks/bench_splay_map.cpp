@@ -0,0 +1,70 @@
+//
+// Бенчмарк поиска при неравномерных запросах: ключи запросов распределены
+// по Ципфу, s21::Map сравнивается со SplayMap.
+//
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// count запросов к ключам keys: ключ ранга r выбирается с весом 1 / r^s.
+// Ранги перемешаны с ключами, чтобы горячие ключи не были соседними
+std::vector<int> zipfQueries(const std::vector<int>& keys, std::size_t count,
+                             double s) {
+  std::vector<double> weights(keys.size());
+  for (std::size_t rank = 0; rank < keys.size(); ++rank) {
+    weights[rank] = 1.0 / std::pow(static_cast<double>(rank + 1), s);
+  }
+  std::discrete_distribution<std::size_t> pick(weights.begin(),
+                                               weights.end());
+  std::mt19937 random(7);
+  std::vector<int> queries(count);
+  for (int& query : queries) query = keys[pick(random)];
+  return queries;
+}
+
+template <typename Map>
+void runLookups(const std::string& name, Map& map,
+                const std::vector<int>& queries) {
+  long total = 0;
+  // Первый проход перестраивает SplayMap под распределение запросов и
+  // прогревает кэши, замеряется второй
+  for (int key : queries) total += map.find(key)->second;
+  double ms = bench::measureMs([&] {
+    for (int key : queries) total += map.find(key)->second;
+  });
+  bench::doNotOptimize(total);
+  bench::report(name.c_str(), queries.size(), ms);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::randomKeys(n);
+
+  s21::Map<int, int> map;
+  s21::SplayMap<int, int> splay;
+  for (int key : keys) {
+    map.insert(key, key);
+    splay.insert(key, key);
+  }
+
+  // s = 1.2: около 90% запросов приходится на 1% ключей
+  for (double s : {0.0, 0.8, 1.2, 1.5}) {
+    std::vector<int> queries = zipfQueries(keys, 4 * n, s);
+    std::string suffix = " find, zipf s=" + std::to_string(s).substr(0, 3);
+    runLookups("s21::Map<int, int>" + suffix, map, queries);
+    runLookups("s21::SplayMap<int, int>" + suffix, splay, queries);
+    const auto& frozen = splay;
+    runLookups("const s21::SplayMap<int, int>" + suffix, frozen, queries);
+  }
+  return 0;
+}
@@ -0,0 +1,60 @@
+//
+// Бенчмарк хеш-таблиц: вставка, успешный и неуспешный поиск и удаление в
+// s21::UnorderedMap против std::unordered_map и s21::Map.
+//
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "../include/s21_containers.hpp"
+#include "../include/s21_containersplus.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+// У s21::Map нет reserve, поэтому резервирование включается параметром
+template <typename MapType, bool Reserve = false>
+void run(const std::string& name, const std::vector<int>& keys,
+         const std::vector<int>& lookups) {
+  std::size_t n = keys.size();
+  MapType map;
+  bench::report((name + " insert").c_str(), n, bench::measureMs([&] {
+                  if constexpr (Reserve) map.reserve(n);
+                  for (int key : keys) map.insert({key, key});
+                }));
+
+  std::size_t found = 0;
+  bench::report((name + " find hit").c_str(), n, bench::measureMs([&] {
+                  for (int key : lookups) found += map.find(key) != map.end();
+                }));
+  // Ключи из [n, 2n) в контейнере отсутствуют
+  int offset = static_cast<int>(n);
+  bench::report((name + " find miss").c_str(), n, bench::measureMs([&] {
+                  for (int key : lookups) {
+                    found += map.find(key + offset) != map.end();
+                  }
+                }));
+  bench::doNotOptimize(found);
+
+  bench::report((name + " erase").c_str(), n, bench::measureMs([&] {
+                  for (int key : lookups) map.erase(map.find(key));
+                }));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = bench::problemSize(argc, argv, 1000000);
+  const std::vector<int> keys = bench::randomKeys(n);
+  const std::vector<int> lookups = bench::randomKeys(n, 7);
+
+  run<s21::Map<int, int>>("s21::Map", keys, lookups);
+  run<std::unordered_map<int, int>>("std::unordered_map", keys, lookups);
+  run<s21::UnorderedMap<int, int>>("s21::UnorderedMap", keys, lookups);
+  run<std::unordered_map<int, int>, true>("std::unordered_map reserved", keys,
+                                          lookups);
+  run<s21::UnorderedMap<int, int>, true>("s21::UnorderedMap reserved", keys,
+                                         lookups);
+  return 0;
+}
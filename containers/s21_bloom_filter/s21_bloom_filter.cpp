@@ -0,0 +1,138 @@
+//
+// Блочный фильтр Блума для отсева промахов в Map и Set.
+//
+
+#include "../../include/s21_bloom_filter/s21_bloom_filter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace s21 {
+
+template <typename Key, typename Hash>
+BloomFilter<Key, Hash>::BloomFilter(size_type capacity, double bits_per_key)
+    : bits_per_key_(bits_per_key),
+      capacity_(0),
+      inserted_(0),
+      erased_(0),
+      rebuilds_(0),
+      lookups_(0),
+      filtered_(0),
+      false_positives_(0) {
+  if (!(bits_per_key > 0.0)) {
+    throw std::invalid_argument("BloomFilter: bits_per_key must be positive");
+  }
+  reset(capacity);
+  rebuilds_ = 0;
+}
+
+template <typename Key, typename Hash>
+BloomFilter<Key, Hash>::BloomFilter(const BloomFilter& other)
+    : bits_per_key_(other.bits_per_key_),
+      capacity_(other.capacity_),
+      inserted_(other.inserted_),
+      erased_(other.erased_),
+      rebuilds_(other.rebuilds_),
+      blocks_(other.blocks_),
+      lookups_(other.lookups_.load(std::memory_order_relaxed)),
+      filtered_(other.filtered_.load(std::memory_order_relaxed)),
+      false_positives_(
+          other.false_positives_.load(std::memory_order_relaxed)) {}
+
+template <typename Key, typename Hash>
+BloomFilter<Key, Hash>& BloomFilter<Key, Hash>::operator=(
+    const BloomFilter& other) {
+  if (this != &other) {
+    bits_per_key_ = other.bits_per_key_;
+    capacity_ = other.capacity_;
+    inserted_ = other.inserted_;
+    erased_ = other.erased_;
+    rebuilds_ = other.rebuilds_;
+    blocks_ = other.blocks_;
+    lookups_.store(other.lookups_.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    filtered_.store(other.filtered_.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+    false_positives_.store(
+        other.false_positives_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+  }
+  return *this;
+}
+
+template <typename Key, typename Hash>
+void BloomFilter<Key, Hash>::reset(size_type capacity) {
+  ++rebuilds_;
+  capacity_ = std::max<size_type>(capacity, 1);
+  double bits = bits_per_key_ * static_cast<double>(capacity_);
+  blocks_.assign(static_cast<size_type>(bits / kBlockBits) + 1, Block{});
+  inserted_ = 0;
+  erased_ = 0;
+}
+
+template <typename Key, typename Hash>
+void BloomFilter<Key, Hash>::insert(const Key& key) {
+  std::uint64_t hash = hashOf(key);
+  Block& block = blocks_[blockIndex(hash)];
+  for (int word = 0; word < 8; ++word) {
+    block.words[word] |= bitOf(hash, word);
+  }
+  ++inserted_;
+}
+
+template <typename Key, typename Hash>
+bool BloomFilter<Key, Hash>::may_contain(const Key& key) const {
+  lookups_.fetch_add(1, std::memory_order_relaxed);
+  std::uint64_t hash = hashOf(key);
+  const Block& block = blocks_[blockIndex(hash)];
+  // Без раннего выхода: восемь проверок одной строки кэша дешевле
+  // непредсказуемых переходов
+  std::uint64_t missing = 0;
+  for (int word = 0; word < 8; ++word) {
+    missing |= bitOf(hash, word) & ~block.words[word];
+  }
+  if (missing) {
+    filtered_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Hash>
+void BloomFilter<Key, Hash>::record_false_positive() const {
+  false_positives_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Key, typename Hash>
+BloomFilterStats BloomFilter<Key, Hash>::stats() const {
+  return {lookups_.load(std::memory_order_relaxed),
+          filtered_.load(std::memory_order_relaxed),
+          false_positives_.load(std::memory_order_relaxed), bits(),
+          rebuilds_};
+}
+
+// От перемешанного хеша зависят и блок, и биты внутри него
+template <typename Key, typename Hash>
+std::uint64_t BloomFilter<Key, Hash>::hashOf(const Key& key) const {
+  return mixHash(static_cast<std::uint64_t>(Hash()(key)));
+}
+
+// Старшие 32 бита хеша выбирают блок умножением вместо деления по модулю
+template <typename Key, typename Hash>
+typename BloomFilter<Key, Hash>::size_type BloomFilter<Key, Hash>::blockIndex(
+    std::uint64_t hash) const {
+  return static_cast<size_type>(((hash >> 32) * blocks_.size()) >> 32);
+}
+
+// Младшие 32 бита, умноженные на свою нечетную соль для каждого слова, дают
+// восемь почти независимых номеров бита
+template <typename Key, typename Hash>
+std::uint64_t BloomFilter<Key, Hash>::bitOf(std::uint64_t hash, int word) {
+  static constexpr std::uint32_t kSalt[8] = {
+      0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+  std::uint32_t mixed = static_cast<std::uint32_t>(hash) * kSalt[word];
+  return std::uint64_t{1} << (mixed >> 26);
+}
+
+}  // namespace s21
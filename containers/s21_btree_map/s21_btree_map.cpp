@@ -0,0 +1,755 @@
+//
+// B+-дерево с узлами размером в несколько кэш-линий.
+//
+
+#include "../../include/s21_btree_map/s21_btree_map.hpp"
+
+#include <limits>
+
+namespace s21 {
+
+// Конструкторы
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>::BTreeMap()
+    : root_(nullptr), size_(0), comp_() {}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>::BTreeMap(const Compare& comp)
+    : root_(nullptr), size_(0), comp_(comp) {}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>::BTreeMap(
+    std::initializer_list<value_type> const& items)
+    : BTreeMap() {
+  for (const auto& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>::BTreeMap(const BTreeMap& other)
+    : root_(nullptr), size_(0), comp_(other.comp_) {
+  if (other.root_) {
+    Leaf* last_leaf = nullptr;
+    root_ = cloneNode(other.root_, last_leaf);
+    size_ = other.size_;
+  }
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>::BTreeMap(BTreeMap&& other) noexcept
+    : root_(other.root_), size_(other.size_), comp_(other.comp_) {
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>::~BTreeMap() {
+  clear();
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>&
+BTreeMap<Key, T, NodeBytes, Compare>::operator=(const BTreeMap& other) {
+  if (this != &other) {
+    BTreeMap copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+BTreeMap<Key, T, NodeBytes, Compare>&
+BTreeMap<Key, T, NodeBytes, Compare>::operator=(BTreeMap&& other) noexcept {
+  if (this != &other) {
+    clear();
+    root_ = other.root_;
+    size_ = other.size_;
+    comp_ = other.comp_;
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+// Доступ к элементам
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+T& BTreeMap<Key, T, NodeBytes, Compare>::at(const Key& key) {
+  iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it.leaf_->values[it.index_];
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+const T& BTreeMap<Key, T, NodeBytes, Compare>::at(const Key& key) const {
+  return const_cast<BTreeMap*>(this)->at(key);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+T& BTreeMap<Key, T, NodeBytes, Compare>::operator[](const Key& key) {
+  iterator it = emplaceUnique(key).first;
+  return it.leaf_->values[it.index_];
+}
+
+// Итераторы
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::iterator
+BTreeMap<Key, T, NodeBytes, Compare>::begin() {
+  return iterator(firstLeaf(), 0);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::iterator
+BTreeMap<Key, T, NodeBytes, Compare>::end() {
+  return iterator();
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::const_iterator
+BTreeMap<Key, T, NodeBytes, Compare>::begin() const {
+  return const_iterator(firstLeaf(), 0);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::const_iterator
+BTreeMap<Key, T, NodeBytes, Compare>::end() const {
+  return const_iterator();
+}
+
+// Вместимость
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+bool BTreeMap<Key, T, NodeBytes, Compare>::empty() const {
+  return size_ == 0;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::size_type
+BTreeMap<Key, T, NodeBytes, Compare>::size() const {
+  return size_;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::size_type
+BTreeMap<Key, T, NodeBytes, Compare>::max_size() const {
+  return std::numeric_limits<size_type>::max();
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::size_type
+BTreeMap<Key, T, NodeBytes, Compare>::height() const {
+  size_type levels = 0;
+  for (const Node* node = root_; node;) {
+    ++levels;
+    node = node->leaf ? nullptr : static_cast<const Inner*>(node)->children[0];
+  }
+  return levels;
+}
+
+// Модификаторы
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::clear() {
+  if (root_) {
+    destroyNode(root_);
+  }
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+std::pair<typename BTreeMap<Key, T, NodeBytes, Compare>::iterator, bool>
+BTreeMap<Key, T, NodeBytes, Compare>::insert(const value_type& value) {
+  return emplaceUnique(value.first, value.second);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+std::pair<typename BTreeMap<Key, T, NodeBytes, Compare>::iterator, bool>
+BTreeMap<Key, T, NodeBytes, Compare>::insert(const Key& key, const T& obj) {
+  return emplaceUnique(key, obj);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+std::pair<typename BTreeMap<Key, T, NodeBytes, Compare>::iterator, bool>
+BTreeMap<Key, T, NodeBytes, Compare>::insert_or_assign(const Key& key,
+                                                       const T& obj) {
+  auto result = emplaceUnique(key, obj);
+  if (!result.second) {
+    result.first.leaf_->values[result.first.index_] = obj;
+  }
+  return result;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+template <typename... Args>
+std::pair<typename BTreeMap<Key, T, NodeBytes, Compare>::iterator, bool>
+BTreeMap<Key, T, NodeBytes, Compare>::try_emplace(const Key& key,
+                                                  Args&&... args) {
+  return emplaceUnique(key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::erase(iterator pos) {
+  if (pos.leaf_) {
+    // Ключ копируется: при удалении ячейки листа сдвигаются
+    Key key = pos.leaf_->keys[pos.index_];
+    erase(key);
+  }
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::size_type
+BTreeMap<Key, T, NodeBytes, Compare>::erase(const Key& key) {
+  if (!root_ || !eraseFrom(root_, key)) {
+    return 0;
+  }
+  --size_;
+
+  // Опустевший корень уступает место единственному потомку
+  if (root_->count == 0) {
+    Node* old_root = root_;
+    if (root_->leaf) {
+      root_ = nullptr;
+      delete static_cast<Leaf*>(old_root);
+    } else {
+      root_ = static_cast<Inner*>(old_root)->children[0];
+      delete static_cast<Inner*>(old_root);
+    }
+  }
+  return 1;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::swap(BTreeMap& other) {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::merge(BTreeMap& other) {
+  if (this == &other) {
+    return;
+  }
+
+  // Значение перемещается только при успешной вставке, поэтому повторы
+  // переезжают в rest нетронутыми
+  BTreeMap rest(other.comp_);
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    T& value = it.leaf_->values[it.index_];
+    if (!try_emplace(it.leaf_->keys[it.index_], std::move(value)).second) {
+      rest.try_emplace(it.leaf_->keys[it.index_], std::move(value));
+    }
+  }
+  other.swap(rest);
+}
+
+// Просмотр контейнера
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+bool BTreeMap<Key, T, NodeBytes, Compare>::contains(const Key& key) const {
+  return find(key) != end();
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::iterator
+BTreeMap<Key, T, NodeBytes, Compare>::find(const Key& key) {
+  Leaf* leaf = findLeaf(key);
+  if (leaf) {
+    size_type index = lowerIndex(leaf->keys, leaf->count, key);
+    if (index < leaf->count && !comp_(key, leaf->keys[index])) {
+      return iterator(leaf, index);
+    }
+  }
+  return end();
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::const_iterator
+BTreeMap<Key, T, NodeBytes, Compare>::find(const Key& key) const {
+  return const_cast<BTreeMap*>(this)->find(key);
+}
+
+// Итераторы из результата получаются после всех вставок, потому что каждая
+// вставка может сдвинуть элементы, вставленные раньше
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+template <typename... Args>
+Vector<std::pair<typename BTreeMap<Key, T, NodeBytes, Compare>::iterator, bool>>
+BTreeMap<Key, T, NodeBytes, Compare>::insert_many(Args&&... args) {
+  Vector<bool> inserted;
+  (inserted.push_back(insert(args).second), ...);
+
+  Vector<std::pair<iterator, bool>> results;
+  size_type index = 0;
+  (results.push_back({find(args.first), inserted[index++]}), ...);
+  return results;
+}
+
+// Поиск
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::size_type
+BTreeMap<Key, T, NodeBytes, Compare>::lowerIndex(const Key* keys,
+                                                 size_type count,
+                                                 const Key& key) const {
+  return static_cast<size_type>(
+      std::lower_bound(keys, keys + count, key, comp_) - keys);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::size_type
+BTreeMap<Key, T, NodeBytes, Compare>::upperIndex(const Key* keys,
+                                                 size_type count,
+                                                 const Key& key) const {
+  return static_cast<size_type>(
+      std::upper_bound(keys, keys + count, key, comp_) - keys);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::Leaf*
+BTreeMap<Key, T, NodeBytes, Compare>::findLeaf(const Key& key) const {
+  Node* node = root_;
+  while (node && !node->leaf) {
+    Inner* inner = static_cast<Inner*>(node);
+    node = inner->children[upperIndex(inner->keys, inner->count, key)];
+  }
+  return static_cast<Leaf*>(node);
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::Leaf*
+BTreeMap<Key, T, NodeBytes, Compare>::firstLeaf() const {
+  Node* node = root_;
+  while (node && !node->leaf) {
+    node = static_cast<Inner*>(node)->children[0];
+  }
+  return static_cast<Leaf*>(node);
+}
+
+// Вставка
+
+// Вставка идет в два этапа. Сначала спуск запоминает путь и число
+// полных узлов на нем; копия ключа, значение, разделитель и все узлы для
+// расщеплений создаются до первого изменения дерева. Затем элементы только
+// перемещаются, поэтому исключение из конструкторов Key и T или из new
+// оставляет дерево прежним, если перемещения Key и T не бросают исключений
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+template <typename... Args>
+std::pair<typename BTreeMap<Key, T, NodeBytes, Compare>::iterator, bool>
+BTreeMap<Key, T, NodeBytes, Compare>::emplaceUnique(const Key& key,
+                                                    Args&&... args) {
+  if (!root_) {
+    root_ = new Leaf();
+  }
+
+  Inner* path[kMaxHeight];
+  size_type slots[kMaxHeight];
+  size_type depth = 0;
+  Node* node = root_;
+  while (!node->leaf) {
+    Inner* inner = static_cast<Inner*>(node);
+    slots[depth] = upperIndex(inner->keys, inner->count, key);
+    path[depth] = inner;
+    node = inner->children[slots[depth++]];
+  }
+  Leaf* leaf = static_cast<Leaf*>(node);
+  size_type index = lowerIndex(leaf->keys, leaf->count, key);
+  if (index < leaf->count && !comp_(key, leaf->keys[index])) {
+    return {iterator(leaf, index), false};
+  }
+
+  SpareNodes spare;
+  try {
+    Key new_key(key);
+    T value(std::forward<Args>(args)...);
+    // Расщепившийся лист отдает наверх свой средний ключ: при любом index
+    // он становится первым в правой половине
+    Key separator = leaf->count == kLeafCapacity
+                        ? leaf->keys[kLeafCapacity / 2]
+                        : Key();
+    if (leaf->count == kLeafCapacity) {
+      spare.leaf = new Leaf();
+      size_type full = depth;
+      while (full > 0 && path[full - 1]->count == kInnerCapacity) {
+        --full;
+      }
+      // Полные предки и, если полон весь путь, новый корень
+      size_type needed = depth - full + (full == 0 ? 1 : 0);
+      for (; spare.inner_count < needed; ++spare.inner_count) {
+        spare.inners[spare.inner_count] = new Inner();
+      }
+    }
+
+    iterator position;
+    Node* right = insertIntoLeaf(leaf, index, std::move(new_key),
+                                 std::move(value), spare, position);
+    for (; right && depth > 0; --depth) {
+      right = insertIntoInner(path[depth - 1], slots[depth - 1], separator,
+                              right, spare);
+    }
+    // Корень расщепился: дерево вырастает на уровень
+    if (right) {
+      Inner* new_root = spare.takeInner();
+      new_root->keys[0] = std::move(separator);
+      new_root->children[0] = root_;
+      new_root->children[1] = right;
+      new_root->count = 1;
+      root_ = new_root;
+    }
+    return {position, true};
+  } catch (...) {
+    if (size_ == 0) {
+      clear();
+    }
+    throw;
+  }
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::Leaf*
+BTreeMap<Key, T, NodeBytes, Compare>::insertIntoLeaf(Leaf* leaf,
+                                                     size_type index,
+                                                     Key&& key, T&& value,
+                                                     SpareNodes& spare,
+                                                     iterator& position) {
+  Leaf* right = nullptr;
+  Leaf* target = leaf;
+  if (leaf->count == kLeafCapacity) {
+    right = spare.leaf;
+    spare.leaf = nullptr;
+    size_type mid = kLeafCapacity / 2;
+    std::move(leaf->keys + mid, leaf->keys + kLeafCapacity, right->keys);
+    std::move(leaf->values + mid, leaf->values + kLeafCapacity,
+              right->values);
+    right->count = kLeafCapacity - mid;
+    leaf->count = mid;
+    right->next = leaf->next;
+    leaf->next = right;
+    if (index > mid) {
+      target = right;
+      index -= mid;
+    }
+  }
+
+  std::move_backward(target->keys + index, target->keys + target->count,
+                     target->keys + target->count + 1);
+  std::move_backward(target->values + index, target->values + target->count,
+                     target->values + target->count + 1);
+  target->keys[index] = std::move(key);
+  target->values[index] = std::move(value);
+  ++target->count;
+  ++size_;
+  position = iterator(target, index);
+  return right;
+}
+
+// Полный узел сначала делится пополам, средний ключ уходит к родителю
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::Node*
+BTreeMap<Key, T, NodeBytes, Compare>::insertIntoInner(Inner* inner,
+                                                      size_type index,
+                                                      Key& separator,
+                                                      Node* right,
+                                                      SpareNodes& spare) {
+  Key incoming(std::move(separator));
+  Inner* half = nullptr;
+  Inner* target = inner;
+  if (inner->count == kInnerCapacity) {
+    half = spare.takeInner();
+    size_type mid = kInnerCapacity / 2;
+    separator = std::move(inner->keys[mid]);
+    std::move(inner->keys + mid + 1, inner->keys + kInnerCapacity,
+              half->keys);
+    std::copy(inner->children + mid + 1, inner->children + kInnerCapacity + 1,
+              half->children);
+    half->count = kInnerCapacity - mid - 1;
+    inner->count = mid;
+    if (index > mid) {
+      target = half;
+      index -= mid + 1;
+    }
+  }
+
+  std::move_backward(target->keys + index, target->keys + target->count,
+                     target->keys + target->count + 1);
+  std::copy_backward(target->children + index + 1,
+                     target->children + target->count + 1,
+                     target->children + target->count + 2);
+  target->keys[index] = std::move(incoming);
+  target->children[index + 1] = right;
+  ++target->count;
+  return half;
+}
+
+// Удаление
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+bool BTreeMap<Key, T, NodeBytes, Compare>::eraseFrom(Node* node,
+                                                     const Key& key) {
+  if (node->leaf) {
+    Leaf* leaf = static_cast<Leaf*>(node);
+    size_type index = lowerIndex(leaf->keys, leaf->count, key);
+    if (index == leaf->count || comp_(key, leaf->keys[index])) {
+      return false;
+    }
+    std::move(leaf->keys + index + 1, leaf->keys + leaf->count,
+              leaf->keys + index);
+    std::move(leaf->values + index + 1, leaf->values + leaf->count,
+              leaf->values + index);
+    --leaf->count;
+    // Освободившаяся ячейка не должна удерживать ресурсы значения
+    leaf->keys[leaf->count] = Key();
+    leaf->values[leaf->count] = T();
+    return true;
+  }
+
+  Inner* inner = static_cast<Inner*>(node);
+  size_type index = upperIndex(inner->keys, inner->count, key);
+  if (!eraseFrom(inner->children[index], key)) {
+    return false;
+  }
+  const Node* child = inner->children[index];
+  if (child->count < (child->leaf ? kMinLeaf : kMinInner)) {
+    rebalance(inner, index);
+  }
+  return true;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::rebalance(Inner* parent,
+                                                     size_type index) {
+  size_type min_count = parent->children[index]->leaf ? kMinLeaf : kMinInner;
+  if (index > 0 && parent->children[index - 1]->count > min_count) {
+    borrowFromLeft(parent, index);
+  } else if (index < parent->count &&
+             parent->children[index + 1]->count > min_count) {
+    borrowFromRight(parent, index);
+  } else if (index > 0) {
+    mergeChildren(parent, index - 1);
+  } else {
+    mergeChildren(parent, index);
+  }
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::borrowFromLeft(Inner* parent,
+                                                          size_type index) {
+  Node* child = parent->children[index];
+  Node* sibling = parent->children[index - 1];
+
+  if (child->leaf) {
+    Leaf* to = static_cast<Leaf*>(child);
+    Leaf* from = static_cast<Leaf*>(sibling);
+    size_type last = from->count - 1;
+    std::move_backward(to->keys, to->keys + to->count,
+                       to->keys + to->count + 1);
+    std::move_backward(to->values, to->values + to->count,
+                       to->values + to->count + 1);
+    to->keys[0] = std::move(from->keys[last]);
+    to->values[0] = std::move(from->values[last]);
+    from->keys[last] = Key();
+    from->values[last] = T();
+    parent->keys[index - 1] = to->keys[0];
+  } else {
+    // Ключ родителя опускается в потомка, последний ключ соседа поднимается
+    Inner* to = static_cast<Inner*>(child);
+    Inner* from = static_cast<Inner*>(sibling);
+    std::move_backward(to->keys, to->keys + to->count,
+                       to->keys + to->count + 1);
+    std::copy_backward(to->children, to->children + to->count + 1,
+                       to->children + to->count + 2);
+    to->keys[0] = std::move(parent->keys[index - 1]);
+    to->children[0] = from->children[from->count];
+    parent->keys[index - 1] = std::move(from->keys[from->count - 1]);
+  }
+  --sibling->count;
+  ++child->count;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::borrowFromRight(Inner* parent,
+                                                           size_type index) {
+  Node* child = parent->children[index];
+  Node* sibling = parent->children[index + 1];
+
+  if (child->leaf) {
+    Leaf* to = static_cast<Leaf*>(child);
+    Leaf* from = static_cast<Leaf*>(sibling);
+    to->keys[to->count] = std::move(from->keys[0]);
+    to->values[to->count] = std::move(from->values[0]);
+    std::move(from->keys + 1, from->keys + from->count, from->keys);
+    std::move(from->values + 1, from->values + from->count, from->values);
+    from->keys[from->count - 1] = Key();
+    from->values[from->count - 1] = T();
+    parent->keys[index] = from->keys[0];
+  } else {
+    Inner* to = static_cast<Inner*>(child);
+    Inner* from = static_cast<Inner*>(sibling);
+    to->keys[to->count] = std::move(parent->keys[index]);
+    to->children[to->count + 1] = from->children[0];
+    parent->keys[index] = std::move(from->keys[0]);
+    std::move(from->keys + 1, from->keys + from->count, from->keys);
+    std::copy(from->children + 1, from->children + from->count + 1,
+              from->children);
+  }
+  --sibling->count;
+  ++child->count;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::mergeChildren(Inner* parent,
+                                                         size_type index) {
+  Node* left = parent->children[index];
+  Node* right = parent->children[index + 1];
+
+  if (left->leaf) {
+    Leaf* to = static_cast<Leaf*>(left);
+    Leaf* from = static_cast<Leaf*>(right);
+    std::move(from->keys, from->keys + from->count, to->keys + to->count);
+    std::move(from->values, from->values + from->count,
+              to->values + to->count);
+    to->count += from->count;
+    to->next = from->next;
+    delete from;
+  } else {
+    // Разделитель родителя становится ключом между половинами
+    Inner* to = static_cast<Inner*>(left);
+    Inner* from = static_cast<Inner*>(right);
+    to->keys[to->count] = std::move(parent->keys[index]);
+    std::move(from->keys, from->keys + from->count,
+              to->keys + to->count + 1);
+    std::copy(from->children, from->children + from->count + 1,
+              to->children + to->count + 1);
+    to->count += from->count + 1;
+    delete from;
+  }
+
+  std::move(parent->keys + index + 1, parent->keys + parent->count,
+            parent->keys + index);
+  std::copy(parent->children + index + 2,
+            parent->children + parent->count + 1,
+            parent->children + index + 1);
+  --parent->count;
+  parent->keys[parent->count] = Key();
+}
+
+// Служебные методы
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+typename BTreeMap<Key, T, NodeBytes, Compare>::Node*
+BTreeMap<Key, T, NodeBytes, Compare>::cloneNode(const Node* source,
+                                                Leaf*& last_leaf) {
+  if (source->leaf) {
+    const Leaf* from = static_cast<const Leaf*>(source);
+    Leaf* copy = new Leaf();
+    try {
+      std::copy(from->keys, from->keys + from->count, copy->keys);
+      std::copy(from->values, from->values + from->count, copy->values);
+    } catch (...) {
+      delete copy;
+      throw;
+    }
+    copy->count = from->count;
+    if (last_leaf) {
+      last_leaf->next = copy;
+    }
+    last_leaf = copy;
+    return copy;
+  }
+
+  const Inner* from = static_cast<const Inner*>(source);
+  Inner* copy = new Inner();
+  size_type cloned = 0;
+  try {
+    std::copy(from->keys, from->keys + from->count, copy->keys);
+    for (; cloned <= from->count; ++cloned) {
+      copy->children[cloned] = cloneNode(from->children[cloned], last_leaf);
+    }
+  } catch (...) {
+    for (size_type i = 0; i < cloned; ++i) {
+      destroyNode(copy->children[i]);
+    }
+    delete copy;
+    throw;
+  }
+  copy->count = from->count;
+  return copy;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+void BTreeMap<Key, T, NodeBytes, Compare>::destroyNode(Node* node) {
+  if (node->leaf) {
+    delete static_cast<Leaf*>(node);
+    return;
+  }
+  Inner* inner = static_cast<Inner*>(node);
+  for (size_type i = 0; i <= inner->count; ++i) {
+    destroyNode(inner->children[i]);
+  }
+  delete inner;
+}
+
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+bool BTreeMap<Key, T, NodeBytes, Compare>::validateForTesting() const {
+  if (!root_) {
+    return size_ == 0;
+  }
+  const Leaf* expected_leaf = firstLeaf();
+  size_type counted = 0;
+  int depth = checkNode(root_, nullptr, nullptr, expected_leaf, counted);
+  return depth > 0 && root_->count > 0 && counted == size_ &&
+         expected_leaf == nullptr;
+}
+
+// Возвращает глубину поддерева или -1, если нарушен какой-либо инвариант.
+// Ключи поддерева должны лежать в [low, high), expected_leaf - следующий
+// лист в списке листьев
+template <typename Key, typename T, std::size_t NodeBytes, typename Compare>
+int BTreeMap<Key, T, NodeBytes, Compare>::checkNode(
+    const Node* node, const Key* low, const Key* high,
+    const Leaf*& expected_leaf, size_type& counted) const {
+  size_type capacity = node->leaf ? kLeafCapacity : kInnerCapacity;
+  size_type min_count = node->leaf ? kMinLeaf : kMinInner;
+  if (node->count > capacity || (node != root_ && node->count < min_count)) {
+    return -1;
+  }
+
+  const Key* keys = node->leaf ? static_cast<const Leaf*>(node)->keys
+                               : static_cast<const Inner*>(node)->keys;
+  for (size_type i = 0; i < node->count; ++i) {
+    if ((i > 0 && !comp_(keys[i - 1], keys[i])) ||
+        (low && comp_(keys[i], *low)) || (high && !comp_(keys[i], *high))) {
+      return -1;
+    }
+  }
+
+  if (node->leaf) {
+    if (node != expected_leaf) {
+      return -1;
+    }
+    expected_leaf = static_cast<const Leaf*>(node)->next;
+    counted += node->count;
+    return 1;
+  }
+
+  const Inner* inner = static_cast<const Inner*>(node);
+  int depth = 0;
+  for (size_type i = 0; i <= inner->count; ++i) {
+    const Key* child_low = i == 0 ? low : &inner->keys[i - 1];
+    const Key* child_high = i == inner->count ? high : &inner->keys[i];
+    int child_depth = checkNode(inner->children[i], child_low, child_high,
+                                expected_leaf, counted);
+    if (child_depth < 0 || (i > 0 && child_depth != depth)) {
+      return -1;
+    }
+    depth = child_depth;
+  }
+  return depth + 1;
+}
+
+}  // namespace s21
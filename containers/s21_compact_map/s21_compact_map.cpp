@@ -0,0 +1,91 @@
+//
+// Упорядоченный словарь с компактными узлами.
+//
+
+#include "../../include/s21_compact_map/s21_compact_map.hpp"
+
+#include <tuple>
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+CompactMap<Key, T, Compare>::CompactMap(
+    std::initializer_list<value_type> const& items) {
+  tree_.reserve(items.size());
+  for (const auto& item : items) {
+    insert(item);
+  }
+}
+
+// Доступ к элементам
+
+template <typename Key, typename T, typename Compare>
+T& CompactMap<Key, T, Compare>::at(const Key& key) {
+  iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+const T& CompactMap<Key, T, Compare>::at(const Key& key) const {
+  const_iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+// Модификаторы
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename CompactMap<Key, T, Compare>::iterator, bool>
+CompactMap<Key, T, Compare>::insert_or_assign(const Key& key, const T& obj) {
+  auto result = try_emplace(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename CompactMap<Key, T, Compare>::iterator, bool>
+CompactMap<Key, T, Compare>::emplace(Args&&... args) {
+  value_type value(std::forward<Args>(args)...);
+  return tree_.emplaceKey(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename CompactMap<Key, T, Compare>::iterator, bool>
+CompactMap<Key, T, Compare>::try_emplace(const Key& key, Args&&... args) {
+  return tree_.emplaceKey(key, std::piecewise_construct,
+                          std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+// Просмотр контейнера
+
+template <typename Key, typename T, typename Compare>
+IteratorRange<typename CompactMap<Key, T, Compare>::const_iterator>
+CompactMap<Key, T, Compare>::range(const Key& lo, const Key& hi) const {
+  if (!tree_.key_comp()(lo, hi)) {
+    return IteratorRange<const_iterator>(end(), end());
+  }
+  return IteratorRange<const_iterator>(lower_bound(lo), lower_bound(hi));
+}
+
+// Номера узлов не меняются при росте массива, поэтому итераторы
+// результата действительны и без предварительного резерва
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+Vector<std::pair<typename CompactMap<Key, T, Compare>::iterator, bool>>
+CompactMap<Key, T, Compare>::insert_many(Args&&... args) {
+  Vector<std::pair<iterator, bool>> results;
+  (results.push_back(insert(std::forward<Args>(args))), ...);
+  return results;
+}
+
+}  // namespace s21
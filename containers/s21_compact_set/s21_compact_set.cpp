@@ -0,0 +1,44 @@
+//
+// Упорядоченное множество с компактными узлами.
+//
+
+#include "../../include/s21_compact_set/s21_compact_set.hpp"
+
+namespace s21 {
+
+template <typename Key, typename Compare>
+CompactSet<Key, Compare>::CompactSet(
+    std::initializer_list<value_type> const& items) {
+  tree_.reserve(items.size());
+  for (const auto& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename Compare>
+template <typename... Args>
+std::pair<typename CompactSet<Key, Compare>::iterator, bool>
+CompactSet<Key, Compare>::emplace(Args&&... args) {
+  Key key(std::forward<Args>(args)...);
+  return tree_.emplaceKey(key, std::move(key));
+}
+
+template <typename Key, typename Compare>
+IteratorRange<typename CompactSet<Key, Compare>::iterator>
+CompactSet<Key, Compare>::range(const Key& lo, const Key& hi) const {
+  if (!tree_.key_comp()(lo, hi)) {
+    return IteratorRange<iterator>(end(), end());
+  }
+  return IteratorRange<iterator>(lower_bound(lo), lower_bound(hi));
+}
+
+template <typename Key, typename Compare>
+template <typename... Args>
+Vector<std::pair<typename CompactSet<Key, Compare>::iterator, bool>>
+CompactSet<Key, Compare>::insert_many(Args&&... args) {
+  Vector<std::pair<iterator, bool>> results;
+  (results.push_back(insert(std::forward<Args>(args))), ...);
+  return results;
+}
+
+}  // namespace s21
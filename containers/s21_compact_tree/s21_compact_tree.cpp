@@ -0,0 +1,588 @@
+//
+// Красно-черное дерево с узлами в массиве и 32-битными ссылками.
+//
+
+#include "../../include/s21_compact_tree/s21_compact_tree.hpp"
+
+#include <algorithm>
+
+namespace s21 {
+
+// Конструкторы
+
+template <typename Value, typename KeyOf, typename Compare>
+CompactTree<Value, KeyOf, Compare>::CompactTree()
+    : CompactTree(Compare()) {}
+
+template <typename Value, typename KeyOf, typename Compare>
+CompactTree<Value, KeyOf, Compare>::CompactTree(const Compare& comp)
+    : nodes_(nullptr),
+      capacity_(0),
+      used_(0),
+      free_(kNil),
+      root_(kNil),
+      size_(0),
+      comp_(comp) {}
+
+// Номера узлов не зависят от адреса массива, поэтому копия повторяет
+// массив слот в слот, без сравнений ключей и перебалансировки
+template <typename Value, typename KeyOf, typename Compare>
+CompactTree<Value, KeyOf, Compare>::CompactTree(const CompactTree& other)
+    : CompactTree(other.comp_) {
+  if (other.size_ == 0) {
+    return;
+  }
+  nodes_ = std::allocator<Node>().allocate(other.used_);
+  capacity_ = other.used_;
+  index_type copied = 1;
+  try {
+    for (; copied < other.used_; ++copied) {
+      const Node& source = other.nodes_[copied];
+      if (source.parent != kFreeMark) {
+        ::new (static_cast<void*>(nodes_[copied].storage))
+            Value(other.valueAt(copied));
+      }
+    }
+  } catch (...) {
+    for (index_type i = 1; i < copied; ++i) {
+      if (other.nodes_[i].parent != kFreeMark) {
+        valueAt(i).~Value();
+      }
+    }
+    deallocate();
+    throw;
+  }
+  for (index_type i = 0; i < other.used_; ++i) {
+    nodes_[i].left = other.nodes_[i].left;
+    nodes_[i].right = other.nodes_[i].right;
+    nodes_[i].parent = other.nodes_[i].parent;
+    nodes_[i].red = other.nodes_[i].red;
+  }
+  used_ = other.used_;
+  free_ = other.free_;
+  root_ = other.root_;
+  size_ = other.size_;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+CompactTree<Value, KeyOf, Compare>::CompactTree(CompactTree&& other) noexcept
+    : CompactTree(other.comp_) {
+  swap(other);
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+CompactTree<Value, KeyOf, Compare>::~CompactTree() {
+  destroyAll();
+  deallocate();
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+CompactTree<Value, KeyOf, Compare>&
+CompactTree<Value, KeyOf, Compare>::operator=(const CompactTree& other) {
+  if (this != &other) {
+    CompactTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+CompactTree<Value, KeyOf, Compare>&
+CompactTree<Value, KeyOf, Compare>::operator=(CompactTree&& other) noexcept {
+  if (this != &other) {
+    destroyAll();
+    deallocate();
+    swap(other);
+  }
+  return *this;
+}
+
+// Вместимость и модификаторы
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::reserve(size_type count) {
+  if (count > kMaxSize) {
+    throw std::length_error("CompactTree size limit exceeded");
+  }
+  if (count + 1 > capacity_) {
+    grow(count + 1);
+  }
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::clear() {
+  destroyAll();
+  used_ = capacity_ == 0 ? 0 : 1;
+  free_ = kNil;
+  root_ = kNil;
+  size_ = 0;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::swap(CompactTree& other) noexcept {
+  std::swap(nodes_, other.nodes_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(used_, other.used_);
+  std::swap(free_, other.free_);
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+template <typename K, typename... Args>
+std::pair<typename CompactTree<Value, KeyOf, Compare>::iterator, bool>
+CompactTree<Value, KeyOf, Compare>::emplaceKey(const K& key, Args&&... args) {
+  index_type parent = kNil;
+  bool as_left = false;
+  for (index_type current = root_; current != kNil;) {
+    parent = current;
+    if (comp_(key, keyAt(current))) {
+      as_left = true;
+      current = nodes_[current].left;
+    } else if (comp_(keyAt(current), key)) {
+      as_left = false;
+      current = nodes_[current].right;
+    } else {
+      return {iterator(this, current), false};
+    }
+  }
+
+  index_type index = allocateNode();
+  try {
+    ::new (static_cast<void*>(nodes_[index].storage))
+        Value(std::forward<Args>(args)...);
+  } catch (...) {
+    releaseNode(index);
+    throw;
+  }
+  Node& node = nodes_[index];
+  node.left = kNil;
+  node.right = kNil;
+  node.parent = parent;
+  node.red = 1;
+  if (parent == kNil) {
+    root_ = index;
+  } else if (as_left) {
+    nodes_[parent].left = index;
+  } else {
+    nodes_[parent].right = index;
+  }
+  ++size_;
+  insertFixup(index);
+  return {iterator(this, index), true};
+}
+
+// Удаление по CLRS: узел с двумя детьми заменяется преемником целиком, а не
+// копированием значения, поэтому номера остальных элементов не меняются
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::erase(const_iterator pos) {
+  index_type z = pos.index_;
+  index_type y = z;
+  bool y_was_red = nodes_[y].red;
+  index_type x;
+  if (nodes_[z].left == kNil) {
+    x = nodes_[z].right;
+    transplant(z, x);
+  } else if (nodes_[z].right == kNil) {
+    x = nodes_[z].left;
+    transplant(z, x);
+  } else {
+    y = minimum(nodes_[z].right);
+    y_was_red = nodes_[y].red;
+    x = nodes_[y].right;
+    if (nodes_[y].parent == z) {
+      nodes_[x].parent = y;
+    } else {
+      transplant(y, x);
+      nodes_[y].right = nodes_[z].right;
+      nodes_[nodes_[y].right].parent = y;
+    }
+    transplant(z, y);
+    nodes_[y].left = nodes_[z].left;
+    nodes_[nodes_[y].left].parent = y;
+    nodes_[y].red = nodes_[z].red;
+  }
+  if (!y_was_red) {
+    eraseFixup(x);
+  }
+  valueAt(z).~Value();
+  releaseNode(z);
+  --size_;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::merge(CompactTree& other) {
+  if (this == &other) {
+    return;
+  }
+  for (index_type current = other.minimum(other.root_); current != kNil;) {
+    index_type following = other.next(current);
+    Value& value = other.valueAt(current);
+    if (emplaceKey(KeyOf::key(value), std::move(value)).second) {
+      other.erase(const_iterator(&other, current));
+    }
+    current = following;
+  }
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+bool CompactTree<Value, KeyOf, Compare>::validateForTesting() const {
+  if (root_ == kNil) {
+    return size_ == 0;
+  }
+  if (nodes_[root_].parent != kNil || nodes_[root_].red || nodes_[kNil].red) {
+    return false;
+  }
+  size_type count = 0;
+  bool valid = true;
+  blackHeight(root_, count, valid);
+  for (index_type i = minimum(root_), j = next(i); j != kNil;
+       i = j, j = next(j)) {
+    valid = valid && comp_(keyAt(i), keyAt(j));
+  }
+  size_type free_count = 0;
+  for (index_type i = free_; i != kNil; i = nodes_[i].left) {
+    valid = valid && nodes_[i].parent == kFreeMark;
+    ++free_count;
+  }
+  return valid && count == size_ && size_ + free_count + 1 == used_;
+}
+
+// Обход
+
+template <typename Value, typename KeyOf, typename Compare>
+typename CompactTree<Value, KeyOf, Compare>::index_type
+CompactTree<Value, KeyOf, Compare>::minimum(index_type index) const {
+  if (index != kNil) {
+    while (nodes_[index].left != kNil) {
+      index = nodes_[index].left;
+    }
+  }
+  return index;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+typename CompactTree<Value, KeyOf, Compare>::index_type
+CompactTree<Value, KeyOf, Compare>::maximum(index_type index) const {
+  if (index != kNil) {
+    while (nodes_[index].right != kNil) {
+      index = nodes_[index].right;
+    }
+  }
+  return index;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+typename CompactTree<Value, KeyOf, Compare>::index_type
+CompactTree<Value, KeyOf, Compare>::next(index_type index) const {
+  if (nodes_[index].right != kNil) {
+    return minimum(nodes_[index].right);
+  }
+  index_type parent = nodes_[index].parent;
+  while (parent != kNil && index == nodes_[parent].right) {
+    index = parent;
+    parent = nodes_[parent].parent;
+  }
+  return parent;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+typename CompactTree<Value, KeyOf, Compare>::index_type
+CompactTree<Value, KeyOf, Compare>::prev(index_type index) const {
+  if (index == kNil) {
+    return maximum(root_);
+  }
+  if (nodes_[index].left != kNil) {
+    return maximum(nodes_[index].left);
+  }
+  index_type parent = nodes_[index].parent;
+  while (parent != kNil && index == nodes_[parent].left) {
+    index = parent;
+    parent = nodes_[parent].parent;
+  }
+  return parent;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+template <typename K>
+typename CompactTree<Value, KeyOf, Compare>::index_type
+CompactTree<Value, KeyOf, Compare>::findIndex(const K& key) const {
+  index_type current = root_;
+  while (current != kNil) {
+    if (comp_(key, keyAt(current))) {
+      current = nodes_[current].left;
+    } else if (comp_(keyAt(current), key)) {
+      current = nodes_[current].right;
+    } else {
+      return current;
+    }
+  }
+  return kNil;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+template <typename K>
+typename CompactTree<Value, KeyOf, Compare>::index_type
+CompactTree<Value, KeyOf, Compare>::boundIndex(const K& key,
+                                               bool upper) const {
+  index_type result = kNil;
+  index_type current = root_;
+  while (current != kNil) {
+    bool go_left = upper ? comp_(key, keyAt(current))
+                         : !comp_(keyAt(current), key);
+    if (go_left) {
+      result = current;
+      current = nodes_[current].left;
+    } else {
+      current = nodes_[current].right;
+    }
+  }
+  return result;
+}
+
+// Память
+
+template <typename Value, typename KeyOf, typename Compare>
+typename CompactTree<Value, KeyOf, Compare>::index_type
+CompactTree<Value, KeyOf, Compare>::allocateNode() {
+  if (free_ != kNil) {
+    index_type index = free_;
+    free_ = nodes_[index].left;
+    return index;
+  }
+  if (used_ == capacity_) {
+    if (size_ >= kMaxSize) {
+      throw std::length_error("CompactTree size limit exceeded");
+    }
+    grow(std::min<size_type>(std::max<size_type>(capacity_ * 2, 16),
+                             kMaxSize + 1));
+  }
+  return used_++;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::releaseNode(index_type index) {
+  nodes_[index].parent = kFreeMark;
+  nodes_[index].left = free_;
+  free_ = index;
+}
+
+// Значения переносятся в новый массив, связи копируются как есть
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::grow(size_type new_capacity) {
+  std::allocator<Node> allocator;
+  Node* fresh = allocator.allocate(new_capacity);
+  if (capacity_ == 0) {
+    fresh[kNil].left = kNil;
+    fresh[kNil].right = kNil;
+    fresh[kNil].parent = kNil;
+    fresh[kNil].red = 0;
+    used_ = 1;
+  }
+  for (index_type i = 0; i < used_ && capacity_ != 0; ++i) {
+    Node& source = nodes_[i];
+    if (i != kNil && source.parent != kFreeMark) {
+      Value& value = valueAt(i);
+      ::new (static_cast<void*>(fresh[i].storage)) Value(std::move(value));
+      value.~Value();
+    }
+    fresh[i].left = source.left;
+    fresh[i].right = source.right;
+    fresh[i].parent = source.parent;
+    fresh[i].red = source.red;
+  }
+  if (nodes_) {
+    allocator.deallocate(nodes_, capacity_);
+  }
+  nodes_ = fresh;
+  capacity_ = new_capacity;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::destroyAll() {
+  if (!std::is_trivially_destructible<Value>::value) {
+    for (index_type i = 1; i < used_; ++i) {
+      if (nodes_[i].parent != kFreeMark) {
+        valueAt(i).~Value();
+      }
+    }
+  }
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::deallocate() {
+  if (nodes_) {
+    std::allocator<Node>().deallocate(nodes_, capacity_);
+  }
+  nodes_ = nullptr;
+  capacity_ = 0;
+  used_ = 0;
+  free_ = kNil;
+  root_ = kNil;
+  size_ = 0;
+}
+
+// Балансировка (CLRS, глава 13)
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::rotateLeft(index_type x) {
+  index_type y = nodes_[x].right;
+  nodes_[x].right = nodes_[y].left;
+  if (nodes_[y].left != kNil) {
+    nodes_[nodes_[y].left].parent = x;
+  }
+  transplant(x, y);
+  nodes_[y].left = x;
+  nodes_[x].parent = y;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::rotateRight(index_type x) {
+  index_type y = nodes_[x].left;
+  nodes_[x].left = nodes_[y].right;
+  if (nodes_[y].right != kNil) {
+    nodes_[nodes_[y].right].parent = x;
+  }
+  transplant(x, y);
+  nodes_[y].right = x;
+  nodes_[x].parent = y;
+}
+
+// Ставит поддерево v на место u; родитель v меняется, даже если v - nil
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::transplant(index_type u,
+                                                    index_type v) {
+  index_type parent = nodes_[u].parent;
+  if (parent == kNil) {
+    root_ = v;
+  } else if (u == nodes_[parent].left) {
+    nodes_[parent].left = v;
+  } else {
+    nodes_[parent].right = v;
+  }
+  nodes_[v].parent = parent;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::insertFixup(index_type z) {
+  while (nodes_[nodes_[z].parent].red) {
+    index_type parent = nodes_[z].parent;
+    index_type grandparent = nodes_[parent].parent;
+    bool parent_is_left = parent == nodes_[grandparent].left;
+    index_type uncle = parent_is_left ? nodes_[grandparent].right
+                                      : nodes_[grandparent].left;
+    if (nodes_[uncle].red) {
+      nodes_[parent].red = 0;
+      nodes_[uncle].red = 0;
+      nodes_[grandparent].red = 1;
+      z = grandparent;
+      continue;
+    }
+    if (parent_is_left) {
+      if (z == nodes_[parent].right) {
+        z = parent;
+        rotateLeft(z);
+      }
+      nodes_[nodes_[z].parent].red = 0;
+      nodes_[grandparent].red = 1;
+      rotateRight(grandparent);
+    } else {
+      if (z == nodes_[parent].left) {
+        z = parent;
+        rotateRight(z);
+      }
+      nodes_[nodes_[z].parent].red = 0;
+      nodes_[grandparent].red = 1;
+      rotateLeft(grandparent);
+    }
+  }
+  nodes_[root_].red = 0;
+}
+
+template <typename Value, typename KeyOf, typename Compare>
+void CompactTree<Value, KeyOf, Compare>::eraseFixup(index_type x) {
+  while (x != root_ && !nodes_[x].red) {
+    index_type parent = nodes_[x].parent;
+    if (x == nodes_[parent].left) {
+      index_type sibling = nodes_[parent].right;
+      if (nodes_[sibling].red) {
+        nodes_[sibling].red = 0;
+        nodes_[parent].red = 1;
+        rotateLeft(parent);
+        sibling = nodes_[parent].right;
+      }
+      if (!nodes_[nodes_[sibling].left].red &&
+          !nodes_[nodes_[sibling].right].red) {
+        nodes_[sibling].red = 1;
+        x = parent;
+        continue;
+      }
+      if (!nodes_[nodes_[sibling].right].red) {
+        nodes_[nodes_[sibling].left].red = 0;
+        nodes_[sibling].red = 1;
+        rotateRight(sibling);
+        sibling = nodes_[parent].right;
+      }
+      nodes_[sibling].red = nodes_[parent].red;
+      nodes_[parent].red = 0;
+      nodes_[nodes_[sibling].right].red = 0;
+      rotateLeft(parent);
+    } else {
+      index_type sibling = nodes_[parent].left;
+      if (nodes_[sibling].red) {
+        nodes_[sibling].red = 0;
+        nodes_[parent].red = 1;
+        rotateRight(parent);
+        sibling = nodes_[parent].left;
+      }
+      if (!nodes_[nodes_[sibling].left].red &&
+          !nodes_[nodes_[sibling].right].red) {
+        nodes_[sibling].red = 1;
+        x = parent;
+        continue;
+      }
+      if (!nodes_[nodes_[sibling].left].red) {
+        nodes_[nodes_[sibling].right].red = 0;
+        nodes_[sibling].red = 1;
+        rotateLeft(sibling);
+        sibling = nodes_[parent].left;
+      }
+      nodes_[sibling].red = nodes_[parent].red;
+      nodes_[parent].red = 0;
+      nodes_[nodes_[sibling].left].red = 0;
+      rotateRight(parent);
+    }
+    x = root_;
+  }
+  nodes_[x].red = 0;
+}
+
+// Возвращает черную высоту поддерева; valid сбрасывается при нарушении
+// цвета или ссылок на родителя, count накапливает число узлов
+template <typename Value, typename KeyOf, typename Compare>
+int CompactTree<Value, KeyOf, Compare>::blackHeight(index_type index,
+                                                    size_type& count,
+                                                    bool& valid) const {
+  if (index == kNil) {
+    return 1;
+  }
+  ++count;
+  const Node& node = nodes_[index];
+  for (index_type child : {node.left, node.right}) {
+    if (child == kNil) {
+      continue;
+    }
+    if (nodes_[child].parent != index || (node.red && nodes_[child].red)) {
+      valid = false;
+    }
+  }
+  int left = blackHeight(node.left, count, valid);
+  int right = blackHeight(node.right, count, valid);
+  if (left != right) {
+    valid = false;
+  }
+  return left + (node.red ? 0 : 1);
+}
+
+}  // namespace s21
@@ -0,0 +1,233 @@
+//
+// Потокобезопасный упорядоченный словарь, разбитый на шарды.
+//
+
+#include "../../include/s21_concurrent_map/s21_concurrent_map.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare, typename Hash>
+ConcurrentMap<Key, T, Compare, Hash>::ConcurrentMap(size_type shard_count,
+                                                    const Compare& comp,
+                                                    const Hash& hash)
+    : shard_count_(1), comp_(comp), hash_(hash) {
+  while (shard_count_ < shard_count) {
+    shard_count_ *= 2;
+  }
+  shards_ = std::make_unique<Shard[]>(shard_count_);
+  for (size_type i = 0; i < shard_count_; ++i) {
+    shards_[i].map = ShardMap(comp_);
+  }
+}
+
+// Точечные операции
+
+template <typename Key, typename T, typename Compare, typename Hash>
+bool ConcurrentMap<Key, T, Compare, Hash>::insert(const Key& key,
+                                                  const T& obj) {
+  Shard& shard = shardFor(key);
+  WriteLock lock = lockExclusive(shard);
+  return shard.map.insert(key, obj).second;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+bool ConcurrentMap<Key, T, Compare, Hash>::insert_or_assign(const Key& key,
+                                                            const T& obj) {
+  Shard& shard = shardFor(key);
+  WriteLock lock = lockExclusive(shard);
+  return shard.map.insert_or_assign(key, obj).second;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+bool ConcurrentMap<Key, T, Compare, Hash>::erase(const Key& key) {
+  Shard& shard = shardFor(key);
+  WriteLock lock = lockExclusive(shard);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return false;
+  }
+  shard.map.erase(it);
+  return true;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+bool ConcurrentMap<Key, T, Compare, Hash>::contains(const Key& key) const {
+  const Shard& shard = shardFor(key);
+  ReadLock lock = lockShared(shard);
+  return shard.map.contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+std::optional<T> ConcurrentMap<Key, T, Compare, Hash>::find(
+    const Key& key) const {
+  const Shard& shard = shardFor(key);
+  ReadLock lock = lockShared(shard);
+  typename ShardMap::const_iterator it = shard.map.lower_bound(key);
+  if (it == shard.map.end() || comp_(key, it->first)) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+template <typename Func>
+bool ConcurrentMap<Key, T, Compare, Hash>::update(const Key& key,
+                                                  Func&& func) {
+  Shard& shard = shardFor(key);
+  WriteLock lock = lockExclusive(shard);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return false;
+  }
+  func(it->second);
+  return true;
+}
+
+// Операции над всеми шардами
+
+template <typename Key, typename T, typename Compare, typename Hash>
+typename ConcurrentMap<Key, T, Compare, Hash>::size_type
+ConcurrentMap<Key, T, Compare, Hash>::size() const {
+  size_type total = 0;
+  for (size_type i = 0; i < shard_count_; ++i) {
+    ReadLock lock = lockShared(shards_[i]);
+    total += shards_[i].map.size();
+  }
+  return total;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+void ConcurrentMap<Key, T, Compare, Hash>::clear() {
+  for (size_type i = 0; i < shard_count_; ++i) {
+    WriteLock lock = lockExclusive(shards_[i]);
+    shards_[i].map.clear();
+  }
+}
+
+// Замки берутся по возрастанию номера шарда, а писатели держат не больше
+// одного замка, поэтому взаимной блокировки нет. Отрезки шардов сливаются
+// кучей из текущих позиций: O(k log s) на k элементов и s шардов
+template <typename Key, typename T, typename Compare, typename Hash>
+template <typename Func>
+void ConcurrentMap<Key, T, Compare, Hash>::scan(const Key& lo, const Key& hi,
+                                                Func&& func) const {
+  using Cursor = std::pair<typename ShardMap::const_iterator,
+                           typename ShardMap::const_iterator>;
+  Vector<ReadLock> locks;
+  Vector<Cursor> cursors;
+  locks.reserve(shard_count_);
+  cursors.reserve(shard_count_);
+  for (size_type i = 0; i < shard_count_; ++i) {
+    const Shard& shard = shards_[i];
+    locks.push_back(lockShared(shard));
+    auto slice = shard.map.range(lo, hi);
+    if (!slice.empty()) {
+      cursors.push_back(Cursor(slice.begin(), slice.end()));
+    }
+  }
+
+  // std::make_heap строит кучу с максимумом наверху, поэтому сравнение
+  // перевернуто
+  auto later = [this](const Cursor& a, const Cursor& b) {
+    return comp_(b.first->first, a.first->first);
+  };
+  Cursor* first = cursors.data();
+  Cursor* last = first + cursors.size();
+  std::make_heap(first, last, later);
+  while (first != last) {
+    std::pop_heap(first, last, later);
+    Cursor& cursor = *(last - 1);
+    func(cursor.first->first, cursor.first->second);
+    if (++cursor.first == cursor.second) {
+      --last;
+    } else {
+      std::push_heap(first, last, later);
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+Vector<typename ConcurrentMap<Key, T, Compare, Hash>::value_type>
+ConcurrentMap<Key, T, Compare, Hash>::range(const Key& lo,
+                                            const Key& hi) const {
+  Vector<value_type> result;
+  scan(lo, hi, [&result](const Key& key, const T& value) {
+    result.push_back(value_type(key, value));
+  });
+  return result;
+}
+
+// Статистика
+
+template <typename Key, typename T, typename Compare, typename Hash>
+Vector<ShardStats> ConcurrentMap<Key, T, Compare, Hash>::shard_stats() const {
+  Vector<ShardStats> result;
+  result.reserve(shard_count_);
+  for (size_type i = 0; i < shard_count_; ++i) {
+    const Shard& shard = shards_[i];
+    ShardStats stats;
+    {
+      // Замок без учета в счетчиках, чтобы опрос не искажал статистику
+      ReadLock lock(shard.mutex);
+      stats.size = shard.map.size();
+    }
+    stats.reads = shard.reads.load(std::memory_order_relaxed);
+    stats.writes = shard.writes.load(std::memory_order_relaxed);
+    stats.contended_reads =
+        shard.contended_reads.load(std::memory_order_relaxed);
+    stats.contended_writes =
+        shard.contended_writes.load(std::memory_order_relaxed);
+    result.push_back(stats);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+void ConcurrentMap<Key, T, Compare, Hash>::reset_shard_stats() {
+  for (size_type i = 0; i < shard_count_; ++i) {
+    shards_[i].reads.store(0, std::memory_order_relaxed);
+    shards_[i].writes.store(0, std::memory_order_relaxed);
+    shards_[i].contended_reads.store(0, std::memory_order_relaxed);
+    shards_[i].contended_writes.store(0, std::memory_order_relaxed);
+  }
+}
+
+// Служебные методы
+
+// Номер шарда - старшие биты перемешанного хеша
+template <typename Key, typename T, typename Compare, typename Hash>
+typename ConcurrentMap<Key, T, Compare, Hash>::Shard&
+ConcurrentMap<Key, T, Compare, Hash>::shardFor(const Key& key) const {
+  std::uint64_t hash = mixHash(static_cast<std::uint64_t>(hash_(key)));
+  return shards_[static_cast<size_type>(hash >> 32) & (shard_count_ - 1)];
+}
+
+// Сначала пробуем захватить замок без ожидания: неудача и есть конфликт
+template <typename Key, typename T, typename Compare, typename Hash>
+typename ConcurrentMap<Key, T, Compare, Hash>::ReadLock
+ConcurrentMap<Key, T, Compare, Hash>::lockShared(const Shard& shard) {
+  ReadLock lock(shard.mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    shard.contended_reads.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+  shard.reads.fetch_add(1, std::memory_order_relaxed);
+  return lock;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash>
+typename ConcurrentMap<Key, T, Compare, Hash>::WriteLock
+ConcurrentMap<Key, T, Compare, Hash>::lockExclusive(Shard& shard) {
+  WriteLock lock(shard.mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    shard.contended_writes.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+  shard.writes.fetch_add(1, std::memory_order_relaxed);
+  return lock;
+}
+
+}  // namespace s21
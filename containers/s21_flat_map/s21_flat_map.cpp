@@ -0,0 +1,469 @@
+//
+// Ассоциативный массив на отсортированных массивах ключей и значений.
+//
+
+#include "../../include/s21_flat_map/s21_flat_map.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace s21 {
+
+// Конструкторы
+
+template <typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::FlatMap() : keys_(), values_(), comp_() {}
+
+template <typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::FlatMap(const Compare& comp)
+    : keys_(), values_(), comp_(comp) {}
+
+template <typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::FlatMap(
+    std::initializer_list<value_type> const& items)
+    : FlatMap() {
+  Vector<std::pair<Key, T>> batch;
+  batch.reserve(items.size());
+  for (const auto& item : items) {
+    batch.push_back(std::pair<Key, T>(item));
+  }
+  Vector<bool> inserted;
+  insertBatch(batch, inserted);
+}
+
+template <typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::FlatMap(const FlatMap& other)
+    : keys_(other.keys_), values_(other.values_), comp_(other.comp_) {}
+
+template <typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::FlatMap(FlatMap&& other) noexcept
+    : keys_(std::move(other.keys_)),
+      values_(std::move(other.values_)),
+      comp_(other.comp_) {}
+
+template <typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>& FlatMap<Key, T, Compare>::operator=(
+    const FlatMap& other) {
+  if (this != &other) {
+    FlatMap copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>& FlatMap<Key, T, Compare>::operator=(
+    FlatMap&& other) noexcept {
+  if (this != &other) {
+    keys_ = std::move(other.keys_);
+    values_ = std::move(other.values_);
+    comp_ = other.comp_;
+  }
+  return *this;
+}
+
+// Доступ к элементам
+
+template <typename Key, typename T, typename Compare>
+T& FlatMap<Key, T, Compare>::at(const Key& key) {
+  iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return *it.value_;
+}
+
+template <typename Key, typename T, typename Compare>
+const T& FlatMap<Key, T, Compare>::at(const Key& key) const {
+  const_iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return *it.value_;
+}
+
+template <typename Key, typename T, typename Compare>
+T& FlatMap<Key, T, Compare>::operator[](const Key& key) {
+  return *emplaceUnique(key).first.value_;
+}
+
+// Итераторы
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::begin() {
+  return iteratorAt(0);
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::end() {
+  return iteratorAt(keys_.size());
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::const_iterator
+FlatMap<Key, T, Compare>::begin() const {
+  return iteratorAt(0);
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::const_iterator
+FlatMap<Key, T, Compare>::end() const {
+  return iteratorAt(keys_.size());
+}
+
+// Вместимость
+
+template <typename Key, typename T, typename Compare>
+bool FlatMap<Key, T, Compare>::empty() const {
+  return keys_.empty();
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::size_type FlatMap<Key, T, Compare>::size()
+    const {
+  return keys_.size();
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::size_type
+FlatMap<Key, T, Compare>::max_size() const {
+  return std::numeric_limits<size_type>::max() / (sizeof(Key) + sizeof(T));
+}
+
+template <typename Key, typename T, typename Compare>
+void FlatMap<Key, T, Compare>::reserve(size_type count) {
+  keys_.reserve(count);
+  values_.reserve(count);
+}
+
+template <typename Key, typename T, typename Compare>
+void FlatMap<Key, T, Compare>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+  values_.shrink_to_fit();
+}
+
+// Модификаторы
+
+// Vector::clear только обнуляет размер, а элементы могут удерживать ресурсы
+template <typename Key, typename T, typename Compare>
+void FlatMap<Key, T, Compare>::clear() {
+  keys_ = Vector<Key>();
+  values_ = Vector<T>();
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename FlatMap<Key, T, Compare>::iterator, bool>
+FlatMap<Key, T, Compare>::insert(const value_type& value) {
+  return emplaceUnique(value.first, value.second);
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename FlatMap<Key, T, Compare>::iterator, bool>
+FlatMap<Key, T, Compare>::insert(const Key& key, const T& obj) {
+  return emplaceUnique(key, obj);
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename FlatMap<Key, T, Compare>::iterator, bool>
+FlatMap<Key, T, Compare>::insert_or_assign(const Key& key, const T& obj) {
+  auto result = emplaceUnique(key, obj);
+  if (!result.second) {
+    *result.first.value_ = obj;
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename FlatMap<Key, T, Compare>::iterator, bool>
+FlatMap<Key, T, Compare>::try_emplace(const Key& key, Args&&... args) {
+  return emplaceUnique(key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare>
+void FlatMap<Key, T, Compare>::erase(iterator pos) {
+  size_type index = static_cast<size_type>(pos.key_ - keys_.data());
+  keys_.erase(keys_.begin() + index);
+  values_.erase(values_.begin() + index);
+}
+
+template <typename Key, typename T, typename Compare>
+void FlatMap<Key, T, Compare>::swap(FlatMap& other) {
+  keys_.swap(other.keys_);
+  values_.swap(other.values_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename T, typename Compare>
+void FlatMap<Key, T, Compare>::merge(FlatMap& other) {
+  if (this == &other) {
+    return;
+  }
+
+  FlatMap merged(comp_);
+  FlatMap rest(other.comp_);
+  merged.reserve(size() + other.size());
+  auto take = [](FlatMap& to, FlatMap& from, size_type index) {
+    to.keys_.push_back(std::move(from.keys_[index]));
+    to.values_.push_back(std::move(from.values_[index]));
+  };
+
+  size_type i = 0;
+  size_type j = 0;
+  while (i < size() && j < other.size()) {
+    if (comp_(keys_[i], other.keys_[j])) {
+      take(merged, *this, i++);
+    } else if (comp_(other.keys_[j], keys_[i])) {
+      take(merged, other, j++);
+    } else {
+      take(merged, *this, i++);
+      take(rest, other, j++);
+    }
+  }
+  for (; i < size(); ++i) {
+    take(merged, *this, i);
+  }
+  for (; j < other.size(); ++j) {
+    take(merged, other, j);
+  }
+  swap(merged);
+  other.swap(rest);
+}
+
+// Просмотр контейнера
+
+template <typename Key, typename T, typename Compare>
+bool FlatMap<Key, T, Compare>::contains(const Key& key) const {
+  return find(key) != end();
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::find(
+    const Key& key) {
+  size_type index = lowerIndex(key);
+  if (index < keys_.size() && !comp_(key, keys_[index])) {
+    return iteratorAt(index);
+  }
+  return end();
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::const_iterator
+FlatMap<Key, T, Compare>::find(const Key& key) const {
+  size_type index = lowerIndex(key);
+  if (index < keys_.size() && !comp_(key, keys_[index])) {
+    return iteratorAt(index);
+  }
+  return end();
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::iterator
+FlatMap<Key, T, Compare>::lower_bound(const Key& key) {
+  return iteratorAt(lowerIndex(key));
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::const_iterator
+FlatMap<Key, T, Compare>::lower_bound(const Key& key) const {
+  return iteratorAt(lowerIndex(key));
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::iterator
+FlatMap<Key, T, Compare>::upper_bound(const Key& key) {
+  return iteratorAt(
+      branchlessUpperBound(keys_.data(), keys_.size(), key, comp_));
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::const_iterator
+FlatMap<Key, T, Compare>::upper_bound(const Key& key) const {
+  return iteratorAt(
+      branchlessUpperBound(keys_.data(), keys_.size(), key, comp_));
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename FlatMap<Key, T, Compare>::iterator,
+          typename FlatMap<Key, T, Compare>::iterator>
+FlatMap<Key, T, Compare>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename FlatMap<Key, T, Compare>::const_iterator,
+          typename FlatMap<Key, T, Compare>::const_iterator>
+FlatMap<Key, T, Compare>::equal_range(const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename T, typename Compare>
+IteratorRange<typename FlatMap<Key, T, Compare>::iterator>
+FlatMap<Key, T, Compare>::range(const Key& lo, const Key& hi) {
+  if (!comp_(lo, hi)) {
+    return {end(), end()};
+  }
+  return {lower_bound(lo), lower_bound(hi)};
+}
+
+template <typename Key, typename T, typename Compare>
+IteratorRange<typename FlatMap<Key, T, Compare>::const_iterator>
+FlatMap<Key, T, Compare>::range(const Key& lo, const Key& hi) const {
+  if (!comp_(lo, hi)) {
+    return {end(), end()};
+  }
+  return {lower_bound(lo), lower_bound(hi)};
+}
+
+// Итераторы из результата получаются после слияния, когда массивы уже не
+// будут перевыделяться
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+Vector<std::pair<typename FlatMap<Key, T, Compare>::iterator, bool>>
+FlatMap<Key, T, Compare>::insert_many(Args&&... args) {
+  Vector<std::pair<Key, T>> batch;
+  batch.reserve(sizeof...(args));
+  (batch.push_back(std::pair<Key, T>(std::forward<Args>(args))), ...);
+  Vector<bool> inserted;
+  insertBatch(batch, inserted);
+
+  Vector<std::pair<iterator, bool>> results;
+  results.reserve(batch.size());
+  for (size_type i = 0; i < batch.size(); ++i) {
+    results.push_back({find(batch[i].first), inserted[i]});
+  }
+  return results;
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename ForwardIt>
+void FlatMap<Key, T, Compare>::assign_sorted(ForwardIt first, ForwardIt last,
+                                             bool checked) {
+  clear();
+  reserve(static_cast<size_type>(std::distance(first, last)));
+  if (checked) {
+    for (ForwardIt prev = first, it = first; it != last; prev = it) {
+      if (++it != last && !comp_((*prev).first, (*it).first)) {
+        Vector<std::pair<Key, T>> batch;
+        for (; first != last; ++first) {
+          batch.push_back(std::pair<Key, T>((*first).first, (*first).second));
+        }
+        Vector<bool> inserted;
+        insertBatch(batch, inserted);
+        return;
+      }
+    }
+  }
+  for (; first != last; ++first) {
+    keys_.push_back((*first).first);
+    values_.push_back((*first).second);
+  }
+}
+
+// Служебные методы
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::size_type
+FlatMap<Key, T, Compare>::lowerIndex(const Key& key) const {
+  return branchlessLowerBound(keys_.data(), keys_.size(), key, comp_);
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::iterator
+FlatMap<Key, T, Compare>::iteratorAt(size_type index) {
+  return iterator(keys_.data() + index, values_.data() + index);
+}
+
+template <typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::const_iterator
+FlatMap<Key, T, Compare>::iteratorAt(size_type index) const {
+  return const_iterator(keys_.data() + index, values_.data() + index);
+}
+
+// Новый элемент дописывается в конец обоих массивов и поворотом встает на
+// свое место: значение перемещается, а не копируется в Vector::insert
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename FlatMap<Key, T, Compare>::iterator, bool>
+FlatMap<Key, T, Compare>::emplaceUnique(const Key& key, Args&&... args) {
+  size_type index = lowerIndex(key);
+  if (index < keys_.size() && !comp_(key, keys_[index])) {
+    return {iteratorAt(index), false};
+  }
+
+  T value(std::forward<Args>(args)...);
+  keys_.push_back(key);
+  try {
+    values_.push_back(std::move(value));
+  } catch (...) {
+    keys_.pop_back();
+    throw;
+  }
+  std::rotate(keys_.begin() + index, keys_.end() - 1, keys_.end());
+  std::rotate(values_.begin() + index, values_.end() - 1, values_.end());
+  return {iteratorAt(index), true};
+}
+
+// Пакет сортируется по индексам, чтобы из равных ключей первым шел более
+// ранний аргумент. Новые элементы вливаются с конца в массивы, удлиненные на
+// их число: каждый старый элемент правее наименьшего нового сдвигается один
+// раз, а не при каждой вставке, и новой памяти сверх удвоения не нужно
+template <typename Key, typename T, typename Compare>
+void FlatMap<Key, T, Compare>::insertBatch(Vector<std::pair<Key, T>>& batch,
+                                           Vector<bool>& inserted) {
+  size_type count = batch.size();
+  Vector<size_type> order(count);
+  inserted = Vector<bool>(count);
+  for (size_type i = 0; i < count; ++i) {
+    order[i] = i;
+    inserted[i] = false;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_type a, size_type b) {
+                     return comp_(batch[a].first, batch[b].first);
+                   });
+
+  // Отбрасываются повторы внутри пакета и ключи, которые уже есть;
+  // positions[j] - место accepted[j] в старых массивах
+  Vector<size_type> accepted;
+  Vector<size_type> positions;
+  for (size_type j = 0; j < count; ++j) {
+    const Key& key = batch[order[j]].first;
+    if (j > 0 && !comp_(batch[order[j - 1]].first, key)) {
+      continue;
+    }
+    size_type index = lowerIndex(key);
+    if (index < size() && !comp_(key, keys_[index])) {
+      continue;
+    }
+    accepted.push_back(order[j]);
+    positions.push_back(index);
+    inserted[order[j]] = true;
+  }
+
+  size_type old_size = size();
+  if (keys_.capacity() < old_size + accepted.size()) {
+    reserve(std::max(old_size + accepted.size(), 2 * keys_.capacity()));
+  }
+  for (size_type j = 0; j < accepted.size(); ++j) {
+    keys_.push_back(Key());
+    values_.push_back(T());
+  }
+
+  // Отрезки старых элементов между соседними новыми сдвигаются целиком
+  size_type end = old_size;
+  for (size_type j = accepted.size(); j > 0; --j) {
+    size_type position = positions[j - 1];
+    std::move_backward(keys_.begin() + position, keys_.begin() + end,
+                       keys_.begin() + end + j);
+    std::move_backward(values_.begin() + position, values_.begin() + end,
+                       values_.begin() + end + j);
+    std::pair<Key, T>& item = batch[accepted[j - 1]];
+    keys_[position + j - 1] = item.first;
+    values_[position + j - 1] = std::move(item.second);
+    end = position;
+  }
+}
+
+}  // namespace s21
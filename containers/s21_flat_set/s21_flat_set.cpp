@@ -0,0 +1,302 @@
+//
+// Множество на отсортированном массиве.
+//
+
+#include "../../include/s21_flat_set/s21_flat_set.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace s21 {
+
+// Конструкторы
+
+template <typename Key, typename Compare>
+FlatSet<Key, Compare>::FlatSet() : keys_(), comp_() {}
+
+template <typename Key, typename Compare>
+FlatSet<Key, Compare>::FlatSet(const Compare& comp) : keys_(), comp_(comp) {}
+
+template <typename Key, typename Compare>
+FlatSet<Key, Compare>::FlatSet(std::initializer_list<value_type> const& items)
+    : FlatSet() {
+  Vector<Key> batch;
+  batch.reserve(items.size());
+  for (const auto& item : items) {
+    batch.push_back(item);
+  }
+  Vector<bool> inserted;
+  insertBatch(batch, inserted);
+}
+
+template <typename Key, typename Compare>
+FlatSet<Key, Compare>::FlatSet(const FlatSet& other)
+    : keys_(other.keys_), comp_(other.comp_) {}
+
+template <typename Key, typename Compare>
+FlatSet<Key, Compare>::FlatSet(FlatSet&& other) noexcept
+    : keys_(std::move(other.keys_)), comp_(other.comp_) {}
+
+template <typename Key, typename Compare>
+FlatSet<Key, Compare>& FlatSet<Key, Compare>::operator=(const FlatSet& other) {
+  if (this != &other) {
+    FlatSet copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare>
+FlatSet<Key, Compare>& FlatSet<Key, Compare>::operator=(
+    FlatSet&& other) noexcept {
+  if (this != &other) {
+    keys_ = std::move(other.keys_);
+    comp_ = other.comp_;
+  }
+  return *this;
+}
+
+// Вместимость
+
+template <typename Key, typename Compare>
+bool FlatSet<Key, Compare>::empty() const {
+  return keys_.empty();
+}
+
+template <typename Key, typename Compare>
+typename FlatSet<Key, Compare>::size_type FlatSet<Key, Compare>::size() const {
+  return keys_.size();
+}
+
+template <typename Key, typename Compare>
+typename FlatSet<Key, Compare>::size_type FlatSet<Key, Compare>::max_size()
+    const {
+  return std::numeric_limits<size_type>::max() / sizeof(Key);
+}
+
+template <typename Key, typename Compare>
+void FlatSet<Key, Compare>::reserve(size_type count) {
+  keys_.reserve(count);
+}
+
+template <typename Key, typename Compare>
+void FlatSet<Key, Compare>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+}
+
+// Модификаторы
+
+// Vector::clear только обнуляет размер, а ключи могут удерживать ресурсы
+template <typename Key, typename Compare>
+void FlatSet<Key, Compare>::clear() {
+  keys_ = Vector<Key>();
+}
+
+template <typename Key, typename Compare>
+std::pair<typename FlatSet<Key, Compare>::iterator, bool>
+FlatSet<Key, Compare>::insert(const value_type& value) {
+  size_type index = lowerIndex(value);
+  if (index < keys_.size() && !comp_(value, keys_[index])) {
+    return {begin() + index, false};
+  }
+  keys_.insert(keys_.begin() + index, value);
+  return {begin() + index, true};
+}
+
+template <typename Key, typename Compare>
+void FlatSet<Key, Compare>::erase(iterator pos) {
+  keys_.erase(keys_.begin() + (pos - begin()));
+}
+
+template <typename Key, typename Compare>
+void FlatSet<Key, Compare>::swap(FlatSet& other) {
+  keys_.swap(other.keys_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename Compare>
+void FlatSet<Key, Compare>::merge(FlatSet& other) {
+  if (this == &other) {
+    return;
+  }
+
+  Vector<Key> merged;
+  Vector<Key> rest;
+  merged.reserve(keys_.size() + other.keys_.size());
+  size_type i = 0;
+  size_type j = 0;
+  while (i < keys_.size() && j < other.keys_.size()) {
+    if (comp_(keys_[i], other.keys_[j])) {
+      merged.push_back(std::move(keys_[i++]));
+    } else if (comp_(other.keys_[j], keys_[i])) {
+      merged.push_back(std::move(other.keys_[j++]));
+    } else {
+      merged.push_back(std::move(keys_[i++]));
+      rest.push_back(std::move(other.keys_[j++]));
+    }
+  }
+  for (; i < keys_.size(); ++i) {
+    merged.push_back(std::move(keys_[i]));
+  }
+  for (; j < other.keys_.size(); ++j) {
+    merged.push_back(std::move(other.keys_[j]));
+  }
+  keys_ = std::move(merged);
+  other.keys_ = std::move(rest);
+}
+
+// Просмотр контейнера
+
+template <typename Key, typename Compare>
+typename FlatSet<Key, Compare>::iterator FlatSet<Key, Compare>::find(
+    const Key& key) const {
+  size_type index = lowerIndex(key);
+  if (index < keys_.size() && !comp_(key, keys_[index])) {
+    return begin() + index;
+  }
+  return end();
+}
+
+template <typename Key, typename Compare>
+bool FlatSet<Key, Compare>::contains(const Key& key) const {
+  return find(key) != end();
+}
+
+template <typename Key, typename Compare>
+typename FlatSet<Key, Compare>::iterator FlatSet<Key, Compare>::lower_bound(
+    const Key& key) const {
+  return begin() + lowerIndex(key);
+}
+
+template <typename Key, typename Compare>
+typename FlatSet<Key, Compare>::iterator FlatSet<Key, Compare>::upper_bound(
+    const Key& key) const {
+  return begin() + branchlessUpperBound(keys_.data(), keys_.size(), key, comp_);
+}
+
+template <typename Key, typename Compare>
+std::pair<typename FlatSet<Key, Compare>::iterator,
+          typename FlatSet<Key, Compare>::iterator>
+FlatSet<Key, Compare>::equal_range(const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename Compare>
+IteratorRange<typename FlatSet<Key, Compare>::iterator>
+FlatSet<Key, Compare>::range(const Key& lo, const Key& hi) const {
+  if (!comp_(lo, hi)) {
+    return {end(), end()};
+  }
+  return {lower_bound(lo), lower_bound(hi)};
+}
+
+// Итераторы из результата получаются после слияния, когда массив уже не
+// будет перевыделяться
+template <typename Key, typename Compare>
+template <typename... Args>
+Vector<std::pair<typename FlatSet<Key, Compare>::iterator, bool>>
+FlatSet<Key, Compare>::insert_many(Args&&... args) {
+  Vector<Key> batch;
+  batch.reserve(sizeof...(args));
+  (batch.push_back(Key(std::forward<Args>(args))), ...);
+  Vector<bool> inserted;
+  insertBatch(batch, inserted);
+
+  Vector<std::pair<iterator, bool>> results;
+  results.reserve(batch.size());
+  for (size_type i = 0; i < batch.size(); ++i) {
+    results.push_back({find(batch[i]), inserted[i]});
+  }
+  return results;
+}
+
+template <typename Key, typename Compare>
+template <typename ForwardIt>
+void FlatSet<Key, Compare>::assign_sorted(ForwardIt first, ForwardIt last,
+                                          bool checked) {
+  clear();
+  keys_.reserve(static_cast<size_type>(std::distance(first, last)));
+  if (checked) {
+    for (ForwardIt prev = first, it = first; it != last; prev = it) {
+      if (++it != last && !comp_(*prev, *it)) {
+        Vector<Key> batch;
+        for (; first != last; ++first) {
+          batch.push_back(*first);
+        }
+        Vector<bool> inserted;
+        insertBatch(batch, inserted);
+        return;
+      }
+    }
+  }
+  for (; first != last; ++first) {
+    keys_.push_back(*first);
+  }
+}
+
+// Служебные методы
+
+template <typename Key, typename Compare>
+typename FlatSet<Key, Compare>::size_type FlatSet<Key, Compare>::lowerIndex(
+    const Key& key) const {
+  return branchlessLowerBound(keys_.data(), keys_.size(), key, comp_);
+}
+
+// Пакет сортируется по индексам, чтобы из равных ключей первым шел более
+// ранний аргумент. Новые ключи вливаются с конца в массив, удлиненный на их
+// число: каждый старый ключ правее наименьшего нового сдвигается один раз,
+// а не при каждой вставке, и новой памяти сверх удвоения не нужно
+template <typename Key, typename Compare>
+void FlatSet<Key, Compare>::insertBatch(const Vector<Key>& batch,
+                                        Vector<bool>& inserted) {
+  size_type count = batch.size();
+  Vector<size_type> order(count);
+  inserted = Vector<bool>(count);
+  for (size_type i = 0; i < count; ++i) {
+    order[i] = i;
+    inserted[i] = false;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_type a, size_type b) {
+                     return comp_(batch[a], batch[b]);
+                   });
+
+  // Отбрасываются повторы внутри пакета и ключи, которые уже есть;
+  // positions[j] - место accepted[j] в старом массиве
+  Vector<size_type> accepted;
+  Vector<size_type> positions;
+  for (size_type j = 0; j < count; ++j) {
+    const Key& key = batch[order[j]];
+    if (j > 0 && !comp_(batch[order[j - 1]], key)) {
+      continue;
+    }
+    size_type index = lowerIndex(key);
+    if (index < keys_.size() && !comp_(key, keys_[index])) {
+      continue;
+    }
+    accepted.push_back(order[j]);
+    positions.push_back(index);
+    inserted[order[j]] = true;
+  }
+
+  size_type old_size = keys_.size();
+  if (keys_.capacity() < old_size + accepted.size()) {
+    keys_.reserve(std::max(old_size + accepted.size(), 2 * keys_.capacity()));
+  }
+  for (size_type j = 0; j < accepted.size(); ++j) {
+    keys_.push_back(Key());
+  }
+
+  // Отрезки старых ключей между соседними новыми сдвигаются целиком
+  size_type end = old_size;
+  for (size_type j = accepted.size(); j > 0; --j) {
+    size_type position = positions[j - 1];
+    std::move_backward(keys_.begin() + position, keys_.begin() + end,
+                       keys_.begin() + end + j);
+    keys_[position + j - 1] = batch[accepted[j - 1]];
+    end = position;
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,448 @@
+//
+// Хеш-таблица с открытой адресацией и групповым пробированием (SwissTable).
+//
+
+#include "../../include/s21_hash_table/s21_hash_table.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace s21 {
+
+// Конструкторы
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+HashTable<Value, KeyOf, Hash, KeyEqual>::HashTable()
+    : HashTable(Hash(), KeyEqual()) {}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+HashTable<Value, KeyOf, Hash, KeyEqual>::HashTable(const Hash& hash,
+                                                   const KeyEqual& equal)
+    : ctrl_(nullptr),
+      slots_(nullptr),
+      capacity_(0),
+      size_(0),
+      deleted_(0),
+      max_load_factor_(kDefaultMaxLoadFactor),
+      hash_(hash),
+      equal_(equal) {}
+
+// Копия раскладывается заново под свой размер: ключи известны как
+// различные, поэтому сравнения не нужны
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+HashTable<Value, KeyOf, Hash, KeyEqual>::HashTable(const HashTable& other)
+    : HashTable(other.hash_, other.equal_) {
+  max_load_factor_ = other.max_load_factor_;
+  try {
+    reserve(other.size_);
+    for (const Value& value : other) {
+      size_type hash = mix(hash_(KeyOf::key(value)));
+      size_type index = findFreeSlot(hash);
+      ::new (static_cast<void*>(slots_ + index)) Value(value);
+      ctrl_[index] = h2(hash);
+      ++size_;
+    }
+  } catch (...) {
+    destroyAll();
+    deallocate();
+    throw;
+  }
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+HashTable<Value, KeyOf, Hash, KeyEqual>::HashTable(HashTable&& other) noexcept
+    : HashTable(other.hash_, other.equal_) {
+  swap(other);
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+HashTable<Value, KeyOf, Hash, KeyEqual>::~HashTable() {
+  destroyAll();
+  deallocate();
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+HashTable<Value, KeyOf, Hash, KeyEqual>&
+HashTable<Value, KeyOf, Hash, KeyEqual>::operator=(const HashTable& other) {
+  if (this != &other) {
+    HashTable copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+HashTable<Value, KeyOf, Hash, KeyEqual>&
+HashTable<Value, KeyOf, Hash, KeyEqual>::operator=(HashTable&& other) noexcept {
+  if (this != &other) {
+    destroyAll();
+    deallocate();
+    swap(other);
+  }
+  return *this;
+}
+
+// Итераторы
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::iterator
+HashTable<Value, KeyOf, Hash, KeyEqual>::begin() {
+  if (capacity_ == 0) {
+    return end();
+  }
+  size_type index = 0;
+  while (ctrl_[index] < kCtrlSentinel) {
+    ++index;
+  }
+  return iterator(ctrl_ + index, slots_ + index);
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::iterator
+HashTable<Value, KeyOf, Hash, KeyEqual>::end() {
+  return iterator(ctrl_ + capacity_, slots_ + capacity_);
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::const_iterator
+HashTable<Value, KeyOf, Hash, KeyEqual>::begin() const {
+  return const_cast<HashTable*>(this)->begin();
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::const_iterator
+HashTable<Value, KeyOf, Hash, KeyEqual>::end() const {
+  return const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+}
+
+// Вместимость
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+float HashTable<Value, KeyOf, Hash, KeyEqual>::load_factor() const {
+  return capacity_ == 0 ? 0.0f
+                        : static_cast<float>(size_) /
+                              static_cast<float>(capacity_);
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::max_load_factor(float factor) {
+  if (!(factor > 0.0f && factor <= 1.0f)) {
+    throw std::invalid_argument("max_load_factor must be in (0, 1]");
+  }
+  max_load_factor_ = factor;
+  if (size_ + deleted_ > growthLimit(capacity_)) {
+    resize(capacityFor(size_));
+  }
+}
+
+// Надгробия тоже расходуют запас роста, поэтому при них таблица
+// перестраивается, даже если емкости формально хватает
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::reserve(size_type count) {
+  count = std::max(count, size_);
+  if (count + deleted_ > growthLimit(capacity_)) {
+    resize(capacityFor(count));
+  }
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::rehash(size_type count) {
+  size_type capacity = capacityFor(size_);
+  if (count > capacity) {
+    capacity = std::max(capacity, Group::kWidth);
+    while (capacity < count) {
+      capacity *= 2;
+    }
+  }
+  resize(capacity);
+}
+
+// Память под слоты остается, как у std::unordered_map::clear
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::clear() {
+  destroyAll();
+  if (capacity_ > 0) {
+    std::fill(ctrl_, ctrl_ + capacity_, kCtrlEmpty);
+  }
+  size_ = 0;
+  deleted_ = 0;
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::swap(HashTable& other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(deleted_, other.deleted_);
+  std::swap(max_load_factor_, other.max_load_factor_);
+  std::swap(hash_, other.hash_);
+  std::swap(equal_, other.equal_);
+}
+
+// Поиск
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+template <typename K>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::iterator
+HashTable<Value, KeyOf, Hash, KeyEqual>::find(const K& key) {
+  size_type index = findIndex(key, mix(hash_(key)));
+  return iterator(ctrl_ + index, slots_ + index);
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+template <typename K>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::const_iterator
+HashTable<Value, KeyOf, Hash, KeyEqual>::find(const K& key) const {
+  size_type index = findIndex(key, mix(hash_(key)));
+  return const_iterator(ctrl_ + index, slots_ + index);
+}
+
+// Модификаторы
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+template <typename K, typename... Args>
+std::pair<typename HashTable<Value, KeyOf, Hash, KeyEqual>::iterator, bool>
+HashTable<Value, KeyOf, Hash, KeyEqual>::emplaceKey(const K& key,
+                                                    Args&&... args) {
+  size_type hash = mix(hash_(key));
+  size_type index = findIndex(key, hash);
+  if (index != capacity_) {
+    return {iterator(ctrl_ + index, slots_ + index), false};
+  }
+
+  if (capacity_ == 0) {
+    resize(capacityFor(1));
+  }
+  index = findFreeSlot(hash);
+  // Надгробие занимается без роста, пустой слот - только в пределах
+  // коэффициента заполнения
+  if (ctrl_[index] == kCtrlEmpty &&
+      size_ + deleted_ >= growthLimit(capacity_)) {
+    resize(capacityFor(size_ + 1));
+    index = findFreeSlot(hash);
+  }
+
+  ::new (static_cast<void*>(slots_ + index)) Value(std::forward<Args>(args)...);
+  if (ctrl_[index] == kCtrlDeleted) {
+    --deleted_;
+  }
+  ctrl_[index] = h2(hash);
+  ++size_;
+  return {iterator(ctrl_ + index, slots_ + index), true};
+}
+
+// Если в группе слота уже есть пустой, ни один поиск не проходил эту группу
+// насквозь: группа не заполнялась целиком с последней перестройки. Тогда
+// слот можно сразу пометить пустым, иначе нужно надгробие, чтобы не
+// оборвать поиск ключей, лежащих дальше
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::erase(const_iterator pos) {
+  size_type index = static_cast<size_type>(pos.ctrl_ - ctrl_);
+  slots_[index].~Value();
+  --size_;
+  size_type group_start = index & ~(Group::kWidth - 1);
+  if (Group(ctrl_ + group_start).matchEmpty().any()) {
+    ctrl_[index] = kCtrlEmpty;
+  } else {
+    ctrl_[index] = kCtrlDeleted;
+    ++deleted_;
+  }
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+template <typename K>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::size_type
+HashTable<Value, KeyOf, Hash, KeyEqual>::eraseKey(const K& key) {
+  const_iterator pos = find(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase(pos);
+  return 1;
+}
+
+// Удаление не сдвигает другие элементы, поэтому обход other продолжается
+// после переноса текущего
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::merge(HashTable& other) {
+  if (this == &other) {
+    return;
+  }
+  for (iterator it = other.begin(); it != other.end();) {
+    iterator current = it++;
+    if (emplaceKey(KeyOf::key(*current), std::move(*current)).second) {
+      other.erase(current);
+    }
+  }
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+bool HashTable<Value, KeyOf, Hash, KeyEqual>::validateForTesting() const {
+  if (capacity_ == 0) {
+    return size_ == 0 && deleted_ == 0;
+  }
+  if (capacity_ % Group::kWidth != 0 || ctrl_[capacity_] != kCtrlSentinel ||
+      size_ + deleted_ > growthLimit(capacity_)) {
+    return false;
+  }
+  size_type full = 0;
+  size_type deleted = 0;
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (ctrl_[i] == kCtrlDeleted) {
+      ++deleted;
+    } else if (ctrl_[i] >= 0) {
+      ++full;
+      const auto& key = KeyOf::key(slots_[i]);
+      size_type hash = mix(hash_(key));
+      if (ctrl_[i] != h2(hash) || findIndex(key, hash) != i) {
+        return false;
+      }
+    } else if (ctrl_[i] != kCtrlEmpty) {
+      return false;
+    }
+  }
+  return full == size_ && deleted == deleted_;
+}
+
+// Служебные методы
+
+// Хотя бы один слот всегда пуст, иначе поиск отсутствующего ключа не
+// остановится
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::size_type
+HashTable<Value, KeyOf, Hash, KeyEqual>::growthLimit(size_type capacity) const {
+  if (capacity == 0) {
+    return 0;
+  }
+  size_type limit = static_cast<size_type>(static_cast<double>(capacity) *
+                                           max_load_factor_);
+  return std::min(limit, capacity - 1);
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::size_type
+HashTable<Value, KeyOf, Hash, KeyEqual>::capacityFor(size_type count) const {
+  if (count == 0) {
+    return 0;
+  }
+  size_type capacity = Group::kWidth;
+  while (growthLimit(capacity) < count) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+// Группы перебираются с шагами 1, 2, 3, ...: при числе групп, равном
+// степени двойки, такая последовательность обходит их все
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+template <typename K>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::size_type
+HashTable<Value, KeyOf, Hash, KeyEqual>::findIndex(const K& key,
+                                                   size_type hash) const {
+  if (capacity_ == 0) {
+    return capacity_;
+  }
+  size_type mask = groupCount() - 1;
+  size_type group = (hash >> 7) & mask;
+  ctrl_t tag = h2(hash);
+  for (size_type step = 1;; ++step) {
+    size_type start = group * Group::kWidth;
+    Group candidates(ctrl_ + start);
+    for (BitMask match = candidates.match(tag); match.any();
+         match.clearLowest()) {
+      size_type index = start + match.lowest();
+      if (equal_(KeyOf::key(slots_[index]), key)) {
+        return index;
+      }
+    }
+    if (candidates.matchEmpty().any()) {
+      return capacity_;
+    }
+    group = (group + step) & mask;
+  }
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+typename HashTable<Value, KeyOf, Hash, KeyEqual>::size_type
+HashTable<Value, KeyOf, Hash, KeyEqual>::findFreeSlot(size_type hash) const {
+  size_type mask = groupCount() - 1;
+  size_type group = (hash >> 7) & mask;
+  for (size_type step = 1;; ++step) {
+    size_type start = group * Group::kWidth;
+    BitMask free = Group(ctrl_ + start).matchEmptyOrDeleted();
+    if (free.any()) {
+      return start + free.lowest();
+    }
+    group = (group + step) & mask;
+  }
+}
+
+// Перекладывает элементы в новые массивы; заодно исчезают надгробия
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::resize(size_type new_capacity) {
+  if (new_capacity == 0) {
+    destroyAll();
+    deallocate();
+    return;
+  }
+
+  std::allocator<Value> allocator;
+  ctrl_t* new_ctrl = new ctrl_t[new_capacity + 1];
+  Value* new_slots;
+  try {
+    new_slots = allocator.allocate(new_capacity);
+  } catch (...) {
+    delete[] new_ctrl;
+    throw;
+  }
+  std::fill(new_ctrl, new_ctrl + new_capacity, kCtrlEmpty);
+  new_ctrl[new_capacity] = kCtrlSentinel;
+
+  ctrl_t* old_ctrl = ctrl_;
+  Value* old_slots = slots_;
+  size_type old_capacity = capacity_;
+  ctrl_ = new_ctrl;
+  slots_ = new_slots;
+  capacity_ = new_capacity;
+  deleted_ = 0;
+
+  for (size_type i = 0; i < old_capacity; ++i) {
+    if (old_ctrl[i] >= 0) {
+      size_type hash = mix(hash_(KeyOf::key(old_slots[i])));
+      size_type index = findFreeSlot(hash);
+      ::new (static_cast<void*>(slots_ + index)) Value(std::move(old_slots[i]));
+      old_slots[i].~Value();
+      ctrl_[index] = h2(hash);
+    }
+  }
+  delete[] old_ctrl;
+  if (old_slots) {
+    allocator.deallocate(old_slots, old_capacity);
+  }
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::destroyAll() {
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (ctrl_[i] >= 0) {
+      slots_[i].~Value();
+    }
+  }
+}
+
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+void HashTable<Value, KeyOf, Hash, KeyEqual>::deallocate() {
+  delete[] ctrl_;
+  if (slots_) {
+    std::allocator<Value>().deallocate(slots_, capacity_);
+  }
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = 0;
+  size_ = 0;
+  deleted_ = 0;
+}
+
+}  // namespace s21
@@ -0,0 +1,835 @@
+//
+// Сжатое множество 32-битных целых в духе Roaring bitmap.
+//
+
+#include "../../include/s21_int_set/s21_int_set.hpp"
+
+#include <algorithm>
+
+namespace s21 {
+
+// Итератор
+
+inline IntSet::const_iterator& IntSet::const_iterator::operator++() {
+  const Container& c = set_->bucket(bucket_);
+  const value_type base = value_ & 0xFFFF0000U;
+  const std::uint16_t current = low(value_);
+  switch (c.kind) {
+    case Kind::kArray:
+      if (++pos_ < c.values.size()) {
+        value_ = base | c.values[pos_];
+        return *this;
+      }
+      break;
+    case Kind::kBitmap: {
+      std::uint32_t pos = 0;
+      std::uint16_t found = 0;
+      if (current != 0xFFFF &&
+          containerSeek(c, static_cast<std::uint16_t>(current + 1), pos,
+                        found)) {
+        value_ = base | found;
+        return *this;
+      }
+      break;
+    }
+    case Kind::kRun:
+      if (current < c.values[2 * pos_] + c.values[2 * pos_ + 1]) {
+        ++value_;
+        return *this;
+      }
+      if (++pos_ < c.values.size() / 2) {
+        value_ = base | c.values[2 * pos_];
+        return *this;
+      }
+      break;
+  }
+  enterBucket(bucket_ + 1);
+  return *this;
+}
+
+inline void IntSet::const_iterator::enterBucket(size_type bucket) {
+  bucket_ = bucket;
+  pos_ = 0;
+  value_ = 0;
+  if (bucket < set_->directory_.size()) {
+    std::uint16_t first = 0;
+    containerSeek(set_->bucket(bucket), 0, pos_, first);
+    value_ = static_cast<value_type>(set_->bucketKey(bucket)) << 16 | first;
+  }
+}
+
+// Конструкторы и итераторы
+
+inline IntSet::IntSet(std::initializer_list<value_type> const& items) {
+  insert(items.begin(), items.end());
+}
+
+inline IntSet::const_iterator IntSet::begin() const {
+  const_iterator it(this, 0, 0, 0);
+  it.enterBucket(0);
+  return it;
+}
+
+inline IntSet::size_type IntSet::memory_usage() const {
+  size_type bytes = sizeof(IntSet) +
+                    directory_.capacity() * sizeof(std::uint32_t) +
+                    containers_.capacity() * sizeof(Container);
+  for (const Container& c : containers_) {
+    bytes += c.values.capacity() * sizeof(std::uint16_t) +
+             c.words.capacity() * sizeof(std::uint64_t);
+  }
+  return bytes;
+}
+
+// Модификаторы
+
+inline void IntSet::clear() {
+  directory_.clear();
+  containers_.clear();
+  size_ = 0;
+}
+
+// Новая корзина удаляется, если ключ в нее не попал, иначе пустой
+// контейнер нарушил бы инвариант
+inline std::pair<IntSet::iterator, bool> IntSet::insert(value_type value) {
+  const std::uint16_t key = high(value);
+  size_type index = bucketIndex(key);
+  const bool created = !bucketFound(index, key);
+  if (created) addBucket(index, key);
+  std::uint32_t pos = 0;
+  bool inserted = false;
+  try {
+    inserted = containerAdd(bucket(index), low(value), pos);
+  } catch (...) {
+    if (created) removeBucket(index);
+    throw;
+  }
+  size_ += inserted;
+  return {iterator(this, index, pos, value), inserted};
+}
+
+template <typename InputIt>
+void IntSet::insert(InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    insert(static_cast<value_type>(*first));
+  }
+}
+
+inline IntSet::size_type IntSet::erase(value_type value) {
+  const std::uint16_t key = high(value);
+  size_type index = bucketIndex(key);
+  if (!bucketFound(index, key) || !containerRemove(bucket(index), low(value))) {
+    return 0;
+  }
+  --size_;
+  if (bucket(index).cardinality == 0) removeBucket(index);
+  return 1;
+}
+
+inline void IntSet::swap(IntSet& other) noexcept {
+  directory_.swap(other.directory_);
+  containers_.swap(other.containers_);
+  std::swap(size_, other.size_);
+}
+
+// Серия занимает 4 байта, массив - 2 байта на ключ, карта - 8 КБ
+inline bool IntSet::run_optimize() {
+  bool has_runs = false;
+  for (Container& c : containers_) {
+    std::size_t run_bytes = 4 * std::size_t{runCount(c)};
+    std::size_t plain_bytes = c.cardinality <= kArrayMax
+                                  ? 2 * std::size_t{c.cardinality}
+                                  : 8 * kBitmapWords;
+    if (run_bytes < plain_bytes) {
+      if (c.kind != Kind::kRun) toRuns(c);
+      has_runs = true;
+    } else if (c.kind == Kind::kRun) {
+      normalize(c);
+    }
+    c.values.shrink_to_fit();
+  }
+  directory_.shrink_to_fit();
+  containers_.shrink_to_fit();
+  return has_runs;
+}
+
+// Просмотр контейнера
+
+inline bool IntSet::contains(value_type value) const {
+  const std::uint16_t key = high(value);
+  size_type index = bucketIndex(key);
+  return bucketFound(index, key) &&
+         containerContains(bucket(index), low(value));
+}
+
+inline IntSet::iterator IntSet::find(value_type value) const {
+  iterator it = lower_bound(value);
+  return it != end() && *it == value ? it : end();
+}
+
+inline IntSet::iterator IntSet::lower_bound(value_type value) const {
+  const std::uint16_t key = high(value);
+  size_type index = bucketIndex(key);
+  if (bucketFound(index, key)) {
+    std::uint32_t pos = 0;
+    std::uint16_t found = 0;
+    if (containerSeek(bucket(index), low(value), pos, found)) {
+      return iterator(this, index, pos, (value & 0xFFFF0000U) | found);
+    }
+    ++index;
+  }
+  iterator it(this, 0, 0, 0);
+  it.enterBucket(index);
+  return it;
+}
+
+// Формы контейнеров могут различаться, поэтому корзины сравниваются через
+// размер пересечения
+inline bool IntSet::operator==(const IntSet& other) const {
+  if (size_ != other.size_ || directory_.size() != other.directory_.size()) {
+    return false;
+  }
+  for (size_type i = 0; i < directory_.size(); ++i) {
+    const Container& a = bucket(i);
+    const Container& b = other.bucket(i);
+    if (a.high != b.high || a.cardinality != b.cardinality ||
+        intersectionCount(a, b) != a.cardinality) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool IntSet::validateForTesting() const {
+  if (directory_.size() != containers_.size()) return false;
+  size_type total = 0;
+  for (size_type i = 0; i < directory_.size(); ++i) {
+    if (i > 0 && bucketKey(i - 1) >= bucketKey(i)) return false;
+    // Номера контейнеров различны, раз каждый контейнер знает свою корзину
+    if ((directory_[i] & 0xFFFF) >= containers_.size()) return false;
+    const Container& c = bucket(i);
+    if (c.high != bucketKey(i) || c.cardinality == 0) return false;
+    std::uint32_t counted = 0;
+    switch (c.kind) {
+      case Kind::kArray:
+        if (!c.words.empty() || c.cardinality > kArrayMax) return false;
+        for (size_type j = 1; j < c.values.size(); ++j) {
+          if (c.values[j - 1] >= c.values[j]) return false;
+        }
+        counted = static_cast<std::uint32_t>(c.values.size());
+        break;
+      case Kind::kBitmap:
+        if (c.words.size() != kBitmapWords || c.cardinality <= kArrayMax) {
+          return false;
+        }
+        for (std::uint64_t word : c.words) {
+          counted += static_cast<std::uint32_t>(__builtin_popcountll(word));
+        }
+        break;
+      case Kind::kRun: {
+        size_type runs = c.values.size() / 2;
+        if (c.values.size() % 2 != 0 || runs == 0 || runs > kArrayMax / 2) {
+          return false;
+        }
+        std::uint32_t prev_end = 0;
+        for (size_type j = 0; j < runs; ++j) {
+          std::uint32_t start = c.values[2 * j];
+          std::uint32_t end = start + c.values[2 * j + 1];
+          // Соседние серии должны быть слиты
+          if (end > 0xFFFF || (j > 0 && start <= prev_end + 1)) return false;
+          counted += end - start + 1;
+          prev_end = end;
+        }
+        break;
+      }
+    }
+    if (counted != c.cardinality) return false;
+    total += c.cardinality;
+  }
+  return total == size_;
+}
+
+// Операции над одним контейнером
+
+// Номер контейнера в младших битах не мешает поиску: у корзины high
+// единственная запись, и она не меньше high << 16
+inline IntSet::size_type IntSet::bucketIndex(std::uint16_t high) const {
+  return static_cast<size_type>(
+      std::lower_bound(directory_.begin(), directory_.end(),
+                       std::uint32_t{high} << 16) -
+      directory_.begin());
+}
+
+inline void IntSet::addBucket(size_type index, std::uint16_t high) {
+  containers_.emplace_back();
+  containers_.back().high = high;
+  std::uint32_t slot = static_cast<std::uint32_t>(containers_.size() - 1);
+  try {
+    directory_.insert(directory_.begin() + index,
+                      std::uint32_t{high} << 16 | slot);
+  } catch (...) {
+    containers_.pop_back();
+    throw;
+  }
+}
+
+inline void IntSet::removeBucket(size_type index) {
+  std::uint32_t slot = directory_[index] & 0xFFFF;
+  directory_.erase(directory_.begin() + index);
+  if (slot + 1 != containers_.size()) {
+    Container& moved = containers_[slot];
+    moved = std::move(containers_.back());
+    directory_[bucketIndex(moved.high)] =
+        std::uint32_t{moved.high} << 16 | slot;
+  }
+  containers_.pop_back();
+}
+
+inline bool IntSet::containerContains(const Container& c,
+                                      std::uint16_t value) {
+  switch (c.kind) {
+    case Kind::kArray:
+      return std::binary_search(c.values.begin(), c.values.end(), value);
+    case Kind::kBitmap:
+      return (c.words[value >> 6] >> (value & 63)) & 1;
+    case Kind::kRun: {
+      std::ptrdiff_t run = runBefore(c, value);
+      return run >= 0 && value - c.values[2 * run] <= c.values[2 * run + 1];
+    }
+  }
+  return false;
+}
+
+// 4097-й ключ переводит массив в карту
+inline bool IntSet::containerAdd(Container& c, std::uint16_t value,
+                                 std::uint32_t& pos) {
+  pos = 0;
+  switch (c.kind) {
+    case Kind::kArray: {
+      auto it = std::lower_bound(c.values.begin(), c.values.end(), value);
+      pos = static_cast<std::uint32_t>(it - c.values.begin());
+      if (it != c.values.end() && *it == value) return false;
+      if (c.cardinality < kArrayMax) {
+        c.values.insert(it, value);
+        ++c.cardinality;
+        return true;
+      }
+      toBitmap(c);
+      return containerAdd(c, value, pos);
+    }
+    case Kind::kBitmap: {
+      std::uint64_t& word = c.words[value >> 6];
+      std::uint64_t bit = std::uint64_t{1} << (value & 63);
+      if (word & bit) return false;
+      word |= bit;
+      ++c.cardinality;
+      return true;
+    }
+    case Kind::kRun: {
+      if (!runAdd(c, value, pos)) return false;
+      if (runCount(c) > kArrayMax / 2) {
+        normalize(c);
+        std::uint16_t found = 0;
+        containerSeek(c, value, pos, found);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+// Карта, в которой осталось не больше 4096 ключей, становится массивом
+inline bool IntSet::containerRemove(Container& c, std::uint16_t value) {
+  switch (c.kind) {
+    case Kind::kArray: {
+      auto it = std::lower_bound(c.values.begin(), c.values.end(), value);
+      if (it == c.values.end() || *it != value) return false;
+      c.values.erase(it);
+      --c.cardinality;
+      return true;
+    }
+    case Kind::kBitmap: {
+      std::uint64_t& word = c.words[value >> 6];
+      std::uint64_t bit = std::uint64_t{1} << (value & 63);
+      if (!(word & bit)) return false;
+      word &= ~bit;
+      if (--c.cardinality <= kArrayMax) toArray(c);
+      return true;
+    }
+    case Kind::kRun:
+      if (!runRemove(c, value)) return false;
+      if (runCount(c) > kArrayMax / 2) normalize(c);
+      return true;
+  }
+  return false;
+}
+
+inline bool IntSet::containerSeek(const Container& c, std::uint16_t value,
+                                  std::uint32_t& pos, std::uint16_t& found) {
+  pos = 0;
+  switch (c.kind) {
+    case Kind::kArray: {
+      auto it = std::lower_bound(c.values.begin(), c.values.end(), value);
+      if (it == c.values.end()) return false;
+      pos = static_cast<std::uint32_t>(it - c.values.begin());
+      found = *it;
+      return true;
+    }
+    case Kind::kBitmap: {
+      std::size_t index = value >> 6;
+      std::uint64_t word = c.words[index] & (~std::uint64_t{0} << (value & 63));
+      while (!word) {
+        if (++index == kBitmapWords) return false;
+        word = c.words[index];
+      }
+      found = static_cast<std::uint16_t>(index * 64 + __builtin_ctzll(word));
+      return true;
+    }
+    case Kind::kRun: {
+      std::ptrdiff_t run = runBefore(c, value);
+      if (run >= 0 && value - c.values[2 * run] <= c.values[2 * run + 1]) {
+        pos = static_cast<std::uint32_t>(run);
+        found = value;
+        return true;
+      }
+      std::size_t next = static_cast<std::size_t>(run + 1);
+      if (next == c.values.size() / 2) return false;
+      pos = static_cast<std::uint32_t>(next);
+      found = c.values[2 * next];
+      return true;
+    }
+  }
+  return false;
+}
+
+// Новый ключ продлевает соседнюю серию, склеивает две серии или начинает
+// свою
+inline bool IntSet::runAdd(Container& c, std::uint16_t value,
+                           std::uint32_t& pos) {
+  std::ptrdiff_t run = runBefore(c, value);
+  std::size_t next = static_cast<std::size_t>(run + 1);
+  bool joins_prev = false;
+  if (run >= 0) {
+    std::uint32_t end = c.values[2 * run] + c.values[2 * run + 1];
+    if (value <= end) {
+      pos = static_cast<std::uint32_t>(run);
+      return false;
+    }
+    joins_prev = value == end + 1;
+  }
+  bool joins_next = next < c.values.size() / 2 &&
+                    std::uint32_t{value} + 1 == c.values[2 * next];
+  if (joins_prev && joins_next) {
+    c.values[2 * run + 1] = static_cast<std::uint16_t>(
+        c.values[2 * next] + c.values[2 * next + 1] - c.values[2 * run]);
+    c.values.erase(c.values.begin() + 2 * next,
+                   c.values.begin() + 2 * next + 2);
+    pos = static_cast<std::uint32_t>(run);
+  } else if (joins_prev) {
+    ++c.values[2 * run + 1];
+    pos = static_cast<std::uint32_t>(run);
+  } else if (joins_next) {
+    c.values[2 * next] = value;
+    ++c.values[2 * next + 1];
+    pos = static_cast<std::uint32_t>(next);
+  } else {
+    const std::uint16_t run_values[2] = {value, 0};
+    c.values.insert(c.values.begin() + 2 * next, run_values, run_values + 2);
+    pos = static_cast<std::uint32_t>(next);
+  }
+  ++c.cardinality;
+  return true;
+}
+
+// Удаление из середины серии делит ее на две
+inline bool IntSet::runRemove(Container& c, std::uint16_t value) {
+  std::ptrdiff_t run = runBefore(c, value);
+  if (run < 0) return false;
+  std::uint16_t start = c.values[2 * run];
+  std::uint16_t length = c.values[2 * run + 1];
+  std::uint32_t end = std::uint32_t{start} + length;
+  if (value > end) return false;
+  if (length == 0) {
+    c.values.erase(c.values.begin() + 2 * run, c.values.begin() + 2 * run + 2);
+  } else if (value == start) {
+    ++c.values[2 * run];
+    --c.values[2 * run + 1];
+  } else if (value == end) {
+    --c.values[2 * run + 1];
+  } else {
+    c.values[2 * run + 1] = static_cast<std::uint16_t>(value - start - 1);
+    const std::uint16_t tail[2] = {static_cast<std::uint16_t>(value + 1),
+                                   static_cast<std::uint16_t>(end - value - 1)};
+    c.values.insert(c.values.begin() + 2 * run + 2, tail, tail + 2);
+  }
+  --c.cardinality;
+  return true;
+}
+
+inline std::ptrdiff_t IntSet::runBefore(const Container& c,
+                                        std::uint16_t value) {
+  std::ptrdiff_t lo = 0;
+  std::ptrdiff_t hi = static_cast<std::ptrdiff_t>(c.values.size() / 2);
+  while (lo < hi) {
+    std::ptrdiff_t mid = lo + (hi - lo) / 2;
+    if (c.values[2 * mid] <= value) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo - 1;
+}
+
+// Начало серии - установленный бит, перед которым бит сброшен
+inline std::uint32_t IntSet::runCount(const Container& c) {
+  std::uint32_t runs = 0;
+  switch (c.kind) {
+    case Kind::kArray:
+      for (std::size_t i = 0; i < c.values.size(); ++i) {
+        runs += i == 0 || c.values[i] != c.values[i - 1] + 1;
+      }
+      break;
+    case Kind::kBitmap: {
+      std::uint64_t carry = 0;
+      for (std::uint64_t word : c.words) {
+        runs += static_cast<std::uint32_t>(
+            __builtin_popcountll(word & ~(word << 1 | carry)));
+        carry = word >> 63;
+      }
+      break;
+    }
+    case Kind::kRun:
+      runs = static_cast<std::uint32_t>(c.values.size() / 2);
+      break;
+  }
+  return runs;
+}
+
+template <typename Func>
+void IntSet::forEachValue(const Container& c, Func func) {
+  switch (c.kind) {
+    case Kind::kArray:
+      for (std::uint16_t value : c.values) func(value);
+      break;
+    case Kind::kBitmap:
+      for (std::size_t i = 0; i < kBitmapWords; ++i) {
+        for (std::uint64_t word = c.words[i]; word; word &= word - 1) {
+          func(static_cast<std::uint16_t>(i * 64 + __builtin_ctzll(word)));
+        }
+      }
+      break;
+    case Kind::kRun:
+      for (std::size_t i = 0; i < c.values.size(); i += 2) {
+        std::uint32_t end = std::uint32_t{c.values[i]} + c.values[i + 1];
+        for (std::uint32_t value = c.values[i]; value <= end; ++value) {
+          func(static_cast<std::uint16_t>(value));
+        }
+      }
+      break;
+  }
+}
+
+// Смена формы
+
+inline void IntSet::toBitmap(Container& c) {
+  std::vector<std::uint64_t> words(kBitmapWords, 0);
+  fillBitmap(c, words.data());
+  c.words.swap(words);
+  std::vector<std::uint16_t>().swap(c.values);
+  c.kind = Kind::kBitmap;
+}
+
+inline void IntSet::toArray(Container& c) {
+  std::vector<std::uint16_t> values;
+  values.reserve(c.cardinality);
+  forEachValue(c, [&values](std::uint16_t value) { values.push_back(value); });
+  c.values.swap(values);
+  std::vector<std::uint64_t>().swap(c.words);
+  c.kind = Kind::kArray;
+}
+
+inline void IntSet::toRuns(Container& c) {
+  std::vector<std::uint16_t> runs;
+  runs.reserve(2 * std::size_t{runCount(c)});
+  forEachValue(c, [&runs](std::uint16_t value) {
+    if (!runs.empty() &&
+        value == std::uint32_t{runs[runs.size() - 2]} + runs.back() + 1) {
+      ++runs.back();
+    } else {
+      runs.push_back(value);
+      runs.push_back(0);
+    }
+  });
+  c.values.swap(runs);
+  std::vector<std::uint64_t>().swap(c.words);
+  c.kind = Kind::kRun;
+}
+
+inline void IntSet::normalize(Container& c) {
+  if (c.cardinality <= kArrayMax) {
+    if (c.kind != Kind::kArray) toArray(c);
+  } else if (c.kind != Kind::kBitmap) {
+    toBitmap(c);
+  }
+}
+
+inline void IntSet::fillBitmap(const Container& c, std::uint64_t* words) {
+  switch (c.kind) {
+    case Kind::kArray:
+      for (std::uint16_t value : c.values) {
+        words[value >> 6] |= std::uint64_t{1} << (value & 63);
+      }
+      break;
+    case Kind::kBitmap:
+      for (std::size_t i = 0; i < kBitmapWords; ++i) words[i] |= c.words[i];
+      break;
+    case Kind::kRun:
+      for (std::size_t i = 0; i < c.values.size(); i += 2) {
+        std::uint32_t start = c.values[i];
+        std::uint32_t end = start + c.values[i + 1];
+        std::uint64_t first_mask = ~std::uint64_t{0} << (start & 63);
+        std::uint64_t last_mask = ~std::uint64_t{0} >> (63 - (end & 63));
+        if (start >> 6 == end >> 6) {
+          words[start >> 6] |= first_mask & last_mask;
+          continue;
+        }
+        words[start >> 6] |= first_mask;
+        for (std::uint32_t w = (start >> 6) + 1; w < end >> 6; ++w) {
+          words[w] = ~std::uint64_t{0};
+        }
+        words[end >> 6] |= last_mask;
+      }
+      break;
+  }
+}
+
+// Операции над парой контейнеров
+
+inline IntSet::Container IntSet::combineContainers(Operation op,
+                                                   const Container& a,
+                                                   const Container& b) {
+  if (a.kind == Kind::kArray && b.kind == Kind::kArray) {
+    return combineArrays(op, a, b);
+  }
+  // Пересечение и разность не больше массива a (или b): достаточно
+  // проверить его ключи в другом контейнере
+  if (op == Operation::kIntersection && a.kind == Kind::kArray) {
+    return filterArray(a, b, true);
+  }
+  if (op == Operation::kIntersection && b.kind == Kind::kArray) {
+    return filterArray(b, a, true);
+  }
+  if (op == Operation::kDifference && a.kind == Kind::kArray) {
+    return filterArray(a, b, false);
+  }
+  return combineBitmaps(op, a, b);
+}
+
+inline IntSet::Container IntSet::combineArrays(Operation op,
+                                               const Container& a,
+                                               const Container& b) {
+  const bool keep_a = op != Operation::kIntersection;
+  const bool keep_b = op == Operation::kUnion || op == Operation::kSymmetric;
+  const bool keep_both =
+      op == Operation::kUnion || op == Operation::kIntersection;
+  Container result;
+  result.values.reserve(op == Operation::kIntersection
+                            ? std::min(a.values.size(), b.values.size())
+                            : a.values.size() + (keep_b ? b.values.size() : 0));
+  auto x = a.values.begin();
+  auto y = b.values.begin();
+  while (x != a.values.end() && y != b.values.end()) {
+    if (*x < *y) {
+      if (keep_a) result.values.push_back(*x);
+      ++x;
+    } else if (*y < *x) {
+      if (keep_b) result.values.push_back(*y);
+      ++y;
+    } else {
+      if (keep_both) result.values.push_back(*x);
+      ++x;
+      ++y;
+    }
+  }
+  if (keep_a) result.values.insert(result.values.end(), x, a.values.end());
+  if (keep_b) result.values.insert(result.values.end(), y, b.values.end());
+  result.cardinality = static_cast<std::uint32_t>(result.values.size());
+  if (result.cardinality > kArrayMax) toBitmap(result);
+  return result;
+}
+
+inline IntSet::Container IntSet::filterArray(const Container& array,
+                                             const Container& other,
+                                             bool keep_present) {
+  Container result;
+  for (std::uint16_t value : array.values) {
+    if (containerContains(other, value) == keep_present) {
+      result.values.push_back(value);
+    }
+  }
+  result.cardinality = static_cast<std::uint32_t>(result.values.size());
+  return result;
+}
+
+// Циклы по словам без ветвлений компилятор векторизует; подсчет битов
+// вынесен в отдельный проход, чтобы не мешать этому
+inline IntSet::Container IntSet::combineBitmaps(Operation op,
+                                                const Container& a,
+                                                const Container& b) {
+  std::vector<std::uint64_t> scratch_a;
+  std::vector<std::uint64_t> scratch_b;
+  auto wordsOf = [](const Container& c, std::vector<std::uint64_t>& scratch) {
+    if (c.kind == Kind::kBitmap) return c.words.data();
+    scratch.assign(kBitmapWords, 0);
+    fillBitmap(c, scratch.data());
+    return static_cast<const std::uint64_t*>(scratch.data());
+  };
+  const std::uint64_t* x = wordsOf(a, scratch_a);
+  const std::uint64_t* y = wordsOf(b, scratch_b);
+
+  Container result;
+  result.kind = Kind::kBitmap;
+  result.words.resize(kBitmapWords);
+  std::uint64_t* out = result.words.data();
+  switch (op) {
+    case Operation::kUnion:
+      for (std::size_t i = 0; i < kBitmapWords; ++i) out[i] = x[i] | y[i];
+      break;
+    case Operation::kIntersection:
+      for (std::size_t i = 0; i < kBitmapWords; ++i) out[i] = x[i] & y[i];
+      break;
+    case Operation::kDifference:
+      for (std::size_t i = 0; i < kBitmapWords; ++i) out[i] = x[i] & ~y[i];
+      break;
+    case Operation::kSymmetric:
+      for (std::size_t i = 0; i < kBitmapWords; ++i) out[i] = x[i] ^ y[i];
+      break;
+  }
+  std::uint32_t cardinality = 0;
+  for (std::size_t i = 0; i < kBitmapWords; ++i) {
+    cardinality += static_cast<std::uint32_t>(__builtin_popcountll(out[i]));
+  }
+  result.cardinality = cardinality;
+  if (cardinality <= kArrayMax) toArray(result);
+  return result;
+}
+
+inline std::uint32_t IntSet::intersectionCount(const Container& a,
+                                               const Container& b) {
+  std::uint32_t count = 0;
+  if (a.kind == Kind::kArray && b.kind == Kind::kArray) {
+    auto x = a.values.begin();
+    auto y = b.values.begin();
+    while (x != a.values.end() && y != b.values.end()) {
+      if (*x < *y) {
+        ++x;
+      } else if (*y < *x) {
+        ++y;
+      } else {
+        ++count;
+        ++x;
+        ++y;
+      }
+    }
+  } else if (a.kind == Kind::kArray || b.kind == Kind::kArray) {
+    const Container& array = a.kind == Kind::kArray ? a : b;
+    const Container& other = a.kind == Kind::kArray ? b : a;
+    for (std::uint16_t value : array.values) {
+      count += containerContains(other, value);
+    }
+  } else {
+    std::vector<std::uint64_t> x(kBitmapWords, 0);
+    std::vector<std::uint64_t> y(kBitmapWords, 0);
+    fillBitmap(a, x.data());
+    fillBitmap(b, y.data());
+    for (std::size_t i = 0; i < kBitmapWords; ++i) {
+      count += static_cast<std::uint32_t>(__builtin_popcountll(x[i] & y[i]));
+    }
+  }
+  return count;
+}
+
+// Совместный проход по старшим половинам: корзина, которая есть только в
+// одном множестве, копируется целиком или пропускается
+inline IntSet IntSet::combine(Operation op, const IntSet& a, const IntSet& b) {
+  const bool keep_a = op != Operation::kIntersection;
+  const bool keep_b = op == Operation::kUnion || op == Operation::kSymmetric;
+  IntSet result;
+  const size_type a_size = a.directory_.size();
+  const size_type b_size = b.directory_.size();
+  size_type i = 0;
+  size_type j = 0;
+  while (i < a_size && j < b_size) {
+    if (a.bucketKey(i) < b.bucketKey(j)) {
+      if (keep_a) result.appendBucket(Container(a.bucket(i)));
+      ++i;
+    } else if (b.bucketKey(j) < a.bucketKey(i)) {
+      if (keep_b) result.appendBucket(Container(b.bucket(j)));
+      ++j;
+    } else {
+      Container c = combineContainers(op, a.bucket(i), b.bucket(j));
+      c.high = a.bucketKey(i);
+      if (c.cardinality) result.appendBucket(std::move(c));
+      ++i;
+      ++j;
+    }
+  }
+  for (; keep_a && i < a_size; ++i) {
+    result.appendBucket(Container(a.bucket(i)));
+  }
+  for (; keep_b && j < b_size; ++j) {
+    result.appendBucket(Container(b.bucket(j)));
+  }
+  return result;
+}
+
+inline void IntSet::appendBucket(Container&& c) {
+  std::uint32_t slot = static_cast<std::uint32_t>(containers_.size());
+  directory_.push_back(std::uint32_t{c.high} << 16 | slot);
+  try {
+    containers_.push_back(std::move(c));
+  } catch (...) {
+    directory_.pop_back();
+    throw;
+  }
+  size_ += containers_.back().cardinality;
+}
+
+// Операции над множествами
+
+inline IntSet set_union(const IntSet& a, const IntSet& b) {
+  return IntSet::combine(IntSet::Operation::kUnion, a, b);
+}
+
+inline IntSet set_intersection(const IntSet& a, const IntSet& b) {
+  return IntSet::combine(IntSet::Operation::kIntersection, a, b);
+}
+
+inline IntSet set_difference(const IntSet& a, const IntSet& b) {
+  return IntSet::combine(IntSet::Operation::kDifference, a, b);
+}
+
+inline IntSet symmetric_difference(const IntSet& a, const IntSet& b) {
+  return IntSet::combine(IntSet::Operation::kSymmetric, a, b);
+}
+
+inline IntSet::size_type intersection_size(const IntSet& a, const IntSet& b) {
+  IntSet::size_type count = 0;
+  IntSet::size_type i = 0;
+  IntSet::size_type j = 0;
+  while (i < a.directory_.size() && j < b.directory_.size()) {
+    if (a.bucketKey(i) < b.bucketKey(j)) {
+      ++i;
+    } else if (b.bucketKey(j) < a.bucketKey(i)) {
+      ++j;
+    } else {
+      count += IntSet::intersectionCount(a.bucket(i), b.bucket(j));
+      ++i;
+      ++j;
+    }
+  }
+  return count;
+}
+
+}  // namespace s21
@@ -4,53 +4,111 @@
 
 #include "../../include/s21_map/s21_map.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <new>
 #include <vector>
 
 namespace s21 {
 
-template <typename Key, typename T>
-Map<Key, T>::Map() : root(nullptr), node_count(0) {}
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>::Map()
+    : root(nullptr),
+      node_count(0),
+      rightmost_(nullptr),
+      comp_(),
+      alloc_() {}
 
-template <typename Key, typename T>
-Map<Key, T>::Map(std::initializer_list<value_type> const& items) : Map() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>::Map(const Compare& comp,
+                                                 const Allocator& alloc)
+    : root(nullptr),
+      node_count(0),
+      rightmost_(nullptr),
+      comp_(comp),
+      alloc_(alloc) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>::Map(
+    std::initializer_list<value_type> const& items)
+    : Map() {
   for (const auto& item : items) {
     insert(item);
   }
 }
 
-template <typename Key, typename T>
-Map<Key, T>::Map(const Map& other) : Map() {
-  for (const auto& item : other) {
-    insert(item);
-  }
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>::Map(const Map& other)
+    : root(nullptr),
+      node_count(0),
+      rightmost_(nullptr),
+      comp_(other.comp_),
+      alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)),
+      filter_(other.filter_ ? std::make_unique<Filter>(*other.filter_)
+                            : nullptr) {
+  copyFrom(other, nullptr);
 }
 
-template <typename Key, typename T>
-Map<Key, T>::Map(Map&& other) noexcept
-    : root(other.root), node_count(other.node_count) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>::Map(Map&& other) noexcept
+    : root(other.root),
+      node_count(other.node_count),
+      rightmost_(other.rightmost_),
+      comp_(other.comp_),
+      alloc_(std::move(other.alloc_)),
+      filter_(std::move(other.filter_)) {
   other.root = nullptr;
   other.node_count = 0;
+  other.rightmost_ = nullptr;
 }
 
-template <typename Key, typename T>
-Map<Key, T>::~Map() {
-  clear(root);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>::~Map() {
+  releaseNodes();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>&
+Map<Key, T, Compare, Allocator, NodePolicy>::operator=(const Map& other) {
+  if (this != &other) {
+    Node* reuse = detachNodes();
+    comp_ = other.comp_;
+    copyFrom(other, reuse);
+    filter_ =
+        other.filter_ ? std::make_unique<Filter>(*other.filter_) : nullptr;
+  }
+  return *this;
 }
 
-template <typename Key, typename T>
-Map<Key, T>& Map<Key, T>::operator=(Map&& other) noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+Map<Key, T, Compare, Allocator, NodePolicy>&
+Map<Key, T, Compare, Allocator, NodePolicy>::operator=(Map&& other) noexcept {
   if (this != &other) {
     clear();
     root = other.root;
     node_count = other.node_count;
+    rightmost_ = other.rightmost_;
+    comp_ = other.comp_;
+    alloc_ = std::move(other.alloc_);
+    filter_ = std::move(other.filter_);
     other.root = nullptr;
     other.node_count = 0;
+    other.rightmost_ = nullptr;
   }
   return *this;
 }
 
-template <typename Key, typename T>
-T& Map<Key, T>::at(const Key& key) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+T& Map<Key, T, Compare, Allocator, NodePolicy>::at(const Key& key) {
   Node* node = findNode(key);
   if (!node) {
     throw std::out_of_range("Key not found");
@@ -58,172 +116,522 @@ T& Map<Key, T>::at(const Key& key) {
   return node->data.second;
 }
 
-template <typename Key, typename T>
-T& Map<Key, T>::operator[](const Key& key) {
-  return insert(std::make_pair(key, T())).first->second;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K, typename C, typename>
+T& Map<Key, T, Compare, Allocator, NodePolicy>::at(const K& key) {
+  Node* node = findNode(key);
+  if (!node) {
+    throw std::out_of_range("Key not found");
+  }
+  return node->data.second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+T& Map<Key, T, Compare, Allocator, NodePolicy>::operator[](const Key& key) {
+  return tryEmplaceImpl(key).first->second;
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::iterator Map<Key, T>::begin() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+T& Map<Key, T, Compare, Allocator, NodePolicy>::operator[](Key&& key) {
+  return tryEmplaceImpl(std::move(key)).first->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::begin() {
   return iterator(findMin(root), root);
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::iterator Map<Key, T>::end() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::end() {
   return iterator(nullptr, root);
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::const_iterator Map<Key, T>::begin() const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::begin() const {
   return const_iterator(findMin(root), root);
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::const_iterator Map<Key, T>::end() const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::end() const {
   return const_iterator(nullptr, root);
 }
 
-template <typename Key, typename T>
-bool Map<Key, T>::empty() const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+bool Map<Key, T, Compare, Allocator, NodePolicy>::empty() const {
   return node_count == 0;
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::size_type Map<Key, T>::size() const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::size_type
+Map<Key, T, Compare, Allocator, NodePolicy>::size() const {
   return node_count;
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::size_type Map<Key, T>::max_size() const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::size_type
+Map<Key, T, Compare, Allocator, NodePolicy>::max_size() const {
   return std::numeric_limits<size_type>::max();
 }
 
-template <typename Key, typename T>
-void Map<Key, T>::clear() {
-  clear(root);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::clear() {
+  releaseNodes();
   root = nullptr;
   node_count = 0;
+  rightmost_ = nullptr;
+  rebuildFilter();
+}
+
+// Если значения не требуют деструкторов, а пул принадлежит только этому
+// контейнеру, память освобождается целиком без обхода дерева
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::releaseNodes() {
+  if (!std::is_trivially_destructible<value_type>::value ||
+      !NodeHooks::release(alloc_)) {
+    clear(root);
+    NodeHooks::release(alloc_);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::reserve(size_type count) {
+  if (count > node_count) {
+    NodeHooks::reserve(alloc_, count - node_count);
+  }
 }
 
-template <typename Key, typename T>
-void Map<Key, T>::clear(Node* node) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::allocator_type
+Map<Key, T, Compare, Allocator, NodePolicy>::get_allocator() const {
+  return allocator_type(alloc_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename... Args>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::createNode(Args&&... args) {
+  Node* node = NodeTraits::allocate(alloc_, 1);
+  try {
+    NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  if constexpr (NodePolicy::kKeyPrefix) {
+    node->key_prefix = NodePolicy::prefix(node->data.first);
+  }
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::destroyNode(Node* node) {
+  NodeTraits::destroy(alloc_, node);
+  NodeTraits::deallocate(alloc_, node, 1);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::clear(Node* node) {
   if (node) {
     clear(node->left);
     clear(node->right);
-    delete node;
+    destroyNode(node);
   }
 }
 
-template <typename Key, typename T>
-std::pair<typename Map<Key, T>::iterator, bool> Map<Key, T>::insert(
-    const value_type& value) {
-  return insert(value.first, value.second);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::insert(const value_type& value) {
+  return tryEmplaceImpl(value.first, value.second);
 }
 
-template <typename Key, typename T>
-std::pair<typename Map<Key, T>::iterator, bool> Map<Key, T>::insert(
-    const Key& key, const T& obj) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::insert(value_type&& value) {
   Node* parent = nullptr;
-  Node* current = root;
+  bool as_left = false;
+  Node* existing = findInsertPosition(value.first, parent, as_left);
+  if (existing) {
+    return std::make_pair(iterator(existing, root), false);
+  }
+  return std::make_pair(
+      attachNode(createNode(std::move(value)), parent, as_left), true);
+}
 
-  while (current) {
-    if (key == current->data.first) {
-      return std::make_pair(iterator(current, root), false);
-    }
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::insert(const Key& key,
+                                                    const T& obj) {
+  return tryEmplaceImpl(key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::insert_or_assign(const Key& key,
+                                                              const T& obj) {
+  auto result = tryEmplaceImpl(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::insert_or_assign(const Key& key,
+                                                              T&& obj) {
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing = findInsertPosition(key, parent, as_left);
+  if (existing) {
+    existing->data.second = std::move(obj);
+    return std::make_pair(iterator(existing, root), false);
+  }
+  Node* node = createNode(key, std::move(obj));
+  return std::make_pair(attachNode(node, parent, as_left), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename... Args>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::emplace(Args&&... args) {
+  Node* node = createNode(std::forward<Args>(args)...);
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing = nullptr;
+  try {
+    existing = findInsertPosition(node->data.first, parent, as_left);
+  } catch (...) {
+    destroyNode(node);
+    throw;
+  }
+  if (existing) {
+    destroyNode(node);
+    return std::make_pair(iterator(existing, root), false);
+  }
+  return std::make_pair(attachNode(node, parent, as_left), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::insert(iterator hint,
+                                                    const value_type& value) {
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing =
+      findHintPosition(hint.getCurrent(), value.first, parent, as_left);
+  if (existing) {
+    return iterator(existing, root);
+  }
+  return attachNode(createNode(value), parent, as_left);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::insert(iterator hint,
+                                                    value_type&& value) {
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing =
+      findHintPosition(hint.getCurrent(), value.first, parent, as_left);
+  if (existing) {
+    return iterator(existing, root);
+  }
+  return attachNode(createNode(std::move(value)), parent, as_left);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename... Args>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::emplace_hint(iterator hint,
+                                                          Args&&... args) {
+  Node* node = createNode(std::forward<Args>(args)...);
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing = nullptr;
+  try {
+    existing = findHintPosition(hint.getCurrent(), node->data.first, parent,
+                                as_left);
+  } catch (...) {
+    destroyNode(node);
+    throw;
+  }
+  if (existing) {
+    destroyNode(node);
+    return iterator(existing, root);
+  }
+  return attachNode(node, parent, as_left);
+}
 
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename... Args>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::try_emplace(const Key& key,
+                                                         Args&&... args) {
+  return tryEmplaceImpl(key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename... Args>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::try_emplace(Key&& key,
+                                                         Args&&... args) {
+  return tryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K, typename... Args>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator, bool>
+Map<Key, T, Compare, Allocator, NodePolicy>::tryEmplaceImpl(K&& key,
+                                                            Args&&... args) {
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing = findInsertPosition(key, parent, as_left);
+  if (existing) {
+    return std::make_pair(iterator(existing, root), false);
+  }
+  Node* node = createNode(std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+  return std::make_pair(attachNode(node, parent, as_left), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findInsertPosition(
+    const K& key, Node*& parent, bool& as_left) const {
+  std::uint64_t prefix = keyPrefix(key);
+  // Ключ больше всех: спуск не нужен, узел встает справа от наибольшего
+  if (rightmost_ && nodeLessThan(rightmost_, key, prefix)) {
+    parent = rightmost_;
+    as_left = false;
+    return nullptr;
+  }
+
+  Node* current = root;
+  while (current) {
     parent = current;
-    if (key < current->data.first) {
+    if (lessThanNode(key, prefix, current)) {
+      as_left = true;
       current = current->left;
-    } else {
+    } else if (nodeLessThan(current, key, prefix)) {
+      as_left = false;
       current = current->right;
+    } else {
+      return current;
     }
   }
+  return nullptr;
+}
 
-  Node* new_node = new Node(std::make_pair(key, obj));
-  new_node->parent = parent;
+// Новый ключ стоит между соседями по порядку before и after, а из двух
+// соседних узлов дерева у одного нужная сторона всегда свободна: если у hint
+// есть левое поддерево, before - его наибольший узел без правого потомка
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findHintPosition(
+    Node* hint, const K& key, Node*& parent, bool& as_left) const {
+  if (!hint) {
+    return findInsertPosition(key, parent, as_left);
+  }
+  std::uint64_t prefix = keyPrefix(key);
+  if (lessThanNode(key, prefix, hint)) {
+    Node* before = findPrev(hint);
+    if (!before || nodeLessThan(before, key, prefix)) {
+      as_left = !hint->left;
+      parent = as_left ? hint : before;
+      return nullptr;
+    }
+  } else if (nodeLessThan(hint, key, prefix)) {
+    // От наибольшего узла findNext поднялся бы до корня
+    Node* after = hint == rightmost_ ? nullptr : findNext(hint);
+    if (!after || lessThanNode(key, prefix, after)) {
+      as_left = hint->right != nullptr;
+      parent = as_left ? after : hint;
+      return nullptr;
+    }
+  } else {
+    return hint;
+  }
+  return findInsertPosition(key, parent, as_left);
+}
 
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::attachNode(Node* node,
+                                                        Node* parent,
+                                                        bool as_left) {
+  node->left = nullptr;
+  node->right = nullptr;
+  node->parent = parent;
+  node->color = Color::kRed;
   if (!parent) {
-    root = new_node;
-  } else if (key < parent->data.first) {
-    parent->left = new_node;
+    root = node;
+  } else if (as_left) {
+    parent->left = node;
   } else {
-    parent->right = new_node;
+    parent->right = node;
+  }
+  if (!parent || (parent == rightmost_ && !as_left)) {
+    rightmost_ = node;
   }
 
   ++node_count;
-  return std::make_pair(iterator(new_node, root), true);
+  NodePolicy::update(node);
+  updatePath(parent);
+  insertFixup(node);
+  filterInsert(node->data.first);
+  return iterator(node, root);
 }
 
-template <typename Key, typename T>
-std::pair<typename Map<Key, T>::iterator, bool> Map<Key, T>::insert_or_assign(
-    const Key& key, const T& obj) {
-  auto result = insert(key, obj);
-  if (!result.second) {
-    result.first->second = obj;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::erase(iterator pos) {
+  Node* node = pos.getCurrent();
+  if (node) {
+    unlinkNode(node);
+    destroyNode(node);
   }
-  return result;
 }
 
-template <typename Key, typename T>
-void Map<Key, T>::erase(iterator pos) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::node_type
+Map<Key, T, Compare, Allocator, NodePolicy>::extract(iterator pos) {
   Node* node = pos.getCurrent();
   if (!node) {
-    return;
+    return node_type();
   }
+  unlinkNode(node);
+  return node_type(node, alloc_);
+}
 
-  // У узла нет потомков
-  if (!node->left && !node->right) {
-    if (node->parent) {
-      if (node->parent->left == node) {
-        node->parent->left = nullptr;
-      } else {
-        node->parent->right = nullptr;
-      }
-    } else {
-      root = nullptr;  // Node is root
-    }
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::node_type
+Map<Key, T, Compare, Allocator, NodePolicy>::extract(const Key& key) {
+  return extract(iterator(findNode(key), root));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::insert_return_type
+Map<Key, T, Compare, Allocator, NodePolicy>::insert(node_type&& handle) {
+  if (handle.empty()) {
+    return {end(), false, node_type()};
   }
-  // У узла 1 потомок
-  else if (!node->left || !node->right) {
-    Node* child = node->left ? node->left : node->right;
-    if (node->parent) {
-      if (node->parent->left == node) {
-        node->parent->left = child;
-      } else {
-        node->parent->right = child;
-      }
-    } else {
-      root = child;  // Node is root
-    }
-    child->parent = node->parent;
+
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing = findInsertPosition(handle.key(), parent, as_left);
+  if (existing) {
+    return {iterator(existing, root), false, std::move(handle)};
+  }
+
+  // Узел из чужой памяти нельзя перевесить: значение переносится в новый узел
+  Node* node = handle.node_;
+  if (handle.alloc_ != alloc_) {
+    node = createNode(std::move(node->data));
+    handle.reset();
+  }
+  handle.node_ = nullptr;
+  return {attachNode(node, parent, as_left), true, node_type()};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::unlinkNode(Node* node) {
+  // removed - узел, который физически исчезает из своей позиции в дереве,
+  // child - узел, который встает на его место (может быть nullptr)
+  if (node == rightmost_) {
+    // У наибольшего узла нет правого потомка, а сам он правый потомок
+    rightmost_ = node->left ? findMax(node->left) : node->parent;
   }
-  // У узла 2 потомка
-  else {
-    Node* successor = findMin(node->right);
 
-    // Повторная связка узлов (взамен копирования)
-    if (successor->parent->left == successor) {
-      successor->parent->left = successor->right;
+  Node* removed = node;
+  Color removed_color = removed->color;
+  Node* child = nullptr;
+  Node* child_parent = nullptr;
+
+  if (!node->left) {
+    child = node->right;
+    child_parent = node->parent;
+    transplant(node, node->right);
+  } else if (!node->right) {
+    child = node->left;
+    child_parent = node->parent;
+    transplant(node, node->left);
+  } else {
+    // У узла 2 потомка: на его место перевешивается преемник, данные не
+    // копируются, поэтому итераторы на остальные элементы остаются валидными
+    removed = findMin(node->right);
+    removed_color = removed->color;
+    child = removed->right;
+
+    if (removed->parent == node) {
+      child_parent = removed;
     } else {
-      successor->parent->right = successor->right;
-    }
-    if (successor->right) {
-      successor->right->parent = successor->parent;
+      child_parent = removed->parent;
+      transplant(removed, removed->right);
+      removed->right = node->right;
+      removed->right->parent = removed;
     }
 
-    // Обновление данных узла
-    node->data.~value_type();
-    new (&node->data) value_type(std::move(successor->data));
-
-    node = successor;
+    transplant(node, removed);
+    removed->left = node->left;
+    removed->left->parent = removed;
+    removed->color = node->color;
   }
 
-  delete node;
   --node_count;
+  updatePath(child_parent);
+
+  if (removed_color == Color::kBlack) {
+    eraseFixup(child, child_parent);
+  }
+  filterErase();
 }
 
-template <typename Key, typename T>
-void Map<Key, T>::swap(Map& other) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::swap(Map& other) {
   Node* tempRoot = root;
   root = other.root;
   other.root = tempRoot;
@@ -231,47 +639,343 @@ void Map<Key, T>::swap(Map& other) {
   size_t tempNodeCount = node_count;
   node_count = other.node_count;
   other.node_count = tempNodeCount;
+
+  std::swap(rightmost_, other.rightmost_);
+
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(filter_, other.filter_);
 }
 
-template <typename Key, typename T>
-void Map<Key, T>::merge(Map& other) {
-  for (auto it = other.begin(); it != other.end(); ++it) {
-    insert(*it);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::merge(Map& other) {
+  if (this == &other) {
+    return;
+  }
+
+  bool same_memory = alloc_ == other.alloc_;
+  iterator it = other.begin();
+  while (it != other.end()) {
+    // Итератор сдвигается заранее: перевешивание узла не трогает соседей
+    Node* node = it.getCurrent();
+    ++it;
+
+    Node* parent = nullptr;
+    bool as_left = false;
+    if (findInsertPosition(node->data.first, parent, as_left)) {
+      continue;
+    }
+    if (same_memory) {
+      other.unlinkNode(node);
+      attachNode(node, parent, as_left);
+    } else {
+      attachNode(createNode(node->data), parent, as_left);
+      other.erase(iterator(node, other.root));
+    }
   }
-  other.clear();
 }
 
-template <typename Key, typename T>
-bool Map<Key, T>::contains(const Key& key) const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+bool Map<Key, T, Compare, Allocator, NodePolicy>::contains(
+    const Key& key) const {
+  return filteredFind(key) != nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K, typename C, typename>
+bool Map<Key, T, Compare, Allocator, NodePolicy>::contains(const K& key) const {
   return findNode(key) != nullptr;
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::Node* Map<Key, T>::findNode(const Key& key) const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findNode(const K& key) const {
+  std::uint64_t prefix = keyPrefix(key);
   Node* current = root;
   while (current) {
-    if (key == current->data.first) {
+    if (lessThanNode(key, prefix, current)) {
+      current = current->left;
+    } else if (nodeLessThan(current, key, prefix)) {
+      current = current->right;
+    } else {
       return current;
     }
-    if (key < current->data.first) {
+  }
+  return nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findBound(const Key& key,
+                                                       bool upper) const {
+  std::uint64_t prefix = keyPrefix(key);
+  Node* bound = nullptr;
+  Node* current = root;
+  while (current) {
+    bool goes_left = upper ? lessThanNode(key, prefix, current)
+                           : !nodeLessThan(current, key, prefix);
+    if (goes_left) {
+      bound = current;
       current = current->left;
     } else {
       current = current->right;
     }
   }
-  return nullptr;
+  return bound;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+std::uint64_t Map<Key, T, Compare, Allocator, NodePolicy>::keyPrefix(
+    const K& key) {
+  if constexpr (NodePolicy::kKeyPrefix) {
+    return NodePolicy::prefix(key);
+  } else {
+    static_cast<void>(key);
+    return 0;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+bool Map<Key, T, Compare, Allocator, NodePolicy>::lessThanNode(
+    const K& key, std::uint64_t prefix, const Node* node) const {
+  if constexpr (NodePolicy::kKeyPrefix) {
+    if (prefix != node->key_prefix) {
+      return prefix < node->key_prefix;
+    }
+  } else {
+    static_cast<void>(prefix);
+  }
+  return comp_(key, node->data.first);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+bool Map<Key, T, Compare, Allocator, NodePolicy>::nodeLessThan(
+    const Node* node, const K& key, std::uint64_t prefix) const {
+  if constexpr (NodePolicy::kKeyPrefix) {
+    if (prefix != node->key_prefix) {
+      return node->key_prefix < prefix;
+    }
+  } else {
+    static_cast<void>(prefix);
+  }
+  return comp_(node->data.first, key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::lower_bound(const Key& key) {
+  return iterator(findBound(key, false), root);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::lower_bound(const Key& key) const {
+  return const_iterator(findBound(key, false), root);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::upper_bound(const Key& key) {
+  return iterator(findBound(key, true), root);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::upper_bound(const Key& key) const {
+  return const_iterator(findBound(key, true), root);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator,
+          typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator>
+Map<Key, T, Compare, Allocator, NodePolicy>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator,
+          typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator>
+Map<Key, T, Compare, Allocator, NodePolicy>::equal_range(const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+IteratorRange<typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator>
+Map<Key, T, Compare, Allocator, NodePolicy>::range(const Key& lo,
+                                                   const Key& hi) {
+  if (!comp_(lo, hi)) {
+    return {end(), end()};
+  }
+  return {lower_bound(lo), lower_bound(hi)};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+IteratorRange<
+    typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator>
+Map<Key, T, Compare, Allocator, NodePolicy>::range(const Key& lo,
+                                                   const Key& hi) const {
+  if (!comp_(lo, hi)) {
+    return {end(), end()};
+  }
+  return {lower_bound(lo), lower_bound(hi)};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::updatePath(Node* node) {
+  // Пустая база узла означает, что обновлять нечего
+  if constexpr (!std::is_empty<typename NodePolicy::NodeBase>::value) {
+    for (; node; node = node->parent) {
+      NodePolicy::update(node);
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::size_type
+Map<Key, T, Compare, Allocator, NodePolicy>::rank(const Key& key) const {
+  static_assert(NodePolicy::kOrderStatistics,
+                "rank() requires the OrderStatistics node policy");
+  size_type result = 0;
+  Node* current = root;
+  while (current) {
+    if (comp_(current->data.first, key)) {
+      result += NodePolicy::size(current->left) + 1;
+      current = current->right;
+    } else {
+      current = current->left;
+    }
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findByIndex(
+    size_type index) const {
+  static_assert(NodePolicy::kOrderStatistics,
+                "select() requires the OrderStatistics node policy");
+  Node* current = index < node_count ? root : nullptr;
+  while (current) {
+    size_type left_size = NodePolicy::size(current->left);
+    if (index < left_size) {
+      current = current->left;
+    } else if (index > left_size) {
+      index -= left_size + 1;
+      current = current->right;
+    } else {
+      break;
+    }
+  }
+  return current;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::select(size_type index) {
+  return iterator(findByIndex(index), root);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::const_iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::select(size_type index) const {
+  return const_iterator(findByIndex(index), root);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::size_type
+Map<Key, T, Compare, Allocator, NodePolicy>::count_range(
+    const Key& lo, const Key& hi) const {
+  return comp_(lo, hi) ? rank(hi) - rank(lo) : 0;
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::Node* Map<Key, T>::findMin(Node* node) const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findMin(Node* node) const {
   while (node && node->left) {
     node = node->left;
   }
   return node;
 }
 
-template <typename Key, typename T>
-const typename Map<Key, T>::Node* Map<Key, T>::MapConstIterator::findMin(
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findMax(Node* node) const {
+  while (node && node->right) {
+    node = node->right;
+  }
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findPrev(Node* node) {
+  if (node->left) {
+    node = node->left;
+    while (node->right) {
+      node = node->right;
+    }
+    return node;
+  }
+  Node* parent = node->parent;
+  while (parent && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::findNext(Node* node) {
+  if (node->right) {
+    node = node->right;
+    while (node->left) {
+      node = node->left;
+    }
+    return node;
+  }
+  Node* parent = node->parent;
+  while (parent && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+const typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::MapConstIterator::findMin(
     const Node* node) const {
   while (node && node->left) {
     node = node->left;
@@ -279,9 +983,24 @@ const typename Map<Key, T>::Node* Map<Key, T>::MapConstIterator::findMin(
   return node;
 }
 
-template <typename Key, typename T>
-typename Map<Key, T>::iterator Map<Key, T>::find(const Key& key) {
-  Node* node = findNodeForTesting(key);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::find(const Key& key) {
+  Node* node = filteredFind(key);
+  if (node) {
+    return iterator(node, root);
+  } else {
+    return end();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K, typename C, typename>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::iterator
+Map<Key, T, Compare, Allocator, NodePolicy>::find(const K& key) {
+  Node* node = findNode(key);
   if (node) {
     return iterator(node, root);
   } else {
@@ -289,13 +1008,584 @@ typename Map<Key, T>::iterator Map<Key, T>::find(const Key& key) {
   }
 }
 
-template <typename Key, typename Value>
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+bool Map<Key, T, Compare, Allocator, NodePolicy>::isRed(const Node* node) {
+  return node && node->color == Color::kRed;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::rotateLeft(Node* node) {
+  Node* pivot = node->right;
+  node->right = pivot->left;
+  if (pivot->left) {
+    pivot->left->parent = node;
+  }
+  transplant(node, pivot);
+  pivot->left = node;
+  node->parent = pivot;
+  NodePolicy::update(node);
+  NodePolicy::update(pivot);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::rotateRight(Node* node) {
+  Node* pivot = node->left;
+  node->left = pivot->right;
+  if (pivot->right) {
+    pivot->right->parent = node;
+  }
+  transplant(node, pivot);
+  pivot->right = node;
+  node->parent = pivot;
+  NodePolicy::update(node);
+  NodePolicy::update(pivot);
+}
+
+// Восстанавливает свойства дерева после вставки красного узла
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::insertFixup(Node* node) {
+  while (isRed(node->parent)) {
+    Node* parent = node->parent;
+    Node* grandparent = parent->parent;
+
+    if (parent == grandparent->left) {
+      Node* uncle = grandparent->right;
+      if (isRed(uncle)) {
+        parent->color = Color::kBlack;
+        uncle->color = Color::kBlack;
+        grandparent->color = Color::kRed;
+        node = grandparent;
+      } else {
+        if (node == parent->right) {
+          node = parent;
+          rotateLeft(node);
+          parent = node->parent;
+        }
+        parent->color = Color::kBlack;
+        grandparent->color = Color::kRed;
+        rotateRight(grandparent);
+      }
+    } else {
+      Node* uncle = grandparent->left;
+      if (isRed(uncle)) {
+        parent->color = Color::kBlack;
+        uncle->color = Color::kBlack;
+        grandparent->color = Color::kRed;
+        node = grandparent;
+      } else {
+        if (node == parent->left) {
+          node = parent;
+          rotateRight(node);
+          parent = node->parent;
+        }
+        parent->color = Color::kBlack;
+        grandparent->color = Color::kRed;
+        rotateLeft(grandparent);
+      }
+    }
+  }
+  root->color = Color::kBlack;
+}
+
+// Восстанавливает черную высоту после удаления черного узла. node может быть
+// nullptr, поэтому его родитель передается отдельно
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::eraseFixup(Node* node,
+                                                             Node* parent) {
+  while (node != root && !isRed(node)) {
+    if (node == parent->left) {
+      Node* sibling = parent->right;
+      if (isRed(sibling)) {
+        sibling->color = Color::kBlack;
+        parent->color = Color::kRed;
+        rotateLeft(parent);
+        sibling = parent->right;
+      }
+      if (!isRed(sibling->left) && !isRed(sibling->right)) {
+        sibling->color = Color::kRed;
+        node = parent;
+        parent = node->parent;
+      } else {
+        if (!isRed(sibling->right)) {
+          sibling->left->color = Color::kBlack;
+          sibling->color = Color::kRed;
+          rotateRight(sibling);
+          sibling = parent->right;
+        }
+        sibling->color = parent->color;
+        parent->color = Color::kBlack;
+        sibling->right->color = Color::kBlack;
+        rotateLeft(parent);
+        node = root;
+      }
+    } else {
+      Node* sibling = parent->left;
+      if (isRed(sibling)) {
+        sibling->color = Color::kBlack;
+        parent->color = Color::kRed;
+        rotateRight(parent);
+        sibling = parent->left;
+      }
+      if (!isRed(sibling->left) && !isRed(sibling->right)) {
+        sibling->color = Color::kRed;
+        node = parent;
+        parent = node->parent;
+      } else {
+        if (!isRed(sibling->left)) {
+          sibling->right->color = Color::kBlack;
+          sibling->color = Color::kRed;
+          rotateLeft(sibling);
+          sibling = parent->left;
+        }
+        sibling->color = parent->color;
+        parent->color = Color::kBlack;
+        sibling->left->color = Color::kBlack;
+        rotateRight(parent);
+        node = root;
+      }
+    }
+  }
+  if (node) {
+    node->color = Color::kBlack;
+  }
+}
+
+// Ставит replacement на место target в родительском узле
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::transplant(
+    Node* target, Node* replacement) {
+  if (!target->parent) {
+    root = replacement;
+  } else if (target == target->parent->left) {
+    target->parent->left = replacement;
+  } else {
+    target->parent->right = replacement;
+  }
+  if (replacement) {
+    replacement->parent = target->parent;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+int Map<Key, T, Compare, Allocator, NodePolicy>::blackHeight(
+    const Node* node) const {
+  if (!node) {
+    return 1;
+  }
+  if (node->left && (node->left->parent != node ||
+                     !comp_(node->left->data.first, node->data.first))) {
+    return -1;
+  }
+  if (node->right && (node->right->parent != node ||
+                      !comp_(node->data.first, node->right->data.first))) {
+    return -1;
+  }
+  if (isRed(node) && (isRed(node->left) || isRed(node->right))) {
+    return -1;
+  }
+  if (!NodePolicy::valid(node)) {
+    return -1;
+  }
+  if constexpr (NodePolicy::kKeyPrefix) {
+    if (node->key_prefix != NodePolicy::prefix(node->data.first)) {
+      return -1;
+    }
+  }
+  int left_height = blackHeight(node->left);
+  int right_height = blackHeight(node->right);
+  if (left_height < 0 || left_height != right_height) {
+    return -1;
+  }
+  return left_height + (isRed(node) ? 0 : 1);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+bool Map<Key, T, Compare, Allocator, NodePolicy>::validateForTesting() const {
+  if (!root) {
+    return node_count == 0 && !rightmost_;
+  }
+  if (root->parent || isRed(root) || rightmost_ != findMax(root)) {
+    return false;
+  }
+  size_type counted = 0;
+  for (auto it = begin(); it != end(); ++it) {
+    ++counted;
+  }
+  return counted == node_count && blackHeight(root) > 0;
+}
+
+// Строит в пустом дереве копию other. Узлы из списка reuse используются
+// повторно вместо выделения новых, лишние освобождаются
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::copyFrom(const Map& other,
+                                                           Node* reuse) {
+  try {
+    cloneTree(other.root, nullptr, &root, reuse);
+  } catch (...) {
+    clear();
+    deleteNodes(reuse);
+    throw;
+  }
+  deleteNodes(reuse);
+  node_count = other.node_count;
+  rightmost_ = findMax(root);
+}
+
+// Копия сразу подвешивается к родителю, поэтому при исключении частично
+// построенное дерево остается достижимым из root и освобождается через clear()
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::cloneTree(
+    const Node* source, Node* parent, Node** slot, Node*& reuse) {
+  while (source) {
+    Node* copy = makeNode(source->data, reuse);
+    copy->color = source->color;
+    copy->parent = parent;
+    static_cast<typename NodePolicy::NodeBase&>(*copy) = *source;
+    *slot = copy;
+
+    cloneTree(source->left, copy, &copy->left, reuse);
+    source = source->right;
+    parent = copy;
+    slot = &copy->right;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename V>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::makeNode(V&& value, Node*& reuse) {
+  if (!reuse) {
+    return createNode(std::forward<V>(value));
+  }
+
+  Node* node = reuse;
+  reuse = reuse->right;
+  node->data.~value_type();
+  try {
+    new (&node->data) value_type(std::forward<V>(value));
+  } catch (...) {
+    NodeTraits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  node->left = nullptr;
+  node->right = nullptr;
+  node->parent = nullptr;
+  node->color = Color::kRed;
+  if constexpr (NodePolicy::kKeyPrefix) {
+    node->key_prefix = NodePolicy::prefix(node->data.first);
+  }
+  return node;
+}
+
+// Правыми поворотами вытягивает дерево в цепочку по right за O(n) без
+// дополнительной памяти и оставляет контейнер пустым
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::detachNodes() {
+  Node* list = nullptr;
+  Node* current = root;
+  while (current) {
+    if (current->left) {
+      Node* left = current->left;
+      current->left = left->right;
+      left->right = current;
+      current = left;
+    } else {
+      Node* next = current->right;
+      current->right = list;
+      list = current;
+      current = next;
+    }
+  }
+  root = nullptr;
+  node_count = 0;
+  rightmost_ = nullptr;
+  return list;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::deleteNodes(Node* list) {
+  while (list) {
+    Node* next = list->right;
+    destroyNode(list);
+    list = next;
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator,
+          typename NodePolicy>
 template <typename... Args>
-Vector<std::pair<typename Map<Key, Value>::iterator, bool>>
-Map<Key, Value>::insert_many(Args&&... args) {
+Vector<std::pair<
+    typename Map<Key, Value, Compare, Allocator, NodePolicy>::iterator, bool>>
+Map<Key, Value, Compare, Allocator, NodePolicy>::insert_many(Args&&... args) {
   Vector<std::pair<iterator, bool>> results;
   (results.push_back(insert(std::forward<Args>(args))), ...);
   return results;
 }
 
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename ForwardIt>
+void Map<Key, T, Compare, Allocator, NodePolicy>::assign_sorted(ForwardIt first,
+                                                                ForwardIt last,
+                                                                bool checked) {
+  if (checked) {
+    for (ForwardIt prev = first, it = first; it != last; prev = it) {
+      if (++it != last && !comp_((*prev).first, (*it).first)) {
+        clear();
+        for (; first != last; ++first) {
+          insert(*first);
+        }
+        return;
+      }
+    }
+  }
+
+  size_type count = static_cast<size_type>(std::distance(first, last));
+  Node* reuse = detachNodes();
+  try {
+    root = buildSorted(first, count, 0, fullLevels(count), reuse);
+  } catch (...) {
+    deleteNodes(reuse);
+    throw;
+  }
+  deleteNodes(reuse);
+  node_count = count;
+  rightmost_ = findMax(root);
+  rebuildFilter();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename RandomIt>
+void Map<Key, T, Compare, Allocator, NodePolicy>::assign_parallel(
+    RandomIt first, RandomIt last, ThreadPool& pool) {
+  std::vector<std::pair<Key, T>> items(first, last);
+  parallel_sort(pool, items.begin(), items.end(),
+                [this](const std::pair<Key, T>& a, const std::pair<Key, T>& b) {
+                  return comp_(a.first, b.first);
+                });
+  // Сортировка устойчива: из равных ключей первым стоит встреченный раньше
+  items.erase(std::unique(items.begin(), items.end(),
+                          [this](const std::pair<Key, T>& a,
+                                 const std::pair<Key, T>& b) {
+                            return !comp_(a.first, b.first);
+                          }),
+              items.end());
+
+  clear();
+  root = buildParallel(std::make_move_iterator(items.begin()), items.size(),
+                       pool);
+  node_count = items.size();
+  rightmost_ = findMax(root);
+  rebuildFilter();
+}
+
+// Фильтр Блума
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::enable_filter(
+    double bits_per_key) {
+  static_assert(kFilterable,
+                "enable_filter requires a BloomFilterHash matching Compare");
+  filter_ = std::make_unique<Filter>(2 * node_count, bits_per_key);
+  for (Node* node = findMin(root); node; node = findNext(node)) {
+    filter_->insert(node->data.first);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+BloomFilterStats Map<Key, T, Compare, Allocator, NodePolicy>::filter_stats()
+    const {
+  return filter_ ? filter_->stats() : BloomFilterStats{};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::filterInsert(
+    const Key& key) {
+  if constexpr (kFilterable) {
+    if (!filter_) return;
+    filter_->insert(key);
+    if (filter_->stale()) rebuildFilter();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::filterErase() {
+  if constexpr (kFilterable) {
+    if (!filter_) return;
+    filter_->note_erase();
+    if (filter_->stale()) rebuildFilter();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Map<Key, T, Compare, Allocator, NodePolicy>::rebuildFilter() {
+  if constexpr (kFilterable) {
+    if (!filter_) return;
+    filter_->reset(2 * node_count);
+    for (Node* node = findMin(root); node; node = findNext(node)) {
+      filter_->insert(node->data.first);
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::filteredFind(
+    const Key& key) const {
+  if constexpr (kFilterable) {
+    if (filter_) {
+      if (!filter_->may_contain(key)) return nullptr;
+      Node* node = findNode(key);
+      if (!node) filter_->record_false_positive();
+      return node;
+    }
+  }
+  return findNode(key);
+}
+
+// Уровни 0..fullLevels(count)-1 заполнены полностью и окрашиваются в черный,
+// узлы неполного последнего уровня - в красный
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::size_type
+Map<Key, T, Compare, Allocator, NodePolicy>::fullLevels(size_type count) {
+  size_type levels = 0;
+  while ((size_type{2} << levels) - 1 <= count) {
+    ++levels;
+  }
+  return levels;
+}
+
+// Поддеревья не пересекаются и пишут только в свою ссылку родителя, поэтому
+// потокам не нужна синхронизация. Размеры NodePolicy верхних узлов
+// пересчитываются после того, как все поддеревья готовы
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename RandomIt>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::buildParallel(RandomIt first,
+                                                           size_type count,
+                                                           ThreadPool& pool) {
+  ParallelBuild<RandomIt> build{};
+  build.red_depth = fullLevels(count);
+  build.split_depth = parallel_build_depth(
+      pool, count, kConcurrentAllocator<NodeAllocator>);
+
+  Node* result = nullptr;
+  try {
+    buildTop(first, count, 0, nullptr, &result, build);
+    pool.parallel_for(build.subtrees.size(), [this, &build](size_type i) {
+      auto& subtree = build.subtrees[i];
+      RandomIt it = subtree.first;
+      Node* reuse = nullptr;
+      Node* node = buildSorted(it, subtree.count, subtree.depth,
+                               build.red_depth, reuse);
+      if (node) {
+        node->parent = subtree.parent;
+      }
+      *subtree.slot = node;
+    });
+  } catch (...) {
+    clear(result);
+    throw;
+  }
+  for (Node* node : build.top) {
+    NodePolicy::update(node);
+  }
+  return result;
+}
+
+// Корень и размеры половин выбираются как в buildSorted, поэтому раскраска
+// по глубине совпадает с последовательным построением
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename RandomIt>
+void Map<Key, T, Compare, Allocator, NodePolicy>::buildTop(
+    RandomIt first, size_type count, size_type depth, Node* parent,
+    Node** slot, ParallelBuild<RandomIt>& build) {
+  if (count == 0) {
+    return;
+  }
+  if (depth == build.split_depth) {
+    build.subtrees.push_back({first, count, depth, parent, slot});
+    return;
+  }
+
+  size_type left_count = (count - 1) / 2;
+  Node* node = createNode(first[left_count]);
+  node->color = depth >= build.red_depth ? Color::kRed : Color::kBlack;
+  node->parent = parent;
+  *slot = node;
+  buildTop(first, left_count, depth + 1, node, &node->left, build);
+  buildTop(first + left_count + 1, count - 1 - left_count, depth + 1, node,
+           &node->right, build);
+  build.top.push_back(node);
+}
+
+// Строит идеально сбалансированное поддерево из count элементов, забирая их
+// из it в порядке симметричного обхода
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename ForwardIt>
+typename Map<Key, T, Compare, Allocator, NodePolicy>::Node*
+Map<Key, T, Compare, Allocator, NodePolicy>::buildSorted(ForwardIt& it,
+                                                         size_type count,
+                                                         size_type depth,
+                                                         size_type red_depth,
+                                                         Node*& reuse) {
+  if (count == 0) {
+    return nullptr;
+  }
+
+  size_type left_count = (count - 1) / 2;
+  Node* left = buildSorted(it, left_count, depth + 1, red_depth, reuse);
+  Node* node = nullptr;
+  try {
+    node = makeNode(*it, reuse);
+    ++it;
+  } catch (...) {
+    clear(left);
+    throw;
+  }
+  node->color = depth >= red_depth ? Color::kRed : Color::kBlack;
+  node->left = left;
+  if (left) {
+    left->parent = node;
+  }
+
+  try {
+    node->right =
+        buildSorted(it, count - 1 - left_count, depth + 1, red_depth, reuse);
+  } catch (...) {
+    clear(node);
+    throw;
+  }
+  if (node->right) {
+    node->right->parent = node;
+  }
+  NodePolicy::update(node);
+  return node;
+}
+
 }  // namespace s21
@@ -4,10 +4,19 @@
 
 #include "../../include/s21_multiset/s21_multiset.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace s21 {
 
 template <typename Key, typename Compare, typename Allocator>
-Multiset<Key, Compare, Allocator>::Multiset() : root_(nullptr), size_(0) {}
+Multiset<Key, Compare, Allocator>::Multiset()
+    : root_(nullptr), size_(0), comp_(), alloc_() {}
+
+template <typename Key, typename Compare, typename Allocator>
+Multiset<Key, Compare, Allocator>::Multiset(const Compare& comp,
+                                            const Allocator& alloc)
+    : root_(nullptr), size_(0), comp_(comp), alloc_(alloc) {}
 
 template <typename Key, typename Compare, typename Allocator>
 Multiset<Key, Compare, Allocator>::Multiset(
@@ -19,36 +28,95 @@ Multiset<Key, Compare, Allocator>::Multiset(
 }
 
 template <typename Key, typename Compare, typename Allocator>
-Multiset<Key, Compare, Allocator>::Multiset(const Multiset& ms) : Multiset() {
+Multiset<Key, Compare, Allocator>::Multiset(const Multiset& ms)
+    : root_(nullptr),
+      size_(0),
+      comp_(ms.comp_),
+      alloc_(NodeTraits::select_on_container_copy_construction(ms.alloc_)) {
   *this = ms;
 }
 
 template <typename Key, typename Compare, typename Allocator>
 Multiset<Key, Compare, Allocator>::Multiset(Multiset&& ms)
-    : root_(ms.root_), size_(ms.size_) {
+    : root_(ms.root_),
+      size_(ms.size_),
+      comp_(ms.comp_),
+      alloc_(std::move(ms.alloc_)) {
   ms.root_ = nullptr;
   ms.size_ = 0;
 }
 
 template <typename Key, typename Compare, typename Allocator>
 Multiset<Key, Compare, Allocator>::~Multiset() {
-  clear(root_);
+  release_nodes();
 }
 
 template <typename Key, typename Compare, typename Allocator>
 void Multiset<Key, Compare, Allocator>::clear(Node* node) {
-  if (node) {
-    clear(node->left);
-    clear(node->right);
-    delete node;
+  // Левый потомок поднимается поворотом, пока у узла есть левое поддерево,
+  // поэтому ни рекурсии, ни стека не нужно даже для вырожденного дерева
+  while (node) {
+    if (Node* left = node->left) {
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    } else {
+      Node* right = node->right;
+      destroy_node(node);
+      node = right;
+    }
+  }
+}
+
+// Для тривиально разрушаемых ключей пул, принадлежащий только этому
+// контейнеру, освобождается целиком без обхода дерева
+template <typename Key, typename Compare, typename Allocator>
+void Multiset<Key, Compare, Allocator>::release_nodes() {
+  if (!std::is_trivially_destructible<Key>::value ||
+      !NodeHooks::release(alloc_)) {
+    clear(root_);
+    NodeHooks::release(alloc_);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename Multiset<Key, Compare, Allocator>::Node*
+Multiset<Key, Compare, Allocator>::create_node(const Key& key) {
+  Node* node = NodeTraits::allocate(alloc_, 1);
+  try {
+    NodeTraits::construct(alloc_, node, key);
+  } catch (...) {
+    NodeTraits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void Multiset<Key, Compare, Allocator>::destroy_node(Node* node) {
+  NodeTraits::destroy(alloc_, node);
+  NodeTraits::deallocate(alloc_, node, 1);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void Multiset<Key, Compare, Allocator>::reserve(size_type count) {
+  if (count > size_) {
+    NodeHooks::reserve(alloc_, count - size_);
   }
 }
 
+template <typename Key, typename Compare, typename Allocator>
+typename Multiset<Key, Compare, Allocator>::allocator_type
+Multiset<Key, Compare, Allocator>::get_allocator() const {
+  return allocator_type(alloc_);
+}
+
 template <typename Key, typename Compare, typename Allocator>
 Multiset<Key, Compare, Allocator>& Multiset<Key, Compare, Allocator>::operator=(
     const Multiset& ms) {
   if (this != &ms) {
     clear();
+    comp_ = ms.comp_;
     for (const auto& item : ms) {
       insert(item);
     }
@@ -63,6 +131,8 @@ Multiset<Key, Compare, Allocator>& Multiset<Key, Compare, Allocator>::operator=(
     clear();
     root_ = ms.root_;
     size_ = ms.size_;
+    comp_ = ms.comp_;
+    alloc_ = std::move(ms.alloc_);
     ms.root_ = nullptr;
     ms.size_ = 0;
   }
@@ -105,12 +175,12 @@ size_t Multiset<Key, Compare, Allocator>::size() const {
 
 template <typename Key, typename Compare, typename Allocator>
 size_t Multiset<Key, Compare, Allocator>::max_size() const {
-  return std::allocator_traits<Allocator>::max_size(alloc_);
+  return NodeTraits::max_size(alloc_);
 }
 
 template <typename Key, typename Compare, typename Allocator>
 void Multiset<Key, Compare, Allocator>::clear() {
-  clear(root_);
+  release_nodes();
   root_ = nullptr;
   size_ = 0;
 }
@@ -125,7 +195,7 @@ typename Multiset<Key, Compare, Allocator>::Node*
 Multiset<Key, Compare, Allocator>::insert(Node* node, const Key& key) {
   if (!node) {
     size_++;
-    return new Node(key);
+    return create_node(key);
   }
   if (comp_(key, node->key)) {
     node->left = insert(node->left, key);
@@ -136,8 +206,9 @@ Multiset<Key, Compare, Allocator>::insert(Node* node, const Key& key) {
 }
 
 template <typename Key, typename Compare, typename Allocator>
+template <typename K>
 typename Multiset<Key, Compare, Allocator>::Node*
-Multiset<Key, Compare, Allocator>::find(Node* node, const Key& key) const {
+Multiset<Key, Compare, Allocator>::find(Node* node, const K& key) const {
   if (!node) return nullptr;
   if (comp_(key, node->key)) {
     return find(node->left, key);
@@ -164,6 +235,25 @@ bool Multiset<Key, Compare, Allocator>::contains(const Key& key) const {
   return find(root_, key) != nullptr;
 }
 
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+size_t Multiset<Key, Compare, Allocator>::count(const K& key) const {
+  return count(root_, key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename Multiset<Key, Compare, Allocator>::iterator
+Multiset<Key, Compare, Allocator>::find(const K& key) {
+  return iterator(find(root_, key));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool Multiset<Key, Compare, Allocator>::contains(const K& key) const {
+  return find(root_, key) != nullptr;
+}
+
 template <typename Key, typename Compare, typename Allocator>
 void Multiset<Key, Compare, Allocator>::erase(iterator pos) {
   if (pos != end()) {
@@ -184,11 +274,11 @@ Multiset<Key, Compare, Allocator>::erase(Node* node, const Key& key) {
   } else {
     if (!node->left) {
       Node* right_child = node->right;
-      delete node;
+      destroy_node(node);
       return right_child;
     } else if (!node->right) {
       Node* left_child = node->left;
-      delete node;
+      destroy_node(node);
       return left_child;
     } else {
       Node* min_node = find_min(node->right);
@@ -217,23 +307,67 @@ void Multiset<Key, Compare, Allocator>::swap(Multiset& other) {
   size_type temp_size = size_;
   size_ = other.size_;
   other.size_ = temp_size;
+
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
 }
 
 template <typename Key, typename Compare, typename Allocator>
 void Multiset<Key, Compare, Allocator>::merge(Multiset& other) {
-  for (auto it = other.begin(); it != other.end(); ++it) {
-    insert(*it);
+  if (this == &other || other.empty()) return;
+  if (alloc_ != other.alloc_) {
+    for (auto it = other.begin(); it != other.end(); ++it) {
+      insert(*it);
+    }
+    other.clear();
+    return;
+  }
+
+  Node* mine = flatten(root_);
+  Node* theirs = flatten(other.root_);
+  size_t count = size_ + other.size_;
+  root_ = nullptr;
+  size_ = 0;
+  other.root_ = nullptr;
+  other.size_ = 0;
+
+  Node* head = nullptr;
+  Node** tail = &head;
+  while (mine && theirs) {
+    if (comp_(theirs->key, mine->key)) {
+      *tail = theirs;
+      theirs = theirs->right;
+    } else {
+      *tail = mine;
+      mine = mine->right;
+    }
+    tail = &(*tail)->right;
   }
-  other.clear();
+  *tail = mine ? mine : theirs;
+  adopt_list(head, count);
 }
 
 template <typename Key, typename Compare, typename Allocator>
 size_t Multiset<Key, Compare, Allocator>::count(const Key& key) const {
+  return count(root_, key);
+}
+
+// Равные ключи могут оказаться в обоих поддеревьях (например, после
+// assign_sorted), поэтому спуск продолжается в обе стороны от совпадения
+template <typename Key, typename Compare, typename Allocator>
+template <typename K>
+size_t Multiset<Key, Compare, Allocator>::count(Node* node,
+                                                const K& key) const {
   size_t cnt = 0;
-  auto node = find(root_, key);
   while (node) {
-    cnt++;
-    node = find(node->right, key);
+    if (comp_(key, node->key)) {
+      node = node->left;
+    } else if (comp_(node->key, key)) {
+      node = node->right;
+    } else {
+      cnt += 1 + count(node->left, key);
+      node = node->right;
+    }
   }
   return cnt;
 }
@@ -286,6 +420,140 @@ Multiset<Key, Compare, Allocator>::upper_bound(const Key& key) const {
   return const_iterator(upper_bound(root_, key));
 }
 
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+void Multiset<Key, Compare, Allocator>::assign_sorted(ForwardIt first,
+                                                      ForwardIt last,
+                                                      bool checked) {
+  clear();
+  if (checked && !std::is_sorted(first, last, comp_)) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+    return;
+  }
+
+  size_t count = static_cast<size_t>(std::distance(first, last));
+  root_ = build_sorted(first, count);
+  size_ = count;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename RandomIt>
+void Multiset<Key, Compare, Allocator>::assign_parallel(RandomIt first,
+                                                        RandomIt last,
+                                                        ThreadPool& pool) {
+  std::vector<Key> keys(first, last);
+  parallel_sort(pool, keys.begin(), keys.end(), comp_);
+  clear();
+  root_ = build_parallel(keys.begin(), keys.size(), pool);
+  size_ = keys.size();
+}
+
+// Поддеревья не пересекаются и пишут только в свою ссылку родителя, поэтому
+// потокам не нужна синхронизация
+template <typename Key, typename Compare, typename Allocator>
+template <typename RandomIt>
+typename Multiset<Key, Compare, Allocator>::Node*
+Multiset<Key, Compare, Allocator>::build_parallel(RandomIt first, size_t count,
+                                                  ThreadPool& pool) {
+  ParallelBuild<RandomIt> build{};
+  build.split_depth = parallel_build_depth(
+      pool, count, kConcurrentAllocator<NodeAllocator>);
+
+  Node* result = nullptr;
+  try {
+    build_top(first, count, 0, &result, build);
+    pool.parallel_for(build.subtrees.size(), [this, &build](size_t i) {
+      auto& subtree = build.subtrees[i];
+      RandomIt it = subtree.first;
+      *subtree.slot = build_sorted(it, subtree.count);
+    });
+  } catch (...) {
+    clear(result);
+    throw;
+  }
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename RandomIt>
+void Multiset<Key, Compare, Allocator>::build_top(
+    RandomIt first, size_t count, size_t depth, Node** slot,
+    ParallelBuild<RandomIt>& build) {
+  if (count == 0) return;
+  if (depth == build.split_depth) {
+    build.subtrees.push_back({first, count, slot});
+    return;
+  }
+  size_t left_count = (count - 1) / 2;
+  Node* node = create_node(first[left_count]);
+  *slot = node;
+  build_top(first, left_count, depth + 1, &node->left, build);
+  build_top(first + left_count + 1, count - 1 - left_count, depth + 1,
+            &node->right, build);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+typename Multiset<Key, Compare, Allocator>::Node*
+Multiset<Key, Compare, Allocator>::build_sorted(ForwardIt& it, size_t count) {
+  if (count == 0) return nullptr;
+  size_t left_count = (count - 1) / 2;
+  Node* left = build_sorted(it, left_count);
+  Node* node = nullptr;
+  try {
+    node = create_node(*it);
+    ++it;
+    node->left = left;
+    node->right = build_sorted(it, count - 1 - left_count);
+  } catch (...) {
+    clear(node ? node : left);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename Multiset<Key, Compare, Allocator>::Node*
+Multiset<Key, Compare, Allocator>::flatten(Node* node) {
+  Node* head = nullptr;
+  Node** tail = &head;
+  while (node) {
+    if (Node* left = node->left) {
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    } else {
+      *tail = node;
+      tail = &node->right;
+      node = node->right;
+    }
+  }
+  return head;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename Multiset<Key, Compare, Allocator>::Node*
+Multiset<Key, Compare, Allocator>::build_from_list(Node*& list,
+                                                   size_t count) {
+  if (count == 0) return nullptr;
+  size_t left_count = (count - 1) / 2;
+  Node* left = build_from_list(list, left_count);
+  Node* node = list;
+  list = list->right;
+  node->left = left;
+  node->right = build_from_list(list, count - 1 - left_count);
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void Multiset<Key, Compare, Allocator>::adopt_list(Node* list,
+                                                   size_t count) {
+  root_ = build_from_list(list, count);
+  size_ = count;
+}
+
 // Методы итератора
 
 template <typename Key, typename Compare, typename Allocator>
@@ -0,0 +1,157 @@
+//
+// Пул узлов для деревьев Map, Set и Multiset.
+//
+
+#include "../../include/s21_node_pool/s21_node_pool.hpp"
+
+#include <new>
+
+namespace s21 {
+
+// NodePool
+
+inline NodePool::NodePool() noexcept
+    : slabs_(nullptr),
+      free_list_(nullptr),
+      cursor_(nullptr),
+      slab_end_(nullptr),
+      block_size_(0),
+      block_alignment_(0),
+      available_(0),
+      in_use_(0),
+      slab_count_(0),
+      next_slab_blocks_(kFirstSlabBlocks) {}
+
+inline NodePool::~NodePool() { release(); }
+
+inline bool NodePool::serves(size_type bytes, size_type alignment) noexcept {
+  if (alignment > alignof(std::max_align_t)) {
+    return false;
+  }
+  if (block_size_ == 0) {
+    block_alignment_ = alignment < alignof(FreeBlock) ? alignof(FreeBlock)
+                                                      : alignment;
+    size_type size = bytes < sizeof(FreeBlock) ? sizeof(FreeBlock) : bytes;
+    block_size_ = (size + block_alignment_ - 1) / block_alignment_ *
+                  block_alignment_;
+  }
+  return bytes <= block_size_ && block_size_ - bytes < block_alignment_ &&
+         alignment <= block_alignment_;
+}
+
+inline void* NodePool::allocate() {
+  if (free_list_) {
+    FreeBlock* block = free_list_;
+    free_list_ = block->next;
+    --available_;
+    ++in_use_;
+    return block;
+  }
+  if (cursor_ == slab_end_) {
+    addSlab(next_slab_blocks_);
+    if (next_slab_blocks_ < kMaxSlabBlocks) {
+      next_slab_blocks_ *= 2;
+    }
+  }
+  void* block = cursor_;
+  cursor_ += block_size_;
+  --available_;
+  ++in_use_;
+  return block;
+}
+
+inline void NodePool::deallocate(void* block) noexcept {
+  FreeBlock* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = free_list_;
+  free_list_ = free_block;
+  ++available_;
+  --in_use_;
+}
+
+inline void NodePool::reserve(size_type blocks) {
+  if (blocks > available_ && block_size_ != 0) {
+    // Остаток хвоста текущего слэба переносится в список свободных, чтобы
+    // новый слэб стал текущим
+    while (cursor_ != slab_end_) {
+      FreeBlock* block = reinterpret_cast<FreeBlock*>(cursor_);
+      block->next = free_list_;
+      free_list_ = block;
+      cursor_ += block_size_;
+    }
+    addSlab(blocks - available_);
+  }
+}
+
+inline void NodePool::release() noexcept {
+  while (slabs_) {
+    Slab* next = slabs_->next;
+    ::operator delete(slabs_);
+    slabs_ = next;
+  }
+  free_list_ = nullptr;
+  cursor_ = nullptr;
+  slab_end_ = nullptr;
+  available_ = 0;
+  in_use_ = 0;
+  slab_count_ = 0;
+  next_slab_blocks_ = kFirstSlabBlocks;
+}
+
+inline void NodePool::addSlab(size_type blocks) {
+  void* memory = ::operator new(sizeof(Slab) + blocks * block_size_);
+  Slab* slab = static_cast<Slab*>(memory);
+  slab->next = slabs_;
+  slabs_ = slab;
+  cursor_ = reinterpret_cast<char*>(slab + 1);
+  slab_end_ = cursor_ + blocks * block_size_;
+  available_ += blocks;
+  ++slab_count_;
+}
+
+// PoolAllocator
+
+template <typename T>
+PoolAllocator<T>::PoolAllocator() : pool_(std::make_shared<NodePool>()) {}
+
+template <typename T>
+T* PoolAllocator<T>::allocate(size_type n) {
+  if (n == 1 && sharedPool().serves(sizeof(T), alignof(T))) {
+    return static_cast<T*>(pool_->allocate());
+  }
+  return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+template <typename T>
+void PoolAllocator<T>::deallocate(T* pointer, size_type n) noexcept {
+  if (n == 1 && pool_ && pool_->serves(sizeof(T), alignof(T))) {
+    pool_->deallocate(pointer);
+  } else {
+    ::operator delete(pointer);
+  }
+}
+
+template <typename T>
+void PoolAllocator<T>::reserve(size_type n) {
+  if (sharedPool().serves(sizeof(T), alignof(T))) {
+    pool_->reserve(n);
+  }
+}
+
+template <typename T>
+bool PoolAllocator<T>::release() noexcept {
+  if (!pool_ || pool_.use_count() != 1) {
+    return false;
+  }
+  pool_->release();
+  return true;
+}
+
+template <typename T>
+NodePool& PoolAllocator<T>::sharedPool() {
+  if (!pool_) {
+    pool_ = std::make_shared<NodePool>();
+  }
+  return *pool_;
+}
+
+}  // namespace s21
@@ -0,0 +1,123 @@
+//
+// Параллельный обход и свертка деревьев.
+//
+
+#include "../../include/s21_parallel/s21_parallel.hpp"
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+namespace parallel {
+
+template <typename Node>
+void splitPart(Node* node, std::size_t depth,
+               std::vector<TreePart<Node>>& parts) {
+  if (!node) {
+    return;
+  }
+  if (depth == 0) {
+    parts.push_back({node, true});
+    return;
+  }
+  splitPart(node->left, depth - 1, parts);
+  parts.push_back({node, false});
+  splitPart(node->right, depth - 1, parts);
+}
+
+template <typename Node>
+std::vector<TreePart<Node>> splitTree(Node* root, std::size_t size,
+                                      const ThreadPool& pool) {
+  // Маленькое дерево обходится одной частью в вызывающем потоке. Иначе
+  // около четырех поддеревьев на поток выравнивают их нагрузку
+  constexpr std::size_t kMinParallel = std::size_t{1} << 14;
+  std::size_t depth = 0;
+  if (size >= kMinParallel) {
+    while ((std::size_t{1} << depth) < 4 * (pool.size() + 1)) {
+      ++depth;
+    }
+  }
+  std::vector<TreePart<Node>> parts;
+  splitPart(root, depth, parts);
+  return parts;
+}
+
+// Стек вместо рекурсии: Set и Multiset могут выродиться в длинную цепочку
+template <typename Node, typename Visit>
+void visitPart(const TreePart<Node>& part, Visit& visit) {
+  if (!part.whole) {
+    visit(part.node);
+    return;
+  }
+  std::vector<Node*> ancestors;
+  Node* node = part.node;
+  while (node || !ancestors.empty()) {
+    for (; node; node = node->left) {
+      ancestors.push_back(node);
+    }
+    node = ancestors.back();
+    ancestors.pop_back();
+    visit(node);
+    node = node->right;
+  }
+}
+
+template <typename Tree, typename Func>
+void for_each(ThreadPool& pool, Tree& tree, Func func) {
+  using Access = TreeAccess<std::remove_const_t<Tree>>;
+  using Node = typename Access::Node;
+
+  auto visit = [&func](Node* node) {
+    if constexpr (std::is_const<Tree>::value) {
+      func(std::as_const(Access::value(node)));
+    } else {
+      func(Access::value(node));
+    }
+  };
+  auto parts = splitTree(Access::root(tree), tree.size(), pool);
+  pool.parallel_for(parts.size(),
+                    [&](std::size_t i) { visitPart(parts[i], visit); });
+}
+
+template <typename Tree, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(ThreadPool& pool, const Tree& tree, T init, BinaryOp op,
+                   UnaryOp transform) {
+  using Access = TreeAccess<Tree>;
+  using Node = typename Access::Node;
+
+  auto parts = splitTree(Access::root(tree), tree.size(), pool);
+  // У части нет нейтрального элемента, поэтому ее свертка начинается с
+  // первого элемента
+  std::vector<std::optional<T>> partial(parts.size());
+  pool.parallel_for(parts.size(), [&](std::size_t i) {
+    std::optional<T>& result = partial[i];
+    auto visit = [&](Node* node) {
+      const auto& value = Access::value(node);
+      if (result) {
+        *result = op(std::move(*result), transform(value));
+      } else {
+        result.emplace(transform(value));
+      }
+    };
+    visitPart(parts[i], visit);
+  });
+
+  for (std::optional<T>& result : partial) {
+    if (result) {
+      init = op(std::move(init), std::move(*result));
+    }
+  }
+  return init;
+}
+
+template <typename Tree, typename T, typename BinaryOp>
+T reduce(ThreadPool& pool, const Tree& tree, T init, BinaryOp op) {
+  return transform_reduce(pool, tree, std::move(init), op,
+                          [](const auto& value) -> const auto& {
+                            return value;
+                          });
+}
+
+}  // namespace parallel
+}  // namespace s21
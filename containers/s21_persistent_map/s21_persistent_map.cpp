@@ -0,0 +1,310 @@
+//
+// Неизменяемый словарь с копированием пути и атомарная публикация версий.
+//
+
+#include "../../include/s21_persistent_map/s21_persistent_map.hpp"
+
+#include <cstdlib>
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+PersistentMap<Key, T, Compare>::PersistentMap(
+    std::initializer_list<value_type> const& items) {
+  for (const auto& item : items) {
+    root_ = insertNode(root_, item.first, item.second, false);
+  }
+}
+
+// Доступ к элементам
+
+template <typename Key, typename T, typename Compare>
+const T& PersistentMap<Key, T, Compare>::at(const Key& key) const {
+  const_iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+// Итераторы
+
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::const_iterator
+PersistentMap<Key, T, Compare>::begin() const {
+  const Node* node = root_.get();
+  while (node && node->left) {
+    node = node->left.get();
+  }
+  return node ? const_iterator(root_.get(), node, comp_) : end();
+}
+
+// Следующий элемент - наименьший ключ, больший текущего
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::PersistentMapIterator&
+PersistentMap<Key, T, Compare>::PersistentMapIterator::operator++() {
+  const Key& key = current_->data.first;
+  const Node* next = nullptr;
+  for (const Node* node = root_; node;) {
+    if (comp_(key, node->data.first)) {
+      next = node;
+      node = node->left.get();
+    } else {
+      node = node->right.get();
+    }
+  }
+  current_ = next;
+  return *this;
+}
+
+// Новые версии
+
+template <typename Key, typename T, typename Compare>
+PersistentMap<Key, T, Compare> PersistentMap<Key, T, Compare>::insert(
+    const value_type& value) const {
+  return insert(value.first, value.second);
+}
+
+template <typename Key, typename T, typename Compare>
+PersistentMap<Key, T, Compare> PersistentMap<Key, T, Compare>::insert(
+    const Key& key, const T& obj) const {
+  return PersistentMap(insertNode(root_, key, obj, false), comp_);
+}
+
+template <typename Key, typename T, typename Compare>
+PersistentMap<Key, T, Compare>
+PersistentMap<Key, T, Compare>::insert_or_assign(const Key& key,
+                                                 const T& obj) const {
+  return PersistentMap(insertNode(root_, key, obj, true), comp_);
+}
+
+template <typename Key, typename T, typename Compare>
+PersistentMap<Key, T, Compare> PersistentMap<Key, T, Compare>::erase(
+    const Key& key) const {
+  return PersistentMap(eraseNode(root_, key), comp_);
+}
+
+// Просмотр контейнера
+
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::const_iterator
+PersistentMap<Key, T, Compare>::find(const Key& key) const {
+  const Node* node = root_.get();
+  while (node) {
+    if (comp_(key, node->data.first)) {
+      node = node->left.get();
+    } else if (comp_(node->data.first, key)) {
+      node = node->right.get();
+    } else {
+      return const_iterator(root_.get(), node, comp_);
+    }
+  }
+  return end();
+}
+
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::const_iterator
+PersistentMap<Key, T, Compare>::lower_bound(const Key& key) const {
+  const Node* result = nullptr;
+  for (const Node* node = root_.get(); node;) {
+    if (comp_(node->data.first, key)) {
+      node = node->right.get();
+    } else {
+      result = node;
+      node = node->left.get();
+    }
+  }
+  return result ? const_iterator(root_.get(), result, comp_) : end();
+}
+
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::const_iterator
+PersistentMap<Key, T, Compare>::upper_bound(const Key& key) const {
+  const Node* result = nullptr;
+  for (const Node* node = root_.get(); node;) {
+    if (comp_(key, node->data.first)) {
+      result = node;
+      node = node->left.get();
+    } else {
+      node = node->right.get();
+    }
+  }
+  return result ? const_iterator(root_.get(), result, comp_) : end();
+}
+
+template <typename Key, typename T, typename Compare>
+bool PersistentMap<Key, T, Compare>::validateForTesting() const {
+  return validateNode(root_.get(), nullptr, nullptr);
+}
+
+// Вспомогательные методы
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+typename PersistentMap<Key, T, Compare>::NodePtr
+PersistentMap<Key, T, Compare>::makeNode(NodePtr left, NodePtr right,
+                                         Args&&... args) {
+  return std::make_shared<const Node>(std::move(left), std::move(right),
+                                      std::forward<Args>(args)...);
+}
+
+// Собирает узел с данными data над поддеревьями left и right, высоты
+// которых отличаются не больше чем на 2, и восстанавливает AVL-баланс
+// одним или двумя поворотами. Поворот здесь - не перестановка указателей,
+// а создание новых узлов, поэтому старые версии не затрагиваются
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::NodePtr
+PersistentMap<Key, T, Compare>::balance(const value_type& data, NodePtr left,
+                                        NodePtr right) {
+  int left_height = heightOf(left);
+  int right_height = heightOf(right);
+  if (left_height > right_height + 1) {
+    if (heightOf(left->left) >= heightOf(left->right)) {
+      return makeNode(left->left, makeNode(left->right, std::move(right), data),
+                      left->data);
+    }
+    const Node* middle = left->right.get();
+    return makeNode(makeNode(left->left, middle->left, left->data),
+                    makeNode(middle->right, std::move(right), data),
+                    middle->data);
+  }
+  if (right_height > left_height + 1) {
+    if (heightOf(right->right) >= heightOf(right->left)) {
+      return makeNode(makeNode(std::move(left), right->left, data),
+                      right->right, right->data);
+    }
+    const Node* middle = right->left.get();
+    return makeNode(makeNode(std::move(left), middle->left, data),
+                    makeNode(middle->right, right->right, right->data),
+                    middle->data);
+  }
+  return makeNode(std::move(left), std::move(right), data);
+}
+
+// Если дерево не изменилось, возвращается тот же узел: по этому признаку
+// вызывающий уровень понимает, что копировать путь не нужно
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::NodePtr
+PersistentMap<Key, T, Compare>::insertNode(const NodePtr& node, const Key& key,
+                                           const T& obj, bool assign) const {
+  if (!node) {
+    return makeNode(nullptr, nullptr, key, obj);
+  }
+  if (comp_(key, node->data.first)) {
+    NodePtr left = insertNode(node->left, key, obj, assign);
+    if (left == node->left) {
+      return node;
+    }
+    return balance(node->data, std::move(left), node->right);
+  }
+  if (comp_(node->data.first, key)) {
+    NodePtr right = insertNode(node->right, key, obj, assign);
+    if (right == node->right) {
+      return node;
+    }
+    return balance(node->data, node->left, std::move(right));
+  }
+  if (!assign) {
+    return node;
+  }
+  return makeNode(node->left, node->right, node->data.first, obj);
+}
+
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::NodePtr
+PersistentMap<Key, T, Compare>::eraseNode(const NodePtr& node,
+                                          const Key& key) const {
+  if (!node) {
+    return node;
+  }
+  if (comp_(key, node->data.first)) {
+    NodePtr left = eraseNode(node->left, key);
+    if (left == node->left) {
+      return node;
+    }
+    return balance(node->data, std::move(left), node->right);
+  }
+  if (comp_(node->data.first, key)) {
+    NodePtr right = eraseNode(node->right, key);
+    if (right == node->right) {
+      return node;
+    }
+    return balance(node->data, node->left, std::move(right));
+  }
+  if (!node->left) {
+    return node->right;
+  }
+  if (!node->right) {
+    return node->left;
+  }
+  // Место удаленного ключа занимает наименьший ключ правого поддерева
+  const Node* successor = node->right.get();
+  while (successor->left) {
+    successor = successor->left.get();
+  }
+  return balance(successor->data, node->left, eraseMin(node->right));
+}
+
+template <typename Key, typename T, typename Compare>
+typename PersistentMap<Key, T, Compare>::NodePtr
+PersistentMap<Key, T, Compare>::eraseMin(const NodePtr& node) {
+  if (!node->left) {
+    return node->right;
+  }
+  return balance(node->data, eraseMin(node->left), node->right);
+}
+
+template <typename Key, typename T, typename Compare>
+bool PersistentMap<Key, T, Compare>::validateNode(const Node* node,
+                                                  const Key* low,
+                                                  const Key* high) const {
+  if (!node) {
+    return true;
+  }
+  const Key& key = node->data.first;
+  if ((low && !comp_(*low, key)) || (high && !comp_(key, *high))) {
+    return false;
+  }
+  int left_height = heightOf(node->left);
+  int right_height = heightOf(node->right);
+  return std::abs(left_height - right_height) <= 1 &&
+         node->height == 1 + std::max(left_height, right_height) &&
+         node->size == 1 + sizeOf(node->left) + sizeOf(node->right) &&
+         validateNode(node->left.get(), low, &key) &&
+         validateNode(node->right.get(), &key, high);
+}
+
+// Атомарная публикация. Свободные функции std::atomic_* для shared_ptr
+// (C++11) меняют корень целиком, счетчик ссылок остается согласованным
+
+template <typename Key, typename T, typename Compare>
+typename AtomicPersistentMap<Key, T, Compare>::map_type
+AtomicPersistentMap<Key, T, Compare>::load() const {
+  return map_type(std::atomic_load(&root_), comp_);
+}
+
+template <typename Key, typename T, typename Compare>
+void AtomicPersistentMap<Key, T, Compare>::store(const map_type& map) {
+  std::atomic_store(&root_, map.root_);
+}
+
+template <typename Key, typename T, typename Compare>
+bool AtomicPersistentMap<Key, T, Compare>::compare_exchange(
+    map_type& expected, const map_type& desired) {
+  return std::atomic_compare_exchange_strong(&root_, &expected.root_,
+                                             desired.root_);
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename Func>
+typename AtomicPersistentMap<Key, T, Compare>::map_type
+AtomicPersistentMap<Key, T, Compare>::update(Func&& func) {
+  map_type current = load();
+  map_type next = func(current);
+  while (!compare_exchange(current, next)) {
+    next = func(current);
+  }
+  return next;
+}
+
+}  // namespace s21
@@ -4,215 +4,571 @@
 
 #include "../../include/s21_set/s21_set.hpp"
 
-#include <functional>
-#include <stack>
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 namespace s21 {
 
-template <typename Key>
-typename Set<Key>::Node* Set<Key>::copyTree(Node* other) {
+// SetNode
+
+template <typename Key, typename NodePolicy>
+SetNode<Key, NodePolicy>* SetNode<Key, NodePolicy>::min(SetNode* node) {
+  while (node && node->left) {
+    node = node->left;
+  }
+  return node;
+}
+
+template <typename Key, typename NodePolicy>
+SetNode<Key, NodePolicy>* SetNode<Key, NodePolicy>::max(SetNode* node) {
+  while (node && node->right) {
+    node = node->right;
+  }
+  return node;
+}
+
+template <typename Key, typename NodePolicy>
+SetNode<Key, NodePolicy>* SetNode<Key, NodePolicy>::next(SetNode* node) {
+  if (node->right) {
+    return min(node->right);
+  }
+  SetNode* parent = node->parent;
+  while (parent && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename Key, typename NodePolicy>
+SetNode<Key, NodePolicy>* SetNode<Key, NodePolicy>::prev(SetNode* node) {
+  if (node->left) {
+    return max(node->left);
+  }
+  SetNode* parent = node->parent;
+  while (parent && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+// Прямой обход без стека: спуск идет к еще не скопированному потомку, а
+// подъем - по ссылкам на родителя в обоих деревьях. NodePolicy
+// пересчитывается при подъеме, когда оба поддерева узла уже скопированы
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::copyTree(Node* other,
+                                                   Node* parent) {
   if (!other) return nullptr;
-  Node* newNode = new Node(other->key);
-  newNode->left = copyTree(other->left);
-  newNode->right = copyTree(other->right);
-  return newNode;
+  Node* result = createNode(other->key);
+  result->parent = parent;
+  Node* source = other;
+  Node* copy = result;
+  try {
+    while (true) {
+      if (source->left && !copy->left) {
+        source = source->left;
+        copy->left = createNode(source->key);
+        copy->left->parent = copy;
+        copy = copy->left;
+      } else if (source->right && !copy->right) {
+        source = source->right;
+        copy->right = createNode(source->key);
+        copy->right->parent = copy;
+        copy = copy->right;
+      } else {
+        if constexpr (!std::is_empty<typename NodePolicy::NodeBase>::value) {
+          NodePolicy::update(copy);
+        }
+        if (source == other) break;
+        source = source->parent;
+        copy = copy->parent;
+      }
+    }
+  } catch (...) {
+    deleteTree(result);
+    throw;
+  }
+  return result;
 }
 
-template <typename Key>
-void Set<Key>::deleteTree(Node* node) {
-  if (!node) return;
-  deleteTree(node->left);
-  deleteTree(node->right);
-  delete node;
+// Левый потомок поворотом поднимается на место node, пока у node не
+// останется левого поддерева; тогда node удаляется и обход идет вправо.
+// Каждый поворот навсегда уменьшает левую ветвь, поэтому удаление линейно
+// и не требует ни рекурсии, ни стека
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::deleteTree(Node* node) {
+  while (node) {
+    if (Node* left = node->left) {
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    } else {
+      Node* right = node->right;
+      destroyNode(node);
+      node = right;
+    }
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Set<Key, Compare, Allocator, NodePolicy>::Node*, bool>
+Set<Key, Compare, Allocator, NodePolicy>::insertNode(const Key& key) {
+  Node* parent = nullptr;
+  Node** slot = &root;
+  while (*slot) {
+    parent = *slot;
+    if (comp_(key, parent->key)) {
+      slot = &parent->left;
+    } else if (comp_(parent->key, key)) {
+      slot = &parent->right;
+    } else {
+      return {parent, false};
+    }
+  }
+  Node* node = createNode(key);
+  node->parent = parent;
+  *slot = node;
+  updatePath(parent);
+  filterInsert(key);
+  return {node, true};
 }
 
-template <typename Key>
-std::pair<typename Set<Key>::Node*, bool> Set<Key>::insertNode(Node*& node,
-                                                               const Key& key) {
-  if (!node) {
-    node = new Node(key);
-    return {node, true};
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::linkNode(Node* parent,
+                                                   bool as_left,
+                                                   const Key& key) {
+  Node* node = createNode(key);
+  node->parent = parent;
+  if (as_left) {
+    parent->left = node;
+  } else {
+    parent->right = node;
+    if (parent == rightmost_) {
+      rightmost_ = node;
+    }
+  }
+  ++tree_size;
+  updatePath(parent);
+  filterInsert(key);
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::transplant(
+    Node* target, Node* replacement) {
+  if (!target->parent) {
+    root = replacement;
+  } else if (target == target->parent->left) {
+    target->parent->left = replacement;
+  } else {
+    target->parent->right = replacement;
   }
-  if (key < node->key) {
-    return insertNode(node->left, key);
-  } else if (key > node->key) {
-    return insertNode(node->right, key);
+  if (replacement) {
+    replacement->parent = target->parent;
   }
-  return {node, false};
 }
 
-template <typename Key>
-typename Set<Key>::Node* Set<Key>::findNode(Node* node, const Key& key) const {
-  if (!node || node->key == key) return node;
-  if (key < node->key) return findNode(node->left, key);
-  return findNode(node->right, key);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::updatePath(Node* node) {
+  if constexpr (!std::is_empty<typename NodePolicy::NodeBase>::value) {
+    for (; node; node = node->parent) {
+      NodePolicy::update(node);
+    }
+  } else {
+    static_cast<void>(node);
+  }
 }
 
-template <typename Key>
-void Set<Key>::inorder(Node* node, std::function<void(Node*)> func) const {
-  if (!node) return;
-  inorder(node->left, func);
-  func(node);
-  inorder(node->right, func);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::findMax(Node* node) const {
+  return Node::max(node);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::findNode(Node* node,
+                                                   const K& key) const {
+  while (node) {
+    if (comp_(key, node->key)) {
+      node = node->left;
+    } else if (comp_(node->key, key)) {
+      node = node->right;
+    } else {
+      break;
+    }
+  }
+  return node;
 }
 
 // Конструкторы
 
-template <typename Key>
-Set<Key>::Set() : root(nullptr), tree_size(0) {}
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>::Set()
+    : root(nullptr), tree_size(0), rightmost_(nullptr), comp_(), alloc_() {}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>::Set(const Compare& comp,
+                                              const Allocator& alloc)
+    : root(nullptr),
+      tree_size(0),
+      rightmost_(nullptr),
+      comp_(comp),
+      alloc_(alloc) {}
 
-template <typename Key>
-Set<Key>::Set(std::initializer_list<value_type> const& items) : Set() {
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>::Set(
+    std::initializer_list<value_type> const& items)
+    : Set() {
   for (const auto& item : items) {
     insert(item);
   }
 }
 
-template <typename Key>
-Set<Key>::Set(const Set& s) : root(copyTree(s.root)), tree_size(s.tree_size) {}
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>::Set(const Set& s)
+    : root(nullptr),
+      tree_size(s.tree_size),
+      rightmost_(nullptr),
+      comp_(s.comp_),
+      alloc_(NodeTraits::select_on_container_copy_construction(s.alloc_)),
+      filter_(s.filter_ ? std::make_unique<Filter>(*s.filter_) : nullptr) {
+  root = copyTree(s.root, nullptr);
+  rightmost_ = findMax(root);
+}
 
-template <typename Key>
-Set<Key>::Set(Set&& s) noexcept : root(s.root), tree_size(s.tree_size) {
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>::Set(Set&& s) noexcept
+    : root(s.root),
+      tree_size(s.tree_size),
+      rightmost_(s.rightmost_),
+      comp_(s.comp_),
+      alloc_(std::move(s.alloc_)),
+      filter_(std::move(s.filter_)) {
   s.root = nullptr;
   s.tree_size = 0;
+  s.rightmost_ = nullptr;
 }
 
-template <typename Key>
-Set<Key>::~Set() {
-  deleteTree(root);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>::~Set() {
+  releaseNodes();
 }
 
 // Операторы присваивания
-template <typename Key>
-Set<Key>& Set<Key>::operator=(const Set& s) {
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>&
+Set<Key, Compare, Allocator, NodePolicy>::operator=(const Set& s) {
   if (this == &s) return *this;
-  deleteTree(root);
-  root = copyTree(s.root);
+  clear();
+  root = copyTree(s.root, nullptr);
   tree_size = s.tree_size;
+  rightmost_ = findMax(root);
+  comp_ = s.comp_;
+  filter_ = s.filter_ ? std::make_unique<Filter>(*s.filter_) : nullptr;
   return *this;
 }
 
-template <typename Key>
-Set<Key>& Set<Key>::operator=(Set&& s) noexcept {
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+Set<Key, Compare, Allocator, NodePolicy>&
+Set<Key, Compare, Allocator, NodePolicy>::operator=(Set&& s) noexcept {
   if (this == &s) return *this;
-  deleteTree(root);
+  clear();
   root = s.root;
   tree_size = s.tree_size;
+  rightmost_ = s.rightmost_;
+  comp_ = s.comp_;
+  alloc_ = std::move(s.alloc_);
+  filter_ = std::move(s.filter_);
   s.root = nullptr;
   s.tree_size = 0;
+  s.rightmost_ = nullptr;
   return *this;
 }
 
 // Итераторы
 
-template <typename Key>
-typename Set<Key>::iterator Set<Key>::begin() {
-  return iterator(root);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::begin() {
+  return iterator(Node::min(root), &root);
 }
 
-template <typename Key>
-typename Set<Key>::iterator Set<Key>::end() {
-  return iterator();
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::end() {
+  return iterator(nullptr, &root);
 }
 
-template <typename Key>
-typename Set<Key>::const_iterator Set<Key>::begin() const {
-  return const_iterator(root);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator
+Set<Key, Compare, Allocator, NodePolicy>::begin() const {
+  return const_iterator(Node::min(root), &root);
 }
 
-template <typename Key>
-typename Set<Key>::const_iterator Set<Key>::end() const {
-  return const_iterator();
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator
+Set<Key, Compare, Allocator, NodePolicy>::end() const {
+  return const_iterator(nullptr, &root);
 }
 
 // Вместимость
 
-template <typename Key>
-bool Set<Key>::empty() const {
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+bool Set<Key, Compare, Allocator, NodePolicy>::empty() const {
   return tree_size == 0;
 }
 
-template <typename Key>
-typename Set<Key>::size_type Set<Key>::size() const {
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::size_type
+Set<Key, Compare, Allocator, NodePolicy>::size() const {
   return tree_size;
 }
 
-template <typename Key>
-typename Set<Key>::size_type Set<Key>::max_size() const {
-  return ~(static_cast<size_type>(0));
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::size_type
+Set<Key, Compare, Allocator, NodePolicy>::max_size() const {
+  return NodeTraits::max_size(alloc_);
 }
 
-template <typename Key>
-typename Set<Key>::Node* SetIterator<Key>::get_current() const {
+template <typename Key, typename NodePolicy>
+typename SetIterator<Key, NodePolicy>::Node*
+SetIterator<Key, NodePolicy>::get_current() const {
   return current;
 }
 
-template <typename Key>
-const typename Set<Key>::Node* SetConstIterator<Key>::get_current() const {
+template <typename Key, typename NodePolicy>
+const typename SetConstIterator<Key, NodePolicy>::Node*
+SetConstIterator<Key, NodePolicy>::get_current() const {
   return current;
 }
 
 // Модификаторы
 
-template <typename Key>
-void Set<Key>::clear() {
-  deleteTree(root);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::clear() {
+  releaseNodes();
   root = nullptr;
   tree_size = 0;
+  rightmost_ = nullptr;
+  rebuildFilter();
 }
 
-template <typename Key>
-std::pair<typename Set<Key>::iterator, bool> Set<Key>::insert(
-    const value_type& value) {
-  auto result = insertNode(root, value);
-  if (result.second) ++tree_size;
-  return {iterator(result.first), result.second};
+// Для тривиально разрушаемых ключей пул, принадлежащий только этому
+// контейнеру, освобождается целиком без обхода дерева
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::releaseNodes() {
+  if (!std::is_trivially_destructible<Key>::value ||
+      !NodeHooks::release(alloc_)) {
+    deleteTree(root);
+    NodeHooks::release(alloc_);
+  }
 }
 
-template <typename Key>
-void Set<Key>::erase(iterator pos) {
-  Node* node = pos.get_current();
-  if (!node) return;
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::reserve(size_type count) {
+  if (count > tree_size) {
+    NodeHooks::reserve(alloc_, count - tree_size);
+  }
+}
 
-  // Лямбда-функция :)
-  std::function<Node*(Node*, Node*)> eraseNode =
-      [&](Node* root, Node* nodeToDelete) -> Node* {
-    if (!root) return root;
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::allocator_type
+Set<Key, Compare, Allocator, NodePolicy>::get_allocator() const {
+  return allocator_type(alloc_);
+}
 
-    if (nodeToDelete->key < root->key) {
-      root->left = eraseNode(root->left, nodeToDelete);
-    } else if (nodeToDelete->key > root->key) {
-      root->right = eraseNode(root->right, nodeToDelete);
-    } else {
-      if (!root->left) {
-        Node* temp = root->right;
-        delete root;
-        return temp;
-      } else if (!root->right) {
-        Node* temp = root->left;
-        delete root;
-        return temp;
-      }
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::createNode(const Key& key) {
+  Node* node = NodeTraits::allocate(alloc_, 1);
+  try {
+    NodeTraits::construct(alloc_, node, key);
+  } catch (...) {
+    NodeTraits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
 
-      Node* temp = root->right;
-      while (temp && temp->left != nullptr) {
-        temp = temp->left;
-      }
-      if (temp) {
-        root->key = temp->key;
-        root->right = eraseNode(root->right, temp);
-      }
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::destroyNode(Node* node) {
+  NodeTraits::destroy(alloc_, node);
+  NodeTraits::deallocate(alloc_, node, 1);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Set<Key, Compare, Allocator, NodePolicy>::iterator, bool>
+Set<Key, Compare, Allocator, NodePolicy>::insert(const value_type& value) {
+  if (rightmost_ && comp_(rightmost_->key, value)) {
+    return {iterator(linkNode(rightmost_, false, value), &root), true};
+  }
+  auto result = insertNode(value);
+  if (result.second) {
+    ++tree_size;
+    if (!rightmost_) rightmost_ = result.first;
+  }
+  return {iterator(result.first, &root), result.second};
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::insert(iterator hint,
+                                                 const value_type& value) {
+  Node* parent = nullptr;
+  bool as_left = false;
+  Node* existing =
+      findHintPosition(hint.get_current(), value, parent, as_left);
+  if (existing) {
+    return iterator(existing, &root);
+  }
+  if (parent) {
+    return iterator(linkNode(parent, as_left, value), &root);
+  }
+  return insert(value).first;
+}
+
+// Если у hint есть левое поддерево, предшественник - его наибольший узел и
+// правого потомка у него нет; так же следующий узел при правом поддереве
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::findHintPosition(
+    Node* hint, const Key& key, Node*& parent, bool& as_left) const {
+  if (!hint) {
+    return nullptr;
+  }
+  if (comp_(key, hint->key)) {
+    Node* before = Node::prev(hint);
+    if (!before || comp_(before->key, key)) {
+      as_left = !hint->left;
+      parent = as_left ? hint : before;
     }
-    return root;
-  };
+  } else if (comp_(hint->key, key)) {
+    // От наибольшего узла Node::next поднялся бы до корня
+    Node* after = hint == rightmost_ ? nullptr : Node::next(hint);
+    if (!after || comp_(key, after->key)) {
+      as_left = hint->right != nullptr;
+      parent = as_left ? after : hint;
+    }
+  } else {
+    return hint;
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename... Args>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::emplace_hint(iterator hint,
+                                                       Args&&... args) {
+  return insert(std::move(hint), Key(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::erase(iterator pos) {
+  Node* node = pos.get_current();
+  if (!node) return;
+  if (node == rightmost_) {
+    rightmost_ = Node::prev(node);
+  }
 
-  eraseNode(root, node);
+  // Узел с двумя потомками заменяется преемником: тот вынимается со своего
+  // места и встает на место node. Узлы не копируют ключи, поэтому
+  // итераторы на остальные элементы остаются действительными
+  Node* changed = node->parent;  // нижний узел, чье поддерево изменилось
+  if (!node->left) {
+    transplant(node, node->right);
+  } else if (!node->right) {
+    transplant(node, node->left);
+  } else {
+    Node* successor = Node::min(node->right);
+    if (successor->parent != node) {
+      changed = successor->parent;
+      transplant(successor, successor->right);
+      successor->right = node->right;
+      successor->right->parent = successor;
+    } else {
+      changed = successor;
+    }
+    transplant(node, successor);
+    successor->left = node->left;
+    successor->left->parent = successor;
+  }
+  destroyNode(node);
   --tree_size;
+  updatePath(changed);
+  filterErase();
 }
 
-template <typename Key>
-void Set<Key>::swap(Set& other) {
+// Полный диапазон освобождается через clear, который не перестраивает
+// ссылки после каждого узла
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::erase(iterator first,
+                                                iterator last) {
+  if (first == begin() && last == end()) {
+    clear();
+    return end();
+  }
+  while (first != last) {
+    erase(first++);
+  }
+  return last;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::size_type
+Set<Key, Compare, Allocator, NodePolicy>::erase(const key_type& key) {
+  Node* node = findNode(root, key);
+  if (!node) return 0;
+  erase(iterator(node, &root));
+  return 1;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::swap(Set& other) {
   Node* tempRoot = root;
   root = other.root;
   other.root = tempRoot;
@@ -220,160 +576,643 @@ void Set<Key>::swap(Set& other) {
   size_type tempSize = tree_size;
   tree_size = other.tree_size;
   other.tree_size = tempSize;
+
+  std::swap(rightmost_, other.rightmost_);
+
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(filter_, other.filter_);
 }
 
-template <typename Key>
-void Set<Key>::merge(Set& other) {
-  for (iterator it = other.begin(); it != other.end(); ++it) {
-    insert(*it);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::merge(Set& other) {
+  if (this == &other || other.empty()) return;
+  if (alloc_ != other.alloc_) {
+    for (iterator it = other.begin(); it != other.end(); ++it) {
+      insert(*it);
+    }
+    other.clear();
+    return;
+  }
+
+  // Обе цепочки сливаются, как в сортировке слиянием; повторы из other
+  // уничтожаются, а дерево строится заново из получившейся цепочки
+  Node* mine = flatten(root);
+  Node* theirs = flatten(other.root);
+  size_t count = tree_size + other.tree_size;
+  root = nullptr;
+  tree_size = 0;
+  other.root = nullptr;
+  other.tree_size = 0;
+  other.rightmost_ = nullptr;
+
+  Node* head = nullptr;
+  Node** tail = &head;
+  while (mine && theirs) {
+    if (comp_(theirs->key, mine->key)) {
+      *tail = theirs;
+      theirs = theirs->right;
+    } else {
+      if (!comp_(mine->key, theirs->key)) {
+        Node* duplicate = theirs;
+        theirs = theirs->right;
+        destroyNode(duplicate);
+        --count;
+      }
+      *tail = mine;
+      mine = mine->right;
+    }
+    tail = &(*tail)->right;
   }
-  other.clear();
+  *tail = mine ? mine : theirs;
+  adoptList(head, count);
 }
 
 // Просмотр контейнера
 
-template <typename Key>
-typename Set<Key>::iterator Set<Key>::find(const key_type& key) {
-  return iterator(findNode(root, key));
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::find(const key_type& key) {
+  return iterator(filteredFind(key), &root);
 }
 
-template <typename Key>
-bool Set<Key>::contains(const key_type& key) const {
-  return findNode(root, key) != nullptr;
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K, typename C, typename>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::find(const K& key) {
+  return iterator(findNode(root, key), &root);
 }
 
-// SetIterator
-
-template <typename Key>
-void SetIterator<Key>::pushLeft(Node* node) {
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::findBound(const K& key,
+                                                    bool upper) const {
+  Node* bound = nullptr;
+  Node* node = root;
   while (node) {
-    ancestors.push(node);
-    node = node->left;
+    bool goes_left = upper ? comp_(key, node->key) : !comp_(node->key, key);
+    if (goes_left) {
+      bound = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
   }
+  return bound;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::lower_bound(const Key& key) {
+  return iterator(findBound(key, false), &root);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator
+Set<Key, Compare, Allocator, NodePolicy>::lower_bound(const Key& key) const {
+  return const_iterator(findBound(key, false), &root);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::upper_bound(const Key& key) {
+  return iterator(findBound(key, true), &root);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator
+Set<Key, Compare, Allocator, NodePolicy>::upper_bound(const Key& key) const {
+  return const_iterator(findBound(key, true), &root);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Set<Key, Compare, Allocator, NodePolicy>::iterator,
+          typename Set<Key, Compare, Allocator, NodePolicy>::iterator>
+Set<Key, Compare, Allocator, NodePolicy>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
 }
 
-template <typename Key>
-SetIterator<Key>::SetIterator() : current(nullptr) {}
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+std::pair<typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator,
+          typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator>
+Set<Key, Compare, Allocator, NodePolicy>::equal_range(const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
 
-template <typename Key>
-SetIterator<Key>::SetIterator(Node* root) : current(nullptr) {
-  pushLeft(root);
-  if (!ancestors.empty()) {
-    current = ancestors.top();
-    ancestors.pop();
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+IteratorRange<typename Set<Key, Compare, Allocator, NodePolicy>::iterator>
+Set<Key, Compare, Allocator, NodePolicy>::range(const Key& lo, const Key& hi) {
+  if (!comp_(lo, hi)) {
+    return {end(), end()};
   }
+  return {lower_bound(lo), lower_bound(hi)};
 }
 
-template <typename Key>
-SetIterator<Key>& SetIterator<Key>::operator++() {
-  if (current->right) {
-    pushLeft(current->right);
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+IteratorRange<typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator>
+Set<Key, Compare, Allocator, NodePolicy>::range(const Key& lo,
+                                                const Key& hi) const {
+  if (!comp_(lo, hi)) {
+    return {end(), end()};
   }
-  if (!ancestors.empty()) {
-    current = ancestors.top();
-    ancestors.pop();
-  } else {
-    current = nullptr;
+  return {lower_bound(lo), lower_bound(hi)};
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::findByIndex(size_t index) const {
+  static_assert(NodePolicy::kOrderStatistics,
+                "select() requires the OrderStatistics node policy");
+  Node* node = index < tree_size ? root : nullptr;
+  while (node) {
+    size_t left_size = NodePolicy::size(node->left);
+    if (index > left_size) {
+      index -= left_size + 1;
+      node = node->right;
+    } else if (index < left_size) {
+      node = node->left;
+    } else {
+      break;
+    }
   }
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::size_type
+Set<Key, Compare, Allocator, NodePolicy>::rank(const Key& key) const {
+  static_assert(NodePolicy::kOrderStatistics,
+                "rank() requires the OrderStatistics node policy");
+  size_type result = 0;
+  Node* node = root;
+  while (node) {
+    if (comp_(node->key, key)) {
+      result += NodePolicy::size(node->left) + 1;
+      node = node->right;
+    } else {
+      node = node->left;
+    }
+  }
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::iterator
+Set<Key, Compare, Allocator, NodePolicy>::select(size_type index) {
+  return iterator(findByIndex(index), &root);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::const_iterator
+Set<Key, Compare, Allocator, NodePolicy>::select(size_type index) const {
+  return const_iterator(findByIndex(index), &root);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::size_type
+Set<Key, Compare, Allocator, NodePolicy>::count_range(
+    const Key& lo, const Key& hi) const {
+  return comp_(lo, hi) ? rank(hi) - rank(lo) : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+bool Set<Key, Compare, Allocator, NodePolicy>::contains(
+    const key_type& key) const {
+  return filteredFind(key) != nullptr;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename K, typename C, typename>
+bool Set<Key, Compare, Allocator, NodePolicy>::contains(const K& key) const {
+  return findNode(root, key) != nullptr;
+}
+
+// SetIterator
+
+template <typename Key, typename NodePolicy>
+SetIterator<Key, NodePolicy>::SetIterator() : current(nullptr), root(nullptr) {}
+
+template <typename Key, typename NodePolicy>
+SetIterator<Key, NodePolicy>::SetIterator(Node* node, Node* const* root)
+    : current(node), root(root) {}
+
+template <typename Key, typename NodePolicy>
+SetIterator<Key, NodePolicy>& SetIterator<Key, NodePolicy>::operator++() {
+  current = Node::next(current);
   return *this;
 }
 
-template <typename Key>
-SetIterator<Key> SetIterator<Key>::operator++(int) {
+template <typename Key, typename NodePolicy>
+SetIterator<Key, NodePolicy> SetIterator<Key, NodePolicy>::operator++(int) {
   SetIterator temp = *this;
   ++(*this);
   return temp;
 }
 
-template <typename Key>
-Key& SetIterator<Key>::operator*() {
+template <typename Key, typename NodePolicy>
+SetIterator<Key, NodePolicy>& SetIterator<Key, NodePolicy>::operator--() {
+  current = current ? Node::prev(current) : Node::max(*root);
+  return *this;
+}
+
+template <typename Key, typename NodePolicy>
+SetIterator<Key, NodePolicy> SetIterator<Key, NodePolicy>::operator--(int) {
+  SetIterator temp = *this;
+  --(*this);
+  return temp;
+}
+
+template <typename Key, typename NodePolicy>
+Key& SetIterator<Key, NodePolicy>::operator*() const {
   return current->key;
 }
 
-template <typename Key>
-Key* SetIterator<Key>::operator->() {
+template <typename Key, typename NodePolicy>
+Key* SetIterator<Key, NodePolicy>::operator->() const {
   return &(current->key);
 }
 
-template <typename Key>
-bool SetIterator<Key>::operator==(const SetIterator& other) const {
+template <typename Key, typename NodePolicy>
+bool SetIterator<Key, NodePolicy>::operator==(const SetIterator& other) const {
   return current == other.current;
 }
 
-template <typename Key>
-bool SetIterator<Key>::operator!=(const SetIterator& other) const {
+template <typename Key, typename NodePolicy>
+bool SetIterator<Key, NodePolicy>::operator!=(const SetIterator& other) const {
   return current != other.current;
 }
 
 // SetConstIterator
-template <typename Key>
-void SetConstIterator<Key>::pushLeft(const Node* node) {
-  while (node) {
-    ancestors.push(node);
-    node = node->left;
-  }
-}
 
-template <typename Key>
-SetConstIterator<Key>::SetConstIterator() : current(nullptr) {}
+template <typename Key, typename NodePolicy>
+SetConstIterator<Key, NodePolicy>::SetConstIterator()
+    : current(nullptr), root(nullptr) {}
 
-template <typename Key>
-SetConstIterator<Key>::SetConstIterator(const Node* root) : current(nullptr) {
-  pushLeft(root);
-  if (!ancestors.empty()) {
-    current = ancestors.top();
-    ancestors.pop();
-  }
-}
+template <typename Key, typename NodePolicy>
+SetConstIterator<Key, NodePolicy>::SetConstIterator(Node* node,
+                                                    Node* const* root)
+    : current(node), root(root) {}
 
-template <typename Key>
-SetConstIterator<Key>& SetConstIterator<Key>::operator++() {
-  if (current->right) {
-    pushLeft(current->right);
-  }
-  if (!ancestors.empty()) {
-    current = ancestors.top();
-    ancestors.pop();
-  } else {
-    current = nullptr;
-  }
+template <typename Key, typename NodePolicy>
+SetConstIterator<Key, NodePolicy>::SetConstIterator(
+    const SetIterator<Key, NodePolicy>& other)
+    : current(other.current), root(other.root) {}
+
+template <typename Key, typename NodePolicy>
+SetConstIterator<Key, NodePolicy>&
+SetConstIterator<Key, NodePolicy>::operator++() {
+  current = Node::next(current);
   return *this;
 }
 
-template <typename Key>
-SetConstIterator<Key> SetConstIterator<Key>::operator++(int) {
+template <typename Key, typename NodePolicy>
+SetConstIterator<Key, NodePolicy>
+SetConstIterator<Key, NodePolicy>::operator++(int) {
   SetConstIterator temp = *this;
   ++(*this);
   return temp;
 }
 
-template <typename Key>
-const Key& SetConstIterator<Key>::operator*() const {
+template <typename Key, typename NodePolicy>
+SetConstIterator<Key, NodePolicy>&
+SetConstIterator<Key, NodePolicy>::operator--() {
+  current = current ? Node::prev(current) : Node::max(*root);
+  return *this;
+}
+
+template <typename Key, typename NodePolicy>
+SetConstIterator<Key, NodePolicy>
+SetConstIterator<Key, NodePolicy>::operator--(int) {
+  SetConstIterator temp = *this;
+  --(*this);
+  return temp;
+}
+
+template <typename Key, typename NodePolicy>
+const Key& SetConstIterator<Key, NodePolicy>::operator*() const {
   return current->key;
 }
 
-template <typename Key>
-const Key* SetConstIterator<Key>::operator->() const {
+template <typename Key, typename NodePolicy>
+const Key* SetConstIterator<Key, NodePolicy>::operator->() const {
   return &(current->key);
 }
 
-template <typename Key>
-bool SetConstIterator<Key>::operator==(const SetConstIterator& other) const {
+template <typename Key, typename NodePolicy>
+bool SetConstIterator<Key, NodePolicy>::operator==(
+    const SetConstIterator& other) const {
   return current == other.current;
 }
 
-template <typename Key>
-bool SetConstIterator<Key>::operator!=(const SetConstIterator& other) const {
+template <typename Key, typename NodePolicy>
+bool SetConstIterator<Key, NodePolicy>::operator!=(
+    const SetConstIterator& other) const {
   return current != other.current;
 }
 
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
 template <typename... Args>
-Vector<std::pair<typename Set<Key>::iterator, bool>> Set<Key>::insert_many(
-    Args&&... args) {
+Vector<std::pair<
+    typename Set<Key, Compare, Allocator, NodePolicy>::iterator, bool>>
+Set<Key, Compare, Allocator, NodePolicy>::insert_many(Args&&... args) {
   Vector<std::pair<iterator, bool>> results;
   (results.push_back(insert(std::forward<Args>(args))), ...);
   return results;
 }
 
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename ForwardIt>
+void Set<Key, Compare, Allocator, NodePolicy>::assign_sorted(ForwardIt first,
+                                                             ForwardIt last,
+                                                             bool checked) {
+  clear();
+  if (checked) {
+    for (ForwardIt prev = first, it = first; it != last; prev = it) {
+      if (++it != last && !comp_(*prev, *it)) {
+        for (; first != last; ++first) {
+          insert(*first);
+        }
+        return;
+      }
+    }
+  }
+
+  size_t count = static_cast<size_t>(std::distance(first, last));
+  root = buildSorted(first, count);
+  tree_size = count;
+  rightmost_ = findMax(root);
+  rebuildFilter();
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename RandomIt>
+void Set<Key, Compare, Allocator, NodePolicy>::assign_parallel(
+    RandomIt first, RandomIt last, ThreadPool& pool) {
+  std::vector<Key> keys(first, last);
+  parallel_sort(pool, keys.begin(), keys.end(), comp_);
+  keys.erase(std::unique(keys.begin(), keys.end(),
+                         [this](const Key& a, const Key& b) {
+                           return !comp_(a, b);
+                         }),
+             keys.end());
+
+  clear();
+  root = buildParallel(keys.begin(), keys.size(), pool);
+  tree_size = keys.size();
+  rightmost_ = findMax(root);
+  rebuildFilter();
+}
+
+// Поддеревья не пересекаются и пишут только в свою ссылку родителя;
+// NodePolicy верхних узлов пересчитывается, когда все поддеревья готовы
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename RandomIt>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::buildParallel(RandomIt first,
+                                                        size_t count,
+                                                        ThreadPool& pool) {
+  ParallelBuild<RandomIt> build{};
+  build.split_depth = parallel_build_depth(
+      pool, count, kConcurrentAllocator<NodeAllocator>);
+
+  Node* result = nullptr;
+  try {
+    buildTop(first, count, 0, nullptr, &result, build);
+    pool.parallel_for(build.subtrees.size(), [this, &build](size_t i) {
+      auto& subtree = build.subtrees[i];
+      RandomIt it = subtree.first;
+      Node* node = buildSorted(it, subtree.count);
+      node->parent = subtree.parent;
+      *subtree.slot = node;
+    });
+  } catch (...) {
+    deleteTree(result);
+    throw;
+  }
+  for (Node* node : build.top) {
+    NodePolicy::update(node);
+  }
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename RandomIt>
+void Set<Key, Compare, Allocator, NodePolicy>::buildTop(
+    RandomIt first, size_t count, size_t depth, Node* parent, Node** slot,
+    ParallelBuild<RandomIt>& build) {
+  if (count == 0) return;
+  if (depth == build.split_depth) {
+    build.subtrees.push_back({first, count, parent, slot});
+    return;
+  }
+  size_t left_count = (count - 1) / 2;
+  Node* node = createNode(first[left_count]);
+  node->parent = parent;
+  *slot = node;
+  buildTop(first, left_count, depth + 1, node, &node->left, build);
+  buildTop(first + left_count + 1, count - 1 - left_count, depth + 1, node,
+           &node->right, build);
+  build.top.push_back(node);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+template <typename ForwardIt>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::buildSorted(ForwardIt& it,
+                                                      size_t count) {
+  if (count == 0) return nullptr;
+  size_t left_count = (count - 1) / 2;
+  Node* left = buildSorted(it, left_count);
+  Node* node = nullptr;
+  try {
+    node = createNode(*it);
+    ++it;
+    node->left = left;
+    if (left) left->parent = node;
+    node->right = buildSorted(it, count - 1 - left_count);
+    if (node->right) node->right->parent = node;
+  } catch (...) {
+    if (node) {
+      deleteTree(node);
+    } else {
+      deleteTree(left);
+    }
+    throw;
+  }
+  NodePolicy::update(node);
+  return node;
+}
+
+// Фильтр Блума
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::enable_filter(
+    double bits_per_key) {
+  static_assert(kFilterable,
+                "enable_filter requires a BloomFilterHash matching Compare");
+  filter_ = std::make_unique<Filter>(2 * tree_size, bits_per_key);
+  for (Node* node = Node::min(root); node; node = Node::next(node)) {
+    filter_->insert(node->key);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+BloomFilterStats Set<Key, Compare, Allocator, NodePolicy>::filter_stats()
+    const {
+  return filter_ ? filter_->stats() : BloomFilterStats{};
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::filterInsert(const Key& key) {
+  if constexpr (kFilterable) {
+    if (!filter_) return;
+    filter_->insert(key);
+    if (filter_->stale()) rebuildFilter();
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::filterErase() {
+  if constexpr (kFilterable) {
+    if (!filter_) return;
+    filter_->note_erase();
+    if (filter_->stale()) rebuildFilter();
+  }
+}
+
+// Запас вдвое: следующее перестроение из-за роста будет не раньше, чем
+// дерево удвоится
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::rebuildFilter() {
+  if constexpr (kFilterable) {
+    if (!filter_) return;
+    filter_->reset(2 * tree_size);
+    for (Node* node = Node::min(root); node; node = Node::next(node)) {
+      filter_->insert(node->key);
+    }
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::filteredFind(const Key& key) const {
+  if constexpr (kFilterable) {
+    if (filter_) {
+      if (!filter_->may_contain(key)) return nullptr;
+      Node* node = findNode(root, key);
+      if (!node) filter_->record_false_positive();
+      return node;
+    }
+  }
+  return findNode(root, key);
+}
+
+// Тот же прием, что в deleteTree: левый потомок поднимается поворотом,
+// пока у узла не останется левого поддерева, и тогда узел - следующий в
+// цепочке
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::flatten(Node* node) {
+  Node* head = nullptr;
+  Node** tail = &head;
+  while (node) {
+    if (Node* left = node->left) {
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    } else {
+      *tail = node;
+      tail = &node->right;
+      node = node->right;
+    }
+  }
+  return head;
+}
+
+// Глубина рекурсии - высота результата, то есть O(log count)
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+typename Set<Key, Compare, Allocator, NodePolicy>::Node*
+Set<Key, Compare, Allocator, NodePolicy>::buildFromList(Node*& list,
+                                                        size_t count) {
+  if (count == 0) return nullptr;
+  size_t left_count = (count - 1) / 2;
+  Node* left = buildFromList(list, left_count);
+  Node* node = list;
+  list = list->right;
+  node->left = left;
+  if (left) left->parent = node;
+  node->right = buildFromList(list, count - 1 - left_count);
+  if (node->right) node->right->parent = node;
+  NodePolicy::update(node);
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+void Set<Key, Compare, Allocator, NodePolicy>::adoptList(Node* list,
+                                                         size_t count) {
+  root = buildFromList(list, count);
+  if (root) root->parent = nullptr;
+  tree_size = count;
+  rightmost_ = findMax(root);
+  rebuildFilter();
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+bool Set<Key, Compare, Allocator, NodePolicy>::validateForTesting() const {
+  if (root && root->parent) {
+    return false;
+  }
+  size_t count = 0;
+  Node* prev = nullptr;
+  for (Node* node = Node::min(root); node; node = Node::next(node)) {
+    if ((node->left && node->left->parent != node) ||
+        (node->right && node->right->parent != node) ||
+        !NodePolicy::valid(node)) {
+      return false;
+    }
+    if (prev && !comp_(prev->key, node->key)) {
+      return false;
+    }
+    prev = node;
+    ++count;
+  }
+  return count == tree_size && prev == rightmost_;
+}
+
 }  // namespace s21
@@ -0,0 +1,230 @@
+//
+// Объединение, пересечение и разности деревьев Set и Multiset.
+//
+
+#include "../../include/s21_set_algebra/s21_set_algebra.hpp"
+
+namespace s21 {
+namespace set_algebra {
+
+template <typename Node>
+template <typename Key, typename Compare>
+StackCursor<Node>::StackCursor(Node* root, const Key* key,
+                               const Compare& comp) {
+  if (!key) {
+    pushLeftSpine(root);
+    return;
+  }
+  // Узлы, от которых спуск ушел налево, - ключи не меньше key; ближайший
+  // из них оказывается на вершине стека
+  while (root) {
+    if (comp(root->key, *key)) {
+      root = root->right;
+    } else {
+      path_.push_back(root);
+      root = root->left;
+    }
+  }
+}
+
+template <typename Node>
+StackCursor<Node>& StackCursor<Node>::operator++() {
+  Node* node = path_.back();
+  path_.pop_back();
+  pushLeftSpine(node->right);
+  return *this;
+}
+
+template <typename Node>
+void StackCursor<Node>::pushLeftSpine(Node* node) {
+  for (; node; node = node->left) {
+    path_.push_back(node);
+  }
+}
+
+template <typename Node>
+void NodeChain<Node>::append(Node* node) {
+  if (last) {
+    last->right = node;
+  } else {
+    head = node;
+  }
+  last = node;
+  ++count;
+}
+
+template <typename Node>
+void NodeChain<Node>::append(NodeChain& other) {
+  if (!other.head) return;
+  if (last) {
+    last->right = other.head;
+  } else {
+    head = other.head;
+  }
+  last = other.last;
+  count += other.count;
+  other = NodeChain();
+}
+
+template <typename Cursor, typename Compare, typename Emit>
+void mergeWalk(Operation op, Cursor a, const Cursor& a_end, Cursor b,
+               const Cursor& b_end, const Compare& comp, Emit& emit) {
+  const bool keep_a = op != Operation::kIntersection;
+  const bool keep_b = op == Operation::kUnion || op == Operation::kSymmetric;
+  const bool keep_both =
+      op == Operation::kUnion || op == Operation::kIntersection;
+  while (a != a_end && b != b_end) {
+    if (comp(*a, *b)) {
+      if (keep_a) emit(*a);
+      ++a;
+    } else if (comp(*b, *a)) {
+      if (keep_b) emit(*b);
+      ++b;
+    } else {
+      if (keep_both) emit(*a);
+      ++a;
+      ++b;
+    }
+  }
+  for (; keep_a && a != a_end; ++a) emit(*a);
+  for (; keep_b && b != b_end; ++b) emit(*b);
+}
+
+template <typename Tree>
+Tree combine(Operation op, const Tree& a, const Tree& b) {
+  using Access = SetAlgebraAccess<Tree>;
+  using Node = typename Access::Node;
+
+  Tree result = Access::makeEmpty(a);
+  NodeChain<Node> chain;
+  auto emit = [&](const auto& key) {
+    chain.append(Access::createNode(result, key));
+  };
+  try {
+    mergeWalk(op, Access::begin(a), Access::end(a), Access::begin(b),
+              Access::end(b), a.key_comp(), emit);
+  } catch (...) {
+    Access::deleteChain(result, chain.head);
+    throw;
+  }
+  Access::adopt(result, chain.head, chain.count);
+  return result;
+}
+
+// Опорные ключи - отдельные верхние узлы большего дерева из
+// parallel::splitTree. Диапазон i - ключи из [pivots[i - 1], pivots[i]) в
+// обоих деревьях, так что диапазоны не пересекаются и их цепочки
+// соединяются по порядку. Узлы
+// результата создаются из нескольких потоков, поэтому это допускается
+// только для std::allocator
+template <typename Tree>
+Tree combineParallel(ThreadPool& pool, Operation op, const Tree& a,
+                     const Tree& b) {
+  using Access = SetAlgebraAccess<Tree>;
+  using Node = typename Access::Node;
+  using Key = typename Tree::key_type;
+
+  if (!Access::kConcurrentAlloc || pool.size() == 0) {
+    return combine(op, a, b);
+  }
+  std::vector<const Key*> pivots;
+  for (const auto& part :
+       parallel::splitTree(Access::root(a.size() >= b.size() ? a : b),
+                           a.size() + b.size(), pool)) {
+    if (!part.whole) pivots.push_back(&part.node->key);
+  }
+  // Маленькие деревья splitTree не делит
+  if (pivots.empty()) {
+    return combine(op, a, b);
+  }
+
+  Tree result = Access::makeEmpty(a);
+  std::size_t ranges = pivots.size() + 1;
+  std::vector<NodeChain<Node>> chains(ranges);
+  auto comp = a.key_comp();
+  try {
+    pool.parallel_for(ranges, [&](std::size_t i) {
+      auto from = [&](const Tree& tree) {
+        return i == 0 ? Access::begin(tree)
+                      : Access::lowerBound(tree, *pivots[i - 1]);
+      };
+      auto to = [&](const Tree& tree) {
+        return i + 1 == ranges ? Access::end(tree)
+                               : Access::lowerBound(tree, *pivots[i]);
+      };
+      auto emit = [&](const Key& key) {
+        chains[i].append(Access::createNode(result, key));
+      };
+      mergeWalk(op, from(a), to(a), from(b), to(b), comp, emit);
+    });
+  } catch (...) {
+    for (NodeChain<Node>& chain : chains) {
+      Access::deleteChain(result, chain.head);
+    }
+    throw;
+  }
+  NodeChain<Node> chain;
+  for (NodeChain<Node>& part : chains) {
+    chain.append(part);
+  }
+  Access::adopt(result, chain.head, chain.count);
+  return result;
+}
+
+}  // namespace set_algebra
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_union(const Tree& a, const Tree& b) {
+  return set_algebra::combine(set_algebra::Operation::kUnion, a, b);
+}
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_intersection(const Tree& a,
+                                                       const Tree& b) {
+  return set_algebra::combine(set_algebra::Operation::kIntersection, a, b);
+}
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_difference(const Tree& a,
+                                                     const Tree& b) {
+  return set_algebra::combine(set_algebra::Operation::kDifference, a, b);
+}
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree symmetric_difference(const Tree& a,
+                                                           const Tree& b) {
+  return set_algebra::combine(set_algebra::Operation::kSymmetric, a, b);
+}
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_union(ThreadPool& pool,
+                                                const Tree& a, const Tree& b) {
+  return set_algebra::combineParallel(pool, set_algebra::Operation::kUnion, a,
+                                      b);
+}
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_intersection(ThreadPool& pool,
+                                                       const Tree& a,
+                                                       const Tree& b) {
+  return set_algebra::combineParallel(
+      pool, set_algebra::Operation::kIntersection, a, b);
+}
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_difference(ThreadPool& pool,
+                                                     const Tree& a,
+                                                     const Tree& b) {
+  return set_algebra::combineParallel(
+      pool, set_algebra::Operation::kDifference, a, b);
+}
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree symmetric_difference(ThreadPool& pool,
+                                                           const Tree& a,
+                                                           const Tree& b) {
+  return set_algebra::combineParallel(pool, set_algebra::Operation::kSymmetric,
+                                      a, b);
+}
+
+}  // namespace s21
@@ -0,0 +1,508 @@
+//
+// Самонастраивающийся упорядоченный словарь на splay-дереве.
+//
+
+#include "../../include/s21_splay_map/s21_splay_map.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace s21 {
+
+// Конструкторы
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+SplayMap<Key, T, Compare, Allocator>::SplayMap(const Compare& comp,
+                                               const Allocator& alloc)
+    : root_(nullptr), node_count_(0), comp_(comp), alloc_(alloc) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+SplayMap<Key, T, Compare, Allocator>::SplayMap(
+    std::initializer_list<value_type> const& items)
+    : SplayMap() {
+  for (const auto& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+SplayMap<Key, T, Compare, Allocator>::SplayMap(const SplayMap& other)
+    : root_(nullptr),
+      node_count_(0),
+      comp_(other.comp_),
+      alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+  copyFrom(other);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+SplayMap<Key, T, Compare, Allocator>::SplayMap(SplayMap&& other) noexcept
+    : root_(other.root_),
+      node_count_(other.node_count_),
+      comp_(other.comp_),
+      alloc_(std::move(other.alloc_)) {
+  other.root_ = nullptr;
+  other.node_count_ = 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+SplayMap<Key, T, Compare, Allocator>&
+SplayMap<Key, T, Compare, Allocator>::operator=(const SplayMap& other) {
+  if (this != &other) {
+    SplayMap copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+SplayMap<Key, T, Compare, Allocator>&
+SplayMap<Key, T, Compare, Allocator>::operator=(SplayMap&& other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+// Доступ к элементам
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+T& SplayMap<Key, T, Compare, Allocator>::at(const Key& key) {
+  iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const T& SplayMap<Key, T, Compare, Allocator>::at(const Key& key) const {
+  Node* node = findNode(key);
+  if (!node) {
+    throw std::out_of_range("Key not found");
+  }
+  return node->data.second;
+}
+
+// Модификаторы
+
+// Дерево разбирается поворотами вправо: левое поддерево поднимается, пока
+// у узла не останется левого потомка, после чего узел удаляется. Рекурсии
+// нет, поэтому вырожденное в цепочку дерево не переполняет стек
+template <typename Key, typename T, typename Compare, typename Allocator>
+void SplayMap<Key, T, Compare, Allocator>::clear() {
+  Node* node = root_;
+  while (node) {
+    if (node->left) {
+      Node* left = node->left;
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    } else {
+      Node* right = node->right;
+      destroyNode(node);
+      node = right;
+    }
+  }
+  root_ = nullptr;
+  node_count_ = 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename SplayMap<Key, T, Compare, Allocator>::iterator, bool>
+SplayMap<Key, T, Compare, Allocator>::insert_or_assign(const Key& key,
+                                                       const T& obj) {
+  auto result = try_emplace(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename SplayMap<Key, T, Compare, Allocator>::iterator, bool>
+SplayMap<Key, T, Compare, Allocator>::emplace(Args&&... args) {
+  Node* node = makeNode(std::forward<Args>(args)...);
+  Node* last = nullptr;
+  bool as_left = false;
+  try {
+    last = findOrLast(node->data.first);
+    as_left = last && comp_(node->data.first, last->data.first);
+  } catch (...) {
+    destroyNode(node);
+    throw;
+  }
+  if (last && !comp_(node->data.first, last->data.first) &&
+      !comp_(last->data.first, node->data.first)) {
+    destroyNode(node);
+    splay(last);
+    return std::make_pair(iterator(this, last), false);
+  }
+  return std::make_pair(attachNode(last, as_left, node), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename SplayMap<Key, T, Compare, Allocator>::iterator, bool>
+SplayMap<Key, T, Compare, Allocator>::try_emplace(const Key& key,
+                                                  Args&&... args) {
+  Node* last = findOrLast(key);
+  if (last && !comp_(key, last->data.first) &&
+      !comp_(last->data.first, key)) {
+    splay(last);
+    return std::make_pair(iterator(this, last), false);
+  }
+  bool as_left = last && comp_(key, last->data.first);
+  Node* node = makeNode(std::piecewise_construct, std::forward_as_tuple(key),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+  return std::make_pair(attachNode(last, as_left, node), true);
+}
+
+// Узел поднимается в корень, после чего его поддеревья сливаются: наибольший
+// узел левого поднимается в его корень и получает правое поддерево
+template <typename Key, typename T, typename Compare, typename Allocator>
+void SplayMap<Key, T, Compare, Allocator>::erase(iterator pos) {
+  Node* node = pos.node_;
+  splay(node);
+  Node* left = node->left;
+  Node* right = node->right;
+  if (!left) {
+    root_ = right;
+    if (right) {
+      right->parent = nullptr;
+    }
+  } else {
+    left->parent = nullptr;
+    root_ = left;
+    Node* max = findMax(left);
+    splay(max);
+    max->right = right;
+    if (right) {
+      right->parent = max;
+    }
+  }
+  destroyNode(node);
+  --node_count_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::size_type
+SplayMap<Key, T, Compare, Allocator>::erase(const Key& key) {
+  iterator it = find(key);
+  if (it == end()) {
+    return 0;
+  }
+  erase(it);
+  return 1;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void SplayMap<Key, T, Compare, Allocator>::swap(SplayMap& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(node_count_, other.node_count_);
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
+}
+
+// Просмотр контейнера
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::iterator
+SplayMap<Key, T, Compare, Allocator>::find(const Key& key) {
+  Node* last = findOrLast(key);
+  if (!last) {
+    return end();
+  }
+  splay(last);
+  bool found = !comp_(key, last->data.first) && !comp_(last->data.first, key);
+  return iterator(this, found ? last : nullptr);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::iterator
+SplayMap<Key, T, Compare, Allocator>::lower_bound(const Key& key) {
+  auto [bound, last] = lowerBoundNode(key);
+  if (last) {
+    splay(bound ? bound : last);
+  }
+  return iterator(this, bound);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::iterator
+SplayMap<Key, T, Compare, Allocator>::upper_bound(const Key& key) {
+  auto [bound, last] = upperBoundNode(key);
+  if (last) {
+    splay(bound ? bound : last);
+  }
+  return iterator(this, bound);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+int SplayMap<Key, T, Compare, Allocator>::depth_of(const Key& key) const {
+  int depth = 0;
+  for (Node* node = root_; node; ++depth) {
+    if (comp_(key, node->data.first)) {
+      node = node->left;
+    } else if (comp_(node->data.first, key)) {
+      node = node->right;
+    } else {
+      return depth;
+    }
+  }
+  return -1;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool SplayMap<Key, T, Compare, Allocator>::validateForTesting() const {
+  if (root_ && root_->parent) {
+    return false;
+  }
+  size_type count = 0;
+  Node* prev = nullptr;
+  for (Node* node = findMin(root_); node; node = findNext(node)) {
+    if ((node->left && node->left->parent != node) ||
+        (node->right && node->right->parent != node)) {
+      return false;
+    }
+    if (prev && !comp_(prev->data.first, node->data.first)) {
+      return false;
+    }
+    prev = node;
+    ++count;
+  }
+  return count == node_count_;
+}
+
+// Вспомогательные функции
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::Node*
+SplayMap<Key, T, Compare, Allocator>::findMin(Node* node) {
+  while (node && node->left) {
+    node = node->left;
+  }
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::Node*
+SplayMap<Key, T, Compare, Allocator>::findMax(Node* node) {
+  while (node && node->right) {
+    node = node->right;
+  }
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::Node*
+SplayMap<Key, T, Compare, Allocator>::findNext(Node* node) {
+  if (node->right) {
+    return findMin(node->right);
+  }
+  Node* parent = node->parent;
+  while (parent && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::Node*
+SplayMap<Key, T, Compare, Allocator>::findPrev(Node* node) {
+  if (node->left) {
+    return findMax(node->left);
+  }
+  Node* parent = node->parent;
+  while (parent && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+typename SplayMap<Key, T, Compare, Allocator>::Node*
+SplayMap<Key, T, Compare, Allocator>::makeNode(Args&&... args) {
+  Node* node = NodeTraits::allocate(alloc_, 1);
+  try {
+    NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void SplayMap<Key, T, Compare, Allocator>::destroyNode(Node* node) {
+  NodeTraits::destroy(alloc_, node);
+  NodeTraits::deallocate(alloc_, node, 1);
+}
+
+// Копия сохраняет форму дерева other. Обход идет по ссылкам на родителей
+// одновременно в обоих деревьях: узел копии создается при первом спуске в
+// него, подъем начинается, когда оба потомка уже скопированы
+template <typename Key, typename T, typename Compare, typename Allocator>
+void SplayMap<Key, T, Compare, Allocator>::copyFrom(const SplayMap& other) {
+  if (!other.root_) {
+    return;
+  }
+  try {
+    const Node* source = other.root_;
+    root_ = makeNode(source->data);
+    Node* target = root_;
+    while (source) {
+      if (source->left && !target->left) {
+        target->left = makeNode(source->left->data);
+        target->left->parent = target;
+        source = source->left;
+        target = target->left;
+      } else if (source->right && !target->right) {
+        target->right = makeNode(source->right->data);
+        target->right->parent = target;
+        source = source->right;
+        target = target->right;
+      } else {
+        source = source->parent;
+        target = target->parent;
+      }
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+  node_count_ = other.node_count_;
+}
+
+// Поворот поднимает node на место его родителя
+template <typename Key, typename T, typename Compare, typename Allocator>
+void SplayMap<Key, T, Compare, Allocator>::rotate(Node* node) {
+  Node* parent = node->parent;
+  Node* grand = parent->parent;
+  if (node == parent->left) {
+    parent->left = node->right;
+    if (node->right) {
+      node->right->parent = parent;
+    }
+    node->right = parent;
+  } else {
+    parent->right = node->left;
+    if (node->left) {
+      node->left->parent = parent;
+    }
+    node->left = parent;
+  }
+  parent->parent = node;
+  node->parent = grand;
+  if (!grand) {
+    root_ = node;
+  } else if (grand->left == parent) {
+    grand->left = node;
+  } else {
+    grand->right = node;
+  }
+}
+
+// Подъем в корень по два уровня: если node и родитель - потомки с одной
+// стороны (zig-zig), сначала поворачивается родитель, иначе (zig-zag) node
+// поворачивается дважды. Именно zig-zig примерно вдвое укорачивает путь
+// до корня и дает амортизированную оценку O(log n)
+template <typename Key, typename T, typename Compare, typename Allocator>
+void SplayMap<Key, T, Compare, Allocator>::splay(Node* node) {
+  while (node->parent) {
+    Node* parent = node->parent;
+    Node* grand = parent->parent;
+    if (grand) {
+      bool zig_zig = (node == parent->left) == (parent == grand->left);
+      rotate(zig_zig ? parent : node);
+    }
+    rotate(node);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::Node*
+SplayMap<Key, T, Compare, Allocator>::findOrLast(const Key& key) const {
+  Node* last = nullptr;
+  for (Node* node = root_; node;) {
+    last = node;
+    if (comp_(key, node->data.first)) {
+      node = node->left;
+    } else if (comp_(node->data.first, key)) {
+      node = node->right;
+    } else {
+      break;
+    }
+  }
+  return last;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::Node*
+SplayMap<Key, T, Compare, Allocator>::findNode(const Key& key) const {
+  Node* last = findOrLast(key);
+  if (last && !comp_(key, last->data.first) &&
+      !comp_(last->data.first, key)) {
+    return last;
+  }
+  return nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename SplayMap<Key, T, Compare, Allocator>::Node*,
+          typename SplayMap<Key, T, Compare, Allocator>::Node*>
+SplayMap<Key, T, Compare, Allocator>::lowerBoundNode(const Key& key) const {
+  Node* bound = nullptr;
+  Node* last = nullptr;
+  for (Node* node = root_; node;) {
+    last = node;
+    if (comp_(node->data.first, key)) {
+      node = node->right;
+    } else {
+      bound = node;
+      node = node->left;
+    }
+  }
+  return std::make_pair(bound, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename SplayMap<Key, T, Compare, Allocator>::Node*,
+          typename SplayMap<Key, T, Compare, Allocator>::Node*>
+SplayMap<Key, T, Compare, Allocator>::upperBoundNode(const Key& key) const {
+  Node* bound = nullptr;
+  Node* last = nullptr;
+  for (Node* node = root_; node;) {
+    last = node;
+    if (comp_(key, node->data.first)) {
+      bound = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return std::make_pair(bound, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename SplayMap<Key, T, Compare, Allocator>::iterator
+SplayMap<Key, T, Compare, Allocator>::attachNode(Node* parent, bool as_left,
+                                                 Node* node) {
+  node->parent = parent;
+  if (!parent) {
+    root_ = node;
+  } else if (as_left) {
+    parent->left = node;
+  } else {
+    parent->right = node;
+  }
+  ++node_count_;
+  splay(node);
+  return iterator(this, node);
+}
+
+}  // namespace s21
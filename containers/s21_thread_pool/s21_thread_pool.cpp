@@ -0,0 +1,162 @@
+//
+// Пул потоков и параллельная сортировка.
+//
+
+#include "../../include/s21_thread_pool/s21_thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+
+inline ThreadPool::ThreadPool(size_type threads) : stopping_(false) {
+  workers_.reserve(threads);
+  for (size_type i = 0; i < threads; ++i) {
+    workers_.emplace_back([this] { workerLoop(); });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+inline ThreadPool::size_type ThreadPool::hardware_threads() noexcept {
+  size_type threads = std::thread::hardware_concurrency();
+  return threads == 0 ? 1 : threads;
+}
+
+inline void ThreadPool::submit(std::function<void()> task) {
+  if (workers_.empty()) {
+    task();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push(std::move(task));
+  }
+  ready_.notify_one();
+}
+
+inline void ThreadPool::workerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+// Итерации раздаются по одной через атомарный счетчик. Помощники держат
+// состояние через shared_ptr: опоздавший помощник может начать уже после
+// возврата из parallel_for, но тогда счетчик исчерпан и func он не вызывает
+template <typename Func>
+void ThreadPool::parallel_for(size_type count, Func&& func) {
+  if (count == 0) {
+    return;
+  }
+
+  struct Job {
+    std::atomic<size_type> next{0};
+    size_type count = 0;
+    size_type done = 0;  // под mutex
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+  };
+  auto job = std::make_shared<Job>();
+  job->count = count;
+  auto* body = &func;
+
+  auto run = [job, body] {
+    for (size_type i = job->next++; i < job->count; i = job->next++) {
+      std::exception_ptr error;
+      try {
+        (*body)(i);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(job->mutex);
+      if (error && !job->error) {
+        job->error = error;
+      }
+      if (++job->done == job->count) {
+        job->finished.notify_all();
+      }
+    }
+  };
+
+  size_type helpers = std::min(size(), count - 1);
+  for (size_type i = 0; i < helpers; ++i) {
+    submit(run);
+  }
+  run();
+
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->finished.wait(lock, [&job] { return job->done == job->count; });
+  if (job->error) {
+    std::rethrow_exception(job->error);
+  }
+}
+
+inline std::size_t parallel_build_depth(const ThreadPool& pool,
+                                        std::size_t count,
+                                        bool concurrent_alloc) {
+  constexpr std::size_t kMinSubtree = std::size_t{1} << 12;
+  if (!concurrent_alloc) {
+    return 0;
+  }
+  std::size_t subtrees = std::min(4 * (pool.size() + 1), count / kMinSubtree);
+  std::size_t depth = 0;
+  while ((std::size_t{1} << depth) < subtrees) {
+    ++depth;
+  }
+  return depth;
+}
+
+template <typename RandomIt, typename Compare>
+void parallel_sort(ThreadPool& pool, RandomIt first, RandomIt last,
+                   Compare comp) {
+  // Отрезки короче kMinRun не окупают передачу в другой поток
+  constexpr std::size_t kMinRun = std::size_t{1} << 14;
+  std::size_t n = static_cast<std::size_t>(last - first);
+  std::size_t runs = std::min(pool.size() + 1, n / kMinRun);
+  if (runs <= 1) {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+
+  auto bound = [n, runs](std::size_t run) {
+    return static_cast<std::ptrdiff_t>(n / runs * std::min(run, runs) +
+                                       std::min(run, n % runs));
+  };
+  pool.parallel_for(runs, [&](std::size_t run) {
+    std::stable_sort(first + bound(run), first + bound(run + 1), comp);
+  });
+  for (std::size_t width = 1; width < runs; width *= 2) {
+    std::size_t pairs = (runs + 2 * width - 1) / (2 * width);
+    pool.parallel_for(pairs, [&](std::size_t pair) {
+      std::size_t begin = pair * 2 * width;
+      std::inplace_merge(first + bound(begin), first + bound(begin + width),
+                         first + bound(begin + 2 * width), comp);
+    });
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,152 @@
+//
+// Хеш-таблица ключ-значение с интерфейсом s21::Map.
+//
+
+#include "../../include/s21_unordered_map/s21_unordered_map.hpp"
+
+#include <tuple>
+
+namespace s21 {
+
+// Конструкторы
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+UnorderedMap<Key, T, Hash, KeyEqual>::UnorderedMap(size_type bucket_count,
+                                                   const Hash& hash,
+                                                   const KeyEqual& equal)
+    : table_(hash, equal) {
+  table_.rehash(bucket_count);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+UnorderedMap<Key, T, Hash, KeyEqual>::UnorderedMap(
+    std::initializer_list<value_type> const& items) {
+  table_.reserve(items.size());
+  for (const auto& item : items) {
+    insert(item);
+  }
+}
+
+// Доступ к элементам
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+T& UnorderedMap<Key, T, Hash, KeyEqual>::at(const Key& key) {
+  iterator it = table_.find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+const T& UnorderedMap<Key, T, Hash, KeyEqual>::at(const Key& key) const {
+  const_iterator it = table_.find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename K, typename H, typename E, typename>
+T& UnorderedMap<Key, T, Hash, KeyEqual>::at(const K& key) {
+  iterator it = table_.find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+T& UnorderedMap<Key, T, Hash, KeyEqual>::operator[](const Key& key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+T& UnorderedMap<Key, T, Hash, KeyEqual>::operator[](Key&& key) {
+  return try_emplace(std::move(key)).first->second;
+}
+
+// Модификаторы
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::insert(const value_type& value) {
+  return table_.emplaceKey(value.first, value);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::insert(value_type&& value) {
+  return table_.emplaceKey(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::insert(const Key& key, const T& obj) {
+  return try_emplace(key, obj);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::insert_or_assign(const Key& key,
+                                                       const T& obj) {
+  auto result = try_emplace(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::insert_or_assign(const Key& key,
+                                                       T&& obj) {
+  auto result = try_emplace(key, std::move(obj));
+  if (!result.second) {
+    result.first->second = std::move(obj);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::emplace(Args&&... args) {
+  value_type value(std::forward<Args>(args)...);
+  return table_.emplaceKey(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::try_emplace(const Key& key,
+                                                  Args&&... args) {
+  return table_.emplaceKey(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+// Ключ перемещается в слот только после поиска, поэтому при существующем
+// ключе аргумент не меняется
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<Key, T, Hash, KeyEqual>::try_emplace(Key&& key, Args&&... args) {
+  return table_.emplaceKey(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename... Args>
+Vector<std::pair<typename UnorderedMap<Key, T, Hash, KeyEqual>::iterator,
+                 bool>>
+UnorderedMap<Key, T, Hash, KeyEqual>::insert_many(Args&&... args) {
+  table_.reserve(size() + sizeof...(args));
+  Vector<std::pair<iterator, bool>> results;
+  (results.push_back(insert(std::forward<Args>(args))), ...);
+  return results;
+}
+
+}  // namespace s21
@@ -0,0 +1,44 @@
+//
+// Хеш-множество с интерфейсом s21::Set.
+//
+
+#include "../../include/s21_unordered_set/s21_unordered_set.hpp"
+
+namespace s21 {
+
+template <typename Key, typename Hash, typename KeyEqual>
+UnorderedSet<Key, Hash, KeyEqual>::UnorderedSet(size_type bucket_count,
+                                                const Hash& hash,
+                                                const KeyEqual& equal)
+    : table_(hash, equal) {
+  table_.rehash(bucket_count);
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+UnorderedSet<Key, Hash, KeyEqual>::UnorderedSet(
+    std::initializer_list<value_type> const& items) {
+  table_.reserve(items.size());
+  for (const auto& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename UnorderedSet<Key, Hash, KeyEqual>::iterator, bool>
+UnorderedSet<Key, Hash, KeyEqual>::emplace(Args&&... args) {
+  Key key(std::forward<Args>(args)...);
+  return table_.emplaceKey(key, std::move(key));
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename... Args>
+Vector<std::pair<typename UnorderedSet<Key, Hash, KeyEqual>::iterator, bool>>
+UnorderedSet<Key, Hash, KeyEqual>::insert_many(Args&&... args) {
+  table_.reserve(size() + sizeof...(args));
+  Vector<std::pair<iterator, bool>> results;
+  (results.push_back(insert(std::forward<Args>(args))), ...);
+  return results;
+}
+
+}  // namespace s21
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 namespace s21 {
 
@@ -81,6 +82,12 @@ typename Vector<T>::reference Vector<T>::operator[](size_type pos) {
   return data_[pos];
 }
 
+template <typename T>
+typename Vector<T>::const_reference Vector<T>::operator[](
+    size_type pos) const {
+  return data_[pos];
+}
+
 template <typename T>
 typename Vector<T>::const_reference Vector<T>::front() {
   if (empty()) {
@@ -102,23 +109,28 @@ T *Vector<T>::data() {
   return data_;
 }
 
+template <typename T>
+const T *Vector<T>::data() const {
+  return data_;
+}
+
 // Итераторы
 // В заголовочном файле
 
 // Вместимость
 
 template <typename T>
-bool Vector<T>::empty() {
+bool Vector<T>::empty() const {
   return size_ == 0;
 }
 
 template <typename T>
-typename Vector<T>::size_type Vector<T>::size() {
+typename Vector<T>::size_type Vector<T>::size() const {
   return size_;
 }
 
 template <typename T>
-typename Vector<T>::size_type Vector<T>::max_size() {
+typename Vector<T>::size_type Vector<T>::max_size() const {
   return std::numeric_limits<size_type>::max();
 }
 
@@ -126,9 +138,7 @@ template <typename T>
 void Vector<T>::reserve(size_type new_capacity) {
   if (new_capacity > capacity_) {
     T *new_data = new T[new_capacity];
-    for (size_type i = 0; i < size_; ++i) {
-      new_data[i] = data_[i];
-    }
+    std::move(data_, data_ + size_, new_data);
     delete[] data_;
     data_ = new_data;
     capacity_ = new_capacity;
@@ -136,7 +146,7 @@ void Vector<T>::reserve(size_type new_capacity) {
 }
 
 template <typename T>
-typename Vector<T>::size_type Vector<T>::capacity() {
+typename Vector<T>::size_type Vector<T>::capacity() const {
   return capacity_;
 }
 
@@ -144,9 +154,7 @@ template <typename T>
 void Vector<T>::shrink_to_fit() {
   if (size_ < capacity_) {
     T *new_data = new T[size_];
-    for (size_type i = 0; i < size_; ++i) {
-      new_data[i] = data_[i];
-    }
+    std::move(data_, data_ + size_, new_data);
     delete[] data_;
     data_ = new_data;
     capacity_ = size_;
@@ -167,9 +175,7 @@ typename Vector<T>::iterator Vector<T>::insert(iterator pos,
   if (size_ == capacity_) {
     reserve(capacity_ == 0 ? 1 : capacity_ * 2);
   }
-  for (size_type i = size_; i > index; --i) {
-    data_[i] = data_[i - 1];
-  }
+  std::move_backward(data_ + index, data_ + size_, data_ + size_ + 1);
   data_[index] = value;
   ++size_;
   return data_ + index;
@@ -178,9 +184,7 @@ typename Vector<T>::iterator Vector<T>::insert(iterator pos,
 template <typename T>
 void Vector<T>::erase(iterator pos) {
   iterator erase_pos = data_ + (pos - data_);
-  for (T *it = erase_pos + 1; it != data_ + size_; ++it) {
-    *(it - 1) = *it;
-  }
+  std::move(erase_pos + 1, data_ + size_, erase_pos);
   --size_;
 }
 
@@ -192,6 +196,14 @@ void Vector<T>::push_back(const_reference value) {
   data_[size_++] = value;
 }
 
+template <typename T>
+void Vector<T>::push_back(T &&value) {
+  if (size_ == capacity_) {
+    reserve(capacity_ == 0 ? 1 : 2 * capacity_);
+  }
+  data_[size_++] = std::move(value);
+}
+
 template <typename T>
 void Vector<T>::pop_back() {
   if (size_ > 0) {
@@ -0,0 +1,130 @@
+//
+// Блочный фильтр Блума для отсева промахов в Map и Set.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_BLOOM_FILTER_HPP
+#define CPP2_S21_CONTAINERS_1_S21_BLOOM_FILTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "../s21_hash_mix/s21_hash_mix.hpp"
+
+namespace s21 {
+
+// Хеш для фильтра дерева с компаратором Compare. Ключи, равные для
+// Compare, обязаны иметь равные хеши, иначе фильтр отвергнет ключ, который
+// в дереве есть. std::hash согласован только с std::less и std::greater;
+// для другого компаратора (например, без учета регистра или по одному полю
+// ключа) специализируйте шаблон и задайте type - хеш тех же частей ключа,
+// которые сравнивает компаратор. Без специализации type = void, и фильтр
+// недоступен
+template <typename Key, typename Compare>
+struct BloomFilterHash {
+  using type = void;
+};
+
+template <typename Key>
+struct BloomFilterHash<Key, std::less<Key>> {
+  using type = std::hash<Key>;
+};
+
+template <typename Key>
+struct BloomFilterHash<Key, std::greater<Key>> {
+  using type = std::hash<Key>;
+};
+
+template <typename Key>
+struct BloomFilterHash<Key, std::less<>> {
+  using type = std::hash<Key>;
+};
+
+template <typename Key>
+struct BloomFilterHash<Key, std::greater<>> {
+  using type = std::hash<Key>;
+};
+
+// Только для таких ключей и компараторов контейнер может включить фильтр
+template <typename Key, typename Compare>
+constexpr bool kBloomFilterable = std::is_default_constructible<
+    typename BloomFilterHash<Key, Compare>::type>::value;
+
+struct BloomFilterStats {
+  std::size_t lookups;          // запросы, прошедшие через фильтр
+  std::size_t filtered;         // отвечены фильтром без спуска по дереву
+  std::size_t false_positives;  // фильтр пропустил, но ключа в дереве нет
+  std::size_t bits;             // размер фильтра
+  std::size_t rebuilds;         // перестроения после роста и удалений
+
+  // Доля отсутствующих ключей, которые фильтр не отсеял
+  double false_positive_rate() const {
+    std::size_t misses = filtered + false_positives;
+    return misses ? static_cast<double>(false_positives) / misses : 0.0;
+  }
+};
+
+// Каждый ключ ставит по одному биту в восемь слов одного 64-байтного блока,
+// поэтому проверка читает одну строку кэша вместо k случайных. При 10 битах
+// на ключ доля ложных срабатываний около 1%. Удалять ключи из фильтра
+// нельзя: владелец сообщает об удалениях, и когда stale() становится true,
+// строит фильтр заново по своим ключам.
+//
+// Hash создается при каждом вызове, поэтому тип фильтра можно назвать и для
+// ключей без std::hash, пока его методы не вызываются. insert и reset не
+// потокобезопасны; may_contain только увеличивает атомарные счетчики и
+// может вызываться из нескольких потоков сразу
+template <typename Key, typename Hash = std::hash<Key>>
+class BloomFilter {
+ public:
+  using size_type = std::size_t;
+
+  // Фильтр на capacity ключей с bits_per_key битами на ключ
+  explicit BloomFilter(size_type capacity, double bits_per_key = 10.0);
+  BloomFilter(const BloomFilter& other);
+  BloomFilter& operator=(const BloomFilter& other);
+
+  // Очищает фильтр и рассчитывает его на capacity ключей; счетчики
+  // запросов сохраняются
+  void reset(size_type capacity);
+  void insert(const Key& key);
+  // false - ключа точно нет
+  bool may_contain(const Key& key) const;
+  // Фильтр пропустил key, но владелец его не нашел
+  void record_false_positive() const;
+  void note_erase() { ++erased_; }
+  // Ключей больше расчетного или половина битов принадлежит удаленным
+  bool stale() const {
+    return inserted_ > capacity_ || erased_ * 2 > inserted_;
+  }
+  size_type bits() const { return blocks_.size() * kBlockBits; }
+  BloomFilterStats stats() const;
+
+ private:
+  struct alignas(64) Block {
+    std::uint64_t words[8];
+  };
+  static constexpr size_type kBlockBits = 512;
+
+  std::uint64_t hashOf(const Key& key) const;
+  size_type blockIndex(std::uint64_t hash) const;
+  // Маска бита в слове word блока
+  static std::uint64_t bitOf(std::uint64_t hash, int word);
+
+  double bits_per_key_;
+  size_type capacity_;
+  size_type inserted_;  // вставки с последнего reset, включая удаленные
+  size_type erased_;
+  size_type rebuilds_;
+  std::vector<Block> blocks_;
+  mutable std::atomic<size_type> lookups_;
+  mutable std::atomic<size_type> filtered_;
+  mutable std::atomic<size_type> false_positives_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_BLOOM_FILTER_HPP
@@ -0,0 +1,320 @@
+//
+// B+-дерево с узлами размером в несколько кэш-линий.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_BTREE_MAP_HPP
+#define CPP2_S21_CONTAINERS_1_S21_BTREE_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Ассоциативный массив с интерфейсом s21::Map поверх B+-дерева. Каждый узел
+// занимает NodeBytes байт, выровнен по кэш-линии и хранит отсортированный
+// массив ключей, поэтому поиск проходит несколько узлов вместо десятков
+// указателей. Ключи и значения листа лежат в отдельных массивах, а листья
+// связаны в список для обхода.
+//
+// Отличия от Map: Key и T должны быть конструируемы по умолчанию и
+// перемещаемы, разыменование итератора возвращает пару ссылок
+// std::pair<const Key&, T&>, а любая вставка или удаление делает
+// недействительными все итераторы.
+template <typename Key, typename T, std::size_t NodeBytes = 256,
+          typename Compare = std::less<Key>>
+class BTreeMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = std::pair<const key_type&, mapped_type&>;
+  using const_reference = std::pair<const key_type&, const mapped_type&>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+ private:
+  static constexpr size_type kCacheLine = 64;
+  // count, признак листа и указатель next или последний указатель на потомка
+  static constexpr size_type kHeaderBytes =
+      sizeof(size_type) + 2 * sizeof(void*);
+
+  static_assert(NodeBytes >= kCacheLine && NodeBytes % kCacheLine == 0,
+                "NodeBytes must be a positive multiple of the cache line");
+
+ public:
+  // Число ключей в листе и во внутреннем узле; не меньше 4, чтобы
+  // расщепление и слияние всегда оставляли непустые половины
+  static constexpr size_type kLeafCapacity = std::max<size_type>(
+      4, (NodeBytes - kHeaderBytes) / (sizeof(Key) + sizeof(T)));
+  static constexpr size_type kInnerCapacity = std::max<size_type>(
+      4, (NodeBytes - kHeaderBytes) / (sizeof(Key) + sizeof(void*)));
+
+ private:
+  // Минимальная заполненность некорневых узлов: столько остается в меньшей
+  // половине при расщеплении полного узла
+  static constexpr size_type kMinLeaf = kLeafCapacity / 2;
+  static constexpr size_type kMinInner = (kInnerCapacity - 1) / 2;
+
+  struct Node {
+    size_type count;
+    bool leaf;
+  };
+
+  struct alignas(kCacheLine) Leaf : Node {
+    Key keys[kLeafCapacity];
+    T values[kLeafCapacity];
+    Leaf* next;
+
+    Leaf() : Node{0, true}, next(nullptr) {}
+  };
+
+  // Все ключи children[i] меньше keys[i], а ключи children[i + 1] не меньше
+  struct alignas(kCacheLine) Inner : Node {
+    Key keys[kInnerCapacity];
+    Node* children[kInnerCapacity + 1];
+
+    Inner() : Node{0, false} {}
+  };
+
+  // Каждый внутренний узел имеет не меньше двух потомков, поэтому высота
+  // не превосходит числа битов size_type
+  static constexpr size_type kMaxHeight = 8 * sizeof(size_type);
+
+  // Узлы для расщеплений одной вставки, созданные до изменения дерева;
+  // невостребованные удаляются деструктором
+  struct SpareNodes {
+    Leaf* leaf = nullptr;
+    Inner* inners[kMaxHeight] = {};
+    size_type inner_count = 0;
+
+    SpareNodes() = default;
+    SpareNodes(const SpareNodes&) = delete;
+    SpareNodes& operator=(const SpareNodes&) = delete;
+    ~SpareNodes() {
+      delete leaf;
+      for (size_type i = 0; i < inner_count; ++i) {
+        delete inners[i];
+      }
+    }
+    Inner* takeInner() {
+      Inner* inner = inners[--inner_count];
+      inners[inner_count] = nullptr;
+      return inner;
+    }
+  };
+
+  Node* root_;
+  size_type size_;
+  Compare comp_;
+
+ public:
+  class BTreeMapIterator;
+  class BTreeMapConstIterator;
+
+  class BTreeMapIterator {
+   public:
+    // Указатель на пару ссылок: operator-> должен вернуть объект с
+    // operator->, а пары в узле нет
+    class ArrowProxy {
+     public:
+      explicit ArrowProxy(reference ref) : ref_(ref) {}
+      const reference* operator->() const { return &ref_; }
+
+     private:
+      reference ref_;
+    };
+
+    BTreeMapIterator() : leaf_(nullptr), index_(0) {}
+    BTreeMapIterator(Leaf* leaf, size_type index)
+        : leaf_(leaf), index_(index) {}
+
+    reference operator*() const {
+      return reference(leaf_->keys[index_], leaf_->values[index_]);
+    }
+    ArrowProxy operator->() const { return ArrowProxy(**this); }
+
+    BTreeMapIterator& operator++() {
+      if (++index_ == leaf_->count) {
+        leaf_ = leaf_->next;
+        index_ = 0;
+      }
+      return *this;
+    }
+    BTreeMapIterator operator++(int) {
+      BTreeMapIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const BTreeMapIterator& other) const {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+    bool operator!=(const BTreeMapIterator& other) const {
+      return !operator==(other);
+    }
+
+   private:
+    friend class BTreeMap;
+    friend class BTreeMapConstIterator;
+
+    Leaf* leaf_;
+    size_type index_;
+  };
+
+  class BTreeMapConstIterator {
+   public:
+    class ArrowProxy {
+     public:
+      explicit ArrowProxy(const_reference ref) : ref_(ref) {}
+      const const_reference* operator->() const { return &ref_; }
+
+     private:
+      const_reference ref_;
+    };
+
+    BTreeMapConstIterator() : leaf_(nullptr), index_(0) {}
+    BTreeMapConstIterator(const Leaf* leaf, size_type index)
+        : leaf_(leaf), index_(index) {}
+    BTreeMapConstIterator(const BTreeMapIterator& other)
+        : leaf_(other.leaf_), index_(other.index_) {}
+
+    const_reference operator*() const {
+      return const_reference(leaf_->keys[index_], leaf_->values[index_]);
+    }
+    ArrowProxy operator->() const { return ArrowProxy(**this); }
+
+    BTreeMapConstIterator& operator++() {
+      if (++index_ == leaf_->count) {
+        leaf_ = leaf_->next;
+        index_ = 0;
+      }
+      return *this;
+    }
+    BTreeMapConstIterator operator++(int) {
+      BTreeMapConstIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const BTreeMapConstIterator& other) const {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+    bool operator!=(const BTreeMapConstIterator& other) const {
+      return !operator==(other);
+    }
+
+   private:
+    const Leaf* leaf_;
+    size_type index_;
+  };
+
+  using iterator = BTreeMapIterator;
+  using const_iterator = BTreeMapConstIterator;
+
+  // Конструкторы
+
+  BTreeMap();
+  explicit BTreeMap(const Compare& comp);
+  BTreeMap(std::initializer_list<value_type> const& items);
+  BTreeMap(const BTreeMap& other);  // поузловое копирование за O(n)
+  BTreeMap(BTreeMap&& other) noexcept;
+  ~BTreeMap();
+
+  BTreeMap& operator=(const BTreeMap& other);
+  BTreeMap& operator=(BTreeMap&& other) noexcept;
+
+  // Доступ к элементам
+
+  T& at(const Key& key);
+  const T& at(const Key& key) const;
+  T& operator[](const Key& key);
+
+  // Итераторы
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Вместимость
+
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+
+  // Модификаторы
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(const Key& key, const T& obj);
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  void erase(iterator pos);
+  size_type erase(const Key& key);  // возвращает число удаленных элементов
+  void swap(BTreeMap& other);
+  // Переносит из other элементы с отсутствующими здесь ключами, повторяющиеся
+  // ключи остаются в other
+  void merge(BTreeMap& other);
+
+  // Просмотр контейнера
+
+  bool contains(const Key& key) const;
+  iterator find(const Key& key);
+  const_iterator find(const Key& key) const;
+  key_compare key_comp() const { return comp_; }
+
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  size_type height() const;  // число уровней, 0 для пустого дерева
+  // Проверяет порядок ключей, разделители, заполненность узлов, одинаковую
+  // глубину листьев и список листьев
+  bool validateForTesting() const;
+
+ private:
+  // Позиция первого ключа, не меньшего key (lower) или большего key (upper)
+  size_type lowerIndex(const Key* keys, size_type count,
+                       const Key& key) const;
+  size_type upperIndex(const Key* keys, size_type count,
+                       const Key& key) const;
+  // Лист, в котором должен находиться key
+  Leaf* findLeaf(const Key& key) const;
+  Leaf* firstLeaf() const;
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplaceUnique(const Key& key, Args&&... args);
+  // Кладет key и value в лист на место index, расщепляя его узлом из spare.
+  // Возвращает новый правый лист или nullptr
+  Leaf* insertIntoLeaf(Leaf* leaf, size_type index, Key&& key, T&& value,
+                       SpareNodes& spare, iterator& position);
+  // Вставляет separator и right справа от children[index]. Полный узел
+  // делится узлом из spare: тогда возвращается правая половина, а в
+  // separator оказывается ключ, уходящий к родителю
+  Node* insertIntoInner(Inner* inner, size_type index, Key& separator,
+                        Node* right, SpareNodes& spare);
+
+  bool eraseFrom(Node* node, const Key& key);
+  // Восстанавливает заполненность потомка children[index]: забирает ключ у
+  // соседа, если тот заполнен больше минимума, иначе сливается с ним
+  void rebalance(Inner* parent, size_type index);
+  void borrowFromLeft(Inner* parent, size_type index);
+  void borrowFromRight(Inner* parent, size_type index);
+  // Сливает children[index + 1] в children[index] и удаляет разделитель
+  void mergeChildren(Inner* parent, size_type index);
+
+  Node* cloneNode(const Node* source, Leaf*& last_leaf);
+  void destroyNode(Node* node);
+  int checkNode(const Node* node, const Key* low, const Key* high,
+                const Leaf*& expected_leaf, size_type& counted) const;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_BTREE_MAP_HPP
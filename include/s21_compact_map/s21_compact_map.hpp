@@ -0,0 +1,130 @@
+//
+// Упорядоченный словарь с компактными узлами.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_COMPACT_MAP_HPP
+#define CPP2_S21_CONTAINERS_1_S21_COMPACT_MAP_HPP
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "../s21_compact_tree/s21_compact_tree.hpp"
+#include "../s21_range/s21_range.hpp"
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Map с узлами в массиве и 32-битными ссылками (см. s21_compact_tree.hpp):
+// для мелких ключей память на элемент вдвое меньше, чем у s21::Map, а
+// соседние по времени вставки узлы лежат рядом. Интерфейс совпадает с Map,
+// кроме узловых операций (extract) и порядковых статистик; вместимость
+// ограничена 2^31 - 2 элементами.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class CompactMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+ private:
+  struct KeyOfPair {
+    static const Key& key(const value_type& value) { return value.first; }
+  };
+  using Tree = CompactTree<value_type, KeyOfPair, Compare>;
+
+  Tree tree_;
+
+ public:
+  using iterator = typename Tree::iterator;
+  using const_iterator = typename Tree::const_iterator;
+
+  static constexpr size_type kNodeSize = Tree::kNodeSize;
+
+  // Конструкторы
+
+  CompactMap() = default;
+  explicit CompactMap(const Compare& comp) : tree_(comp) {}
+  CompactMap(std::initializer_list<value_type> const& items);
+  CompactMap(const CompactMap& other) = default;
+  CompactMap(CompactMap&& other) noexcept = default;
+  ~CompactMap() = default;
+
+  CompactMap& operator=(const CompactMap& other) = default;
+  CompactMap& operator=(CompactMap&& other) noexcept = default;
+
+  // Доступ к элементам
+
+  T& at(const Key& key);
+  const T& at(const Key& key) const;
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  // Итераторы
+
+  iterator begin() { return tree_.begin(); }
+  iterator end() { return tree_.end(); }
+  const_iterator begin() const { return tree_.begin(); }
+  const_iterator end() const { return tree_.end(); }
+
+  // Вместимость
+
+  bool empty() const { return tree_.empty(); }
+  size_type size() const { return tree_.size(); }
+  size_type max_size() const { return Tree::kMaxSize; }
+  size_type capacity() const { return tree_.capacity(); }
+  // Выделяет массив под count узлов сразу, без промежуточных ростов
+  void reserve(size_type count) { tree_.reserve(count); }
+
+  // Модификаторы
+
+  void clear() { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return tree_.emplaceKey(value.first, value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return tree_.emplaceKey(value.first, std::move(value));
+  }
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  void erase(iterator pos) { tree_.erase(pos); }
+  void swap(CompactMap& other) { tree_.swap(other.tree_); }
+  // Повторяющиеся ключи остаются в other
+  void merge(CompactMap& other) { tree_.merge(other.tree_); }
+
+  // Просмотр контейнера
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+  iterator find(const Key& key) { return tree_.find(key); }
+  const_iterator find(const Key& key) const { return tree_.find(key); }
+  iterator lower_bound(const Key& key) { return tree_.lower_bound(key); }
+  const_iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  }
+  iterator upper_bound(const Key& key) { return tree_.upper_bound(key); }
+  const_iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  }
+  // Элементы с ключами из [lo, hi); пусто, если hi не больше lo
+  IteratorRange<const_iterator> range(const Key& lo, const Key& hi) const;
+  key_compare key_comp() const { return tree_.key_comp(); }
+
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  bool validateForTesting() const { return tree_.validateForTesting(); }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_COMPACT_MAP_HPP
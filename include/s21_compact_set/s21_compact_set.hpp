@@ -0,0 +1,105 @@
+//
+// Упорядоченное множество с компактными узлами.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_COMPACT_SET_HPP
+#define CPP2_S21_CONTAINERS_1_S21_COMPACT_SET_HPP
+
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "../s21_compact_tree/s21_compact_tree.hpp"
+#include "../s21_range/s21_range.hpp"
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Set на том же дереве, что и CompactMap: узел Set<int> занимает 16 байт.
+// Ключи нельзя менять через итератор
+template <typename Key, typename Compare = std::less<Key>>
+class CompactSet {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+ private:
+  struct KeyOfValue {
+    static const Key& key(const Key& value) { return value; }
+  };
+  using Tree = CompactTree<Key, KeyOfValue, Compare>;
+
+  Tree tree_;
+
+ public:
+  using iterator = typename Tree::const_iterator;
+  using const_iterator = typename Tree::const_iterator;
+
+  static constexpr size_type kNodeSize = Tree::kNodeSize;
+
+  // Конструкторы
+
+  CompactSet() = default;
+  explicit CompactSet(const Compare& comp) : tree_(comp) {}
+  CompactSet(std::initializer_list<value_type> const& items);
+  CompactSet(const CompactSet& other) = default;
+  CompactSet(CompactSet&& other) noexcept = default;
+  ~CompactSet() = default;
+
+  CompactSet& operator=(const CompactSet& other) = default;
+  CompactSet& operator=(CompactSet&& other) noexcept = default;
+
+  // Итераторы
+
+  iterator begin() const { return tree_.begin(); }
+  iterator end() const { return tree_.end(); }
+
+  // Вместимость
+
+  bool empty() const { return tree_.empty(); }
+  size_type size() const { return tree_.size(); }
+  size_type max_size() const { return Tree::kMaxSize; }
+  size_type capacity() const { return tree_.capacity(); }
+  void reserve(size_type count) { tree_.reserve(count); }
+
+  // Модификаторы
+
+  void clear() { tree_.clear(); }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return tree_.emplaceKey(value, value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return tree_.emplaceKey(value, std::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  void erase(iterator pos) { tree_.erase(pos); }
+  void swap(CompactSet& other) { tree_.swap(other.tree_); }
+  void merge(CompactSet& other) { tree_.merge(other.tree_); }
+
+  // Просмотр контейнера
+
+  iterator find(const Key& key) const { return tree_.find(key); }
+  bool contains(const Key& key) const { return find(key) != end(); }
+  iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  }
+  iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  }
+  IteratorRange<iterator> range(const Key& lo, const Key& hi) const;
+  key_compare key_comp() const { return tree_.key_comp(); }
+
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  bool validateForTesting() const { return tree_.validateForTesting(); }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_COMPACT_SET_HPP
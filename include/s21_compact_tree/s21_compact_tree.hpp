@@ -0,0 +1,223 @@
+//
+// Красно-черное дерево с узлами в массиве и 32-битными ссылками.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_COMPACT_TREE_HPP
+#define CPP2_S21_CONTAINERS_1_S21_COMPACT_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Общая основа CompactMap и CompactSet. Узлы лежат в одном массиве и
+// ссылаются друг на друга 32-битными номерами вместо 8-байтовых указателей,
+// а цвет занимает старший бит поля родителя. Узел Map<int, int> занимает
+// 20 байт вместо 40 у s21::Map (и еще 8-16 байт заголовка malloc на каждый
+// узел), узел Set<int> - 16 байт.
+//
+// Слот 0 - общий черный лист (nil) с изменяемым родителем, как в CLRS:
+// балансировка после удаления не проверяет пустые ссылки отдельно.
+// Освобожденные слоты собираются в список и занимаются снова; массив
+// растет вдвое, когда список пуст. Рост переносит значения, но номера
+// узлов сохраняются, поэтому итераторы (дерево и номер) остаются
+// действительными при любых вставках. Удаление делает недействительным
+// только итератор на удаленный элемент.
+template <typename Value, typename KeyOf, typename Compare>
+class CompactTree {
+ public:
+  using size_type = std::size_t;
+  using index_type = std::uint32_t;
+
+ private:
+  struct Node {
+    alignas(Value) unsigned char storage[sizeof(Value)];
+    index_type left;
+    index_type right;
+    index_type parent : 31;
+    index_type red : 1;
+  };
+
+  static constexpr index_type kNil = 0;
+  // Значение поля parent у слота из списка свободных
+  static constexpr index_type kFreeMark = 0x7FFFFFFF;
+
+ public:
+  // Наибольшее число элементов: номер узла должен уместиться в 31 бит
+  static constexpr size_type kMaxSize = kFreeMark - 1;
+  static constexpr size_type kNodeSize = sizeof(Node);
+
+  template <bool IsConst>
+  class CompactTreeIterator {
+   public:
+    using tree_pointer =
+        std::conditional_t<IsConst, const CompactTree*, CompactTree*>;
+    using value_pointer = std::conditional_t<IsConst, const Value*, Value*>;
+    using value_reference = std::conditional_t<IsConst, const Value&, Value&>;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_pointer;
+    using reference = value_reference;
+
+    CompactTreeIterator() : tree_(nullptr), index_(kNil) {}
+    CompactTreeIterator(tree_pointer tree, index_type index)
+        : tree_(tree), index_(index) {}
+    template <bool OtherConst,
+              typename = std::enable_if_t<IsConst && !OtherConst>>
+    CompactTreeIterator(const CompactTreeIterator<OtherConst>& other)
+        : tree_(other.tree_), index_(other.index_) {}
+
+    value_reference operator*() const { return tree_->valueAt(index_); }
+    value_pointer operator->() const { return &tree_->valueAt(index_); }
+
+    CompactTreeIterator& operator++() {
+      index_ = tree_->next(index_);
+      return *this;
+    }
+    CompactTreeIterator operator++(int) {
+      CompactTreeIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+    // Шаг назад от end() переходит к наибольшему элементу
+    CompactTreeIterator& operator--() {
+      index_ = tree_->prev(index_);
+      return *this;
+    }
+    CompactTreeIterator operator--(int) {
+      CompactTreeIterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    bool operator==(const CompactTreeIterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const CompactTreeIterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    friend class CompactTree;
+    template <bool>
+    friend class CompactTreeIterator;
+
+    tree_pointer tree_;
+    index_type index_;
+  };
+
+  using iterator = CompactTreeIterator<false>;
+  using const_iterator = CompactTreeIterator<true>;
+
+  CompactTree();
+  explicit CompactTree(const Compare& comp);
+  CompactTree(const CompactTree& other);
+  CompactTree(CompactTree&& other) noexcept;
+  ~CompactTree();
+
+  CompactTree& operator=(const CompactTree& other);
+  CompactTree& operator=(CompactTree&& other) noexcept;
+
+  iterator begin() { return iterator(this, minimum(root_)); }
+  iterator end() { return iterator(this, kNil); }
+  const_iterator begin() const { return const_iterator(this, minimum(root_)); }
+  const_iterator end() const { return const_iterator(this, kNil); }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  // Число слотов массива без слота nil
+  size_type capacity() const { return capacity_ == 0 ? 0 : capacity_ - 1; }
+  void reserve(size_type count);
+  void clear();  // массив остается за деревом
+  void swap(CompactTree& other) noexcept;
+  Compare key_comp() const { return comp_; }
+
+  template <typename K>
+  iterator find(const K& key) {
+    return iterator(this, findIndex(key));
+  }
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return const_iterator(this, findIndex(key));
+  }
+  template <typename K>
+  iterator lower_bound(const K& key) {
+    return iterator(this, boundIndex(key, false));
+  }
+  template <typename K>
+  const_iterator lower_bound(const K& key) const {
+    return const_iterator(this, boundIndex(key, false));
+  }
+  template <typename K>
+  iterator upper_bound(const K& key) {
+    return iterator(this, boundIndex(key, true));
+  }
+  template <typename K>
+  const_iterator upper_bound(const K& key) const {
+    return const_iterator(this, boundIndex(key, true));
+  }
+
+  // Строит Value из args в новом узле, только если key еще нет
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceKey(const K& key, Args&&... args);
+  void erase(const_iterator pos);
+  // Переносит из other элементы с отсутствующими здесь ключами
+  void merge(CompactTree& other);
+
+  // Свойства красно-черного дерева, ссылки на родителей, порядок ключей и
+  // список свободных слотов
+  bool validateForTesting() const;
+
+ private:
+  Node* nodes_;
+  size_type capacity_;  // слотов в массиве, включая nil
+  index_type used_;     // слоты [0, used_) хоть раз выдавались
+  index_type free_;     // голова списка свободных слотов, связанного left
+  index_type root_;
+  size_type size_;
+  Compare comp_;
+
+  Value& valueAt(index_type index) {
+    return *std::launder(reinterpret_cast<Value*>(nodes_[index].storage));
+  }
+  const Value& valueAt(index_type index) const {
+    return *std::launder(
+        reinterpret_cast<const Value*>(nodes_[index].storage));
+  }
+  const auto& keyAt(index_type index) const {
+    return KeyOf::key(valueAt(index));
+  }
+
+  index_type minimum(index_type index) const;
+  index_type maximum(index_type index) const;
+  index_type next(index_type index) const;
+  index_type prev(index_type index) const;
+  template <typename K>
+  index_type findIndex(const K& key) const;
+  template <typename K>
+  index_type boundIndex(const K& key, bool upper) const;
+
+  index_type allocateNode();
+  void releaseNode(index_type index);
+  void grow(size_type new_capacity);
+  void destroyAll();
+  void deallocate();
+
+  void rotateLeft(index_type x);
+  void rotateRight(index_type x);
+  void transplant(index_type u, index_type v);
+  void insertFixup(index_type z);
+  void eraseFixup(index_type x);
+  int blackHeight(index_type index, size_type& count, bool& valid) const;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_COMPACT_TREE_HPP
@@ -0,0 +1,121 @@
+//
+// Потокобезопасный упорядоченный словарь, разбитый на шарды.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_CONCURRENT_MAP_HPP
+#define CPP2_S21_CONTAINERS_1_S21_CONCURRENT_MAP_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+#include "../s21_hash_mix/s21_hash_mix.hpp"
+#include "../s21_map/s21_map.hpp"
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Счетчики одного шарда с момента создания или reset_shard_stats.
+// contended_* - сколько захватов застали замок занятым и ждали
+struct ShardStats {
+  std::size_t size = 0;
+  std::size_t reads = 0;
+  std::size_t writes = 0;
+  std::size_t contended_reads = 0;
+  std::size_t contended_writes = 0;
+};
+
+// Ключи распределяются по шардам хешем, у каждого шарда свое дерево s21::Map
+// и свой замок читателей-писателей: точечные операции разных потоков
+// конфликтуют, только попав в один шард. Шард выбирается хешем, а не
+// диапазоном ключей, чтобы нагрузка не зависела от распределения ключей;
+// упорядоченный обход поэтому сливает отрезки всех шардов.
+//
+// Итераторы наружу не отдаются: найденные значения копируются, а изменение
+// на месте делается через update под замком шарда.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Hash = std::hash<Key>>
+class ConcurrentMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using hasher = Hash;
+
+  static constexpr size_type kDefaultShardCount = 16;
+
+  // Число шардов округляется вверх до степени двойки
+  explicit ConcurrentMap(size_type shard_count = kDefaultShardCount,
+                         const Compare& comp = Compare(),
+                         const Hash& hash = Hash());
+  ConcurrentMap(const ConcurrentMap&) = delete;
+  ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+  ~ConcurrentMap() = default;
+
+  // Точечные операции, каждая под замком одного шарда
+
+  bool insert(const Key& key, const T& obj);  // false, если ключ уже есть
+  bool insert_or_assign(const Key& key, const T& obj);  // true при вставке
+  bool erase(const Key& key);
+  bool contains(const Key& key) const;
+  std::optional<T> find(const Key& key) const;  // копия значения
+  // Вызывает func(T&) под исключительным замком; false, если ключа нет
+  template <typename Func>
+  bool update(const Key& key, Func&& func);
+
+  // Операции над всеми шардами
+
+  // Сумма размеров шардов; при параллельных изменениях - приблизительная
+  size_type size() const;
+  bool empty() const { return size() == 0; }
+  void clear();
+
+  // Вызывает func(const Key&, const T&) для ключей из [lo, hi) в порядке
+  // возрастания. Все шарды держатся под разделяемыми замками до конца
+  // обхода, поэтому обход видит согласованный срез, но блокирует писателей:
+  // func должна быть короткой и не обращаться к этому же контейнеру
+  template <typename Func>
+  void scan(const Key& lo, const Key& hi, Func&& func) const;
+  Vector<value_type> range(const Key& lo, const Key& hi) const;
+
+  // Статистика
+
+  size_type shard_count() const { return shard_count_; }
+  Vector<ShardStats> shard_stats() const;
+  void reset_shard_stats();
+
+ private:
+  using ShardMap = Map<Key, T, Compare>;
+  using ReadLock = std::shared_lock<std::shared_mutex>;
+  using WriteLock = std::unique_lock<std::shared_mutex>;
+
+  // Каждый шард на своих строках кеша, чтобы замки и счетчики соседних
+  // шардов не делили строку
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    ShardMap map;
+    mutable std::atomic<size_type> reads{0};
+    mutable std::atomic<size_type> writes{0};
+    mutable std::atomic<size_type> contended_reads{0};
+    mutable std::atomic<size_type> contended_writes{0};
+  };
+
+  Shard& shardFor(const Key& key) const;
+  static ReadLock lockShared(const Shard& shard);
+  static WriteLock lockExclusive(Shard& shard);
+
+  std::unique_ptr<Shard[]> shards_;
+  size_type shard_count_;
+  Compare comp_;
+  Hash hash_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_CONCURRENT_MAP_HPP
@@ -1,17 +1,23 @@
 #ifndef CPP2_S21_CONTAINERS_1_PROGRAM_HPP
 #define CPP2_S21_CONTAINERS_1_PROGRAM_HPP
 
+#include "../containers/s21_bloom_filter/s21_bloom_filter.cpp"
 #include "../containers/s21_list/s21_list.cpp"
 #include "../containers/s21_map/s21_map.cpp"
+#include "../containers/s21_node_pool/s21_node_pool.cpp"
 #include "../containers/s21_queue/s21_queue.cpp"
 #include "../containers/s21_set/s21_set.cpp"
 #include "../containers/s21_stack/s21_stack.cpp"
+#include "../containers/s21_thread_pool/s21_thread_pool.cpp"
 #include "../containers/s21_vector/s21_vector.cpp"
+#include "s21_bloom_filter/s21_bloom_filter.hpp"
 #include "s21_list/s21_list.hpp"
 #include "s21_map/s21_map.hpp"
+#include "s21_node_pool/s21_node_pool.hpp"
 #include "s21_queue/s21_queue.hpp"
 #include "s21_set/s21_set.hpp"
 #include "s21_stack/s21_stack.hpp"
+#include "s21_thread_pool/s21_thread_pool.hpp"
 #include "s21_vector/s21_vector.hpp"
 
 #endif  // CPP2_S21_CONTAINERS_1_PROGRAM_HPP
\ No newline at end of file
@@ -6,8 +6,38 @@
 #define CPP2_S21_CONTAINERS_1_S21_CONTAINERSPLUS_HPP
 
 #include "../containers/s21_array/s21_array.cpp"
+#include "../containers/s21_btree_map/s21_btree_map.cpp"
+#include "../containers/s21_compact_map/s21_compact_map.cpp"
+#include "../containers/s21_compact_set/s21_compact_set.cpp"
+#include "../containers/s21_compact_tree/s21_compact_tree.cpp"
+#include "../containers/s21_concurrent_map/s21_concurrent_map.cpp"
+#include "../containers/s21_flat_map/s21_flat_map.cpp"
+#include "../containers/s21_flat_set/s21_flat_set.cpp"
+#include "../containers/s21_hash_table/s21_hash_table.cpp"
+#include "../containers/s21_int_set/s21_int_set.cpp"
 #include "../containers/s21_multiset//s21_multiset.cpp"
+#include "../containers/s21_parallel/s21_parallel.cpp"
+#include "../containers/s21_persistent_map/s21_persistent_map.cpp"
+#include "../containers/s21_set_algebra/s21_set_algebra.cpp"
+#include "../containers/s21_splay_map/s21_splay_map.cpp"
+#include "../containers/s21_unordered_map/s21_unordered_map.cpp"
+#include "../containers/s21_unordered_set/s21_unordered_set.cpp"
 #include "s21_array/s21_array.hpp"
+#include "s21_btree_map/s21_btree_map.hpp"
+#include "s21_compact_map/s21_compact_map.hpp"
+#include "s21_compact_set/s21_compact_set.hpp"
+#include "s21_compact_tree/s21_compact_tree.hpp"
+#include "s21_concurrent_map/s21_concurrent_map.hpp"
+#include "s21_flat_map/s21_flat_map.hpp"
+#include "s21_flat_set/s21_flat_set.hpp"
+#include "s21_hash_table/s21_hash_table.hpp"
+#include "s21_int_set/s21_int_set.hpp"
 #include "s21_multiset/s21_multiset.hpp"
+#include "s21_parallel/s21_parallel.hpp"
+#include "s21_persistent_map/s21_persistent_map.hpp"
+#include "s21_set_algebra/s21_set_algebra.hpp"
+#include "s21_splay_map/s21_splay_map.hpp"
+#include "s21_unordered_map/s21_unordered_map.hpp"
+#include "s21_unordered_set/s21_unordered_set.hpp"
 
 #endif  // CPP2_S21_CONTAINERS_1_S21_CONTAINERSPLUS_HPP
@@ -0,0 +1,251 @@
+//
+// Ассоциативный массив на отсортированных массивах ключей и значений.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_FLAT_MAP_HPP
+#define CPP2_S21_CONTAINERS_1_S21_FLAT_MAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "../s21_range/s21_range.hpp"
+#include "../s21_sorted_search/s21_sorted_search.hpp"
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Ассоциативный массив с интерфейсом s21::Map для таблиц, которые строятся
+// один раз и много читаются. Ключи и значения лежат в двух отсортированных
+// s21::Vector: двоичный поиск без ветвлений проходит только по плотному
+// массиву ключей, а на элемент не тратится ни одного указателя. Одиночная
+// вставка и удаление стоят O(n), поэтому строить таблицу лучше пакетом через
+// insert_many или assign_sorted.
+//
+// Отличия от Map: Key и T должны быть конструируемы по умолчанию,
+// разыменование итератора возвращает пару ссылок std::pair<const Key&, T&>,
+// а любая вставка или удаление делает недействительными все итераторы.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class FlatMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = std::pair<const key_type&, mapped_type&>;
+  using const_reference = std::pair<const key_type&, const mapped_type&>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+  class FlatMapIterator;
+  class FlatMapConstIterator;
+
+  class FlatMapIterator {
+   public:
+    // Пары в массивах нет, поэтому operator-> возвращает обертку над парой
+    // ссылок
+    class ArrowProxy {
+     public:
+      explicit ArrowProxy(reference ref) : ref_(ref) {}
+      const reference* operator->() const { return &ref_; }
+
+     private:
+      reference ref_;
+    };
+
+    FlatMapIterator() : key_(nullptr), value_(nullptr) {}
+    FlatMapIterator(const Key* key, T* value) : key_(key), value_(value) {}
+
+    reference operator*() const { return reference(*key_, *value_); }
+    ArrowProxy operator->() const { return ArrowProxy(**this); }
+
+    FlatMapIterator& operator++() {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+    FlatMapIterator operator++(int) {
+      FlatMapIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+    FlatMapIterator& operator--() {
+      --key_;
+      --value_;
+      return *this;
+    }
+    FlatMapIterator operator--(int) {
+      FlatMapIterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    bool operator==(const FlatMapIterator& other) const {
+      return key_ == other.key_;
+    }
+    bool operator!=(const FlatMapIterator& other) const {
+      return key_ != other.key_;
+    }
+
+   private:
+    friend class FlatMap;
+    friend class FlatMapConstIterator;
+
+    const Key* key_;
+    T* value_;
+  };
+
+  class FlatMapConstIterator {
+   public:
+    class ArrowProxy {
+     public:
+      explicit ArrowProxy(const_reference ref) : ref_(ref) {}
+      const const_reference* operator->() const { return &ref_; }
+
+     private:
+      const_reference ref_;
+    };
+
+    FlatMapConstIterator() : key_(nullptr), value_(nullptr) {}
+    FlatMapConstIterator(const Key* key, const T* value)
+        : key_(key), value_(value) {}
+    FlatMapConstIterator(const FlatMapIterator& other)
+        : key_(other.key_), value_(other.value_) {}
+
+    const_reference operator*() const {
+      return const_reference(*key_, *value_);
+    }
+    ArrowProxy operator->() const { return ArrowProxy(**this); }
+
+    FlatMapConstIterator& operator++() {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+    FlatMapConstIterator operator++(int) {
+      FlatMapConstIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+    FlatMapConstIterator& operator--() {
+      --key_;
+      --value_;
+      return *this;
+    }
+    FlatMapConstIterator operator--(int) {
+      FlatMapConstIterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    bool operator==(const FlatMapConstIterator& other) const {
+      return key_ == other.key_;
+    }
+    bool operator!=(const FlatMapConstIterator& other) const {
+      return key_ != other.key_;
+    }
+
+   private:
+    friend class FlatMap;
+
+    const Key* key_;
+    const T* value_;
+  };
+
+  using iterator = FlatMapIterator;
+  using const_iterator = FlatMapConstIterator;
+
+  // Конструкторы
+
+  FlatMap();
+  explicit FlatMap(const Compare& comp);
+  FlatMap(std::initializer_list<value_type> const& items);  // одним пакетом
+  FlatMap(const FlatMap& other);
+  FlatMap(FlatMap&& other) noexcept;
+  ~FlatMap() = default;
+
+  FlatMap& operator=(const FlatMap& other);
+  FlatMap& operator=(FlatMap&& other) noexcept;
+
+  // Доступ к элементам
+
+  T& at(const Key& key);
+  const T& at(const Key& key) const;
+  T& operator[](const Key& key);
+
+  // Итераторы
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Вместимость
+
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  void reserve(size_type count);  // выделяет память под count элементов
+  void shrink_to_fit();           // отдает память сверх size()
+
+  // Модификаторы
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(const Key& key, const T& obj);
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  void erase(iterator pos);
+  void swap(FlatMap& other);
+  // Сливает элементы за один проход по обоим массивам; повторяющиеся ключи
+  // остаются в other
+  void merge(FlatMap& other);
+
+  // Просмотр контейнера
+
+  bool contains(const Key& key) const;
+  iterator find(const Key& key);
+  const_iterator find(const Key& key) const;
+  key_compare key_comp() const { return comp_; }
+
+  iterator lower_bound(const Key& key);  // первый ключ, не меньший key
+  const_iterator lower_bound(const Key& key) const;
+  iterator upper_bound(const Key& key);  // первый ключ, больший key
+  const_iterator upper_bound(const Key& key) const;
+  std::pair<iterator, iterator> equal_range(const Key& key);
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+  IteratorRange<iterator> range(const Key& lo, const Key& hi);
+  IteratorRange<const_iterator> range(const Key& lo, const Key& hi) const;
+
+  // Сортирует аргументы и вливает их в массивы за один проход вместо
+  // сдвига хвоста на каждый элемент. Из повторов внутри пакета вставляется
+  // первый, как при последовательных insert
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  // Заменяет содержимое отсортированным по ключу диапазоном без сравнений
+  // между соседями. С checked = true порядок проверяется, и при нарушении
+  // элементы вставляются пакетом
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last, bool checked = false);
+
+ private:
+  Vector<Key> keys_;
+  Vector<T> values_;
+  Compare comp_;
+
+  size_type lowerIndex(const Key& key) const;
+  iterator iteratorAt(size_type index);
+  const_iterator iteratorAt(size_type index) const;
+  template <typename... Args>
+  std::pair<iterator, bool> emplaceUnique(const Key& key, Args&&... args);
+  // Вливает batch в массивы, перемещая значения; inserted[i] - вставлен ли
+  // batch[i]
+  void insertBatch(Vector<std::pair<Key, T>>& batch, Vector<bool>& inserted);
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_FLAT_MAP_HPP
@@ -0,0 +1,108 @@
+//
+// Множество на отсортированном массиве.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_FLAT_SET_HPP
+#define CPP2_S21_CONTAINERS_1_S21_FLAT_SET_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "../s21_range/s21_range.hpp"
+#include "../s21_sorted_search/s21_sorted_search.hpp"
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Множество с интерфейсом s21::Set, хранящее ключи подряд в отсортированном
+// s21::Vector. Поиск - двоичный без ветвлений, память - только сами ключи,
+// а обход идет по непрерывному массиву. Одиночная вставка и удаление стоят
+// O(n), поэтому таблицы строятся пакетом через insert_many или assign_sorted
+// и дальше в основном читаются.
+//
+// Key должен быть конструируем по умолчанию. Любая вставка или удаление
+// делает недействительными все итераторы.
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = const Key*;  // ключи нельзя менять через итератор
+  using const_iterator = const Key*;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+  // Конструкторы
+
+  FlatSet();
+  explicit FlatSet(const Compare& comp);
+  FlatSet(std::initializer_list<value_type> const& items);  // одним пакетом
+  FlatSet(const FlatSet& other);
+  FlatSet(FlatSet&& other) noexcept;
+  ~FlatSet() = default;
+
+  FlatSet& operator=(const FlatSet& other);
+  FlatSet& operator=(FlatSet&& other) noexcept;
+
+  // Итераторы
+
+  iterator begin() const { return keys_.begin(); }
+  iterator end() const { return keys_.end(); }
+
+  // Вместимость
+
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  void reserve(size_type count);  // выделяет память под count ключей
+  void shrink_to_fit();           // отдает память сверх size()
+
+  // Модификаторы
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  void erase(iterator pos);
+  void swap(FlatSet& other);
+  // Сливает ключи за один проход по обоим массивам; повторяющиеся ключи
+  // остаются в other
+  void merge(FlatSet& other);
+
+  // Просмотр контейнера
+
+  iterator find(const Key& key) const;
+  bool contains(const Key& key) const;
+  key_compare key_comp() const { return comp_; }
+
+  iterator lower_bound(const Key& key) const;  // первый ключ, не меньший key
+  iterator upper_bound(const Key& key) const;  // первый ключ, больший key
+  std::pair<iterator, iterator> equal_range(const Key& key) const;
+  IteratorRange<iterator> range(const Key& lo, const Key& hi) const;
+
+  // Сортирует аргументы и вливает их в массив за один проход вместо
+  // сдвига хвоста на каждый ключ. Из повторов внутри пакета вставляется
+  // первый, как при последовательных insert
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  // Заменяет содержимое отсортированным диапазоном без сравнений между
+  // соседями. С checked = true порядок проверяется, и при нарушении ключи
+  // вставляются пакетом
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last, bool checked = false);
+
+ private:
+  Vector<Key> keys_;
+  Compare comp_;
+
+  size_type lowerIndex(const Key& key) const;
+  // Вливает batch в keys_; inserted[i] - вставлен ли batch[i]
+  void insertBatch(const Vector<Key>& batch, Vector<bool>& inserted);
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_FLAT_SET_HPP
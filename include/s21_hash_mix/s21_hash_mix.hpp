@@ -0,0 +1,24 @@
+//
+// Перемешивание хешей для хеш-таблиц, шардов и фильтра Блума.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_HASH_MIX_HPP
+#define CPP2_S21_CONTAINERS_1_S21_HASH_MIX_HPP
+
+#include <cstdint>
+
+namespace s21 {
+
+// std::hash целых чисел - тождественная функция, поэтому хеш умножается на
+// нечетную константу золотого сечения, а старшая половина произведения
+// складывается с младшей. Старшие 32 бита результата - старшие биты
+// произведения, младшие - их сумма по модулю 2 с младшими; и те, и другие
+// зависят от всех битов исходного хеша
+inline std::uint64_t mixHash(std::uint64_t hash) {
+  std::uint64_t product = hash * 0x9E3779B97F4A7C15ULL;
+  return product ^ (product >> 32);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_HASH_MIX_HPP
@@ -0,0 +1,246 @@
+//
+// Хеш-таблица с открытой адресацией и групповым пробированием (SwissTable).
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_HASH_TABLE_HPP
+#define CPP2_S21_CONTAINERS_1_S21_HASH_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../s21_hash_mix/s21_hash_mix.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+// Управляющий байт слота: неотрицательное значение - 7 младших бит хеша
+// занятого слота, отрицательные - служебные состояния
+using ctrl_t = signed char;
+
+constexpr ctrl_t kCtrlEmpty = -128;   // слот никогда не был занят
+constexpr ctrl_t kCtrlDeleted = -2;   // надгробие после удаления
+constexpr ctrl_t kCtrlSentinel = -1;  // байт за последним слотом
+
+// Множество позиций в группе: бит i - слот i группы
+class BitMask {
+ public:
+  explicit BitMask(std::uint32_t mask) : mask_(mask) {}
+
+  bool any() const { return mask_ != 0; }
+  unsigned lowest() const {
+    return static_cast<unsigned>(__builtin_ctz(mask_));
+  }
+  void clearLowest() { mask_ &= mask_ - 1; }
+
+ private:
+  std::uint32_t mask_;
+};
+
+// Группа из kWidth управляющих байтов, сравниваемых разом. С SSE2 каждое
+// сравнение - одна инструкция на 16 байт и movemask, без SSE2 - цикл по
+// байтам с тем же результатом
+class Group {
+ public:
+  static constexpr std::size_t kWidth = 16;
+
+#ifdef __SSE2__
+  explicit Group(const ctrl_t* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  BitMask match(ctrl_t h2) const {
+    return BitMask(static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+  BitMask matchEmpty() const { return match(kCtrlEmpty); }
+  // Пустые и удаленные слоты меньше kCtrlSentinel, занятые - больше
+  BitMask matchEmptyOrDeleted() const {
+    return BitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kCtrlSentinel), ctrl_))));
+  }
+
+ private:
+  __m128i ctrl_;
+#else
+  explicit Group(const ctrl_t* ctrl) : ctrl_(ctrl) {}
+
+  BitMask match(ctrl_t h2) const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+    }
+    return BitMask(mask);
+  }
+  BitMask matchEmpty() const { return match(kCtrlEmpty); }
+  BitMask matchEmptyOrDeleted() const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl_[i] < kCtrlSentinel) << i;
+    }
+    return BitMask(mask);
+  }
+
+ private:
+  const ctrl_t* ctrl_;
+#endif
+};
+
+// Общая основа UnorderedMap и UnorderedSet. Слоты и управляющие байты лежат
+// в двух массивах одной длины - степени двойки, кратной ширине группы.
+// Хеш делится на h1 (номер первой группы) и h2 (7 бит в управляющем байте):
+// поиск сравнивает h2 со всей группой за раз и проверяет ключи только у
+// совпавших слотов, а встреча пустого слота в группе завершает поиск.
+//
+// KeyOf::key(value) возвращает ключ значения. Элементы лежат прямо в
+// массиве слотов, поэтому рост таблицы перемещает их и делает итераторы
+// недействительными; удаление итераторы на другие элементы не трогает.
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+class HashTable {
+ public:
+  using size_type = std::size_t;
+
+  template <bool IsConst>
+  class HashTableIterator {
+   public:
+    using value_pointer = std::conditional_t<IsConst, const Value*, Value*>;
+    using value_reference = std::conditional_t<IsConst, const Value&, Value&>;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_pointer;
+    using reference = value_reference;
+
+    HashTableIterator() : ctrl_(nullptr), slot_(nullptr) {}
+    HashTableIterator(const ctrl_t* ctrl, value_pointer slot)
+        : ctrl_(ctrl), slot_(slot) {}
+    template <bool OtherConst,
+              typename = std::enable_if_t<IsConst && !OtherConst>>
+    HashTableIterator(const HashTableIterator<OtherConst>& other)
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    value_reference operator*() const { return *slot_; }
+    value_pointer operator->() const { return slot_; }
+
+    // Сигнальный байт за последним слотом останавливает пропуск свободных
+    HashTableIterator& operator++() {
+      do {
+        ++ctrl_;
+        ++slot_;
+      } while (*ctrl_ < kCtrlSentinel);
+      return *this;
+    }
+    HashTableIterator operator++(int) {
+      HashTableIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const HashTableIterator& other) const {
+      return ctrl_ == other.ctrl_;
+    }
+    bool operator!=(const HashTableIterator& other) const {
+      return ctrl_ != other.ctrl_;
+    }
+
+   private:
+    friend class HashTable;
+    template <bool>
+    friend class HashTableIterator;
+
+    const ctrl_t* ctrl_;
+    value_pointer slot_;
+  };
+
+  using iterator = HashTableIterator<false>;
+  using const_iterator = HashTableIterator<true>;
+
+  static constexpr float kDefaultMaxLoadFactor = 0.875f;
+
+  HashTable();
+  HashTable(const Hash& hash, const KeyEqual& equal);
+  HashTable(const HashTable& other);
+  HashTable(HashTable&& other) noexcept;
+  ~HashTable();
+
+  HashTable& operator=(const HashTable& other);
+  HashTable& operator=(HashTable&& other) noexcept;
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type bucket_count() const { return capacity_; }
+  float load_factor() const;
+  float max_load_factor() const { return max_load_factor_; }
+  // Значение из (0, 1]; таблица сразу растет, если уже переполнена
+  void max_load_factor(float factor);
+  // Готовит место под count элементов без роста при вставках
+  void reserve(size_type count);
+  // Перестраивает таблицу под не менее чем count слотов, убирая надгробия
+  void rehash(size_type count);
+  void clear();
+  void swap(HashTable& other) noexcept;
+
+  Hash hash_function() const { return hash_; }
+  KeyEqual key_eq() const { return equal_; }
+
+  template <typename K>
+  iterator find(const K& key);
+  template <typename K>
+  const_iterator find(const K& key) const;
+
+  // Строит Value из args в свободном слоте, только если key еще нет
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceKey(const K& key, Args&&... args);
+
+  void erase(const_iterator pos);
+  template <typename K>
+  size_type eraseKey(const K& key);
+
+  // Переносит из other элементы с отсутствующими здесь ключами
+  void merge(HashTable& other);
+
+  // Проверяет счетчики, сигнальный байт и находимость каждого элемента
+  bool validateForTesting() const;
+
+ private:
+  ctrl_t* ctrl_;  // capacity_ байтов и сигнальный байт
+  Value* slots_;
+  size_type capacity_;
+  size_type size_;
+  size_type deleted_;  // число надгробий
+  float max_load_factor_;
+  Hash hash_;
+  KeyEqual equal_;
+
+  static size_type mix(size_type hash) {
+    return static_cast<size_type>(mixHash(hash));
+  }
+  static ctrl_t h2(size_type hash) {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  }
+  size_type groupCount() const { return capacity_ / Group::kWidth; }
+  size_type growthLimit(size_type capacity) const;
+  size_type capacityFor(size_type count) const;
+
+  template <typename K>
+  size_type findIndex(const K& key, size_type hash) const;
+  // Первый пустой или удаленный слот на пути пробирования хеша
+  size_type findFreeSlot(size_type hash) const;
+  void resize(size_type new_capacity);
+  void destroyAll();
+  void deallocate();
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_HASH_TABLE_HPP
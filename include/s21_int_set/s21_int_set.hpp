@@ -0,0 +1,240 @@
+//
+// Сжатое множество 32-битных целых в духе Roaring bitmap.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_INT_SET_HPP
+#define CPP2_S21_CONTAINERS_1_S21_INT_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Старшие 16 бит ключа выбирают корзину, младшие хранятся в контейнере
+// корзины одним из трех способов:
+// - массив - отсортированные младшие половины, до 4096 ключей (2 байта на
+//   ключ);
+// - битовая карта - 1024 слова по 64 бита, если ключей больше 4096 (8 КБ);
+// - серии - пары (начало, длина - 1); их выбирает run_optimize(), когда они
+//   короче двух других форм.
+// Поиск - двоичный поиск по массиву старших половин и затем внутри одного
+// контейнера. Объединение и пересечение обрабатывают карты по 64 ключа за
+// операцию над словом. Итераторы только для чтения и перебирают ключи по
+// возрастанию; любая вставка или удаление делает их недействительными
+class IntSet {
+ public:
+  using key_type = std::uint32_t;
+  using value_type = std::uint32_t;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+
+ private:
+  enum class Kind : unsigned char { kArray, kBitmap, kRun };
+
+  struct Container {
+    Kind kind = Kind::kArray;
+    std::uint16_t high = 0;  // старшая половина ключей корзины
+    std::uint32_t cardinality = 0;
+    // kArray - отсортированные ключи, kRun - пары начало, длина - 1
+    std::vector<std::uint16_t> values;
+    std::vector<std::uint64_t> words;  // kBitmap
+  };
+
+  static constexpr std::uint32_t kArrayMax = 4096;
+  static constexpr std::size_t kBitmapWords = 1024;
+
+  // Старшая половина ключей корзины в старших 16 битах, номер ее
+  // контейнера в containers_ - в младших; по возрастанию старших половин.
+  // Новая корзина сдвигает только эти 4-байтные записи, а не контейнеры
+  std::vector<std::uint32_t> directory_;
+  std::vector<Container> containers_;  // в порядке создания корзин
+  size_type size_ = 0;
+
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = IntSet::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+
+    reference operator*() const { return value_; }
+    pointer operator->() const { return &value_; }
+    const_iterator& operator++();
+    const_iterator operator++(int) {
+      const_iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+    bool operator==(const const_iterator& other) const {
+      return bucket_ == other.bucket_ && value_ == other.value_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class IntSet;
+
+    const_iterator(const IntSet* set, size_type bucket, std::uint32_t pos,
+                   value_type value)
+        : set_(set), bucket_(bucket), pos_(pos), value_(value) {}
+    // Первый ключ корзины bucket или end(), если корзин больше нет
+    void enterBucket(size_type bucket);
+
+    const IntSet* set_ = nullptr;
+    size_type bucket_ = 0;
+    std::uint32_t pos_ = 0;  // индекс в массиве или номер серии
+    value_type value_ = 0;
+  };
+  using iterator = const_iterator;
+
+  // Конструкторы
+
+  IntSet() = default;
+  IntSet(std::initializer_list<value_type> const& items);
+  IntSet(const IntSet& other) = default;
+  IntSet(IntSet&& other) noexcept = default;
+  ~IntSet() = default;
+
+  IntSet& operator=(const IntSet& other) = default;
+  IntSet& operator=(IntSet&& other) noexcept = default;
+
+  // Итераторы
+
+  const_iterator begin() const;
+  const_iterator end() const {
+    return const_iterator(this, directory_.size(), 0, 0);
+  }
+
+  // Вместимость
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const { return size_type{1} << 32; }
+  // Байты, занятые множеством вместе с его кучей
+  size_type memory_usage() const;
+
+  // Модификаторы
+
+  void clear();
+  std::pair<iterator, bool> insert(value_type value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  void erase(iterator pos) { erase(*pos); }
+  size_type erase(value_type value);
+  void swap(IntSet& other) noexcept;
+  // Переводит в серии контейнеры, которым так нужно меньше памяти, и
+  // освобождает запас емкости. Возвращает true, если серии появились
+  bool run_optimize();
+
+  // Просмотр контейнера
+
+  bool contains(value_type value) const;
+  iterator find(value_type value) const;
+  iterator lower_bound(value_type value) const;  // первый ключ, не меньший
+  size_type count(value_type value) const { return contains(value); }
+
+  bool operator==(const IntSet& other) const;
+  bool operator!=(const IntSet& other) const { return !(*this == other); }
+
+  // Проверяет формы контейнеров, порядок и счетчики ключей
+  bool validateForTesting() const;
+
+ private:
+  friend IntSet set_union(const IntSet& a, const IntSet& b);
+  friend IntSet set_intersection(const IntSet& a, const IntSet& b);
+  friend IntSet set_difference(const IntSet& a, const IntSet& b);
+  friend IntSet symmetric_difference(const IntSet& a, const IntSet& b);
+  friend IntSet::size_type intersection_size(const IntSet& a,
+                                             const IntSet& b);
+
+  enum class Operation { kUnion, kIntersection, kDifference, kSymmetric };
+
+  static std::uint16_t high(value_type value) {
+    return static_cast<std::uint16_t>(value >> 16);
+  }
+  static std::uint16_t low(value_type value) {
+    return static_cast<std::uint16_t>(value);
+  }
+  // Номер корзины high в directory_ или место, куда ее вставить
+  size_type bucketIndex(std::uint16_t high) const;
+  std::uint16_t bucketKey(size_type index) const {
+    return static_cast<std::uint16_t>(directory_[index] >> 16);
+  }
+  bool bucketFound(size_type index, std::uint16_t high) const {
+    return index < directory_.size() && bucketKey(index) == high;
+  }
+  const Container& bucket(size_type index) const {
+    return containers_[directory_[index] & 0xFFFF];
+  }
+  Container& bucket(size_type index) {
+    return containers_[directory_[index] & 0xFFFF];
+  }
+  void addBucket(size_type index, std::uint16_t high);
+  // Последний контейнер переезжает на место удаленного
+  void removeBucket(size_type index);
+
+  // Операции над одним контейнером. pos в add и seek - позиция для
+  // итератора: индекс в массиве или номер серии
+  static bool containerContains(const Container& c, std::uint16_t value);
+  static bool containerAdd(Container& c, std::uint16_t value,
+                           std::uint32_t& pos);
+  static bool containerRemove(Container& c, std::uint16_t value);
+  // Первый ключ контейнера, не меньший value; false, если такого нет
+  static bool containerSeek(const Container& c, std::uint16_t value,
+                            std::uint32_t& pos, std::uint16_t& found);
+  static bool runAdd(Container& c, std::uint16_t value, std::uint32_t& pos);
+  static bool runRemove(Container& c, std::uint16_t value);
+  // Номер последней серии, начинающейся не позже value, или -1
+  static std::ptrdiff_t runBefore(const Container& c, std::uint16_t value);
+  static std::uint32_t runCount(const Container& c);
+  // Вызывает func для каждого ключа контейнера по возрастанию
+  template <typename Func>
+  static void forEachValue(const Container& c, Func func);
+
+  // Смена формы
+  static void toBitmap(Container& c);
+  static void toArray(Container& c);
+  static void toRuns(Container& c);
+  // Массив или карта - что меньше для текущего числа ключей
+  static void normalize(Container& c);
+  // Ставит биты ключей c в words из kBitmapWords слов
+  static void fillBitmap(const Container& c, std::uint64_t* words);
+
+  // Операции над парой контейнеров одной корзины; пустой результат -
+  // cardinality == 0
+  static Container combineContainers(Operation op, const Container& a,
+                                     const Container& b);
+  static Container combineArrays(Operation op, const Container& a,
+                                 const Container& b);
+  static Container filterArray(const Container& array, const Container& other,
+                               bool keep_present);
+  static Container combineBitmaps(Operation op, const Container& a,
+                                  const Container& b);
+  static std::uint32_t intersectionCount(const Container& a,
+                                         const Container& b);
+  static IntSet combine(Operation op, const IntSet& a, const IntSet& b);
+  void appendBucket(Container&& c);  // корзина больше всех имеющихся
+};
+
+// Те же операции, что для Set и Multiset в s21_set_algebra.hpp, за время,
+// линейное по числу корзин и размеру их контейнеров
+IntSet set_union(const IntSet& a, const IntSet& b);
+IntSet set_intersection(const IntSet& a, const IntSet& b);
+IntSet set_difference(const IntSet& a, const IntSet& b);
+IntSet symmetric_difference(const IntSet& a, const IntSet& b);
+// Размер пересечения без построения результата
+IntSet::size_type intersection_size(const IntSet& a, const IntSet& b);
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_INT_SET_HPP
@@ -5,17 +5,43 @@
 #ifndef CPP2_S21_CONTAINERS_1_S21_MAP_HPP
 #define CPP2_S21_CONTAINERS_1_S21_MAP_HPP
 
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <limits>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "../s21_bloom_filter/s21_bloom_filter.hpp"
+#include "../s21_node_pool/s21_node_pool.hpp"
+#include "../s21_range/s21_range.hpp"
+#include "../s21_thread_pool/s21_thread_pool.hpp"
+#include "../s21_tree_policy/s21_tree_policy.hpp"
 #include "../s21_vector/s21_vector.hpp"
 
 namespace s21 {
 
-template <typename Key, typename T>
+namespace parallel {
+// Доступ параллельных алгоритмов к узлам дерева (s21_parallel.hpp)
+template <typename Tree>
+struct TreeAccess;
+}  // namespace parallel
+
+// NodePolicy добавляет в узлы дополнительные данные (см. s21_tree_policy.hpp):
+// с OrderStatistics доступны rank, select и count_range, а KeyPrefix ускоряет
+// поиск по строковым ключам
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          typename NodePolicy = PlainNodes>
 class Map {
+  template <typename>
+  friend struct parallel::TreeAccess;
+
  public:
   using key_type = Key;   // первый параметр шаблона
   using mapped_type = T;  // второй параметр шаблона
@@ -27,20 +53,54 @@ class Map {
       const value_type&;  // определяет тип ссылки на константу
   using size_type = std::size_t;  // size_t определяет тип размера контейнера
                                   // (стандартный тип — size_t)
+  using key_compare = Compare;  // функция сравнения ключей
+  using allocator_type = Allocator;  // аллокатор, из которого берутся узлы
+
+  static_assert(!NodePolicy::kKeyPrefix ||
+                    (std::is_same<Key, std::string>::value &&
+                     (std::is_same<Compare, std::less<Key>>::value ||
+                      std::is_same<Compare, std::less<>>::value)),
+                "KeyPrefix requires std::string keys ordered by std::less");
 
  private:
-  struct Node {
+  // Цвет узла красно-черного дерева
+  enum class Color : unsigned char { kRed, kBlack };
+
+  struct Node : NodePolicy::NodeBase {
     value_type data;
     Node* left;
     Node* right;
     Node* parent;
-
-    explicit Node(const value_type& value)
-        : data(value), left(nullptr), right(nullptr), parent(nullptr) {}
+    Color color;
+
+    // Значение конструируется на месте из переданных аргументов
+    template <typename... Args>
+    explicit Node(Args&&... args)
+        : data(std::forward<Args>(args)...),
+          left(nullptr),
+          right(nullptr),
+          parent(nullptr),
+          color(Color::kRed) {}
   };
 
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  using NodeHooks = NodeAllocatorHooks<NodeAllocator>;
+  using Filter = BloomFilter<Key, typename BloomFilterHash<Key, Compare>::type>;
+  static constexpr bool kFilterable = kBloomFilterable<Key, Compare>;
+
   Node* root;
   size_type node_count;
+  Node* rightmost_;  // узел с наибольшим ключом для вставки в конец за O(1)
+  Compare comp_;
+  NodeAllocator alloc_;
+  std::unique_ptr<Filter> filter_;  // nullptr, пока не включен
+
+  // Перегрузки с параметром K участвуют в выборе, только если компаратор
+  // прозрачный (объявляет is_transparent), как в std::map
+  template <typename K, typename C = Compare>
+  using TransparentKey = typename C::is_transparent;
 
  public:
   // Вложенный класс итератора
@@ -114,6 +174,7 @@ class Map {
     const Node* root;
 
    public:
+    MapConstIterator() : current(nullptr), root(nullptr) {}
     explicit MapConstIterator(const Node* node, const Node* root)
         : current(node), root(root) {}
 
@@ -138,6 +199,8 @@ class Map {
 
     const_reference operator*() const { return current->data; }
 
+    const value_type* operator->() const { return &(current->data); }
+
    private:
     const Node* findMin(const Node* node) const;
 
@@ -158,9 +221,70 @@ class Map {
   using iterator = MapIterator;
   using const_iterator = MapConstIterator;
 
+  // Узел, извлеченный из контейнера (node_type из std::map). Владеет узлом и
+  // копией аллокатора, которым он выделен, и удаляет узел, если тот так и не
+  // был вставлен обратно
+  class MapNodeHandle {
+   public:
+    MapNodeHandle() noexcept : node_(nullptr), alloc_() {}
+    MapNodeHandle(MapNodeHandle&& other) noexcept
+        : node_(other.node_), alloc_(std::move(other.alloc_)) {
+      other.node_ = nullptr;
+    }
+    MapNodeHandle& operator=(MapNodeHandle&& other) noexcept {
+      if (this != &other) {
+        reset();
+        node_ = other.node_;
+        alloc_ = std::move(other.alloc_);
+        other.node_ = nullptr;
+      }
+      return *this;
+    }
+    MapNodeHandle(const MapNodeHandle&) = delete;
+    MapNodeHandle& operator=(const MapNodeHandle&) = delete;
+    ~MapNodeHandle() { reset(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    const key_type& key() const { return node_->data.first; }
+    mapped_type& mapped() const { return node_->data.second; }
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+   private:
+    friend class Map;
+
+    MapNodeHandle(Node* node, const NodeAllocator& alloc)
+        : node_(node), alloc_(alloc) {}
+
+    void reset() noexcept {
+      if (node_) {
+        NodeTraits::destroy(alloc_, node_);
+        NodeTraits::deallocate(alloc_, node_, 1);
+        node_ = nullptr;
+      }
+    }
+
+    Node* node_;
+    NodeAllocator alloc_;
+  };
+
+  using node_type = MapNodeHandle;
+
+  // Результат insert(node_type&&): при существующем ключе узел возвращается
+  // вызывающему в поле node
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
   // Конструкторы
 
   Map();
+  explicit Map(const Compare& comp,
+               const Allocator& alloc =
+                   Allocator());  // конструктор с компаратором и аллокатором
   Map(std::initializer_list<value_type> const&
           items); /* конструктор списка инициализаторов, создает список,
 инициализированный с использованием std::initializer_list
@@ -170,13 +294,18 @@ class Map {
 
   ~Map();  // Деструктор
 
+  Map& operator=(const Map& other);  // Оператор копирующего присваивания
   Map& operator=(Map&& other) noexcept;  // Оператор присваивания
 
   // Доступ к элементам
 
   T& at(const Key& key);  // доступ к указанному элементу с проверкой границ
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  T& at(const K& key);  // at без построения временного Key
   T& operator[](
       const Key& key);  // получить доступ или вставить указанный элемент
+  T& operator[](Key&& key);
 
   // Итераторы
 
@@ -193,6 +322,8 @@ class Map {
   size_type size() const;  // возвращает количество элементов
   size_type max_size()
       const;  // возвращает максимально возможное количество элементов
+  void reserve(size_type count);  // готовит память аллокатора под count узлов
+  allocator_type get_allocator() const;
 
   // Модификаторы
 
@@ -207,35 +338,220 @@ class Map {
       const T& obj);  // вставляет значение по ключу и возвращает итератор туда,
                       // где находится элемент в контейнере, и логическое
                       // значение, обозначающее, имела ли место вставка.
+  std::pair<iterator, bool> insert(value_type&& value);
+  // Вставляет извлеченный узел без выделения памяти, если аллокаторы равны
+  insert_return_type insert(node_type&& handle);
   std::pair<iterator, bool> insert_or_assign(
       const Key& key, const T& obj);  // удаляет из контейнера либо один
                                       // элемент, либо диапазон элементов.
+  std::pair<iterator, bool> insert_or_assign(const Key& key, T&& obj);
+
+  // Конструирует элемент на месте из args. Узел создается до поиска, поэтому
+  // при существующем ключе он сразу удаляется
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  // Вставка с подсказкой: hint - позиция рядом с новым ключом (соседний
+  // элемент или end() для ключа больше всех). Если подсказка верна, спуска от
+  // корня нет и вставка стоит амортизированно O(1), иначе ключ ищется обычным
+  // спуском. Возвращает итератор на элемент с этим ключом
+  iterator insert(iterator hint, const value_type& value);
+  iterator insert(iterator hint, value_type&& value);
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args);
+
+  // Конструирует значение из args только если ключа key еще нет, иначе
+  // аргументы не используются
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
   void erase(iterator pos);  // стирает элемент в позиции pos
+  // Отцепляет узел от дерева, не уничтожая его; остальные итераторы валидны
+  node_type extract(iterator pos);
+  node_type extract(const Key& key);  // пустой узел, если ключа нет
   void swap(Map& other);  // заменяет содержимое контейнера содержимым x,
                           // которое является другим списком того же типа.
                           // Размеры могут отличаться.
-  void merge(Map& other);  // объединяет два контейнера map
+  // Переносит из other узлы с отсутствующими здесь ключами. При равных
+  // аллокаторах узлы перевешиваются без выделений; повторяющиеся ключи
+  // остаются в other
+  void merge(Map& other);
 
   // Просмотр контейнера
 
   bool contains(const Key& key)
       const;  // проверяет, есть ли в контейнере элемент с ключом key
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  bool contains(const K& key) const;
   void custom_swap(T& a, T& b);
 
   // Вспомогательные методы
 
   Node* findNodeForTesting(const Key& key) const { return findNode(key); }
+  bool validateForTesting()
+      const;  // проверяет свойства красно-черного дерева и связи с родителями
   iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  iterator find(const K& key);
+  key_compare key_comp() const { return comp_; }
+
+  // Фильтр Блума перед contains(key) и find(key), как у Set: большинство
+  // промахов отвечается им без спуска по дереву. Фильтр пополняется при
+  // вставке и перестраивается по дереву после его роста и после удаления
+  // половины вставленных ключей. Хеш берется из BloomFilterHash<Key,
+  // Compare> и обязан быть согласован с компаратором; перегрузки с
+  // прозрачным компаратором фильтр не используют
+  void enable_filter(double bits_per_key = 10.0);
+  void disable_filter() { filter_.reset(); }
+  bool filter_enabled() const { return filter_ != nullptr; }
+  BloomFilterStats filter_stats() const;  // нули, если фильтр выключен
+
+  // Порядковые статистики, только для NodePolicy = OrderStatistics
+  size_type rank(const Key& key) const;  // число ключей, меньших key
+  iterator select(size_type index);  // элемент с номером index или end()
+  const_iterator select(size_type index) const;
+  iterator nth(size_type index) { return select(index); }
+  const_iterator nth(size_type index) const { return select(index); }
+  size_type count_range(const Key& lo, const Key& hi) const;  // в [lo, hi)
+
+  // Поиск границ - один спуск от корня за O(log n)
+  iterator lower_bound(const Key& key);  // первый ключ, не меньший key
+  const_iterator lower_bound(const Key& key) const;
+  iterator upper_bound(const Key& key);  // первый ключ, больший key
+  const_iterator upper_bound(const Key& key) const;
+  std::pair<iterator, iterator> equal_range(const Key& key);
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+  // Элементы с ключами из [lo, hi); пусто, если hi не больше lo
+  IteratorRange<iterator> range(const Key& lo, const Key& hi);
+  IteratorRange<const_iterator> range(const Key& lo, const Key& hi) const;
 
   template <typename... Args>
   Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
 
+  // Заменяет содержимое элементами из [first, last), отсортированными по
+  // строго возрастающему ключу. Дерево строится сразу сбалансированным за O(n).
+  // При checked = true порядок проверяется, и если он нарушен, элементы
+  // вставляются по одному (при повторе ключа остается первый элемент)
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last, bool checked = false);
+
+  // Заменяет содержимое элементами из [first, last) в любом порядке. Копия
+  // входа сортируется параллельно на pool, из повторов ключа остается первый,
+  // а нижние поддеревья сбалансированного дерева строятся в потоках pool.
+  // С аллокатором, отличным от std::allocator, узлы создает один поток
+  template <typename RandomIt>
+  void assign_parallel(RandomIt first, RandomIt last, ThreadPool& pool);
+
  private:
-  Node* findNode(const Key& key) const;
+  template <typename K>
+  Node* findNode(const K& key) const;
+  // Один спуск от корня: возвращает узел с ключом key или nullptr и
+  // запоминает родителя и сторону, куда подвешивать новый узел
+  template <typename K>
+  Node* findInsertPosition(const K& key, Node*& parent, bool& as_left) const;
+  // То же, но сначала проверяет место рядом с hint (nullptr - end())
+  template <typename K>
+  Node* findHintPosition(Node* hint, const K& key, Node*& parent,
+                         bool& as_left) const;
+  iterator attachNode(Node* node, Node* parent, bool as_left);
+  void unlinkNode(Node* node);  // вынимает узел из дерева с балансировкой
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplaceImpl(K&& key, Args&&... args);
   Node* findMin(Node* node) const;
+  Node* findMax(Node* node) const;
+  // Соседние по порядку ключей узлы, nullptr за краем дерева
+  static Node* findPrev(Node* node);
+  static Node* findNext(Node* node);
+  // Первый узел, ключ которого не меньше key (при upper - больше key)
+  Node* findBound(const Key& key, bool upper) const;
+
+  // Сравнения искомого ключа с ключом узла. prefix - результат keyPrefix(key):
+  // с политикой KeyPrefix разные префиксы решают сравнение без чтения строки
+  // узла, без нее prefix не используется
+  template <typename K>
+  static std::uint64_t keyPrefix(const K& key);
+  template <typename K>
+  bool lessThanNode(const K& key, std::uint64_t prefix,
+                    const Node* node) const;
+  template <typename K>
+  bool nodeLessThan(const Node* node, const K& key,
+                    std::uint64_t prefix) const;
+  Node* findByIndex(size_type index) const;
+  void updatePath(Node* node);  // пересчитывает NodePolicy от node до корня
+  // Поддержка фильтра Блума; без включенного фильтра ничего не делают
+  void filterInsert(const Key& key);
+  void filterErase();
+  void rebuildFilter();  // заново по ключам дерева
+  // Узел key или nullptr; промах, отсеянный фильтром, не спускается по дереву
+  Node* filteredFind(const Key& key) const;
   void clear(Node* node);
+
+  // Балансировка красно-черного дерева
+  static bool isRed(const Node* node);
+  void rotateLeft(Node* node);
+  void rotateRight(Node* node);
+  void insertFixup(Node* node);
+  void eraseFixup(Node* node, Node* parent);
+  void transplant(Node* target, Node* replacement);
+  int blackHeight(const Node* node) const;  // -1, если поддерево некорректно
+
+  // Поузловое копирование дерева за O(n) без сравнений ключей
+  void copyFrom(const Map& other, Node* reuse);
+  void cloneTree(const Node* source, Node* parent, Node** slot, Node*& reuse);
+  template <typename V>
+  Node* makeNode(V&& value, Node*& reuse);
+  Node* detachNodes();  // разбирает дерево в список узлов, связанных по right
+  void deleteNodes(Node* list);
+  void releaseNodes();  // уничтожает все узлы, не обнуляя root
+
+  template <typename... Args>
+  Node* createNode(Args&&... args);
+  void destroyNode(Node* node);
+
+  template <typename ForwardIt>
+  Node* buildSorted(ForwardIt& it, size_type count, size_type depth,
+                    size_type red_depth, Node*& reuse);
+  // Число полностью заполненных уровней дерева из count узлов: глубже
+  // buildSorted красит узлы в красный
+  static size_type fullLevels(size_type count);
+
+  // Параллельное построение: узлы выше split_depth создаются сразу, а
+  // поддеревья на этой глубине откладываются и строятся в потоках
+  template <typename RandomIt>
+  struct ParallelBuild {
+    struct Subtree {
+      RandomIt first;
+      size_type count;
+      size_type depth;
+      Node* parent;
+      Node** slot;  // ссылка родителя, куда подвесить поддерево
+    };
+    size_type split_depth;
+    size_type red_depth;
+    std::vector<Subtree> subtrees;
+    std::vector<Node*> top;  // верхние узлы, потомки раньше родителей
+  };
+  template <typename RandomIt>
+  Node* buildParallel(RandomIt first, size_type count, ThreadPool& pool);
+  template <typename RandomIt>
+  void buildTop(RandomIt first, size_type count, size_type depth,
+                Node* parent, Node** slot, ParallelBuild<RandomIt>& build);
 };
 
+// Map с размерами поддеревьев в узлах
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+using RankedMap = Map<Key, T, Compare, Allocator, OrderStatistics>;
+
+// Map со строковыми ключами и префиксами ключей в узлах
+template <typename T, typename Compare = std::less<std::string>,
+          typename Allocator =
+              std::allocator<std::pair<const std::string, T>>>
+using PrefixMap = Map<std::string, T, Compare, Allocator, KeyPrefix>;
+
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_1_S21_MAP_HPP
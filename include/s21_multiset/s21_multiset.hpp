@@ -9,14 +9,33 @@
 #include <initializer_list>
 #include <iterator>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
+#include "../s21_node_pool/s21_node_pool.hpp"
+#include "../s21_thread_pool/s21_thread_pool.hpp"
 #include "../s21_vector/s21_vector.hpp"
 
 namespace s21 {
 
+namespace parallel {
+// Доступ параллельных алгоритмов к узлам дерева (s21_parallel.hpp)
+template <typename Tree>
+struct TreeAccess;
+}  // namespace parallel
+
+// Доступ операций над множествами к узлам дерева (s21_set_algebra.hpp)
+template <typename Tree>
+struct SetAlgebraAccess;
+
 template <typename Key, typename Compare = std::less<Key>,
           typename Allocator = std::allocator<Key>>
 class Multiset {
+  template <typename>
+  friend struct parallel::TreeAccess;
+  template <typename>
+  friend struct SetAlgebraAccess;
+
  private:
   struct Node {
     Key key;
@@ -26,18 +45,32 @@ class Multiset {
     explicit Node(const Key &k) : key(k), left(nullptr), right(nullptr) {}
   };
 
+  // Узлы выделяются аллокатором, перепривязанным к типу узла
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  using NodeHooks = NodeAllocatorHooks<NodeAllocator>;
+
   Node *root_;
   size_t size_;
   Compare comp_;
-  Allocator alloc_;
+  NodeAllocator alloc_;
+
+  // Перегрузки с параметром K доступны только для прозрачного компаратора
+  template <typename K, typename C = Compare>
+  using TransparentKey = typename C::is_transparent;
 
   void clear(Node *node);
+  void release_nodes();  // уничтожает все узлы, не обнуляя root_
+  Node *create_node(const Key &key);
+  void destroy_node(Node *node);
   // Вставляет ключ в дерево, начиная с указанного узла
   Node *insert(Node *node, const Key &key);
 
   // Находит узел с заданным ключом, начиная с указанного узла (константная
   // версия)
-  Node *find(Node *node, const Key &key) const;
+  template <typename K>
+  Node *find(Node *node, const K &key) const;
 
   // Находит первый узел не меньший, чем заданный ключ, начиная с указанного
   // узла (константная версия)
@@ -56,12 +89,51 @@ class Multiset {
   // Находит узел с минимальным ключом, начиная с указанного узла
   Node *find_min(Node *node) const;
 
+  // Подсчитывает узлы с заданным ключом в поддереве
+  template <typename K>
+  size_t count(Node *node, const K &key) const;
+
+  // Строит идеально сбалансированное поддерево из count элементов,
+  // забирая их из it по порядку
+  template <typename ForwardIt>
+  Node *build_sorted(ForwardIt &it, size_t count);
+
+  // Переделывает дерево поворотами в цепочку по правым ссылкам в порядке
+  // ключей
+  static Node *flatten(Node *node);
+
+  // Идеально сбалансированное поддерево из первых count узлов цепочки list
+  static Node *build_from_list(Node *&list, size_t count);
+
+  // Делает пустое дерево деревом из цепочки count узлов, выделенных alloc_
+  void adopt_list(Node *list, size_t count);
+
+  // Параллельное построение: узлы выше split_depth создаются сразу, а
+  // поддеревья на этой глубине строятся в потоках
+  template <typename RandomIt>
+  struct ParallelBuild {
+    struct Subtree {
+      RandomIt first;
+      size_t count;
+      Node **slot;  // ссылка родителя, куда подвесить поддерево
+    };
+    size_t split_depth;
+    std::vector<Subtree> subtrees;
+  };
+  template <typename RandomIt>
+  Node *build_parallel(RandomIt first, size_t count, ThreadPool &pool);
+  template <typename RandomIt>
+  void build_top(RandomIt first, size_t count, size_t depth, Node **slot,
+                 ParallelBuild<RandomIt> &build);
+
  public:
   using key_type = Key;
   using value_type = Key;  // мультимножество хранит только ключи
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
   // Вложенный класс итератора
   class iterator {
@@ -110,6 +182,8 @@ class Multiset {
   // Конструкторы
 
   Multiset();
+  explicit Multiset(const Compare &comp,
+                    const Allocator &alloc = Allocator());
 
   Multiset(std::initializer_list<Key> const
                &items); /* конструктор списка инициализаторов, создает
@@ -138,6 +212,8 @@ class Multiset {
   size_type size() const;  // возвращает количество элементов
   size_type max_size()
       const;  // возвращает максимально возможное количество элементов
+  void reserve(size_type count);  // готовит память аллокатора под count узлов
+  allocator_type get_allocator() const;
 
   // Модификаторы
 
@@ -149,7 +225,10 @@ class Multiset {
   void swap(Multiset &other);  // Заменяет содержимое контейнера содержимым x,
   // которое является другим списком того же типа.
   // Размеры могут отличаться.
-  void merge(Multiset &other);  // объединяет два отсортированных контейнера
+  // Забирает все ключи other, other становится пустым. При равных
+  // аллокаторах узлы other переходят в это дерево без копирования, и оба
+  // дерева сливаются за O(n + m); равные ключи этого дерева идут первыми
+  void merge(Multiset &other);
 
   size_type count(const Key &key) const;  // Подсчитывает количество элементов с
   // заданным ключом в мультимножестве
@@ -159,6 +238,18 @@ class Multiset {
       const;  // Находит первый элемент с заданным ключом в мультимножестве
   bool contains(const Key &key)
       const;  // Проверяет наличие элемента с заданным ключом в мультимножестве
+
+  // Поиск по любому типу, сравнимому с Key (только для прозрачного Compare)
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  size_type count(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  iterator find(const K &key);
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  bool contains(const K &key) const;
+  key_compare key_comp() const { return comp_; }
   std::pair<iterator, iterator> equal_range(
       const Key &key);  // Возвращает диапазон элементов с заданным ключом в
   // мультимножестве
@@ -174,6 +265,19 @@ class Multiset {
       const Key &key) const;  // Возвращает итератор на первый элемент больший,
                               // чем заданный ключ
 
+  // Заменяет содержимое неубывающей последовательностью [first, last) и
+  // строит идеально сбалансированное дерево за O(n). При checked = true
+  // порядок проверяется, и при нарушении элементы вставляются по одному
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last, bool checked = false);
+
+  // Заменяет содержимое ключами из [first, last) в любом порядке, сохраняя
+  // повторы: копия сортируется параллельно на pool, нижние поддеревья
+  // строятся в потоках pool. С аллокатором, отличным от std::allocator, узлы
+  // создает один поток
+  template <typename RandomIt>
+  void assign_parallel(RandomIt first, RandomIt last, ThreadPool &pool);
+
   template <typename... Args>
   Vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
     Vector<std::pair<iterator, bool>> result;
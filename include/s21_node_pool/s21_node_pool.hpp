@@ -0,0 +1,145 @@
+//
+// Пул узлов для деревьев Map, Set и Multiset.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_NODE_POOL_HPP
+#define CPP2_S21_CONTAINERS_1_S21_NODE_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Раздает блоки одного размера из больших непрерывных слэбов. Освобожденные
+// блоки складываются в интрузивный список свободных блоков, а release()
+// возвращает всю память сразу за O(число слэбов). Не потокобезопасен.
+class NodePool {
+ public:
+  using size_type = std::size_t;
+
+  NodePool() noexcept;
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+  ~NodePool();
+
+  // Размер и выравнивание блока фиксируются при первом обращении
+  bool serves(size_type bytes, size_type alignment) noexcept;
+  void* allocate();
+  void deallocate(void* block) noexcept;
+
+  // Гарантирует, что следующие blocks выделений обойдутся без нового слэба
+  void reserve(size_type blocks);
+  // Возвращает системе все слэбы; выданные блоки становятся недействительными
+  void release() noexcept;
+
+  size_type block_size() const noexcept { return block_size_; }
+  size_type slab_count() const noexcept { return slab_count_; }
+  size_type in_use() const noexcept { return in_use_; }
+  size_type available() const noexcept { return available_; }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  struct alignas(std::max_align_t) Slab {
+    Slab* next;
+  };
+
+  static constexpr size_type kFirstSlabBlocks = 64;
+  static constexpr size_type kMaxSlabBlocks = 64 * 1024;
+
+  void addSlab(size_type blocks);
+
+  Slab* slabs_;
+  FreeBlock* free_list_;
+  char* cursor_;    // начало еще не выданной части последнего слэба
+  char* slab_end_;  // конец последнего слэба
+  size_type block_size_;
+  size_type block_alignment_;
+  size_type available_;  // блоки в списке свободных и в хвосте слэба
+  size_type in_use_;
+  size_type slab_count_;
+  size_type next_slab_blocks_;
+};
+
+// Аллокатор узлов поверх NodePool. Конструктор по умолчанию создает пул, и
+// все копии, в том числе для другого типа, разделяют его и равны между
+// собой. Перемещение забирает пул целиком; перемещенный аллокатор заводит
+// новый пул при следующем выделении. Запросы другого размера или на
+// несколько объектов сразу уходят в ::operator new.
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <typename U>
+  struct rebind {
+    using other = PoolAllocator<U>;
+  };
+
+  PoolAllocator();
+  PoolAllocator(const PoolAllocator& other) noexcept = default;
+  PoolAllocator(PoolAllocator&& other) noexcept = default;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+  PoolAllocator& operator=(const PoolAllocator& other) noexcept = default;
+  PoolAllocator& operator=(PoolAllocator&& other) noexcept = default;
+
+  T* allocate(size_type n);
+  void deallocate(T* pointer, size_type n) noexcept;
+
+  // Копия контейнера получает собственный пул
+  PoolAllocator select_on_container_copy_construction() const {
+    return PoolAllocator();
+  }
+
+  void reserve(size_type n);
+  // Освобождает все слэбы, если пул больше никем не используется
+  bool release() noexcept;
+
+  const NodePool* pool() const noexcept { return pool_.get(); }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>& other) const noexcept {
+    return pool_ == other.pool_;
+  }
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>& other) const noexcept {
+    return pool_ != other.pool_;
+  }
+
+ private:
+  template <typename U>
+  friend class PoolAllocator;
+
+  NodePool& sharedPool();  // заново создает пул после перемещения
+
+  std::shared_ptr<NodePool> pool_;
+};
+
+// Точки расширения, которые деревья вызывают у своего аллокатора узлов.
+// Для аллокаторов без reserve() и release() это пустые операции.
+template <typename Alloc, typename = void>
+struct NodeAllocatorHooks {
+  static void reserve(Alloc&, std::size_t) {}
+  static bool release(Alloc&) noexcept { return false; }
+};
+
+template <typename Alloc>
+struct NodeAllocatorHooks<
+    Alloc, std::void_t<decltype(std::declval<Alloc&>().release()),
+                       decltype(std::declval<Alloc&>().reserve(0))>> {
+  static void reserve(Alloc& alloc, std::size_t n) { alloc.reserve(n); }
+  static bool release(Alloc& alloc) noexcept { return alloc.release(); }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_NODE_POOL_HPP
@@ -0,0 +1,97 @@
+//
+// Параллельный обход и свертка деревьев Map, Set и Multiset.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_PARALLEL_HPP
+#define CPP2_S21_CONTAINERS_1_S21_PARALLEL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "../s21_map/s21_map.hpp"
+#include "../s21_multiset/s21_multiset.hpp"
+#include "../s21_set/s21_set.hpp"
+#include "../s21_thread_pool/s21_thread_pool.hpp"
+
+namespace s21 {
+namespace parallel {
+
+// Дерево делится на части в порядке ключей: верхние узлы до глубины,
+// зависящей от числа потоков pool, по одному, а поддеревья под ними -
+// целиком. Части обрабатываются в потоках pool, поддерево обходится
+// итеративно. Set и Multiset не балансируются, поэтому при вырожденном
+// дереве почти вся работа может достаться одной части.
+//
+// Функции, переданные в алгоритмы, вызываются из нескольких потоков сразу.
+// Элементы Map передаются как value_type& (значение можно менять), ключи
+// Set и Multiset - только для чтения
+
+// Вызывает func для каждого элемента tree в произвольном порядке
+template <typename Tree, typename Func>
+void for_each(ThreadPool& pool, Tree& tree, Func func);
+
+// Свертка init op x1 op x2 ... для преобразованных transform элементов.
+// Части сворачиваются независимо, а их результаты объединяются в порядке
+// ключей, поэтому op должна быть ассоциативной, но не обязательно
+// коммутативной
+template <typename Tree, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(ThreadPool& pool, const Tree& tree, T init, BinaryOp op,
+                   UnaryOp transform);
+
+// transform_reduce без преобразования элементов
+template <typename Tree, typename T, typename BinaryOp>
+T reduce(ThreadPool& pool, const Tree& tree, T init, BinaryOp op);
+
+// Специализации для каждого дерева: тип узла, корень и ссылка на элемент
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename NodePolicy>
+struct TreeAccess<Map<Key, T, Compare, Allocator, NodePolicy>> {
+  using Tree = Map<Key, T, Compare, Allocator, NodePolicy>;
+  using Node = typename Tree::Node;
+  using reference = typename Tree::value_type&;
+
+  static Node* root(const Tree& tree) { return tree.root; }
+  static reference value(Node* node) { return node->data; }
+};
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+struct TreeAccess<Set<Key, Compare, Allocator, NodePolicy>> {
+  using Tree = Set<Key, Compare, Allocator, NodePolicy>;
+  using Node = typename Tree::Node;
+  using reference = const Key&;
+
+  static Node* root(const Tree& tree) { return tree.root; }
+  static reference value(Node* node) { return node->key; }
+};
+
+template <typename Key, typename Compare, typename Allocator>
+struct TreeAccess<Multiset<Key, Compare, Allocator>> {
+  using Tree = Multiset<Key, Compare, Allocator>;
+  using Node = typename Tree::Node;
+  using reference = const Key&;
+
+  static Node* root(const Tree& tree) { return tree.root_; }
+  static reference value(Node* node) { return node->key; }
+};
+
+// Часть дерева: один верхний узел или все поддерево node
+template <typename Node>
+struct TreePart {
+  Node* node;
+  bool whole;
+};
+
+// Части дерева root в порядке ключей; size - число элементов дерева
+template <typename Node>
+std::vector<TreePart<Node>> splitTree(Node* root, std::size_t size,
+                                      const ThreadPool& pool);
+
+// Вызывает visit для узлов part в порядке ключей
+template <typename Node, typename Visit>
+void visitPart(const TreePart<Node>& part, Visit& visit);
+
+}  // namespace parallel
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_PARALLEL_HPP
@@ -0,0 +1,211 @@
+//
+// Неизменяемый словарь с копированием пути и атомарная публикация версий.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_PERSISTENT_MAP_HPP
+#define CPP2_S21_CONTAINERS_1_S21_PERSISTENT_MAP_HPP
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+class AtomicPersistentMap;
+
+// Каждая версия словаря неизменяема. insert и erase возвращают новую
+// версию: копируются только узлы на пути от корня к измененному ключу
+// (O(log n) штук), остальные узлы общие со старой версией. Узлы считаются
+// ссылками shared_ptr и освобождаются вместе с последней версией, которая
+// их видит. Копия словаря - это копия указателя на корень, то есть снимок
+// за O(1), и читать его можно из любого потока без блокировок.
+//
+// Дерево - AVL: после копирования пути балансировка трогает только узлы
+// этого же пути, поэтому высота и число копий остаются логарифмическими.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class PersistentMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+ private:
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+  struct Node {
+    template <typename... Args>
+    explicit Node(NodePtr left_child, NodePtr right_child, Args&&... args)
+        : data(std::forward<Args>(args)...),
+          left(std::move(left_child)),
+          right(std::move(right_child)),
+          height(1 + std::max(heightOf(left), heightOf(right))),
+          size(1 + sizeOf(left) + sizeOf(right)) {}
+
+    value_type data;
+    NodePtr left;
+    NodePtr right;
+    int height;
+    size_type size;
+  };
+
+ public:
+  // Узлы общие у разных версий, поэтому ссылок на родителя нет: следующий
+  // элемент ищется спуском от корня версии за O(log n)
+  class PersistentMapIterator {
+   public:
+    PersistentMapIterator() : root_(nullptr), current_(nullptr) {}
+
+    PersistentMapIterator& operator++();
+    PersistentMapIterator operator++(int) {
+      PersistentMapIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const PersistentMapIterator& other) const {
+      return current_ == other.current_;
+    }
+    bool operator!=(const PersistentMapIterator& other) const {
+      return !operator==(other);
+    }
+
+    const_reference operator*() const { return current_->data; }
+    const value_type* operator->() const { return &current_->data; }
+
+   private:
+    friend class PersistentMap;
+
+    PersistentMapIterator(const Node* root, const Node* current,
+                          const Compare& comp)
+        : root_(root), current_(current), comp_(comp) {}
+
+    const Node* root_;
+    const Node* current_;
+    Compare comp_;
+  };
+
+  using iterator = PersistentMapIterator;
+  using const_iterator = PersistentMapIterator;
+
+  // Конструкторы
+
+  PersistentMap() = default;
+  explicit PersistentMap(const Compare& comp) : comp_(comp) {}
+  PersistentMap(std::initializer_list<value_type> const& items);
+  PersistentMap(const PersistentMap& other) = default;  // снимок за O(1)
+  PersistentMap(PersistentMap&& other) noexcept = default;
+  ~PersistentMap() = default;
+
+  PersistentMap& operator=(const PersistentMap& other) = default;
+  PersistentMap& operator=(PersistentMap&& other) noexcept = default;
+
+  // Доступ к элементам
+
+  const T& at(const Key& key) const;
+
+  // Итераторы
+
+  const_iterator begin() const;
+  const_iterator end() const { return const_iterator(); }
+
+  // Вместимость
+
+  bool empty() const { return root_ == nullptr; }
+  size_type size() const { return sizeOf(root_); }
+
+  // Новые версии. Сам словарь не меняется; если ключ уже есть (или его нет
+  // для erase), возвращается эта же версия без выделений
+
+  [[nodiscard]] PersistentMap insert(const value_type& value) const;
+  [[nodiscard]] PersistentMap insert(const Key& key, const T& obj) const;
+  [[nodiscard]] PersistentMap insert_or_assign(const Key& key,
+                                               const T& obj) const;
+  [[nodiscard]] PersistentMap erase(const Key& key) const;
+  [[nodiscard]] PersistentMap clear() const {
+    return PersistentMap(comp_);
+  }
+
+  // Просмотр контейнера
+
+  const_iterator find(const Key& key) const;
+  bool contains(const Key& key) const { return find(key) != end(); }
+  const_iterator lower_bound(const Key& key) const;  // первый не меньший key
+  const_iterator upper_bound(const Key& key) const;  // первый больший key
+  key_compare key_comp() const { return comp_; }
+
+  // true, если обе версии - один и тот же снимок (общий корень)
+  bool same_version(const PersistentMap& other) const {
+    return root_ == other.root_;
+  }
+
+  bool validateForTesting() const;  // порядок ключей, баланс, размеры
+
+ private:
+  friend class AtomicPersistentMap<Key, T, Compare>;
+
+  PersistentMap(NodePtr root, const Compare& comp)
+      : root_(std::move(root)), comp_(comp) {}
+
+  static int heightOf(const NodePtr& node) {
+    return node ? node->height : 0;
+  }
+  static size_type sizeOf(const NodePtr& node) {
+    return node ? node->size : 0;
+  }
+
+  template <typename... Args>
+  static NodePtr makeNode(NodePtr left, NodePtr right, Args&&... args);
+  static NodePtr balance(const value_type& data, NodePtr left,
+                         NodePtr right);
+  NodePtr insertNode(const NodePtr& node, const Key& key, const T& obj,
+                     bool assign) const;
+  NodePtr eraseNode(const NodePtr& node, const Key& key) const;
+  static NodePtr eraseMin(const NodePtr& node);
+  bool validateNode(const Node* node, const Key* low, const Key* high) const;
+
+  NodePtr root_;
+  Compare comp_;
+};
+
+// Ячейка, через которую писатели публикуют версии PersistentMap, а
+// читатели забирают текущую. Публикация - атомарная замена корня, читатель
+// получает целый снимок и дальше работает с ним без синхронизации
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class AtomicPersistentMap {
+ public:
+  using map_type = PersistentMap<Key, T, Compare>;
+
+  AtomicPersistentMap() = default;
+  explicit AtomicPersistentMap(const map_type& initial)
+      : root_(initial.root_), comp_(initial.comp_) {}
+  AtomicPersistentMap(const AtomicPersistentMap&) = delete;
+  AtomicPersistentMap& operator=(const AtomicPersistentMap&) = delete;
+
+  map_type load() const;
+  void store(const map_type& map);
+  // Публикует desired, только если текущая версия - expected; иначе
+  // записывает текущую версию в expected и возвращает false
+  bool compare_exchange(map_type& expected, const map_type& desired);
+  // Применяет func(map_type) -> map_type к текущей версии и публикует
+  // результат, повторяя при гонке с другими писателями. Возвращает
+  // опубликованную версию
+  template <typename Func>
+  map_type update(Func&& func);
+
+ private:
+  typename map_type::NodePtr root_;
+  Compare comp_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_PERSISTENT_MAP_HPP
@@ -0,0 +1,32 @@
+//
+// Полуинтервал итераторов, пригодный для range-based for.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_RANGE_HPP
+#define CPP2_S21_CONTAINERS_1_S21_RANGE_HPP
+
+#include <utility>
+
+namespace s21 {
+
+// Результат range(lo, hi) у упорядоченных контейнеров: хранит только два
+// итератора, поэтому обход диапазона стоит O(k) после поиска границ - O(log n)
+// у Map и O(высоты дерева) у несбалансированного Set
+template <typename Iterator>
+class IteratorRange {
+ public:
+  IteratorRange(Iterator first, Iterator last)
+      : first_(std::move(first)), last_(std::move(last)) {}
+
+  Iterator begin() const { return first_; }
+  Iterator end() const { return last_; }
+  bool empty() const { return first_ == last_; }
+
+ private:
+  Iterator first_;
+  Iterator last_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_RANGE_HPP
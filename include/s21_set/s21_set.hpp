@@ -8,50 +8,113 @@
 #include <cstddef>
 #include <functional>
 #include <initializer_list>
-#include <stack>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
+#include "../s21_bloom_filter/s21_bloom_filter.hpp"
+#include "../s21_node_pool/s21_node_pool.hpp"
+#include "../s21_range/s21_range.hpp"
+#include "../s21_thread_pool/s21_thread_pool.hpp"
+#include "../s21_tree_policy/s21_tree_policy.hpp"
 #include "../s21_vector/s21_vector.hpp"
 
 namespace s21 {
 
-template <typename Key>
-class Set;  // Forward declaration of Set class
+namespace parallel {
+// Доступ параллельных алгоритмов к узлам дерева (s21_parallel.hpp)
+template <typename Tree>
+struct TreeAccess;
+}  // namespace parallel
 
-template <typename Key>
+// Доступ операций над множествами к узлам дерева (s21_set_algebra.hpp)
+template <typename Tree>
+struct SetAlgebraAccess;
+
+// Узел дерева Set. Не зависит от компаратора и аллокатора, поэтому итераторы
+// параметризуются только типом ключа и политикой узла
+template <typename Key, typename NodePolicy = PlainNodes>
+struct SetNode : NodePolicy::NodeBase {
+  Key key;
+  SetNode* left;
+  SetNode* right;
+  SetNode* parent;
+
+  explicit SetNode(const Key& key)
+      : key(key), left(nullptr), right(nullptr), parent(nullptr) {}
+
+  // Соседние по порядку ключей узлы по ссылкам на родителей, nullptr за
+  // краем дерева. Полный обход проходит каждое ребро дважды, поэтому шаг
+  // стоит O(1) в среднем
+  static SetNode* next(SetNode* node);
+  static SetNode* prev(SetNode* node);
+  static SetNode* min(SetNode* node);
+  static SetNode* max(SetNode* node);
+};
+
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+class Set;
+
+// Итератор - узел и ссылка на корень дерева, которая нужна только для
+// шага назад от end(). Он тривиально копируется и ничего не выделяет.
+// Итераторы остаются действительными при вставках и при удалении других
+// элементов
+template <typename Key, typename NodePolicy = PlainNodes>
 class SetIterator {
  private:
-  using Node = typename Set<Key>::Node;
-  Node* current;
-  std::stack<Node*> ancestors;
+  template <typename, typename, typename, typename>
+  friend class Set;
+  template <typename, typename>
+  friend class SetConstIterator;
 
-  void pushLeft(Node* node);
+  using Node = SetNode<Key, NodePolicy>;
+  Node* current;
+  Node* const* root;
 
  public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = Key;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Key*;
+  using reference = Key&;
+
   SetIterator();
-  explicit SetIterator(Node* root);
+  SetIterator(Node* node, Node* const* root);
   SetIterator& operator++();
   SetIterator operator++(int);
-  Key& operator*();
-  Key* operator->();
+  // Шаг назад от end() переходит к наибольшему ключу
+  SetIterator& operator--();
+  SetIterator operator--(int);
+  Key& operator*() const;
+  Key* operator->() const;
   bool operator==(const SetIterator& other) const;
   bool operator!=(const SetIterator& other) const;
   Node* get_current() const;
 };
 
-template <typename Key>
+template <typename Key, typename NodePolicy = PlainNodes>
 class SetConstIterator {
  private:
-  using Node = typename Set<Key>::Node;
-  const Node* current;
-  std::stack<const Node*> ancestors;
-
-  void pushLeft(const Node* node);
+  using Node = SetNode<Key, NodePolicy>;
+  Node* current;
+  Node* const* root;
 
  public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = Key;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Key*;
+  using reference = const Key&;
+
   SetConstIterator();
-  explicit SetConstIterator(const Node* root);
+  SetConstIterator(Node* node, Node* const* root);
+  SetConstIterator(const SetIterator<Key, NodePolicy>& other);  // NOLINT
   SetConstIterator& operator++();
   SetConstIterator operator++(int);
+  SetConstIterator& operator--();
+  SetConstIterator operator--(int);
   const Key& operator*() const;
   const Key* operator->() const;
   bool operator==(const SetConstIterator& other) const;
@@ -59,42 +122,126 @@ class SetConstIterator {
   const Node* get_current() const;
 };
 
-template <typename Key>
+// Дерево поиска без балансировки: спуск от корня стоит O(высоты), то есть
+// O(log n) после assign_sorted, assign_parallel и merge с равными
+// аллокаторами, которые строят сбалансированное дерево, и в среднем при
+// случайном порядке вставок, но O(n) после вставок по возрастанию или
+// убыванию. Оценки O(log n) в худшем случае есть только у Map.
+// NodePolicy = OrderStatistics добавляет rank, select и count_range
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          typename NodePolicy = PlainNodes>
 class Set {
- private:
-  struct Node {
-    Key key;
-    Node* left;
-    Node* right;
+  template <typename>
+  friend struct parallel::TreeAccess;
+  template <typename>
+  friend struct SetAlgebraAccess;
 
-    explicit Node(const Key& key) : key(key), left(nullptr), right(nullptr) {}
-  };
+  static_assert(!NodePolicy::kKeyPrefix, "KeyPrefix is supported by Map only");
+
+ private:
+  using Node = SetNode<Key, NodePolicy>;
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  using NodeHooks = NodeAllocatorHooks<NodeAllocator>;
+  using Filter = BloomFilter<Key, typename BloomFilterHash<Key, Compare>::type>;
+  static constexpr bool kFilterable = kBloomFilterable<Key, Compare>;
 
   Node* root;
   size_t tree_size;
+  Node* rightmost_;  // узел с наибольшим ключом для вставки в конец за O(1)
+  Compare comp_;
+  NodeAllocator alloc_;
+  std::unique_ptr<Filter> filter_;  // nullptr, пока не включен
+
+  // Перегрузки с параметром K доступны только для прозрачного компаратора
+  template <typename K, typename C = Compare>
+  using TransparentKey = typename C::is_transparent;
 
   // Utility functions
-  Node* copyTree(Node* other);
+  Node* copyTree(Node* other, Node* parent);
   void deleteTree(Node* node);
-  std::pair<Node*, bool> insertNode(Node*& node, const Key& key);
-  Node* findNode(Node* node, const Key& key) const;
-  void inorder(Node* node, std::function<void(Node*)> func) const;
+  void releaseNodes();  // уничтожает все узлы, не обнуляя root
+  Node* createNode(const Key& key);
+  void destroyNode(Node* node);
+  // Спуск от корня; возвращает узел key и true, если он создан
+  std::pair<Node*, bool> insertNode(const Key& key);
+  // Узел подвешивается прямо к parent без спуска от корня
+  Node* linkNode(Node* parent, bool as_left, const Key& key);
+  // Место для key рядом с hint, как у Map: key встает между hint и его
+  // соседом левым потомком hint или правым потомком предшественника, либо
+  // правым потомком hint или левым потомком следующего. Возвращает hint,
+  // если ключи равны, и nullptr с parent == nullptr, если key не соседствует
+  // с hint
+  Node* findHintPosition(Node* hint, const Key& key, Node*& parent,
+                         bool& as_left) const;
+  // Заменяет поддерево target поддеревом replacement в ссылке родителя
+  void transplant(Node* target, Node* replacement);
+  void updatePath(Node* node);  // пересчитывает NodePolicy от node до корня
+  Node* findMax(Node* node) const;
+  template <typename K>
+  Node* findNode(Node* node, const K& key) const;
+  // Первый узел, ключ которого не меньше key (при upper - больше key)
+  template <typename K>
+  Node* findBound(const K& key, bool upper) const;
+  // Узел с номером index или nullptr
+  Node* findByIndex(size_t index) const;
+  template <typename ForwardIt>
+  Node* buildSorted(ForwardIt& it, size_t count);
+  // Переделывает дерево поворотами в цепочку по правым ссылкам в порядке
+  // ключей; ссылки на родителей при этом не поддерживаются
+  static Node* flatten(Node* node);
+  // Идеально сбалансированное поддерево из первых count узлов цепочки list
+  static Node* buildFromList(Node*& list, size_t count);
+  // Поддержка фильтра Блума; без включенного фильтра ничего не делают
+  void filterInsert(const Key& key);
+  void filterErase();
+  void rebuildFilter();  // заново по ключам дерева
+  // Узел key или nullptr; промах, отсеянный фильтром, не спускается по дереву
+  Node* filteredFind(const Key& key) const;
+  // Делает пустое дерево деревом из цепочки count узлов, выделенных alloc_.
+  // clear() здесь нельзя: он может вернуть в систему весь пул вместе с
+  // узлами цепочки
+  void adoptList(Node* list, size_t count);
+  // Параллельное построение: узлы выше split_depth создаются сразу, а
+  // поддеревья на этой глубине строятся в потоках
+  template <typename RandomIt>
+  struct ParallelBuild {
+    struct Subtree {
+      RandomIt first;
+      size_t count;
+      Node* parent;
+      Node** slot;  // ссылка родителя, куда подвесить поддерево
+    };
+    size_t split_depth;
+    std::vector<Subtree> subtrees;
+    std::vector<Node*> top;  // верхние узлы, потомки раньше родителей
+  };
+  template <typename RandomIt>
+  Node* buildParallel(RandomIt first, size_t count, ThreadPool& pool);
+  template <typename RandomIt>
+  void buildTop(RandomIt first, size_t count, size_t depth, Node* parent,
+                Node** slot, ParallelBuild<RandomIt>& build);
 
  public:
-  friend class SetIterator<Key>;
-  friend class SetConstIterator<Key>;
 
   // Переопределения типов
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = SetIterator<Key>;
-  using const_iterator = SetConstIterator<Key>;
+  using iterator = SetIterator<Key, NodePolicy>;
+  using const_iterator = SetConstIterator<Key, NodePolicy>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
   // Конструкторы
   Set();
+  explicit Set(const Compare& comp, const Allocator& alloc = Allocator());
   Set(std::initializer_list<value_type> const& items);
   Set(const Set& s);
   Set(Set&& s) noexcept;
@@ -109,27 +256,112 @@ class Set {
   iterator end();
   const_iterator begin() const;
   const_iterator end() const;
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
 
   // Вместимость
   bool empty() const;
   size_type size() const;
   size_type max_size() const;
+  void reserve(size_type count);  // готовит память аллокатора под count узлов
+  allocator_type get_allocator() const;
 
   // Модификаторы
   void clear();
   std::pair<iterator, bool> insert(const value_type& value);
+  // Вставка с подсказкой. Если ключ встает сразу перед hint или сразу после
+  // него (hint - результат предыдущей вставки или lower_bound ключа), узел
+  // подвешивается без спуска от корня за O(1) в среднем; hint == end()
+  // подвешивает ключ больше всех к наибольшему узлу. Иначе это обычная
+  // вставка. Дерево не балансируется, поэтому вставки по возрастанию через
+  // подсказку строят цепочку, и поиск в ней стоит O(n)
+  iterator insert(iterator hint, const value_type& value);
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args);
   void erase(iterator pos);
+  iterator erase(iterator first, iterator last);  // стирает [first, last)
+  size_type erase(const key_type& key);  // 1, если ключ был, иначе 0
   void swap(Set& other);
+  // Забирает все ключи other, other становится пустым. При равных
+  // аллокаторах узлы other переходят в это дерево без копирования, и оба
+  // дерева сливаются за O(n + m)
   void merge(Set& other);
 
   // Просмотр контейнера
   iterator find(const key_type& key);
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  iterator find(const K& key);
   bool contains(const key_type& key) const;
+  template <typename K, typename C = Compare,
+            typename = TransparentKey<K, C>>
+  bool contains(const K& key) const;
+  key_compare key_comp() const { return comp_; }
+
+  // Фильтр Блума перед contains(key) и find(key): большинство промахов
+  // отвечается им без спуска по дереву. Вставки сразу попадают в фильтр, а
+  // после роста дерева и после удаления половины вставленных ключей фильтр
+  // перестраивается по дереву за O(n), что в среднем дает O(1) на операцию.
+  // Только для компараторов, для которых BloomFilterHash задает согласованный
+  // с ними хеш (std::less и std::greater с std::hash<Key>); перегрузки с
+  // прозрачным компаратором фильтр не используют. Копия Set получает копию
+  // фильтра
+  void enable_filter(double bits_per_key = 10.0);
+  void disable_filter() { filter_.reset(); }
+  bool filter_enabled() const { return filter_ != nullptr; }
+  BloomFilterStats filter_stats() const;  // нули, если фильтр выключен
+
+  // Порядковые статистики, только для NodePolicy = OrderStatistics. Каждая
+  // - один спуск от корня за O(высоты), не O(log n), как у Map
+  size_type rank(const Key& key) const;  // число ключей, меньших key
+  iterator select(size_type index);  // ключ с номером index или end()
+  const_iterator select(size_type index) const;
+  iterator nth(size_type index) { return select(index); }
+  const_iterator nth(size_type index) const { return select(index); }
+  size_type count_range(const Key& lo, const Key& hi) const;  // в [lo, hi)
+
+  // Поиск границ - один спуск от корня за O(высоты), range - O(высоты + k)
+  // для k ключей диапазона. O(log n) только для сбалансированного дерева
+  iterator lower_bound(const Key& key);  // первый ключ, не меньший key
+  const_iterator lower_bound(const Key& key) const;
+  iterator upper_bound(const Key& key);  // первый ключ, больший key
+  const_iterator upper_bound(const Key& key) const;
+  std::pair<iterator, iterator> equal_range(const Key& key);
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+  // Ключи из [lo, hi); пусто, если hi не больше lo
+  IteratorRange<iterator> range(const Key& lo, const Key& hi);
+  IteratorRange<const_iterator> range(const Key& lo, const Key& hi) const;
 
   template <typename... Args>
   Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  // Заменяет содержимое строго возрастающей последовательностью [first, last)
+  // и строит идеально сбалансированное дерево за O(n). При checked = true
+  // порядок проверяется, и при нарушении элементы вставляются по одному
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last, bool checked = false);
+  // Заменяет содержимое ключами из [first, last) в любом порядке: копия
+  // сортируется параллельно на pool, повторы отбрасываются, нижние
+  // поддеревья строятся в потоках pool. С аллокатором, отличным от
+  // std::allocator, узлы создает один поток
+  template <typename RandomIt>
+  void assign_parallel(RandomIt first, RandomIt last, ThreadPool& pool);
+
+  // Порядок ключей, ссылки на родителей, NodePolicy и наибольший узел
+  bool validateForTesting() const;
 };
 
+// Set с размерами поддеревьев в узлах
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+using RankedSet = Set<Key, Compare, Allocator, OrderStatistics>;
+
 }  // namespace s21
 
 #endif  // S21_SET_HPP
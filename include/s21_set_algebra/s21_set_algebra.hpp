@@ -0,0 +1,184 @@
+//
+// Объединение, пересечение и разности деревьев Set и Multiset.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_SET_ALGEBRA_HPP
+#define CPP2_S21_CONTAINERS_1_S21_SET_ALGEBRA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "../s21_multiset/s21_multiset.hpp"
+#include "../s21_parallel/s21_parallel.hpp"
+#include "../s21_set/s21_set.hpp"
+#include "../s21_thread_pool/s21_thread_pool.hpp"
+
+namespace s21 {
+
+// Операция - один совместный проход по ключам a и b в порядке возрастания,
+// как у std::set_union. Узлы результата сразу связываются в цепочку, из
+// которой строится идеально сбалансированное дерево, поэтому время -
+// O(n + m) без спусков от корня. Результат получает компаратор a и
+// аллокатор, выбранный как при копировании a.
+//
+// Повторы Multiset считаются как в std::set_union: ключ, входящий в a k раз,
+// а в b - l раз, попадает в объединение max(k, l) раз, в пересечение -
+// min(k, l), в разность - max(k - l, 0), в симметричную разность - |k - l|.
+//
+// Версии с ThreadPool делят ключи границами из верхних узлов большего
+// дерева на диапазоны, которые сливаются в потоках pool, а затем цепочки
+// диапазонов соединяются. Для небольших деревьев и аллокаторов, отличных от
+// std::allocator, они работают как последовательные
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_union(const Tree& a, const Tree& b);
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_intersection(const Tree& a,
+                                                       const Tree& b);
+// Ключи a, которых нет в b
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_difference(const Tree& a,
+                                                     const Tree& b);
+// Ключи, которые есть ровно в одном из деревьев
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree symmetric_difference(const Tree& a,
+                                                           const Tree& b);
+
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_union(ThreadPool& pool,
+                                                const Tree& a, const Tree& b);
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_intersection(ThreadPool& pool,
+                                                       const Tree& a,
+                                                       const Tree& b);
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree set_difference(ThreadPool& pool,
+                                                     const Tree& a,
+                                                     const Tree& b);
+template <typename Tree>
+typename SetAlgebraAccess<Tree>::Tree symmetric_difference(ThreadPool& pool,
+                                                           const Tree& a,
+                                                           const Tree& b);
+
+namespace set_algebra {
+
+enum class Operation { kUnion, kIntersection, kDifference, kSymmetric };
+
+// Обход Multiset без ссылок на родителей: в стеке лежат узлы, в чьи левые
+// поддеревья обход уже спустился
+template <typename Node>
+class StackCursor {
+ public:
+  StackCursor() = default;
+  // Первый узел с ключом не меньше *key, при key == nullptr - наименьший
+  template <typename Key, typename Compare>
+  StackCursor(Node* root, const Key* key, const Compare& comp);
+
+  const auto& operator*() const { return path_.back()->key; }
+  StackCursor& operator++();
+  bool operator!=(const StackCursor& other) const {
+    return node() != other.node();
+  }
+
+ private:
+  Node* node() const { return path_.empty() ? nullptr : path_.back(); }
+  void pushLeftSpine(Node* node);
+
+  std::vector<Node*> path_;
+};
+
+// Узлы результата в порядке ключей, связанные правыми ссылками
+template <typename Node>
+struct NodeChain {
+  Node* head = nullptr;
+  Node* last = nullptr;
+  std::size_t count = 0;
+
+  void append(Node* node);
+  void append(NodeChain& other);  // забирает цепочку other целиком
+};
+
+// Вызывает emit для каждого ключа результата op над [a, a_end) и
+// [b, b_end) в порядке возрастания
+template <typename Cursor, typename Compare, typename Emit>
+void mergeWalk(Operation op, Cursor a, const Cursor& a_end, Cursor b,
+               const Cursor& b_end, const Compare& comp, Emit& emit);
+
+template <typename Tree>
+Tree combine(Operation op, const Tree& a, const Tree& b);
+template <typename Tree>
+Tree combineParallel(ThreadPool& pool, Operation op, const Tree& a,
+                     const Tree& b);
+
+}  // namespace set_algebra
+
+// Для других типов Tree не определен, и операции в перегрузку не попадают
+template <typename Tree>
+struct SetAlgebraAccess {};
+
+// Специализации для каждого дерева: пустое дерево с параметрами образца,
+// обход ключей, создание узлов и сборка дерева из цепочки
+template <typename Key, typename Compare, typename Allocator,
+          typename NodePolicy>
+struct SetAlgebraAccess<Set<Key, Compare, Allocator, NodePolicy>> {
+  using Tree = Set<Key, Compare, Allocator, NodePolicy>;
+  using Node = typename Tree::Node;
+  using Cursor = typename Tree::const_iterator;
+  static constexpr bool kConcurrentAlloc =
+      kConcurrentAllocator<typename Tree::NodeAllocator>;
+
+  static Tree makeEmpty(const Tree& like) {
+    Allocator alloc(
+        Tree::NodeTraits::select_on_container_copy_construction(like.alloc_));
+    return Tree(like.comp_, alloc);
+  }
+  static Node* root(const Tree& tree) { return tree.root; }
+  static Cursor begin(const Tree& tree) { return tree.begin(); }
+  static Cursor end(const Tree& tree) { return tree.end(); }
+  static Cursor lowerBound(const Tree& tree, const Key& key) {
+    return tree.lower_bound(key);
+  }
+  static Node* createNode(Tree& tree, const Key& key) {
+    return tree.createNode(key);
+  }
+  static void deleteChain(Tree& tree, Node* head) { tree.deleteTree(head); }
+  static void adopt(Tree& tree, Node* head, std::size_t count) {
+    tree.adoptList(head, count);
+  }
+};
+
+template <typename Key, typename Compare, typename Allocator>
+struct SetAlgebraAccess<Multiset<Key, Compare, Allocator>> {
+  using Tree = Multiset<Key, Compare, Allocator>;
+  using Node = typename Tree::Node;
+  using Cursor = set_algebra::StackCursor<Node>;
+  static constexpr bool kConcurrentAlloc =
+      kConcurrentAllocator<typename Tree::NodeAllocator>;
+
+  static Tree makeEmpty(const Tree& like) {
+    Allocator alloc(
+        Tree::NodeTraits::select_on_container_copy_construction(like.alloc_));
+    return Tree(like.comp_, alloc);
+  }
+  static Node* root(const Tree& tree) { return tree.root_; }
+  static Cursor begin(const Tree& tree) {
+    return Cursor(tree.root_, static_cast<const Key*>(nullptr), tree.comp_);
+  }
+  static Cursor end(const Tree&) { return Cursor(); }
+  static Cursor lowerBound(const Tree& tree, const Key& key) {
+    return Cursor(tree.root_, &key, tree.comp_);
+  }
+  static Node* createNode(Tree& tree, const Key& key) {
+    return tree.create_node(key);
+  }
+  static void deleteChain(Tree& tree, Node* head) { tree.clear(head); }
+  static void adopt(Tree& tree, Node* head, std::size_t count) {
+    tree.adopt_list(head, count);
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_SET_ALGEBRA_HPP
@@ -0,0 +1,52 @@
+//
+// Двоичный поиск без ветвлений по отсортированному массиву.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_SORTED_SEARCH_HPP
+#define CPP2_S21_CONTAINERS_1_S21_SORTED_SEARCH_HPP
+
+#include <cstddef>
+
+namespace s21 {
+
+// Каждый шаг сдвигает base условным выражением, которое компилятор
+// превращает в cmov, а число шагов зависит только от count. Поэтому поиск
+// не страдает от неверно предсказанных переходов, а вместо этого ждет
+// загрузки ключа; на таблицах, читаемых миллионы раз, это заметно быстрее
+// std::lower_bound.
+
+// Индекс первого ключа, не меньшего key
+template <typename Key, typename K, typename Compare>
+std::size_t branchlessLowerBound(const Key* keys, std::size_t count,
+                                 const K& key, const Compare& comp) {
+  if (count == 0) {
+    return 0;
+  }
+  const Key* base = keys;
+  while (count > 1) {
+    std::size_t half = count / 2;
+    base = comp(base[half - 1], key) ? base + half : base;
+    count -= half;
+  }
+  return static_cast<std::size_t>(base - keys) + (comp(*base, key) ? 1 : 0);
+}
+
+// Индекс первого ключа, большего key
+template <typename Key, typename K, typename Compare>
+std::size_t branchlessUpperBound(const Key* keys, std::size_t count,
+                                 const K& key, const Compare& comp) {
+  if (count == 0) {
+    return 0;
+  }
+  const Key* base = keys;
+  while (count > 1) {
+    std::size_t half = count / 2;
+    base = comp(key, base[half - 1]) ? base : base + half;
+    count -= half;
+  }
+  return static_cast<std::size_t>(base - keys) + (comp(key, *base) ? 0 : 1);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_SORTED_SEARCH_HPP
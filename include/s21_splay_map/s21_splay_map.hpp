@@ -0,0 +1,242 @@
+//
+// Самонастраивающийся упорядоченный словарь на splay-дереве.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_SPLAY_MAP_HPP
+#define CPP2_S21_CONTAINERS_1_S21_SPLAY_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Map для неравномерных обращений: найденный ключ поворотами поднимается в
+// корень (splay), поэтому часто запрашиваемые ключи держатся у вершины и
+// находятся за несколько сравнений. Баланса нет: отдельная операция может
+// стоить O(n), но любая последовательность из m операций - O(m log n).
+// При сильном перекосе запросов (распределение Ципфа) горячие ключи лежат
+// мельче, чем в сбалансированном s21::Map, но каждый поиск еще и
+// переписывает ссылки на пути. Выгоднее всего дать дереву подстроиться под
+// запросы, а затем искать через константные перегрузки (bench_splay_map).
+//
+// Неконстантные find, at, operator[], contains, lower_bound и upper_bound
+// перестраивают дерево, поэтому даже чтение без const нельзя вести из
+// нескольких потоков сразу. Константные перегрузки дерево не меняют.
+// Повороты не перемещают узлы, и итераторы остаются действительными при
+// любых операциях, кроме удаления их собственного элемента.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class SplayMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ private:
+  struct Node {
+    template <typename... Args>
+    explicit Node(Args&&... args)
+        : data(std::forward<Args>(args)...),
+          left(nullptr),
+          right(nullptr),
+          parent(nullptr) {}
+
+    value_type data;
+    Node* left;
+    Node* right;
+    Node* parent;
+  };
+
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+ public:
+  template <bool IsConst>
+  class SplayMapIterator {
+   public:
+    using map_pointer =
+        std::conditional_t<IsConst, const SplayMap*, SplayMap*>;
+    using value_pointer =
+        std::conditional_t<IsConst, const value_type*, value_type*>;
+    using value_reference =
+        std::conditional_t<IsConst, const value_type&, value_type&>;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_pointer;
+    using reference = value_reference;
+
+    SplayMapIterator() : map_(nullptr), node_(nullptr) {}
+    SplayMapIterator(map_pointer map, Node* node) : map_(map), node_(node) {}
+    template <bool OtherConst,
+              typename = std::enable_if_t<IsConst && !OtherConst>>
+    SplayMapIterator(const SplayMapIterator<OtherConst>& other)
+        : map_(other.map_), node_(other.node_) {}
+
+    value_reference operator*() const { return node_->data; }
+    value_pointer operator->() const { return &node_->data; }
+
+    SplayMapIterator& operator++() {
+      node_ = findNext(node_);
+      return *this;
+    }
+    SplayMapIterator operator++(int) {
+      SplayMapIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+    // Шаг назад от end() переходит к наибольшему элементу
+    SplayMapIterator& operator--() {
+      node_ = node_ ? findPrev(node_) : findMax(map_->root_);
+      return *this;
+    }
+    SplayMapIterator operator--(int) {
+      SplayMapIterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    bool operator==(const SplayMapIterator& other) const {
+      return node_ == other.node_;
+    }
+    bool operator!=(const SplayMapIterator& other) const {
+      return node_ != other.node_;
+    }
+
+   private:
+    friend class SplayMap;
+    template <bool>
+    friend class SplayMapIterator;
+
+    map_pointer map_;
+    Node* node_;
+  };
+
+  using iterator = SplayMapIterator<false>;
+  using const_iterator = SplayMapIterator<true>;
+
+  // Конструкторы
+
+  SplayMap() : SplayMap(Compare()) {}
+  explicit SplayMap(const Compare& comp,
+                    const Allocator& alloc = Allocator());
+  SplayMap(std::initializer_list<value_type> const& items);
+  SplayMap(const SplayMap& other);
+  SplayMap(SplayMap&& other) noexcept;
+  ~SplayMap() { clear(); }
+
+  SplayMap& operator=(const SplayMap& other);
+  SplayMap& operator=(SplayMap&& other) noexcept;
+
+  // Доступ к элементам
+
+  T& at(const Key& key);
+  const T& at(const Key& key) const;
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  // Итераторы
+
+  iterator begin() { return iterator(this, findMin(root_)); }
+  iterator end() { return iterator(this, nullptr); }
+  const_iterator begin() const { return const_iterator(this, findMin(root_)); }
+  const_iterator end() const { return const_iterator(this, nullptr); }
+
+  // Вместимость
+
+  bool empty() const { return node_count_ == 0; }
+  size_type size() const { return node_count_; }
+  size_type max_size() const {
+    return std::min<size_type>(NodeTraits::max_size(alloc_),
+                               std::numeric_limits<std::ptrdiff_t>::max());
+  }
+
+  // Модификаторы
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return try_emplace(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return try_emplace(value.first, std::move(value.second));
+  }
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  void erase(iterator pos);
+  size_type erase(const Key& key);
+  void swap(SplayMap& other) noexcept;
+
+  // Просмотр контейнера. Неконстантные версии поднимают в корень найденный
+  // узел, а если ключа нет - последний пройденный
+
+  iterator find(const Key& key);
+  const_iterator find(const Key& key) const {
+    return const_iterator(this, findNode(key));
+  }
+  bool contains(const Key& key) { return find(key) != end(); }
+  bool contains(const Key& key) const { return findNode(key) != nullptr; }
+  iterator lower_bound(const Key& key);  // первый не меньший key
+  const_iterator lower_bound(const Key& key) const {
+    return const_iterator(this, lowerBoundNode(key).first);
+  }
+  iterator upper_bound(const Key& key);  // первый больший key
+  const_iterator upper_bound(const Key& key) const {
+    return const_iterator(this, upperBoundNode(key).first);
+  }
+  key_compare key_comp() const { return comp_; }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  // Глубина узла key (корень - 0) или -1, если ключа нет; дерево не меняется
+  int depth_of(const Key& key) const;
+
+  bool validateForTesting() const;  // порядок ключей, ссылки на родителей
+
+ private:
+  static Node* findMin(Node* node);
+  static Node* findMax(Node* node);
+  static Node* findNext(Node* node);
+  static Node* findPrev(Node* node);
+
+  template <typename... Args>
+  Node* makeNode(Args&&... args);
+  void destroyNode(Node* node);
+  void copyFrom(const SplayMap& other);
+
+  void rotate(Node* node);
+  void splay(Node* node);
+  // Узел key или последний пройденный узел, если ключа нет
+  Node* findOrLast(const Key& key) const;
+  Node* findNode(const Key& key) const;
+  // Граница и последний пройденный узел
+  std::pair<Node*, Node*> lowerBoundNode(const Key& key) const;
+  std::pair<Node*, Node*> upperBoundNode(const Key& key) const;
+  // Подвешивает node к parent (nullptr - пустое дерево) и поднимает в корень
+  iterator attachNode(Node* parent, bool as_left, Node* node);
+
+  Node* root_;
+  size_type node_count_;
+  Compare comp_;
+  NodeAllocator alloc_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_SPLAY_MAP_HPP
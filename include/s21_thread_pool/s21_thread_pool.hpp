@@ -0,0 +1,81 @@
+//
+// Пул потоков и параллельная сортировка для массового построения деревьев.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_THREAD_POOL_HPP
+#define CPP2_S21_CONTAINERS_1_S21_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+// Пул с фиксированным числом рабочих потоков и общей очередью задач.
+// Основной способ работы - parallel_for: вызывающий поток тоже выполняет
+// итерации, поэтому вложенный вызов из задачи пула не ждет свободного потока
+// и не может зависнуть
+class ThreadPool {
+ public:
+  using size_type = std::size_t;
+
+  // threads = 0 - пул без потоков, вся работа идет в вызывающем потоке
+  explicit ThreadPool(size_type threads = hardware_threads());
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();  // дожидается задач из очереди
+
+  // Число рабочих потоков без вызывающего
+  size_type size() const noexcept { return workers_.size(); }
+  // Число аппаратных потоков, не меньше 1
+  static size_type hardware_threads() noexcept;
+
+  // Ставит задачу в очередь. Исключение из задачи завершает программу, как
+  // у std::thread
+  void submit(std::function<void()> task);
+
+  // Вызывает func(i) для всех i из [0, count) и возвращается, когда все
+  // вызовы завершены. Первое исключение из func пробрасывается дальше
+  template <typename Func>
+  void parallel_for(size_type count, Func&& func);
+
+ private:
+  void workerLoop();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stopping_;
+};
+
+// Устойчивая сортировка [first, last): отрезки сортируются в потоках pool,
+// затем попарно сливаются, пока не останется один. Последнее слияние
+// выполняется одним потоком
+template <typename RandomIt, typename Compare>
+void parallel_sort(ThreadPool& pool, RandomIt first, RandomIt last,
+                   Compare comp);
+
+// Узлы из std::allocator можно создавать в нескольких потоках сразу, а пул
+// узлов и прочие аллокаторы не обязаны это допускать
+template <typename Alloc>
+constexpr bool kConcurrentAllocator = std::is_same<
+    Alloc, std::allocator<typename Alloc::value_type>>::value;
+
+// Глубина, на которой параллельное построение дерева из count узлов отдает
+// поддеревья потокам pool. Поддерево меньше 4096 узлов не окупает передачу
+// в поток, а около четырех поддеревьев на поток выравнивают нагрузку. Ноль -
+// все дерево строит вызывающий поток; так всегда при concurrent_alloc =
+// false
+std::size_t parallel_build_depth(const ThreadPool& pool, std::size_t count,
+                                 bool concurrent_alloc);
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_THREAD_POOL_HPP
@@ -0,0 +1,94 @@
+//
+// Политики дополнительных данных в узлах деревьев Map и Set.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_TREE_POLICY_HPP
+#define CPP2_S21_CONTAINERS_1_S21_TREE_POLICY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace s21 {
+
+// Политика задает базовый класс узла (NodeBase) и пересчет его полей по
+// потомкам (update). Дерево вызывает update для узла после любого изменения
+// его поддерева, снизу вверх.
+
+// Узлы без дополнительных полей: пустая база не увеличивает размер узла
+struct PlainNodes {
+  static constexpr bool kOrderStatistics = false;
+  static constexpr bool kKeyPrefix = false;
+
+  struct NodeBase {};
+
+  template <typename Node>
+  static void update(Node*) noexcept {}
+  template <typename Node>
+  static bool valid(const Node*) noexcept {
+    return true;
+  }
+};
+
+// Каждый узел хранит размер своего поддерева, что дает rank и select за
+// O(высоты дерева)
+struct OrderStatistics {
+  static constexpr bool kOrderStatistics = true;
+  static constexpr bool kKeyPrefix = false;
+
+  struct NodeBase {
+    std::size_t subtree_size = 1;
+  };
+
+  template <typename Node>
+  static std::size_t size(const Node* node) noexcept {
+    return node ? node->subtree_size : 0;
+  }
+  template <typename Node>
+  static void update(Node* node) noexcept {
+    node->subtree_size = 1 + size(node->left) + size(node->right);
+  }
+  template <typename Node>
+  static bool valid(const Node* node) noexcept {
+    return node->subtree_size == 1 + size(node->left) + size(node->right);
+  }
+};
+
+// Для Map со строковыми ключами: узел хранит первые 8 байт ключа, упакованные
+// старшим байтом вперед и дополненные нулями. Сравнение таких чисел дает тот
+// же порядок, что и std::string::compare, поэтому спуск по дереву сравнивает
+// префикс искомого ключа с полем узла и читает строку узла из кучи, только
+// когда префиксы равны. Выигрыш есть, только если ключи часто различаются
+// в первых 8 байтах: у ключей с общим началом ("https://...") префиксы
+// равны, и остается лишь лишняя работа. Подходит для Map<std::string, T> с
+// std::less<> или std::less<std::string>; узел становится на 8 байт больше
+struct KeyPrefix {
+  static constexpr bool kOrderStatistics = false;
+  static constexpr bool kKeyPrefix = true;
+
+  struct NodeBase {
+    std::uint64_t key_prefix = 0;
+  };
+
+  static std::uint64_t prefix(std::string_view key) noexcept {
+    std::uint64_t result = 0;
+    std::size_t length = std::min(key.size(), sizeof(result));
+    for (std::size_t i = 0; i < length; ++i) {
+      result |= std::uint64_t{static_cast<unsigned char>(key[i])}
+                << (56 - 8 * i);
+    }
+    return result;
+  }
+
+  template <typename Node>
+  static void update(Node*) noexcept {}
+  template <typename Node>
+  static bool valid(const Node*) noexcept {
+    return true;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_TREE_POLICY_HPP
@@ -0,0 +1,169 @@
+//
+// Хеш-таблица ключ-значение с интерфейсом s21::Map.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_UNORDERED_MAP_HPP
+#define CPP2_S21_CONTAINERS_1_S21_UNORDERED_MAP_HPP
+
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../s21_hash_table/s21_hash_table.hpp"
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Ассоциативный массив на хеш-таблице с открытой адресацией: поиск стоит
+// в среднем одно сравнение группы управляющих байтов и одно сравнение
+// ключа вместо O(log n) сравнений в s21::Map. Методы совпадают с Map, кроме
+// упорядоченных (границы, range, порядковые статистики) и узловых (extract),
+// поэтому контейнер можно подставить сменой псевдонима типа.
+//
+// Пары хранятся прямо в массиве слотов: рост таблицы делает итераторы
+// недействительными, удаление - только итератор на удаленный элемент.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class UnorderedMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+ private:
+  struct KeyOfPair {
+    static const Key& key(const value_type& value) { return value.first; }
+  };
+  using Table = HashTable<value_type, KeyOfPair, Hash, KeyEqual>;
+
+  // Перегрузки с параметром K участвуют в выборе, только если и хеш, и
+  // сравнение прозрачные (объявляют is_transparent), как в std::unordered_map
+  template <typename K, typename H = Hash, typename E = KeyEqual>
+  using TransparentKey =
+      std::void_t<typename H::is_transparent, typename E::is_transparent>;
+
+  Table table_;
+
+ public:
+  using iterator = typename Table::iterator;
+  using const_iterator = typename Table::const_iterator;
+
+  // Конструкторы
+
+  UnorderedMap() = default;
+  explicit UnorderedMap(size_type bucket_count, const Hash& hash = Hash(),
+                        const KeyEqual& equal = KeyEqual());
+  UnorderedMap(std::initializer_list<value_type> const& items);
+  UnorderedMap(const UnorderedMap& other) = default;
+  UnorderedMap(UnorderedMap&& other) noexcept = default;
+  ~UnorderedMap() = default;
+
+  UnorderedMap& operator=(const UnorderedMap& other) = default;
+  UnorderedMap& operator=(UnorderedMap&& other) noexcept = default;
+
+  // Доступ к элементам
+
+  T& at(const Key& key);
+  const T& at(const Key& key) const;
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  T& at(const K& key);  // at без построения временного Key
+  T& operator[](const Key& key);
+  T& operator[](Key&& key);
+
+  // Итераторы
+
+  iterator begin() { return table_.begin(); }
+  iterator end() { return table_.end(); }
+  const_iterator begin() const { return table_.begin(); }
+  const_iterator end() const { return table_.end(); }
+
+  // Вместимость
+
+  bool empty() const { return table_.empty(); }
+  size_type size() const { return table_.size(); }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1);
+  }
+  // Готовит место под count элементов без перестроек при вставках
+  void reserve(size_type count) { table_.reserve(count); }
+
+  // Хеш-политика
+
+  size_type bucket_count() const { return table_.bucket_count(); }
+  float load_factor() const { return table_.load_factor(); }
+  float max_load_factor() const { return table_.max_load_factor(); }
+  // Доля занятых слотов, после которой таблица растет; из (0, 1]
+  void max_load_factor(float factor) { table_.max_load_factor(factor); }
+  void rehash(size_type count) { table_.rehash(count); }
+  hasher hash_function() const { return table_.hash_function(); }
+  key_equal key_eq() const { return table_.key_eq(); }
+
+  // Модификаторы
+
+  void clear() { table_.clear(); }
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  std::pair<iterator, bool> insert(const Key& key, const T& obj);
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  std::pair<iterator, bool> insert_or_assign(const Key& key, T&& obj);
+  // Пара строится до поиска, поэтому при существующем ключе она сразу
+  // уничтожается
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  void erase(iterator pos) { table_.erase(pos); }
+  size_type erase(const Key& key) { return table_.eraseKey(key); }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  size_type erase(const K& key) {
+    return table_.eraseKey(key);
+  }
+  void swap(UnorderedMap& other) { table_.swap(other.table_); }
+  // Переносит из other элементы с отсутствующими здесь ключами,
+  // повторяющиеся ключи остаются в other
+  void merge(UnorderedMap& other) { table_.merge(other.table_); }
+
+  // Просмотр контейнера
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  bool contains(const K& key) const {
+    return table_.find(key) != table_.end();
+  }
+  iterator find(const Key& key) { return table_.find(key); }
+  const_iterator find(const Key& key) const { return table_.find(key); }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  iterator find(const K& key) {
+    return table_.find(key);
+  }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  const_iterator find(const K& key) const {
+    return table_.find(key);
+  }
+
+  // Место под все аргументы резервируется заранее, поэтому итераторы
+  // результата остаются действительными
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  bool validateForTesting() const { return table_.validateForTesting(); }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_UNORDERED_MAP_HPP
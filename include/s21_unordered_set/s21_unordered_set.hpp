@@ -0,0 +1,130 @@
+//
+// Хеш-множество с интерфейсом s21::Set.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_S21_UNORDERED_SET_HPP
+#define CPP2_S21_CONTAINERS_1_S21_UNORDERED_SET_HPP
+
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "../s21_hash_table/s21_hash_table.hpp"
+#include "../s21_vector/s21_vector.hpp"
+
+namespace s21 {
+
+// Множество на той же хеш-таблице, что и UnorderedMap. Методы совпадают с
+// Set, кроме упорядоченных; ключи нельзя менять через итератор.
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class UnorderedSet {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+ private:
+  struct KeyOfValue {
+    static const Key& key(const Key& value) { return value; }
+  };
+  using Table = HashTable<Key, KeyOfValue, Hash, KeyEqual>;
+
+  template <typename K, typename H = Hash, typename E = KeyEqual>
+  using TransparentKey =
+      std::void_t<typename H::is_transparent, typename E::is_transparent>;
+
+  Table table_;
+
+ public:
+  using iterator = typename Table::const_iterator;
+  using const_iterator = typename Table::const_iterator;
+
+  // Конструкторы
+
+  UnorderedSet() = default;
+  explicit UnorderedSet(size_type bucket_count, const Hash& hash = Hash(),
+                        const KeyEqual& equal = KeyEqual());
+  UnorderedSet(std::initializer_list<value_type> const& items);
+  UnorderedSet(const UnorderedSet& other) = default;
+  UnorderedSet(UnorderedSet&& other) noexcept = default;
+  ~UnorderedSet() = default;
+
+  UnorderedSet& operator=(const UnorderedSet& other) = default;
+  UnorderedSet& operator=(UnorderedSet&& other) noexcept = default;
+
+  // Итераторы
+
+  iterator begin() const { return table_.begin(); }
+  iterator end() const { return table_.end(); }
+
+  // Вместимость
+
+  bool empty() const { return table_.empty(); }
+  size_type size() const { return table_.size(); }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / (sizeof(Key) + 1);
+  }
+  void reserve(size_type count) { table_.reserve(count); }
+
+  // Хеш-политика
+
+  size_type bucket_count() const { return table_.bucket_count(); }
+  float load_factor() const { return table_.load_factor(); }
+  float max_load_factor() const { return table_.max_load_factor(); }
+  void max_load_factor(float factor) { table_.max_load_factor(factor); }
+  void rehash(size_type count) { table_.rehash(count); }
+  hasher hash_function() const { return table_.hash_function(); }
+  key_equal key_eq() const { return table_.key_eq(); }
+
+  // Модификаторы
+
+  void clear() { table_.clear(); }
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return table_.emplaceKey(value, value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return table_.emplaceKey(value, std::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  void erase(iterator pos) { table_.erase(pos); }
+  size_type erase(const Key& key) { return table_.eraseKey(key); }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  size_type erase(const K& key) {
+    return table_.eraseKey(key);
+  }
+  void swap(UnorderedSet& other) { table_.swap(other.table_); }
+  void merge(UnorderedSet& other) { table_.merge(other.table_); }
+
+  // Просмотр контейнера
+
+  iterator find(const Key& key) const { return table_.find(key); }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  iterator find(const K& key) const {
+    return table_.find(key);
+  }
+  bool contains(const Key& key) const { return find(key) != end(); }
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = TransparentKey<K, H, E>>
+  bool contains(const K& key) const {
+    return table_.find(key) != table_.end();
+  }
+
+  template <typename... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  bool validateForTesting() const { return table_.validateForTesting(); }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_UNORDERED_SET_HPP
@@ -51,28 +51,31 @@ class Vector {
   reference at(
       size_type pos);  // доступ к указанному элементу с проверкой границ
   reference operator[](size_type pos);  // доступ к указанному элементу
+  const_reference operator[](size_type pos) const;
   const_reference front();  // доступ к первлму элементу
   const_reference back();  // доступ к последнему элементу
   T* data();  // прямой доступ к базовому массиву
+  const T* data() const;
 
   // Итераторы
 
   iterator begin() { return data_; };  // перемещает итератор в начало
   iterator end() { return data_ + size_; };  // перемещает итератор в конец
-  const_iterator begin() const;  // перемещает итератор в начало
-  const_iterator end() const;  // перемещает итератор в конец
+  const_iterator begin() const { return data_; };  // то же для константы
+  const_iterator end() const { return data_ + size_; };
 
   // Вместимость
 
-  bool empty();      // проверяет, пуст ли контейнер
-  size_type size();  // возвращает количество элементов
-  size_type
-  max_size();  // возвращает максимально возможное количество элементов
+  bool empty() const;      // проверяет, пуст ли контейнер
+  size_type size() const;  // возвращает количество элементов
+  size_type max_size() const;  // возвращает максимально возможное
+                               // количество элементов
   void reserve(size_type new_cap);  // выделяет память для указанного количества
-                                    // элементов и копирует текущие элементы
+                                    // элементов и перемещает текущие элементы
                                     // массива в новый массив
-  size_type capacity();  // возвращает количество элементов, которые могут
-                         // храниться в выделенной на данный момент памяти
+  size_type capacity() const;  // возвращает количество элементов, которые
+                               // могут храниться в выделенной на данный
+                               // момент памяти
   void shrink_to_fit();  // уменьшает использование памяти за счет освобождения
                          // неиспользуемой памяти
 
@@ -85,6 +88,7 @@ class Vector {
                                            // указывающий на новый элемент
   void erase(iterator pos);  // стирает элемент в позиции pos
   void push_back(const_reference value);  // добавляет элемент в конец
+  void push_back(T&& value);  // перемещает элемент в конец
   void pop_back();           // удаляет последний элемент
   void swap(Vector& other);  // Заменяет содержимое контейнера содержимым x,
                              // которое является другим векторным объектом того
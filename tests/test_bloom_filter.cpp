@@ -0,0 +1,250 @@
+//
+// Тесты фильтра Блума и его использования в Set и Map
+//
+#include <cctype>
+#include <string>
+#include <utility>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+namespace {
+
+// Ключ без std::hash: Set и Map с ним должны собираться как раньше
+struct Point {
+  int x;
+  int y;
+  bool operator<(const Point& other) const {
+    return x < other.x || (x == other.x && y < other.y);
+  }
+};
+
+// Сравнение без учета регистра: std::hash с ним не согласован
+struct CaseInsensitiveLess {
+  bool operator()(const std::string& a, const std::string& b) const {
+    return lower(a) < lower(b);
+  }
+  static std::string lower(std::string text) {
+    for (char& c : text) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return text;
+  }
+};
+
+struct CaseInsensitiveHash {
+  std::size_t operator()(const std::string& text) const {
+    return std::hash<std::string>()(CaseInsensitiveLess::lower(text));
+  }
+};
+
+// Порядок только по x
+struct ByX {
+  bool operator()(const std::pair<int, int>& a,
+                  const std::pair<int, int>& b) const {
+    return a.first < b.first;
+  }
+};
+
+}  // namespace
+
+namespace s21 {
+template <>
+struct BloomFilterHash<std::string, CaseInsensitiveLess> {
+  using type = CaseInsensitiveHash;
+};
+}  // namespace s21
+
+TEST(BloomFilterTest, No_False_Negatives) {
+  BloomFilter<int> filter(10000);
+  for (int i = 0; i < 10000; ++i) filter.insert(i * 7);
+  for (int i = 0; i < 10000; ++i) EXPECT_TRUE(filter.may_contain(i * 7));
+  EXPECT_EQ(filter.stats().filtered, 0u);
+  EXPECT_EQ(filter.stats().lookups, 10000u);
+}
+
+TEST(BloomFilterTest, False_Positive_Rate) {
+  BloomFilter<int> filter(10000);
+  for (int i = 0; i < 10000; ++i) filter.insert(i);
+  int passed = 0;
+  for (int i = 10000; i < 110000; ++i) passed += filter.may_contain(i);
+  // При 10 битах на ключ ожидается около 1%
+  EXPECT_LT(passed, 3000);
+  EXPECT_EQ(filter.stats().filtered, 100000u - passed);
+}
+
+TEST(BloomFilterTest, Stale_After_Growth_And_Erases) {
+  BloomFilter<std::string> filter(4);
+  EXPECT_THROW(BloomFilter<int>(4, 0.0), std::invalid_argument);
+  for (int i = 0; i < 4; ++i) filter.insert(std::to_string(i));
+  EXPECT_FALSE(filter.stale());
+  filter.insert("4");
+  EXPECT_TRUE(filter.stale());
+
+  filter.reset(8);
+  EXPECT_EQ(filter.stats().rebuilds, 1u);
+  for (int i = 0; i < 4; ++i) filter.insert(std::to_string(i));
+  filter.note_erase();
+  filter.note_erase();
+  EXPECT_FALSE(filter.stale());
+  filter.note_erase();
+  EXPECT_TRUE(filter.stale());
+}
+
+TEST(BloomFilterTest, Set_Filters_Misses) {
+  Set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(2 * i);
+  EXPECT_FALSE(set.filter_enabled());
+  set.enable_filter();
+  EXPECT_TRUE(set.filter_enabled());
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(set.contains(2 * i));
+    EXPECT_FALSE(set.contains(2 * i + 1));
+    EXPECT_EQ(set.find(2 * i + 1), set.end());
+    EXPECT_EQ(*set.find(2 * i), 2 * i);
+  }
+  BloomFilterStats stats = set.filter_stats();
+  EXPECT_EQ(stats.lookups, 4000u);
+  EXPECT_EQ(stats.filtered + stats.false_positives, 2000u);
+  EXPECT_LT(stats.false_positive_rate(), 0.1);
+  EXPECT_GT(stats.bits, 0u);
+
+  set.disable_filter();
+  EXPECT_EQ(set.filter_stats().lookups, 0u);
+  EXPECT_TRUE(set.contains(0));
+}
+
+TEST(BloomFilterTest, Set_Stays_In_Sync) {
+  Set<int> set;
+  set.enable_filter();
+  // Рост от пустого дерева: фильтр перестраивается и не теряет ключи
+  for (int i = 0; i < 5000; ++i) set.insert(i);
+  EXPECT_GT(set.filter_stats().rebuilds, 5u);
+  for (int i = 0; i < 5000; ++i) ASSERT_TRUE(set.contains(i));
+
+  // После удаления большей части ключей они перестают проходить фильтр
+  for (int i = 0; i < 4000; ++i) set.erase(i);
+  for (int i = 0; i < 4000; ++i) ASSERT_FALSE(set.contains(i));
+  for (int i = 4000; i < 5000; ++i) ASSERT_TRUE(set.contains(i));
+  BloomFilterStats stats = set.filter_stats();
+  EXPECT_GT(stats.filtered, stats.false_positives);
+
+  Set<int> other = {1, 2, 3};
+  set.merge(other);
+  EXPECT_TRUE(set.contains(2));
+  set.clear();
+  EXPECT_FALSE(set.contains(4500));
+
+  std::vector<int> keys = {1, 3, 5};
+  set.assign_sorted(keys.begin(), keys.end());
+  EXPECT_TRUE(set.contains(5));
+  EXPECT_FALSE(set.contains(4));
+}
+
+TEST(BloomFilterTest, Set_Copy_And_Move) {
+  Set<int> set = {1, 2, 3};
+  set.enable_filter();
+  Set<int> copy(set);
+  EXPECT_TRUE(copy.filter_enabled());
+  copy.insert(10);
+  EXPECT_TRUE(copy.contains(10));
+  EXPECT_FALSE(set.contains(10));
+
+  Set<int> assigned;
+  assigned = copy;
+  EXPECT_TRUE(assigned.filter_enabled());
+  EXPECT_TRUE(assigned.contains(10));
+
+  Set<int> moved(std::move(copy));
+  EXPECT_TRUE(moved.filter_enabled());
+  EXPECT_TRUE(moved.contains(10));
+
+  Set<int> plain;
+  plain.swap(moved);
+  EXPECT_TRUE(plain.filter_enabled());
+  EXPECT_FALSE(moved.filter_enabled());
+}
+
+TEST(BloomFilterTest, Map_Filters_Misses) {
+  Map<std::string, int> map;
+  for (int i = 0; i < 1000; ++i) map.insert(std::to_string(2 * i), i);
+  map.enable_filter();
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(map.contains(std::to_string(2 * i)));
+    EXPECT_FALSE(map.contains(std::to_string(2 * i + 1)));
+    EXPECT_EQ(map.find(std::to_string(2 * i + 1)), map.end());
+    EXPECT_EQ(map.find(std::to_string(2 * i))->second, i);
+  }
+  BloomFilterStats stats = map.filter_stats();
+  EXPECT_EQ(stats.lookups, 4000u);
+  EXPECT_EQ(stats.filtered + stats.false_positives, 2000u);
+  EXPECT_LT(stats.false_positive_rate(), 0.1);
+}
+
+TEST(BloomFilterTest, Map_Stays_In_Sync) {
+  Map<int, int> map;
+  map.enable_filter();
+  for (int i = 0; i < 5000; ++i) map[i] = i;
+  for (int i = 0; i < 5000; ++i) ASSERT_TRUE(map.contains(i));
+  for (int i = 0; i < 4000; ++i) map.erase(map.find(i));
+  for (int i = 0; i < 4000; ++i) ASSERT_FALSE(map.contains(i));
+  for (int i = 4000; i < 5000; ++i) ASSERT_TRUE(map.contains(i));
+
+  auto handle = map.extract(4500);
+  EXPECT_FALSE(map.contains(4500));
+  map.insert(std::move(handle));
+  EXPECT_TRUE(map.contains(4500));
+
+  Map<int, int> copy(map);
+  Map<int, int> moved(std::move(map));
+  EXPECT_TRUE(copy.filter_enabled());
+  EXPECT_TRUE(moved.filter_enabled());
+  EXPECT_TRUE(copy.contains(4999));
+  EXPECT_TRUE(moved.validateForTesting());
+  moved.clear();
+  EXPECT_FALSE(moved.contains(4999));
+}
+
+TEST(BloomFilterTest, Key_Without_Hash) {
+  Set<Point> set = {{1, 2}, {3, 4}};
+  Map<Point, int> map = {{{1, 2}, 1}};
+  EXPECT_FALSE(set.filter_enabled());
+  EXPECT_TRUE(set.contains({3, 4}));
+  EXPECT_TRUE(map.contains({1, 2}));
+  EXPECT_EQ(map.filter_stats().lookups, 0u);
+}
+
+// Фильтр хеширует ключ так же, как его видит компаратор, и не отвергает
+// ключ, равный хранимому
+TEST(BloomFilterTest, Custom_Comparator) {
+  static_assert(kBloomFilterable<int, std::greater<int>>);
+  static_assert(!kBloomFilterable<std::pair<int, int>, ByX>);
+  static_assert(!kBloomFilterable<Point, std::less<Point>>);
+
+  Set<std::string, CaseInsensitiveLess> set;
+  for (int i = 0; i < 500; ++i) set.insert("Key" + std::to_string(i));
+  set.enable_filter();
+  for (int i = 0; i < 500; ++i) {
+    ASSERT_TRUE(set.contains("KEY" + std::to_string(i)));
+    ASSERT_NE(set.find("key" + std::to_string(i)), set.end());
+    ASSERT_FALSE(set.contains("key" + std::to_string(i + 500)));
+  }
+  EXPECT_GT(set.filter_stats().filtered, 0u);
+
+  Map<std::string, int, CaseInsensitiveLess> map;
+  map.enable_filter();
+  map.insert("Apple", 1);
+  EXPECT_TRUE(map.contains("APPLE"));
+  EXPECT_EQ(map.find("apple")->second, 1);
+
+  Set<int, std::greater<int>> reversed = {3, 1, 2};
+  reversed.enable_filter();
+  EXPECT_TRUE(reversed.contains(2));
+  EXPECT_FALSE(reversed.contains(4));
+
+  // Без согласованного хеша фильтр не включается, а поиск работает
+  Set<std::pair<int, int>, ByX> by_x = {{1, 1}, {2, 2}};
+  EXPECT_TRUE(by_x.contains({1, 5}));
+}
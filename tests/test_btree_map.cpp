@@ -0,0 +1,241 @@
+//
+// Тесты B+-дерева BTreeMap
+//
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+// Узел в одну кэш-линию: по 4 ключа в узле, дерево быстро растет в высоту
+template <typename K, typename V>
+using TinyBTreeMap = BTreeMap<K, V, 64>;
+
+namespace {
+
+// Копирование бросает исключение, пока armed; перемещение не бросает
+struct ThrowingKey {
+  static bool armed;
+  int value = 0;
+
+  ThrowingKey() = default;
+  explicit ThrowingKey(int v) : value(v) {}
+  ThrowingKey(const ThrowingKey& other) : value(other.value) { check(); }
+  ThrowingKey(ThrowingKey&& other) noexcept = default;
+  ThrowingKey& operator=(const ThrowingKey& other) {
+    check();
+    value = other.value;
+    return *this;
+  }
+  ThrowingKey& operator=(ThrowingKey&& other) noexcept = default;
+  bool operator<(const ThrowingKey& other) const {
+    return value < other.value;
+  }
+
+  static void check() {
+    if (armed) throw std::runtime_error("copy failed");
+  }
+};
+
+bool ThrowingKey::armed = false;
+
+template <typename Map>
+std::vector<int> keysOf(const Map& map) {
+  std::vector<int> keys;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    keys.push_back((*it).first.value);
+  }
+  return keys;
+}
+
+}  // namespace
+
+TEST(BTreeMapTest, Basic_Interface) {
+  BTreeMap<int, int> map{{2, 20}, {1, 10}, {3, 30}};
+  EXPECT_EQ(map.size(), 3UL);
+  EXPECT_FALSE(map.empty());
+  EXPECT_EQ(map.at(2), 20);
+  EXPECT_TRUE(map.contains(3));
+  EXPECT_FALSE(map.contains(4));
+  EXPECT_THROW(map.at(4), std::out_of_range);
+
+  map[4] = 40;
+  EXPECT_EQ(map.at(4), 40);
+  EXPECT_FALSE(map.insert(1, 100).second);
+  EXPECT_EQ(map.at(1), 10);
+  EXPECT_FALSE(map.insert_or_assign(1, 100).second);
+  EXPECT_EQ(map.at(1), 100);
+  EXPECT_TRUE(map.insert({5, 50}).second);
+
+  int expected = 1;
+  for (auto it = map.begin(); it != map.end(); ++it, ++expected) {
+    EXPECT_EQ(it->first, expected);
+  }
+  EXPECT_EQ(expected, 6);
+
+  map.erase(map.find(3));
+  EXPECT_EQ(map.erase(3), 0UL);
+  EXPECT_EQ(map.erase(4), 1UL);
+  EXPECT_EQ(map.size(), 3UL);
+  EXPECT_TRUE(map.validateForTesting());
+
+  const BTreeMap<int, int>& view = map;
+  EXPECT_EQ(view.at(5), 50);
+  EXPECT_EQ(view.find(3), view.end());
+  EXPECT_EQ((*view.find(2)).second, 20);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.height(), 0UL);
+}
+
+// Случайные вставки и удаления сверяются с std::map, инварианты дерева
+// проверяются на каждом шаге
+TEST(BTreeMapTest, Random_Operations_Match_Std_Map) {
+  TinyBTreeMap<int, int> map;
+  std::map<int, int> reference;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> key_dist(0, 499);
+
+  for (int step = 0; step < 5000; ++step) {
+    int key = key_dist(gen);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), reference.erase(key));
+    } else {
+      EXPECT_EQ(map.insert(key, step).second,
+                reference.insert({key, step}).second);
+    }
+    ASSERT_TRUE(map.validateForTesting()) << "step " << step;
+  }
+  EXPECT_GT(map.height(), 2UL);
+  ASSERT_EQ(map.size(), reference.size());
+
+  auto expected = reference.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++expected) {
+    EXPECT_EQ((*it).first, expected->first);
+    EXPECT_EQ((*it).second, expected->second);
+  }
+
+  for (const auto& item : reference) {
+    EXPECT_EQ(map.erase(item.first), 1UL);
+  }
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+// Последовательные ключи заполняют только правый край дерева
+TEST(BTreeMapTest, Sequential_Keys) {
+  TinyBTreeMap<int, int> map;
+  for (int i = 0; i < 1000; ++i) map.insert(i, i);
+  EXPECT_TRUE(map.validateForTesting());
+  for (int i = 999; i >= 0; i -= 2) map.erase(i);
+  EXPECT_TRUE(map.validateForTesting());
+  EXPECT_EQ(map.size(), 500UL);
+  EXPECT_EQ(map.at(500), 500);
+  EXPECT_FALSE(map.contains(501));
+}
+
+TEST(BTreeMapTest, String_Values_And_Copy) {
+  BTreeMap<std::string, std::string, 128> map;
+  for (int i = 0; i < 200; ++i) {
+    map[std::to_string(i)] = std::string(20, static_cast<char>('a' + i % 26));
+  }
+  BTreeMap<std::string, std::string, 128> copy(map);
+  EXPECT_TRUE(copy.validateForTesting());
+  map.erase("10");
+  EXPECT_FALSE(map.contains("10"));
+  EXPECT_EQ(copy.at("10"), std::string(20, 'k'));
+
+  BTreeMap<std::string, std::string, 128> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 200UL);
+  copy = moved;
+  EXPECT_EQ(copy.size(), 200UL);
+  moved = std::move(map);
+  EXPECT_EQ(moved.size(), 199UL);
+  EXPECT_TRUE(moved.validateForTesting());
+}
+
+// Повторяющиеся ключи остаются в источнике вместе со своими значениями
+TEST(BTreeMapTest, Merge_Keeps_Duplicates) {
+  TinyBTreeMap<int, std::string> map;
+  TinyBTreeMap<int, std::string> other;
+  for (int i = 0; i < 100; i += 2) map.insert(i, "map");
+  for (int i = 0; i < 100; i += 3) other.insert(i, "other");
+
+  map.merge(other);
+  EXPECT_EQ(map.size(), 67UL);
+  EXPECT_EQ(other.size(), 17UL);
+  EXPECT_EQ(map.at(0), "map");
+  EXPECT_EQ(map.at(3), "other");
+  EXPECT_EQ(other.at(6), "other");
+  EXPECT_FALSE(other.contains(3));
+  EXPECT_TRUE(map.validateForTesting());
+  EXPECT_TRUE(other.validateForTesting());
+}
+
+TEST(BTreeMapTest, Insert_Many) {
+  TinyBTreeMap<int, int> map{{5, 50}};
+  auto results = map.insert_many(std::pair<const int, int>{1, 10},
+                                 std::pair<const int, int>{5, 0},
+                                 std::pair<const int, int>{9, 90});
+  ASSERT_EQ(results.size(), 3UL);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ((*results[1].first).second, 50);
+  EXPECT_EQ((*results[2].first).first, 9);
+  EXPECT_EQ(map.size(), 3UL);
+}
+
+// Неудачная вставка не меняет дерево: ни сдвиг в листе, ни расщепления
+// листа, внутренних узлов и корня не начинаются до копирования ключа
+TEST(BTreeMapTest, Throwing_Key_Leaves_Tree_Unchanged) {
+  BTreeMap<ThrowingKey, int> small;
+  for (int i = 0; i < 20; i += 2) small.insert(ThrowingKey(i), i);
+  ThrowingKey::armed = true;
+  EXPECT_THROW(small.insert(ThrowingKey(5), 5), std::runtime_error);
+  ThrowingKey::armed = false;
+  EXPECT_EQ(small.size(), 10UL);
+  EXPECT_TRUE(small.contains(ThrowingKey(18)));
+  EXPECT_EQ(keysOf(small),
+            (std::vector<int>{0, 2, 4, 6, 8, 10, 12, 14, 16, 18}));
+
+  TinyBTreeMap<ThrowingKey, int> map;
+  std::vector<int> expected;
+  for (int i = 0; i < 400; i += 2) {
+    map.insert(ThrowingKey(i), i);
+    expected.push_back(i);
+  }
+  ASSERT_GT(map.height(), 2UL);
+  for (int i = -1; i < 401; i += 2) {
+    ThrowingKey::armed = true;
+    EXPECT_THROW(map[ThrowingKey(i)], std::runtime_error);
+    ThrowingKey::armed = false;
+    ASSERT_TRUE(map.validateForTesting());
+    ASSERT_EQ(keysOf(map), expected);
+  }
+  for (int i = -1; i < 401; i += 2) {
+    ASSERT_TRUE(map.insert(ThrowingKey(i), i).second);
+  }
+  EXPECT_EQ(map.size(), 401UL);
+  EXPECT_TRUE(map.validateForTesting());
+
+  // Исключение из конструктора значения и при вставке в пустое дерево
+  TinyBTreeMap<int, ThrowingKey> values;
+  ThrowingKey value(1);
+  ThrowingKey::armed = true;
+  EXPECT_THROW(values.insert(1, value), std::runtime_error);
+  ThrowingKey::armed = false;
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(values.height(), 0UL);
+  for (int i = 0; i < 64; ++i) values.insert(i, value);
+  ThrowingKey::armed = true;
+  EXPECT_THROW(values.insert(100, value), std::runtime_error);
+  ThrowingKey::armed = false;
+  EXPECT_EQ(values.size(), 64UL);
+  EXPECT_TRUE(values.validateForTesting());
+}
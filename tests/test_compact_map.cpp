@@ -0,0 +1,121 @@
+//
+// Тесты CompactMap и компактного дерева
+//
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+TEST(CompactMapTest, Node_Layout_Is_Compact) {
+  EXPECT_EQ((CompactMap<int, int>::kNodeSize), 20UL);
+  EXPECT_EQ(CompactSet<int>::kNodeSize, 16UL);
+}
+
+TEST(CompactMapTest, Basic_Interface) {
+  CompactMap<int, std::string> map{{2, "two"}, {1, "one"}, {2, "dos"}};
+  EXPECT_EQ(map.size(), 2UL);
+  EXPECT_EQ(map.at(2), "two");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+
+  map[3] = "three";
+  EXPECT_FALSE(map.insert(3, "tres").second);
+  EXPECT_FALSE(map.insert_or_assign(3, "tres").second);
+  EXPECT_EQ(map.at(3), "tres");
+  EXPECT_TRUE(map.emplace(5, "five").second);
+  EXPECT_TRUE(map.try_emplace(4, 2, 'x').second);
+  EXPECT_EQ(map.find(4)->second, "xx");
+
+  std::vector<int> keys;
+  for (const auto& item : map) keys.push_back(item.first);
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4, 5}));
+  auto last = map.end();
+  --last;
+  EXPECT_EQ(last->first, 5);
+
+  EXPECT_EQ(map.lower_bound(3)->first, 3);
+  EXPECT_EQ(map.upper_bound(3)->first, 4);
+  std::size_t in_range = 0;
+  for (const auto& item : map.range(2, 4)) in_range += item.first;
+  EXPECT_EQ(in_range, 5UL);
+
+  map.erase(map.find(2));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_TRUE(map.validateForTesting());
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(CompactMapTest, Matches_Std_Map) {
+  std::mt19937 random(11);
+  CompactMap<int, int> map;
+  std::map<int, int> reference;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 2000);
+    if (random() % 3 == 0) {
+      auto it = map.find(key);
+      EXPECT_EQ(it != map.end(), reference.erase(key) == 1);
+      if (it != map.end()) map.erase(it);
+    } else {
+      EXPECT_EQ(map.insert({key, i}).second,
+                reference.insert({key, i}).second);
+    }
+  }
+  EXPECT_TRUE(map.validateForTesting());
+  ASSERT_EQ(map.size(), reference.size());
+  auto expected = reference.begin();
+  for (const auto& item : map) {
+    EXPECT_EQ(item, *expected);
+    ++expected;
+  }
+  // Освобожденные слоты переиспользуются: массив не больше пика размера
+  EXPECT_LE(map.capacity(), 4096UL);
+}
+
+TEST(CompactMapTest, Iterators_Survive_Growth) {
+  CompactMap<int, int> map;
+  auto first = map.insert({0, 0}).first;
+  for (int i = 1; i < 1000; ++i) map[i] = i;
+  EXPECT_GE(map.capacity(), 1000UL);
+  EXPECT_EQ(first->first, 0);
+  first->second = 42;
+  EXPECT_EQ(map.at(0), 42);
+
+  map.reserve(5000);
+  EXPECT_GE(map.capacity(), 5000UL);
+  EXPECT_EQ(first->second, 42);
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+TEST(CompactMapTest, Merge_Insert_Many_And_Copy) {
+  CompactMap<int, int> map{{1, 10}, {3, 30}};
+  CompactMap<int, int> other{{2, 20}, {3, 300}, {4, 40}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 4UL);
+  EXPECT_EQ(map.at(3), 30);
+  EXPECT_EQ(other.size(), 1UL);
+  EXPECT_EQ(other.at(3), 300);
+  EXPECT_TRUE(other.validateForTesting());
+
+  auto results = map.insert_many(std::pair<const int, int>(5, 50),
+                                 std::pair<const int, int>(1, 0));
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(results[1].first->second, 10);
+
+  map.erase(map.find(2));
+  CompactMap<int, int> copy(map);
+  map.clear();
+  EXPECT_TRUE(copy.validateForTesting());
+  EXPECT_EQ(copy.size(), 4UL);
+  copy[6] = 60;
+  EXPECT_TRUE(copy.validateForTesting());
+  CompactMap<int, int> moved(std::move(copy));
+  EXPECT_EQ(moved.at(6), 60);
+  map = moved;
+  EXPECT_EQ(map.size(), 5UL);
+}
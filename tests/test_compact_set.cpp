@@ -0,0 +1,63 @@
+//
+// Тесты CompactSet
+//
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+TEST(CompactSetTest, Basic_Interface) {
+  CompactSet<std::string> set{"pear", "apple", "fig", "apple"};
+  EXPECT_EQ(set.size(), 3UL);
+  EXPECT_EQ(*set.begin(), "apple");
+  EXPECT_TRUE(set.contains("fig"));
+  EXPECT_TRUE(set.emplace(2, 'z').second);
+  EXPECT_FALSE(set.insert("fig").second);
+
+  set.erase(set.find("fig"));
+  std::vector<std::string> expected{"apple", "pear", "zz"};
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_EQ(*set.lower_bound("b"), "pear");
+  EXPECT_EQ(set.upper_bound("zz"), set.end());
+
+  auto results = set.insert_many("kiwi", "pear");
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  CompactSet<std::string> other{"kiwi", "lime"};
+  set.merge(other);
+  EXPECT_EQ(set.size(), 5UL);
+  EXPECT_TRUE(other.contains("kiwi"));
+  EXPECT_TRUE(set.validateForTesting());
+}
+
+TEST(CompactSetTest, Matches_Std_Set) {
+  std::mt19937 random(5);
+  CompactSet<int> set;
+  std::set<int> reference;
+  for (int i = 0; i < 30000; ++i) {
+    int key = static_cast<int>(random() % 4000);
+    if (random() % 2 == 0) {
+      auto it = set.find(key);
+      EXPECT_EQ(it != set.end(), reference.erase(key) == 1);
+      if (it != set.end()) set.erase(it);
+    } else {
+      EXPECT_EQ(set.insert(key).second, reference.insert(key).second);
+    }
+  }
+  EXPECT_TRUE(set.validateForTesting());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(),
+                         reference.end()));
+  std::size_t visited = 0;
+  for (int key : set.range(1000, 2000)) {
+    EXPECT_TRUE(key >= 1000 && key < 2000);
+    ++visited;
+  }
+  EXPECT_EQ(visited, static_cast<std::size_t>(std::distance(
+                         reference.lower_bound(1000),
+                         reference.lower_bound(2000))));
+}
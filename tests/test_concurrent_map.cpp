@@ -0,0 +1,103 @@
+//
+// Тесты ConcurrentMap
+//
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+TEST(ConcurrentMapTest, Basic_Interface) {
+  ConcurrentMap<int, std::string> map(5);
+  EXPECT_EQ(map.shard_count(), 8UL);
+  EXPECT_TRUE(map.empty());
+
+  EXPECT_TRUE(map.insert(1, "one"));
+  EXPECT_FALSE(map.insert(1, "uno"));
+  EXPECT_TRUE(map.insert_or_assign(2, "two"));
+  EXPECT_FALSE(map.insert_or_assign(2, "dos"));
+  EXPECT_EQ(*map.find(2), "dos");
+  EXPECT_FALSE(map.find(3).has_value());
+  EXPECT_TRUE(map.contains(1));
+
+  EXPECT_TRUE(map.update(1, [](std::string& value) { value += "!"; }));
+  EXPECT_FALSE(map.update(3, [](std::string&) {}));
+  EXPECT_EQ(*map.find(1), "one!");
+
+  EXPECT_TRUE(map.erase(1));
+  EXPECT_FALSE(map.erase(1));
+  EXPECT_EQ(map.size(), 1UL);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(ConcurrentMapTest, Range_Merges_Shards_In_Order) {
+  ConcurrentMap<int, int> map(16);
+  for (int i = 0; i < 1000; ++i) map.insert(i * 7 % 1000, i);
+
+  auto slice = map.range(100, 250);
+  ASSERT_EQ(slice.size(), 150UL);
+  for (std::size_t i = 0; i < slice.size(); ++i) {
+    EXPECT_EQ(slice[i].first, 100 + static_cast<int>(i));
+  }
+  EXPECT_TRUE(map.range(250, 100).empty());
+
+  int previous = -1;
+  std::size_t visited = 0;
+  map.scan(0, 1000, [&](const int& key, const int&) {
+    EXPECT_LT(previous, key);
+    previous = key;
+    ++visited;
+  });
+  EXPECT_EQ(visited, 1000UL);
+}
+
+TEST(ConcurrentMapTest, Parallel_Writers_And_Scans) {
+  ConcurrentMap<int, int> map(8);
+  const int kThreads = 8;
+  const int kPerThread = 2000;
+  for (int key = 0; key < 100; ++key) map.insert(key, 0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&map, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        map.insert(1000 + t * kPerThread + i, i);
+        map.update(i % 100, [](int& value) { ++value; });
+        if (i % 2 == 0) map.erase(1000 + t * kPerThread + i);
+      }
+    });
+  }
+  // Каждый обход видит согласованный срез: ключи строго возрастают
+  bool ordered = true;
+  for (int round = 0; round < 20; ++round) {
+    auto slice = map.range(0, 1000 + kThreads * kPerThread);
+    for (std::size_t i = 1; i < slice.size(); ++i) {
+      ordered = ordered && slice[i - 1].first < slice[i].first;
+    }
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_TRUE(ordered);
+
+  EXPECT_EQ(map.size(), 100UL + kThreads * kPerThread / 2);
+  int total = 0;
+  map.scan(0, 100, [&total](const int&, const int& value) { total += value; });
+  EXPECT_EQ(total, kThreads * kPerThread);
+
+  std::size_t reads = 0;
+  std::size_t writes = 0;
+  std::size_t size = 0;
+  for (const ShardStats& stats : map.shard_stats()) {
+    reads += stats.reads;
+    writes += stats.writes;
+    size += stats.size;
+    EXPECT_LE(stats.contended_writes, stats.writes);
+  }
+  EXPECT_EQ(size, map.size());
+  EXPECT_EQ(writes, 100UL + kThreads * kPerThread * 5 / 2);
+  EXPECT_GT(reads, 0UL);
+  map.reset_shard_stats();
+  EXPECT_EQ(map.shard_stats()[0].writes, 0UL);
+}
@@ -0,0 +1,144 @@
+//
+// Тесты FlatMap
+//
+#include <map>
+#include <random>
+#include <string>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+TEST(FlatMapTest, Basic_Interface) {
+  FlatMap<int, std::string> map{{3, "three"}, {1, "one"}, {2, "two"}};
+  EXPECT_EQ(map.size(), 3UL);
+  EXPECT_EQ(map.at(2), "two");
+  EXPECT_THROW(map.at(4), std::out_of_range);
+  EXPECT_TRUE(map.contains(1));
+  EXPECT_FALSE(map.contains(0));
+
+  map[4] = "four";
+  EXPECT_EQ(map.at(4), "four");
+  EXPECT_FALSE(map.insert(1, "uno").second);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_FALSE(map.insert_or_assign(1, "uno").second);
+  EXPECT_EQ(map.at(1), "uno");
+  auto result = map.try_emplace(0, 3, 'z');
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(result.first->second, "zzz");
+
+  int expected = 0;
+  for (auto it = map.begin(); it != map.end(); ++it, ++expected) {
+    EXPECT_EQ((*it).first, expected);
+  }
+  EXPECT_EQ(expected, 5);
+
+  map.erase(map.find(2));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 4UL);
+
+  const FlatMap<int, std::string>& view = map;
+  EXPECT_EQ(view.at(3), "three");
+  EXPECT_EQ(view.find(2), view.end());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+// Повторы внутри пакета и с уже имеющимися ключами не вставляются, а
+// итераторы результата указывают на элементы после слияния
+TEST(FlatMapTest, Insert_Many_Merges_Batch) {
+  FlatMap<int, int> map{{5, 50}, {1, 10}};
+  auto results = map.insert_many(std::pair<const int, int>{3, 30},
+                                 std::pair<const int, int>{5, 0},
+                                 std::pair<const int, int>{7, 70},
+                                 std::pair<const int, int>{3, 31});
+  ASSERT_EQ(results.size(), 4UL);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_TRUE(results[2].second);
+  EXPECT_FALSE(results[3].second);
+  EXPECT_EQ((*results[1].first).second, 50);
+  EXPECT_EQ((*results[3].first).second, 30);
+  EXPECT_EQ(map.size(), 4UL);
+
+  int keys[] = {1, 3, 5, 7};
+  int index = 0;
+  for (auto item : map) {
+    EXPECT_EQ(item.first, keys[index++]);
+  }
+}
+
+TEST(FlatMapTest, Bounds_And_Range) {
+  FlatMap<int, int> map;
+  for (int i = 0; i < 100; i += 10) map.insert(i, i);
+  EXPECT_EQ(map.lower_bound(15)->first, 20);
+  EXPECT_EQ(map.lower_bound(20)->first, 20);
+  EXPECT_EQ(map.upper_bound(20)->first, 30);
+  EXPECT_EQ(map.upper_bound(90), map.end());
+  auto equal = map.equal_range(40);
+  EXPECT_EQ(equal.first->first, 40);
+  EXPECT_EQ(equal.second->first, 50);
+
+  int sum = 0;
+  for (auto item : map.range(25, 60)) sum += item.second;
+  EXPECT_EQ(sum, 30 + 40 + 50);
+  EXPECT_TRUE(map.range(60, 25).empty());
+}
+
+// Случайные вставки и удаления сверяются с std::map
+TEST(FlatMapTest, Matches_Std_Map) {
+  FlatMap<int, int> map;
+  std::map<int, int> reference;
+  std::mt19937 gen(7);
+  for (int step = 0; step < 3000; ++step) {
+    int key = static_cast<int>(gen() % 500);
+    auto it = map.find(key);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(it != map.end(), reference.erase(key) == 1);
+      if (it != map.end()) map.erase(it);
+    } else {
+      EXPECT_EQ(map.insert(key, step).second,
+                reference.insert({key, step}).second);
+    }
+  }
+  ASSERT_EQ(map.size(), reference.size());
+  auto expected = reference.begin();
+  for (auto item : map) {
+    EXPECT_EQ(item.first, expected->first);
+    EXPECT_EQ(item.second, expected->second);
+    ++expected;
+  }
+}
+
+TEST(FlatMapTest, Merge_Copy_And_Assign_Sorted) {
+  FlatMap<int, std::string> map{{1, "a"}, {3, "c"}};
+  FlatMap<int, std::string> other{{2, "b"}, {3, "x"}, {4, "d"}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 4UL);
+  EXPECT_EQ(map.at(3), "c");
+  EXPECT_EQ(map.at(4), "d");
+  EXPECT_EQ(other.size(), 1UL);
+  EXPECT_EQ(other.at(3), "x");
+
+  FlatMap<int, std::string> copy(map);
+  map.clear();
+  EXPECT_EQ(copy.at(2), "b");
+  map = copy;
+  FlatMap<int, std::string> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 4UL);
+  EXPECT_EQ(map.size(), 4UL);
+
+  std::map<int, std::string> sorted{{10, "j"}, {20, "t"}};
+  map.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(map.size(), 2UL);
+  EXPECT_EQ(map.at(20), "t");
+
+  std::pair<const int, std::string> unsorted[] = {
+      {5, "e"}, {2, "b"}, {5, "dup"}};
+  map.assign_sorted(std::begin(unsorted), std::end(unsorted), true);
+  EXPECT_EQ(map.size(), 2UL);
+  EXPECT_EQ(map.at(5), "e");
+  EXPECT_EQ(map.begin()->first, 2);
+}
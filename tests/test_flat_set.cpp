@@ -0,0 +1,100 @@
+//
+// Тесты FlatSet и двоичного поиска без ветвлений
+//
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+// Результат совпадает с std::lower_bound и std::upper_bound на массивах
+// любой длины, в том числе с повторами
+TEST(FlatSetTest, Branchless_Search_Matches_Std) {
+  std::less<int> comp;
+  for (int count = 0; count < 40; ++count) {
+    std::vector<int> keys;
+    for (int i = 0; i < count; ++i) keys.push_back(i / 2 * 3);
+    for (int key = -2; key <= count * 2; ++key) {
+      auto lower = std::lower_bound(keys.begin(), keys.end(), key);
+      auto upper = std::upper_bound(keys.begin(), keys.end(), key);
+      EXPECT_EQ(branchlessLowerBound(keys.data(), keys.size(), key, comp),
+                static_cast<std::size_t>(lower - keys.begin()));
+      EXPECT_EQ(branchlessUpperBound(keys.data(), keys.size(), key, comp),
+                static_cast<std::size_t>(upper - keys.begin()));
+    }
+  }
+}
+
+TEST(FlatSetTest, Basic_Interface) {
+  FlatSet<std::string> set{"pear", "apple", "fig", "apple"};
+  EXPECT_EQ(set.size(), 3UL);
+  EXPECT_EQ(*set.begin(), "apple");
+  EXPECT_TRUE(set.contains("fig"));
+  EXPECT_FALSE(set.contains("plum"));
+
+  auto result = set.insert("kiwi");
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(*result.first, "kiwi");
+  EXPECT_FALSE(set.insert("fig").second);
+
+  set.erase(set.find("fig"));
+  EXPECT_FALSE(set.contains("fig"));
+  std::vector<std::string> expected{"apple", "kiwi", "pear"};
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+
+  EXPECT_EQ(*set.lower_bound("b"), "kiwi");
+  EXPECT_EQ(set.upper_bound("pear"), set.end());
+  EXPECT_EQ(std::distance(set.range("a", "l").begin(),
+                          set.range("a", "l").end()),
+            2);
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(FlatSetTest, Insert_Many_And_Merge) {
+  FlatSet<int> set{10, 30};
+  auto results = set.insert_many(20, 10, 40, 20);
+  ASSERT_EQ(results.size(), 4UL);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_TRUE(results[2].second);
+  EXPECT_FALSE(results[3].second);
+  EXPECT_EQ(*results[3].first, 20);
+  EXPECT_EQ(set.size(), 4UL);
+
+  FlatSet<int> other{5, 30, 50};
+  set.merge(other);
+  std::vector<int> expected{5, 10, 20, 30, 40, 50};
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_EQ(other.size(), 1UL);
+  EXPECT_TRUE(other.contains(30));
+
+  FlatSet<int> copy(set);
+  set.clear();
+  EXPECT_EQ(copy.size(), 6UL);
+  set = copy;
+  EXPECT_EQ(set.size(), 6UL);
+}
+
+TEST(FlatSetTest, Assign_Sorted_Matches_Std_Set) {
+  std::set<int> reference;
+  for (int i = 0; i < 1000; ++i) reference.insert(i * 7 % 1009);
+  FlatSet<int> set;
+  set.assign_sorted(reference.begin(), reference.end());
+  EXPECT_EQ(set.size(), reference.size());
+  for (int key = -5; key < 1015; ++key) {
+    EXPECT_EQ(set.contains(key), reference.count(key) == 1);
+  }
+
+  std::vector<int> unsorted{3, 1, 3, 2};
+  set.assign_sorted(unsorted.begin(), unsorted.end(), true);
+  std::vector<int> expected{1, 2, 3};
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+}
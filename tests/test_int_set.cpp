@@ -0,0 +1,192 @@
+//
+// Тесты IntSet
+//
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+namespace {
+
+std::vector<std::uint32_t> keysOf(const IntSet& set) {
+  return std::vector<std::uint32_t>(set.begin(), set.end());
+}
+
+// Ключи разной плотности: редкие корзины-массивы, плотная корзина-карта и
+// длинные серии
+std::set<std::uint32_t> mixedKeys(unsigned seed) {
+  std::mt19937 random(seed);
+  std::set<std::uint32_t> keys;
+  for (int i = 0; i < 3000; ++i) keys.insert(random());
+  for (int i = 0; i < 20000; ++i) keys.insert(0x50000U + random() % 40000);
+  for (std::uint32_t i = 0x70000U; i < 0x7FFFFU; i += 1 + random() % 3) {
+    keys.insert(i);
+  }
+  for (std::uint32_t i = 0xFFFF0000U; i <= 0xFFFF0100U; ++i) keys.insert(i);
+  keys.insert(0xFFFFFFFFU);
+  return keys;
+}
+
+}  // namespace
+
+TEST(IntSetTest, Basic_Interface) {
+  IntSet set{7, 3, 70000, 3, 0xFFFFFFFFU};
+  EXPECT_EQ(set.size(), 4UL);
+  EXPECT_EQ(*set.begin(), 3U);
+  EXPECT_TRUE(set.contains(70000));
+  EXPECT_FALSE(set.contains(70001));
+  EXPECT_EQ(set.count(7), 1UL);
+
+  auto result = set.insert(5);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(*result.first, 5U);
+  EXPECT_EQ(*++result.first, 7U);
+  EXPECT_FALSE(set.insert(70000).second);
+
+  EXPECT_EQ(*set.lower_bound(8), 70000U);
+  EXPECT_EQ(set.find(8), set.end());
+  set.erase(set.find(70000));
+  EXPECT_EQ(set.erase(70000), 0UL);
+  EXPECT_EQ(set.erase(0xFFFFFFFFU), 1UL);
+  EXPECT_EQ(keysOf(set), (std::vector<std::uint32_t>{3, 5, 7}));
+  EXPECT_EQ(set.lower_bound(8), set.end());
+  EXPECT_TRUE(set.validateForTesting());
+
+  IntSet other;
+  other.swap(set);
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(other.size(), 3UL);
+  other.clear();
+  EXPECT_EQ(other.begin(), other.end());
+}
+
+TEST(IntSetTest, Matches_Std_Set) {
+  std::mt19937 random(11);
+  std::set<std::uint32_t> expected;
+  IntSet set;
+  // Узкий диапазон заставляет корзины переходить между массивом и картой
+  for (int i = 0; i < 60000; ++i) {
+    std::uint32_t key = random() % 200000;
+    if (random() % 3 == 0) {
+      EXPECT_EQ(set.erase(key), expected.erase(key));
+    } else {
+      EXPECT_EQ(set.insert(key).second, expected.insert(key).second);
+    }
+  }
+  EXPECT_TRUE(set.validateForTesting());
+  EXPECT_EQ(set.size(), expected.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+  for (std::uint32_t key = 0; key < 200000; key += 7) {
+    ASSERT_EQ(set.contains(key), expected.count(key) == 1);
+    auto it = set.lower_bound(key);
+    auto std_it = expected.lower_bound(key);
+    ASSERT_EQ(it == set.end(), std_it == expected.end());
+    if (std_it != expected.end()) {
+      ASSERT_EQ(*it, *std_it);
+    }
+  }
+
+  // Удаление почти всего возвращает корзины к массивам
+  for (std::uint32_t key = 0; key < 199000; ++key) {
+    set.erase(key);
+    expected.erase(key);
+  }
+  EXPECT_TRUE(set.validateForTesting());
+  EXPECT_EQ(keysOf(set),
+            std::vector<std::uint32_t>(expected.begin(), expected.end()));
+}
+
+TEST(IntSetTest, Run_Optimize) {
+  IntSet set;
+  for (std::uint32_t i = 100; i < 60000; ++i) set.insert(i);
+  set.insert(65535);
+  std::size_t before = set.memory_usage();
+  EXPECT_TRUE(set.run_optimize());
+  EXPECT_LT(set.memory_usage(), before / 20);
+  EXPECT_TRUE(set.validateForTesting());
+
+  // Вставки и удаления внутри серий: продление, склейка и разрез
+  EXPECT_TRUE(set.insert(99).second);
+  EXPECT_TRUE(set.insert(60000).second);
+  EXPECT_TRUE(set.insert(60002).second);
+  EXPECT_TRUE(set.insert(60001).second);
+  EXPECT_FALSE(set.insert(500).second);
+  EXPECT_EQ(set.erase(30000), 1UL);
+  EXPECT_EQ(set.erase(30000), 0UL);
+  EXPECT_EQ(set.erase(99), 1UL);
+  EXPECT_EQ(set.erase(60002), 1UL);
+  EXPECT_EQ(set.erase(65535), 1UL);
+  EXPECT_TRUE(set.validateForTesting());
+  EXPECT_EQ(set.size(), 59901UL);
+  EXPECT_FALSE(set.contains(30000));
+  EXPECT_TRUE(set.contains(30001));
+  EXPECT_EQ(*set.lower_bound(30000), 30001U);
+  EXPECT_EQ(*set.find(60001), 60001U);
+
+  std::vector<std::uint32_t> keys = keysOf(set);
+  EXPECT_EQ(keys.size(), set.size());
+  EXPECT_EQ(keys.front(), 100U);
+  EXPECT_EQ(keys.back(), 60001U);
+
+  // Множество из одиночных ключей в серии не переводится
+  IntSet sparse{1, 3, 5, 100000};
+  EXPECT_FALSE(sparse.run_optimize());
+  EXPECT_EQ(sparse, (IntSet{1, 3, 5, 100000}));
+}
+
+TEST(IntSetTest, Many_Runs_Fall_Back) {
+  IntSet set;
+  for (std::uint32_t i = 0; i < 20; ++i) set.insert(i);
+  ASSERT_TRUE(set.run_optimize());
+  // Каждый второй ключ - отдельная серия, пока их не станет слишком много
+  for (std::uint32_t i = 22; i < 20000; i += 2) set.insert(i);
+  EXPECT_TRUE(set.validateForTesting());
+  EXPECT_EQ(set.size(), 20U + 9989U);
+  for (std::uint32_t i = 1; i < 20; i += 2) set.erase(i);
+  EXPECT_TRUE(set.validateForTesting());
+}
+
+TEST(IntSetTest, Set_Operations) {
+  std::set<std::uint32_t> a = mixedKeys(1);
+  std::set<std::uint32_t> b = mixedKeys(2);
+  IntSet x(std::initializer_list<std::uint32_t>{});
+  IntSet y;
+  x.insert(a.begin(), a.end());
+  y.insert(b.begin(), b.end());
+  IntSet x_runs = x;
+  x_runs.run_optimize();
+  EXPECT_EQ(x_runs, x);
+
+  auto check = [&](const IntSet& result, auto std_op) {
+    std::vector<std::uint32_t> expected;
+    std_op(a.begin(), a.end(), b.begin(), b.end(),
+           std::back_inserter(expected));
+    EXPECT_TRUE(result.validateForTesting());
+    EXPECT_EQ(keysOf(result), expected);
+  };
+  using It = std::set<std::uint32_t>::iterator;
+  using Out = std::back_insert_iterator<std::vector<std::uint32_t>>;
+  for (const IntSet* left : {&x, &x_runs}) {
+    check(set_union(*left, y), std::set_union<It, It, Out>);
+    check(set_intersection(*left, y), std::set_intersection<It, It, Out>);
+    check(set_difference(*left, y), std::set_difference<It, It, Out>);
+    check(symmetric_difference(*left, y),
+          std::set_symmetric_difference<It, It, Out>);
+  }
+
+  std::vector<std::uint32_t> common;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(common));
+  EXPECT_EQ(intersection_size(x, y), common.size());
+  EXPECT_EQ(intersection_size(x_runs, y), common.size());
+  EXPECT_EQ(intersection_size(x, IntSet()), 0UL);
+  EXPECT_EQ(set_union(x, IntSet()), x);
+  EXPECT_NE(x, y);
+}
@@ -1,6 +1,14 @@
 //
 // Created by Тихон Чабусов on 27.07.2024.
 //
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "all_tests.h"
 
 using namespace s21;
@@ -264,3 +272,608 @@ TEST(MapTest, Erase_Non_Existent_Node) {
   EXPECT_EQ(map.find(20), map.end());
   EXPECT_EQ(map.size(), 3UL);
 }
+
+// Тест балансировки при вставке возрастающих и убывающих ключей
+TEST(MapTest, Balanced_Sorted_Insert) {
+  s21::Map<int, int> ascending;
+  s21::Map<int, int> descending;
+  for (int i = 0; i < 10000; ++i) {
+    ascending.insert(i, i);
+    descending.insert(10000 - i, i);
+  }
+  EXPECT_TRUE(ascending.validateForTesting());
+  EXPECT_TRUE(descending.validateForTesting());
+  EXPECT_EQ(ascending.size(), 10000UL);
+
+  int expected = 0;
+  for (auto it = ascending.begin(); it != ascending.end(); ++it) {
+    EXPECT_EQ((*it).first, expected++);
+  }
+}
+
+// Тест балансировки при чередовании вставок и удалений
+TEST(MapTest, Balanced_Insert_Erase) {
+  s21::Map<int, int> map;
+  unsigned state = 12345;
+  for (int i = 0; i < 5000; ++i) {
+    state = state * 1103515245u + 12345u;
+    map.insert(static_cast<int>(state % 2000), i);
+    if (i % 3 == 0) {
+      state = state * 1103515245u + 12345u;
+      map.erase(map.find(static_cast<int>(state % 2000)));
+    }
+  }
+  EXPECT_TRUE(map.validateForTesting());
+
+  while (!map.empty()) {
+    map.erase(map.begin());
+    if (map.size() % 97 == 0) {
+      EXPECT_TRUE(map.validateForTesting());
+    }
+  }
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+// Итераторы на оставшиеся элементы не инвалидируются при удалении
+TEST(MapTest, Erase_Keeps_Other_Iterators) {
+  s21::Map<int, int> map{{10, 10}, {5, 5}, {15, 15}, {12, 12}, {18, 18}};
+  auto successor = map.find(12);
+  map.erase(map.find(10));
+  EXPECT_EQ((*successor).first, 12);
+  EXPECT_EQ(successor, map.find(12));
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+// Копия сохраняет форму и цвета исходного дерева
+TEST(MapTest, Copy_Constructor_Large) {
+  s21::Map<int, int> source;
+  for (int i = 0; i < 5000; ++i) {
+    source.insert(i, i * 2);
+  }
+  s21::Map<int, int> copy(source);
+  EXPECT_TRUE(copy.validateForTesting());
+  EXPECT_EQ(copy.size(), source.size());
+
+  auto it = copy.begin();
+  for (auto src = source.begin(); src != source.end(); ++src, ++it) {
+    EXPECT_EQ((*it).first, (*src).first);
+    EXPECT_EQ((*it).second, (*src).second);
+  }
+  EXPECT_EQ(it, copy.end());
+
+  copy[0] = -1;
+  EXPECT_EQ(source.at(0), 0);
+}
+
+// Тест оператора копирующего присваивания
+TEST(MapTest, Copy_Assignment_Operator) {
+  s21::Map<int, int> map1{{1, 10}, {2, 20}, {3, 30}};
+  s21::Map<int, int> map2{{7, 70}};
+  map2 = map1;
+  EXPECT_EQ(map2.size(), 3UL);
+  EXPECT_EQ(map2.at(1), 10);
+  EXPECT_EQ(map2.at(3), 30);
+  EXPECT_FALSE(map2.contains(7));
+  EXPECT_TRUE(map2.validateForTesting());
+
+  map2 = map2;
+  EXPECT_EQ(map2.size(), 3UL);
+
+  s21::Map<int, int> empty;
+  map2 = empty;
+  EXPECT_TRUE(map2.empty());
+  EXPECT_TRUE(map2.validateForTesting());
+}
+
+// Присваивание переиспользует узлы контейнера-приемника
+TEST(MapTest, Copy_Assignment_Reuses_Nodes) {
+  s21::Map<int, std::string> target;
+  for (int i = 0; i < 100; ++i) {
+    target.insert(i, "old");
+  }
+  std::vector<const void*> old_nodes;
+  for (int i = 0; i < 100; ++i) {
+    old_nodes.push_back(target.findNodeForTesting(i));
+  }
+
+  s21::Map<int, std::string> source;
+  for (int i = 0; i < 50; ++i) {
+    source.insert(i + 1000, "new");
+  }
+  target = source;
+
+  EXPECT_EQ(target.size(), 50UL);
+  EXPECT_TRUE(target.validateForTesting());
+  for (int i = 0; i < 50; ++i) {
+    const void* node = target.findNodeForTesting(i + 1000);
+    EXPECT_NE(std::find(old_nodes.begin(), old_nodes.end(), node),
+              old_nodes.end());
+    EXPECT_EQ(target.at(i + 1000), "new");
+  }
+}
+
+// Тест построения из отсортированного диапазона
+TEST(MapTest, Assign_Sorted) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.push_back({i * 2, i});
+  }
+  s21::Map<int, int> map{{-5, 5}};
+  map.assign_sorted(items.begin(), items.end());
+  EXPECT_EQ(map.size(), 1000UL);
+  EXPECT_TRUE(map.validateForTesting());
+  EXPECT_FALSE(map.contains(-5));
+  EXPECT_EQ(map.at(998), 499);
+
+  map.insert(1, 1);
+  map.erase(map.find(0));
+  EXPECT_TRUE(map.validateForTesting());
+
+  for (std::size_t n = 0; n < 40; ++n) {
+    s21::Map<int, int> small;
+    small.assign_sorted(items.begin(), items.begin() + n);
+    EXPECT_EQ(small.size(), n);
+    EXPECT_TRUE(small.validateForTesting());
+  }
+}
+
+// Проверяемый режим переходит на обычные вставки для неупорядоченных данных
+TEST(MapTest, Assign_Sorted_Checked) {
+  std::vector<std::pair<int, int>> items{{3, 30}, {1, 10}, {2, 20}, {1, 11}};
+  s21::Map<int, int> map;
+  map.assign_sorted(items.begin(), items.end(), true);
+  EXPECT_EQ(map.size(), 3UL);
+  EXPECT_EQ(map.at(1), 10);
+  EXPECT_TRUE(map.validateForTesting());
+
+  std::vector<std::pair<int, int>> sorted{{1, 10}, {2, 20}, {3, 30}};
+  map.assign_sorted(sorted.begin(), sorted.end(), true);
+  EXPECT_EQ(map.size(), 3UL);
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+// Поиск по std::string_view и const char* без построения std::string
+TEST(MapTest, Transparent_Lookup) {
+  s21::Map<std::string, int, std::less<>> map{{"alpha", 1}, {"beta", 2}};
+  std::string_view key = "beta";
+  EXPECT_TRUE(map.contains(key));
+  EXPECT_FALSE(map.contains("gamma"));
+  EXPECT_EQ(map.at(key), 2);
+  EXPECT_EQ(map.at("alpha"), 1);
+  EXPECT_THROW(map.at(std::string_view("delta")), std::out_of_range);
+  EXPECT_EQ((*map.find("alpha")).second, 1);
+  EXPECT_EQ(map.find(std::string_view("zeta")), map.end());
+}
+
+// Тест пользовательского компаратора
+TEST(MapTest, Custom_Compare) {
+  s21::Map<int, int, std::greater<int>> map{{1, 10}, {3, 30}, {2, 20}};
+  auto it = map.begin();
+  EXPECT_EQ((*it).first, 3);
+  ++it;
+  EXPECT_EQ((*it).first, 2);
+  ++it;
+  EXPECT_EQ((*it).first, 1);
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+namespace {
+
+// Считает создания, копирования и перемещения значения
+struct Tracked {
+  static int constructed;
+  static int copied;
+  static int moved;
+  std::vector<int> payload;
+
+  Tracked() { ++constructed; }
+  explicit Tracked(int size) : payload(size, size) { ++constructed; }
+  Tracked(const Tracked& other) : payload(other.payload) { ++copied; }
+  Tracked(Tracked&& other) noexcept : payload(std::move(other.payload)) {
+    ++moved;
+  }
+  Tracked& operator=(const Tracked& other) {
+    payload = other.payload;
+    ++copied;
+    return *this;
+  }
+  Tracked& operator=(Tracked&& other) noexcept {
+    payload = std::move(other.payload);
+    ++moved;
+    return *this;
+  }
+
+  static void reset() { constructed = copied = moved = 0; }
+};
+
+int Tracked::constructed = 0;
+int Tracked::copied = 0;
+int Tracked::moved = 0;
+
+}  // namespace
+
+// operator[] не создает значение, если ключ уже есть
+TEST(MapTest, Bracket_Operator_No_Extra_Copies) {
+  s21::Map<int, Tracked> map;
+  Tracked::reset();
+  map[1].payload.push_back(7);
+  EXPECT_EQ(Tracked::constructed, 1);
+  EXPECT_EQ(Tracked::copied, 0);
+  EXPECT_EQ(Tracked::moved, 0);
+
+  Tracked::reset();
+  map[1].payload.push_back(8);
+  EXPECT_EQ(Tracked::constructed, 0);
+  EXPECT_EQ(Tracked::copied, 0);
+  EXPECT_EQ(map[1].payload.size(), 2UL);
+
+  std::string key = "moved-key";
+  s21::Map<std::string, int> names;
+  names[std::move(key)] = 5;
+  EXPECT_EQ(names.at("moved-key"), 5);
+}
+
+// Тест метода try_emplace
+TEST(MapTest, Try_Emplace) {
+  s21::Map<int, Tracked> map;
+  Tracked::reset();
+  auto result = map.try_emplace(1, 100);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ((*result.first).second.payload.size(), 100UL);
+  EXPECT_EQ(Tracked::constructed, 1);
+  EXPECT_EQ(Tracked::copied + Tracked::moved, 0);
+
+  Tracked value(5);
+  Tracked::reset();
+  result = map.try_emplace(1, std::move(value));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(value.payload.size(), 5UL);  // аргумент не тронут
+  EXPECT_EQ(Tracked::moved, 0);
+}
+
+// Тест метода emplace
+TEST(MapTest, Emplace) {
+  s21::Map<int, std::string> map;
+  auto result = map.emplace(1, "one");
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ((*result.first).second, "one");
+
+  result = map.emplace(1, "uno");
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(map.at(1), "one");
+
+  result = map.emplace(std::piecewise_construct, std::forward_as_tuple(2),
+                       std::forward_as_tuple(3, 'x'));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(map.at(2), "xxx");
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+// Вставка rvalue перемещает значение в узел
+TEST(MapTest, Insert_Rvalue) {
+  s21::Map<int, Tracked> map;
+  std::pair<const int, Tracked> item(1, Tracked(10));
+  Tracked::reset();
+  auto result = map.insert(std::move(item));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(Tracked::copied, 0);
+  EXPECT_EQ(Tracked::moved, 1);
+
+  Tracked::reset();
+  map.insert_or_assign(1, Tracked(3));
+  EXPECT_EQ(Tracked::copied, 0);
+  EXPECT_EQ(map.at(1).payload.size(), 3UL);
+}
+
+// Извлеченный узел вставляется обратно без копирования значения
+TEST(MapTest, Extract_And_Insert_Node) {
+  Map<int, std::string> map{{1, "one"}, {2, "two"}, {3, "three"}};
+  const std::string* address = &map.at(2);
+
+  auto handle = map.extract(2);
+  ASSERT_FALSE(handle.empty());
+  EXPECT_EQ(handle.key(), 2);
+  EXPECT_EQ(handle.mapped(), "two");
+  EXPECT_EQ(map.size(), 2UL);
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_TRUE(map.validateForTesting());
+
+  handle.mapped() = "TWO";
+  Map<int, std::string> other;
+  auto result = other.insert(std::move(handle));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_EQ(&(*result.position).second, address);
+  EXPECT_EQ(other.at(2), "TWO");
+
+  EXPECT_TRUE(map.extract(42).empty());
+  result = map.insert(Map<int, std::string>::node_type());
+  EXPECT_FALSE(result.inserted);
+  EXPECT_TRUE(result.position == map.end());
+}
+
+// При существующем ключе узел возвращается вызывающему
+TEST(MapTest, Insert_Node_Duplicate) {
+  Map<int, int> map{{1, 10}, {2, 20}};
+  Map<int, int> other{{1, 100}};
+  auto result = map.insert(other.extract(other.begin()));
+  EXPECT_FALSE(result.inserted);
+  ASSERT_FALSE(result.node.empty());
+  EXPECT_EQ(result.node.mapped(), 100);
+  EXPECT_EQ((*result.position).second, 10);
+  EXPECT_TRUE(other.empty());
+}
+
+// merge перевешивает узлы, а повторяющиеся ключи оставляет в other
+TEST(MapTest, Merge_Moves_Nodes) {
+  Map<int, int> map;
+  Map<int, int> other;
+  for (int i = 0; i < 200; i += 2) map.insert({i, i});
+  for (int i = 0; i < 200; i += 3) other.insert({i, -i});
+  const int* moved = &other.at(3);
+
+  map.merge(other);
+  EXPECT_EQ(&map.at(3), moved);
+  EXPECT_EQ(map.size(), 133UL);
+  EXPECT_EQ(other.size(), 34UL);
+  for (const auto& item : other) {
+    EXPECT_EQ(item.first % 6, 0);
+    EXPECT_EQ(map.at(item.first), item.first);
+  }
+  EXPECT_TRUE(map.validateForTesting());
+  EXPECT_TRUE(other.validateForTesting());
+}
+
+TEST(MapTest, Bounds) {
+  Map<int, int> map;
+  for (int i = 0; i < 100; i += 10) map.insert({i, i / 10});
+  EXPECT_EQ((*map.lower_bound(30)).first, 30);
+  EXPECT_EQ((*map.lower_bound(31)).first, 40);
+  EXPECT_EQ((*map.upper_bound(30)).first, 40);
+  EXPECT_EQ((*map.lower_bound(-5)).first, 0);
+  EXPECT_TRUE(map.lower_bound(91) == map.end());
+  EXPECT_TRUE(map.upper_bound(90) == map.end());
+
+  auto equal = map.equal_range(50);
+  EXPECT_EQ((*equal.first).second, 5);
+  EXPECT_EQ((*equal.second).first, 60);
+  equal = map.equal_range(55);
+  EXPECT_TRUE(equal.first == equal.second);
+
+  const Map<int, int>& cmap = map;
+  EXPECT_EQ((*cmap.lower_bound(15)).first, 20);
+  EXPECT_TRUE(cmap.upper_bound(95) == cmap.end());
+}
+
+TEST(MapTest, Range) {
+  Map<int, int> map;
+  for (int i = 0; i < 1000; ++i) map.insert({(i * 7) % 1000, i});
+  std::vector<int> keys;
+  for (auto& item : map.range(100, 105)) {
+    keys.push_back(item.first);
+    item.second = -1;
+  }
+  EXPECT_EQ(keys, (std::vector<int>{100, 101, 102, 103, 104}));
+  EXPECT_EQ(map.at(104), -1);
+  EXPECT_NE(map.at(105), -1);
+
+  EXPECT_TRUE(map.range(7, 7).empty());
+  EXPECT_TRUE(map.range(9, 3).empty());
+
+  const Map<int, int>& cmap = map;
+  int count = 0;
+  for (const auto& item : cmap.range(990, 5000)) count += item.first >= 990;
+  EXPECT_EQ(count, 10);
+}
+
+// Размеры поддеревьев переживают вставки, удаления, повороты и копирование
+TEST(MapTest, Ranked_Map_Order_Statistics) {
+  RankedMap<int, int> map;
+  std::vector<int> keys;
+  for (int i = 0; i < 500; ++i) {
+    int key = (i * 7919) % 1000;
+    map.insert({key, i});
+    keys.push_back(key);
+  }
+  for (int i = 0; i < 500; i += 3) {
+    map.erase(map.find(keys[static_cast<std::size_t>(i)]));
+  }
+  ASSERT_TRUE(map.validateForTesting());
+
+  std::vector<int> sorted;
+  for (const auto& item : map) sorted.push_back(item.first);
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    EXPECT_EQ((*map.select(i)).first, sorted[i]);
+    EXPECT_EQ(map.rank(sorted[i]), i);
+  }
+  EXPECT_TRUE(map.select(sorted.size()) == map.end());
+  EXPECT_EQ(map.rank(-1), 0UL);
+  EXPECT_EQ(map.rank(100000), sorted.size());
+
+  auto first = std::lower_bound(sorted.begin(), sorted.end(), 200);
+  auto last = std::lower_bound(sorted.begin(), sorted.end(), 700);
+  EXPECT_EQ(map.count_range(200, 700),
+            static_cast<std::size_t>(last - first));
+  EXPECT_EQ(map.count_range(700, 200), 0UL);
+
+  RankedMap<int, int> copy(map);
+  EXPECT_TRUE(copy.validateForTesting());
+  EXPECT_EQ((*copy.nth(10)).first, sorted[10]);
+
+  const RankedMap<int, int>& cmap = map;
+  EXPECT_EQ((*cmap.nth(0)).first, sorted.front());
+}
+
+TEST(MapTest, Ranked_Map_Bulk_And_Merge) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 100; ++i) items.push_back({i * 2, i});
+  RankedMap<int, int> map;
+  map.assign_sorted(items.begin(), items.end());
+  ASSERT_TRUE(map.validateForTesting());
+  EXPECT_EQ(map.rank(50), 25UL);
+
+  RankedMap<int, int> odd;
+  for (int i = 1; i < 200; i += 2) odd.insert({i, i});
+  map.merge(odd);
+  EXPECT_TRUE(map.validateForTesting());
+  EXPECT_TRUE(odd.validateForTesting());
+  EXPECT_EQ(map.size(), 200UL);
+  EXPECT_EQ((*map.select(137)).first, 137);
+
+  auto handle = map.extract(100);
+  EXPECT_EQ(map.rank(150), 149UL);
+  map.insert(std::move(handle));
+  EXPECT_EQ(map.rank(150), 150UL);
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+TEST(MapTest, Insert_With_Hint) {
+  Map<int, int> map;
+  auto it = map.end();
+  for (int i = 0; i < 200; i += 2) it = map.insert(map.end(), {i, i});
+  EXPECT_EQ(it->first, 198);
+  ASSERT_TRUE(map.validateForTesting());
+
+  // Подсказка - сосед нового ключа слева или справа
+  it = map.insert(map.find(10), {11, 0});
+  EXPECT_EQ(it->first, 11);
+  it = map.insert(map.find(20), {19, 0});
+  EXPECT_EQ(it->first, 19);
+  it = map.emplace_hint(map.begin(), -1, 0);
+  EXPECT_EQ(map.begin()->first, -1);
+  // Неверная подсказка и существующий ключ
+  it = map.insert(map.begin(), {151, 0});
+  EXPECT_EQ(it->first, 151);
+  it = map.emplace_hint(map.find(50), 40, 7);
+  EXPECT_EQ(it->second, 40);
+  EXPECT_EQ(map.size(), 104UL);
+  EXPECT_TRUE(map.validateForTesting());
+
+  std::vector<int> keys;
+  for (const auto& item : map) keys.push_back(item.first);
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+}
+
+TEST(MapTest, Rightmost_Stays_Valid) {
+  RankedMap<int, int> map;
+  auto hint = map.end();
+  for (int i = 0; i < 1000; ++i) {
+    // Почти упорядоченные ключи: каждый пятый немного отстает
+    int key = i % 5 == 4 ? i - 3 : i + 1000;
+    hint = map.insert(hint, {key, i});
+  }
+  ASSERT_TRUE(map.validateForTesting());
+  EXPECT_EQ(map.rank(1500), 600UL);
+
+  map.erase(map.find(1998));
+  map.erase(map.find(1999));
+  EXPECT_TRUE(map.validateForTesting());
+  map.insert({1998, 0});
+  map.extract(1998);
+  EXPECT_TRUE(map.validateForTesting());
+
+  RankedMap<int, int> copy(map);
+  EXPECT_TRUE(copy.validateForTesting());
+  copy.insert(copy.end(), {5000, 0});
+  map.swap(copy);
+  EXPECT_TRUE(map.validateForTesting());
+  EXPECT_TRUE(copy.validateForTesting());
+  map.clear();
+  map.insert(map.end(), {1, 1});
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+TEST(MapTest, Assign_Parallel) {
+  std::mt19937 random(17);
+  Vector<std::pair<int, int>> items;
+  std::map<int, int> reference;
+  for (int i = 0; i < 200000; ++i) {
+    int key = static_cast<int>(random() % 150000);
+    items.push_back({key, i});
+    reference.insert({key, i});  // из повторов остается первый
+  }
+
+  ThreadPool pool(3);
+  RankedMap<int, int> map{{-1, -1}};
+  map.assign_parallel(items.begin(), items.end(), pool);
+  ASSERT_TRUE(map.validateForTesting());
+  ASSERT_EQ(map.size(), reference.size());
+  auto expected = reference.begin();
+  for (const auto& item : map) {
+    EXPECT_EQ(item, *expected);
+    ++expected;
+  }
+  EXPECT_EQ((*map.select(1000)).first,
+            std::next(reference.begin(), 1000)->first);
+  map.insert(map.end(), {150000, 0});
+  EXPECT_TRUE(map.validateForTesting());
+
+  // Узлы из пула создает один поток
+  Map<int, int, std::less<int>, PoolAllocator<std::pair<const int, int>>>
+      pooled;
+  pooled.assign_parallel(items.begin(), items.end(), pool);
+  EXPECT_TRUE(pooled.validateForTesting());
+  EXPECT_EQ(pooled.size(), reference.size());
+
+  map.assign_parallel(items.begin(), items.begin(), pool);
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+TEST(MapTest, Key_Prefix_Policy) {
+  EXPECT_EQ(KeyPrefix::prefix("ab"), 0x6162000000000000ULL);
+  EXPECT_EQ(KeyPrefix::prefix("abcdefghij"), 0x6162636465666768ULL);
+  EXPECT_GT(KeyPrefix::prefix("\xff"), KeyPrefix::prefix("a"));
+
+  // Общие начала, ключи короче префикса, нулевые и старшие байты
+  std::mt19937 random(23);
+  const std::string alphabet("/a\0\xff", 4);
+  std::vector<std::string> keys{"", std::string(1, '\0'), "https://"};
+  for (int i = 0; i < 3000; ++i) {
+    std::string key = i % 2 ? "https://host/" : "";
+    std::size_t length = random() % 12;
+    for (std::size_t j = 0; j < length; ++j) {
+      key += alphabet[random() % alphabet.size()];
+    }
+    keys.push_back(key);
+  }
+
+  PrefixMap<int> map;
+  std::map<std::string, int> reference;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    const std::string& key = keys[i];
+    if (i % 5 == 0) {
+      map.insert(map.lower_bound(key), {key, static_cast<int>(i)});
+    } else {
+      map.insert(key, static_cast<int>(i));
+    }
+    reference.insert({key, static_cast<int>(i)});
+  }
+  ASSERT_TRUE(map.validateForTesting());
+  ASSERT_EQ(map.size(), reference.size());
+  auto expected = reference.begin();
+  for (const auto& item : map) {
+    EXPECT_EQ(item, *expected);
+    ++expected;
+  }
+  for (const std::string& key : keys) {
+    EXPECT_EQ(map.at(key), reference.at(key));
+    EXPECT_EQ(map.upper_bound(key) == map.end(),
+              reference.upper_bound(key) == reference.end());
+  }
+  EXPECT_FALSE(map.contains("https://host/b"));
+
+  // Копия поверх старых узлов пересчитывает их префиксы
+  PrefixMap<int> copy{{"zzz", 1}};
+  copy = map;
+  EXPECT_TRUE(copy.validateForTesting());
+  for (const std::string& key : keys) {
+    auto it = copy.find(key);
+    if (it != copy.end()) copy.erase(it);
+  }
+  EXPECT_TRUE(copy.empty());
+
+  PrefixMap<int, std::less<>> transparent{{"https://host/a", 1}};
+  EXPECT_TRUE(transparent.contains(std::string_view("https://host/a")));
+  EXPECT_FALSE(transparent.contains("https://host/"));
+}
@@ -2,6 +2,11 @@
 // Created by Тихон Чабусов on 29.07.2024.
 //
 
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "all_tests.h"
 
 using namespace s21;
@@ -97,4 +102,50 @@ TEST(MultisetTest, Upper_Bound) {
   Multiset<int> ms{1, 2, 3, 4, 5};
   auto it = ms.upper_bound(3);
   EXPECT_EQ(*it, 4);
-}
\ No newline at end of file
+}
+TEST(MultisetTest, Assign_Sorted) {
+  std::vector<int> items = {1, 1, 1, 2, 3, 3, 4, 5, 5, 5, 5};
+  Multiset<int> ms{42};
+  ms.assign_sorted(items.begin(), items.end());
+  EXPECT_EQ(ms.size(), items.size());
+  EXPECT_EQ(ms.count(42), 0UL);
+  EXPECT_EQ(ms.count(1), 3UL);
+  EXPECT_EQ(ms.count(3), 2UL);
+  EXPECT_EQ(ms.count(5), 4UL);
+  EXPECT_EQ(*ms.lower_bound(2), 2);
+}
+
+TEST(MultisetTest, Assign_Sorted_Checked) {
+  std::vector<int> items = {3, 1, 2, 1};
+  Multiset<int> ms;
+  ms.assign_sorted(items.begin(), items.end(), true);
+  EXPECT_EQ(ms.size(), 4UL);
+  EXPECT_EQ(ms.count(1), 2UL);
+}
+
+TEST(MultisetTest, Transparent_Lookup) {
+  Multiset<std::string, std::less<>> ms{"alpha", "beta", "alpha"};
+  EXPECT_EQ(ms.count(std::string_view("alpha")), 2UL);
+  EXPECT_EQ(ms.count("gamma"), 0UL);
+  EXPECT_TRUE(ms.contains("beta"));
+  EXPECT_TRUE(ms.find(std::string_view("beta")) != ms.end());
+  EXPECT_FALSE(ms.find(std::string_view("zeta")) != ms.end());
+}
+
+TEST(MultisetTest, Assign_Parallel) {
+  std::vector<int> keys;
+  for (int i = 0; i < 50000; ++i) keys.push_back((i * 7919) % 20000);
+  ThreadPool pool(2);
+  Multiset<int> ms{-1};
+  ms.assign_parallel(keys.begin(), keys.end(), pool);
+  EXPECT_EQ(ms.size(), keys.size());
+  EXPECT_EQ(ms.count(-1), 0UL);
+  EXPECT_EQ(ms.count(0), 3UL);
+  EXPECT_EQ(ms.count(19999), 3UL);
+  EXPECT_EQ(ms.count(10000), 2UL);
+  std::vector<int> sorted(keys);
+  std::sort(sorted.begin(), sorted.end());
+  std::size_t index = 0;
+  for (int key : ms) EXPECT_EQ(key, sorted[index++]);
+  EXPECT_EQ(index, sorted.size());
+}
@@ -0,0 +1,176 @@
+//
+// Тесты пула узлов и PoolAllocator в деревьях
+//
+#include <string>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+template <typename K, typename V>
+using PoolMap =
+    Map<K, V, std::less<K>, PoolAllocator<std::pair<const K, V>>>;
+
+// Освобожденный блок переиспользуется без нового слэба
+TEST(NodePoolTest, Reuses_Freed_Blocks) {
+  NodePool pool;
+  ASSERT_TRUE(pool.serves(sizeof(long), alignof(long)));
+  EXPECT_FALSE(pool.serves(sizeof(long) * 4, alignof(long)));
+
+  void* first = pool.allocate();
+  EXPECT_EQ(pool.in_use(), 1UL);
+  EXPECT_EQ(pool.slab_count(), 1UL);
+  pool.deallocate(first);
+  EXPECT_EQ(pool.in_use(), 0UL);
+
+  void* second = pool.allocate();
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(pool.slab_count(), 1UL);
+  pool.deallocate(second);
+}
+
+// reserve выделяет память заранее, release возвращает все слэбы
+TEST(NodePoolTest, Reserve_And_Release) {
+  NodePool pool;
+  ASSERT_TRUE(pool.serves(32, alignof(std::max_align_t)));
+  pool.reserve(1000);
+  EXPECT_GE(pool.available(), 1000UL);
+  std::size_t slabs = pool.slab_count();
+
+  for (int i = 0; i < 1000; ++i) pool.allocate();
+  EXPECT_EQ(pool.slab_count(), slabs);
+  EXPECT_EQ(pool.in_use(), 1000UL);
+
+  pool.release();
+  EXPECT_EQ(pool.slab_count(), 0UL);
+  EXPECT_EQ(pool.in_use(), 0UL);
+  EXPECT_EQ(pool.available(), 0UL);
+}
+
+TEST(NodePoolTest, Map_Uses_Pool) {
+  PoolMap<int, int> map;
+  map.reserve(500);
+  const NodePool* pool = map.get_allocator().pool();
+  ASSERT_NE(pool, nullptr);
+  std::size_t slabs = pool->slab_count();
+
+  for (int i = 0; i < 500; ++i) map.insert({i, i * 2});
+  EXPECT_EQ(pool->slab_count(), slabs);
+  EXPECT_EQ(pool->in_use(), 500UL);
+  EXPECT_TRUE(map.validateForTesting());
+
+  for (int i = 0; i < 500; i += 2) map.erase(map.find(i));
+  EXPECT_EQ(pool->in_use(), 250UL);
+  EXPECT_EQ(map.at(7), 14);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  map.insert({1, 1});
+  EXPECT_EQ(map.at(1), 1);
+}
+
+// Копия получает собственный пул, перемещение забирает пул целиком
+TEST(NodePoolTest, Map_Copy_And_Move) {
+  PoolMap<int, std::string> map{{1, "one"}, {2, "two"}, {3, "three"}};
+  PoolMap<int, std::string> copy(map);
+  EXPECT_NE(copy.get_allocator(), map.get_allocator());
+  EXPECT_EQ(copy.at(2), "two");
+
+  const NodePool* pool = map.get_allocator().pool();
+  PoolMap<int, std::string> moved(std::move(map));
+  EXPECT_EQ(moved.get_allocator().pool(), pool);
+  EXPECT_EQ(moved.at(3), "three");
+
+  copy = moved;
+  EXPECT_EQ(copy.size(), 3UL);
+  copy.clear();
+  EXPECT_EQ(moved.at(1), "one");
+}
+
+TEST(NodePoolTest, Set_Uses_Pool) {
+  Set<std::string, std::less<std::string>, PoolAllocator<std::string>> set;
+  set.reserve(100);
+  for (int i = 0; i < 100; ++i) set.insert(std::to_string(i));
+  EXPECT_EQ(set.get_allocator().pool()->in_use(), 100UL);
+  EXPECT_TRUE(set.contains("42"));
+
+  set.erase(set.find("42"));
+  EXPECT_FALSE(set.contains("42"));
+  EXPECT_EQ(set.get_allocator().pool()->in_use(), 99UL);
+
+  auto copy = set;
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(copy.size(), 99UL);
+  EXPECT_TRUE(copy.contains("7"));
+}
+
+TEST(NodePoolTest, Multiset_Uses_Pool) {
+  Multiset<int, std::less<int>, PoolAllocator<int>> ms;
+  ms.reserve(64);
+  for (int i = 0; i < 64; ++i) ms.insert(i % 8);
+  EXPECT_EQ(ms.get_allocator().pool()->in_use(), 64UL);
+  EXPECT_EQ(ms.count(3), 8UL);
+
+  Multiset<int, std::less<int>, PoolAllocator<int>> other;
+  other.swap(ms);
+  EXPECT_TRUE(ms.empty());
+  EXPECT_EQ(other.count(5), 8UL);
+  other.clear();
+  EXPECT_EQ(other.size(), 0UL);
+}
+
+// Карты на общем пуле сливаются без выделений, на разных - копированием
+TEST(NodePoolTest, Map_Merge_Across_Pools) {
+  PoolMap<int, int> map{{1, 1}, {2, 2}};
+  PoolMap<int, int> shared(std::less<int>(), map.get_allocator());
+  shared.insert({2, 20});
+  shared.insert({3, 30});
+  const NodePool* pool = map.get_allocator().pool();
+  EXPECT_EQ(pool->in_use(), 4UL);
+
+  map.merge(shared);
+  EXPECT_EQ(pool->in_use(), 4UL);
+  EXPECT_EQ(map.at(3), 30);
+  EXPECT_EQ(shared.size(), 1UL);
+
+  PoolMap<int, int> separate{{4, 40}, {1, 10}};
+  map.merge(separate);
+  EXPECT_EQ(map.at(4), 40);
+  EXPECT_EQ(map.at(1), 1);
+  EXPECT_EQ(separate.size(), 1UL);
+  EXPECT_EQ(separate.get_allocator().pool()->in_use(), 1UL);
+
+  auto handle = separate.extract(1);
+  auto result = map.insert(std::move(handle));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(result.node.mapped(), 10);
+}
+
+// Копии, сделанные до первого выделения, разделяют пул и остаются равными
+TEST(NodePoolTest, Allocator_Copies_Share_Pool) {
+  PoolAllocator<std::pair<const int, int>> alloc;
+  PoolAllocator<int> rebound(alloc);
+  ASSERT_NE(alloc.pool(), nullptr);
+  EXPECT_EQ(rebound.pool(), alloc.pool());
+  EXPECT_EQ(rebound, alloc);
+
+  PoolMap<int, int> first(std::less<int>(), alloc);
+  PoolMap<int, int> second(std::less<int>(), alloc);
+  EXPECT_EQ(first.get_allocator(), second.get_allocator());
+  first.insert({1, 1});
+  second.insert({2, 2});
+  second.insert({3, 3});
+  EXPECT_EQ(first.get_allocator(), second.get_allocator());
+  EXPECT_EQ(first.get_allocator(), alloc);
+  EXPECT_EQ(alloc.pool()->in_use(), 3UL);
+
+  PoolAllocator<int> other;
+  EXPECT_NE(other, rebound);
+  PoolAllocator<int> moved(std::move(rebound));
+  EXPECT_EQ(moved, alloc);
+  int* value = rebound.allocate(1);
+  EXPECT_NE(rebound.pool(), nullptr);
+  EXPECT_NE(rebound, moved);
+  rebound.deallocate(value, 1);
+}
@@ -0,0 +1,86 @@
+//
+// Тесты параллельного обхода и свертки деревьев
+//
+#include <atomic>
+#include <string>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+namespace {
+
+// Свертка, проверяющая порядок: некоммутативна, но ассоциативна
+struct Ordered {
+  int first;
+  int last;
+  bool sorted;
+};
+
+Ordered joinOrdered(const Ordered& a, const Ordered& b) {
+  return {a.first, b.last, a.sorted && b.sorted && a.last < b.first};
+}
+
+}  // namespace
+
+TEST(ParallelTest, Map_For_Each_And_Transform_Reduce) {
+  ThreadPool pool(3);
+  Map<int, long> map;
+  for (int i = 0; i < 50000; ++i) map.insert(map.end(), {i, i});
+
+  parallel::for_each(pool, map, [](std::pair<const int, long>& item) {
+    item.second *= 2;
+  });
+  EXPECT_EQ(map.at(12345), 24690);
+  long total = parallel::transform_reduce(
+      pool, map, 0L, [](long a, long b) { return a + b; },
+      [](const std::pair<const int, long>& item) { return item.second; });
+  EXPECT_EQ(total, 49999L * 50000L);
+
+  std::atomic<long> seen{0};
+  const Map<int, long>& cmap = map;
+  parallel::for_each(pool, cmap, [&](const std::pair<const int, long>& item) {
+    seen += item.first;
+  });
+  EXPECT_EQ(seen, 49999L * 50000L / 2);
+
+  Ordered order = parallel::transform_reduce(
+      pool, map, Ordered{-1, -1, true}, joinOrdered,
+      [](const std::pair<const int, long>& item) {
+        return Ordered{item.first, item.first, true};
+      });
+  EXPECT_TRUE(order.sorted);
+  EXPECT_EQ(order.last, 49999);
+}
+
+TEST(ParallelTest, Set_And_Multiset_Reduce) {
+  ThreadPool pool(2);
+  Set<int> set;
+  for (int i = 0; i < 40000; ++i) set.insert((i * 7919) % 40000);
+  EXPECT_EQ(parallel::reduce(pool, set, 0L,
+                             [](long a, long b) { return a + b; }),
+            39999L * 40000L / 2);
+  Ordered order = parallel::transform_reduce(
+      pool, set, Ordered{-1, -1, true}, joinOrdered,
+      [](int key) { return Ordered{key, key, true}; });
+  EXPECT_TRUE(order.sorted);
+
+  // Ключи по возрастанию вырождают Set в цепочку
+  Set<int> chain;
+  for (int i = 0; i < 30000; ++i) chain.insert(chain.end(), i);
+  std::atomic<int> visited{0};
+  parallel::for_each(pool, chain, [&](int) { ++visited; });
+  EXPECT_EQ(visited, 30000);
+
+  Multiset<std::string> words;
+  for (int i = 0; i < 20000; ++i) words.insert(std::to_string(i % 100));
+  std::size_t length = parallel::transform_reduce(
+      pool, words, std::size_t{0},
+      [](std::size_t a, std::size_t b) { return a + b; },
+      [](const std::string& word) { return word.size(); });
+  EXPECT_EQ(length, 200UL * (10 + 90 * 2));
+
+  Set<int> empty;
+  EXPECT_EQ(
+      parallel::reduce(pool, empty, 7, [](int a, int b) { return a + b; }), 7);
+}
@@ -0,0 +1,140 @@
+//
+// Тесты PersistentMap и AtomicPersistentMap
+//
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+namespace {
+
+bool sameItems(const PersistentMap<int, int>& map,
+               const std::map<int, int>& reference) {
+  auto expected = reference.begin();
+  for (const auto& item : map) {
+    if (expected == reference.end() || item != *expected) return false;
+    ++expected;
+  }
+  return expected == reference.end();
+}
+
+std::size_t countItems(const PersistentMap<int, int>& map) {
+  std::size_t count = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) ++count;
+  return count;
+}
+
+}  // namespace
+
+TEST(PersistentMapTest, Versions_Are_Independent) {
+  PersistentMap<int, std::string> empty;
+  auto first = empty.insert(1, "one").insert(2, "two");
+  auto second = first.insert_or_assign(2, "dos").insert(3, "three");
+  auto third = second.erase(1);
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(first.size(), 2UL);
+  EXPECT_EQ(first.at(2), "two");
+  EXPECT_EQ(second.size(), 3UL);
+  EXPECT_EQ(second.at(2), "dos");
+  EXPECT_EQ(third.size(), 2UL);
+  EXPECT_FALSE(third.contains(1));
+  EXPECT_TRUE(second.contains(1));
+  EXPECT_THROW(third.at(1), std::out_of_range);
+
+  // Без изменений возвращается та же версия
+  EXPECT_TRUE(first.insert(1, "uno").same_version(first));
+  EXPECT_TRUE(first.erase(7).same_version(first));
+  EXPECT_FALSE(first.insert_or_assign(1, "uno").same_version(first));
+
+  auto snapshot = second;
+  EXPECT_TRUE(snapshot.same_version(second));
+  EXPECT_TRUE(second.clear().empty());
+  EXPECT_EQ(second.size(), 3UL);
+
+  std::vector<int> keys;
+  for (const auto& item : second) keys.push_back(item.first);
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(second.lower_bound(2)->first, 2);
+  EXPECT_EQ(second.upper_bound(2)->first, 3);
+  EXPECT_EQ(second.upper_bound(3), second.end());
+}
+
+TEST(PersistentMapTest, Every_Version_Matches_Std_Map) {
+  std::mt19937 random(3);
+  PersistentMap<int, int> map{{5, 5}, {1, 1}};
+  std::map<int, int> reference{{5, 5}, {1, 1}};
+  std::vector<PersistentMap<int, int>> versions;
+  std::vector<std::map<int, int>> references;
+  for (int i = 0; i < 4000; ++i) {
+    int key = static_cast<int>(random() % 500);
+    switch (random() % 3) {
+      case 0:
+        map = map.erase(key);
+        reference.erase(key);
+        break;
+      case 1:
+        map = map.insert_or_assign(key, i);
+        reference[key] = i;
+        break;
+      default:
+        map = map.insert(key, i);
+        reference.insert({key, i});
+    }
+    if (i % 400 == 0) {
+      versions.push_back(map);
+      references.push_back(reference);
+    }
+  }
+  versions.push_back(map);
+  references.push_back(reference);
+
+  for (std::size_t v = 0; v < versions.size(); ++v) {
+    EXPECT_TRUE(versions[v].validateForTesting());
+    ASSERT_EQ(versions[v].size(), references[v].size());
+    EXPECT_TRUE(sameItems(versions[v], references[v]));
+  }
+}
+
+TEST(PersistentMapTest, Atomic_Publish_Under_Concurrency) {
+  AtomicPersistentMap<int, int> cell;
+  const int kWriters = 4;
+  const int kPerWriter = 500;
+  std::vector<std::thread> threads;
+  for (int w = 0; w < kWriters; ++w) {
+    threads.emplace_back([&cell, w] {
+      for (int i = 0; i < kPerWriter; ++i) {
+        cell.update([w, i](const PersistentMap<int, int>& map) {
+          return map.insert(w * kPerWriter + i, i);
+        });
+      }
+    });
+  }
+  // Читатель видит только целые версии, и их размер не убывает
+  bool consistent = true;
+  std::size_t previous = 0;
+  for (int round = 0; round < 200; ++round) {
+    PersistentMap<int, int> snapshot = cell.load();
+    consistent = consistent && snapshot.size() >= previous &&
+                 countItems(snapshot) == snapshot.size();
+    previous = snapshot.size();
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_TRUE(consistent);
+
+  PersistentMap<int, int> result = cell.load();
+  EXPECT_EQ(result.size(), static_cast<std::size_t>(kWriters * kPerWriter));
+  EXPECT_TRUE(result.validateForTesting());
+
+  PersistentMap<int, int> stale = result.erase(0);
+  cell.store(PersistentMap<int, int>());
+  EXPECT_FALSE(cell.compare_exchange(stale, result));
+  EXPECT_TRUE(stale.empty());
+  EXPECT_TRUE(cell.compare_exchange(stale, result));
+  EXPECT_TRUE(cell.load().same_version(result));
+}
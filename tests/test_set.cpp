@@ -2,6 +2,13 @@
 // Created by Тихон Чабусов on 05.08.2024.
 //
 
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -122,3 +129,317 @@ TEST(SetTest, Contains) {
   EXPECT_TRUE(s.contains(3));
   EXPECT_FALSE(s.contains(4));
 }
+
+TEST(SetTest, Assign_Sorted) {
+  std::vector<int> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.push_back(i * 3);
+  }
+  Set<int> s = {-1};
+  s.assign_sorted(items.begin(), items.end());
+  EXPECT_EQ(s.size(), 1000UL);
+  EXPECT_FALSE(s.contains(-1));
+  EXPECT_TRUE(s.contains(999 * 3));
+  EXPECT_FALSE(s.contains(1));
+
+  int expected = 0;
+  for (auto it = s.begin(); it != s.end(); ++it, expected += 3) {
+    EXPECT_EQ(*it, expected);
+  }
+  EXPECT_EQ(expected, 3000);
+}
+
+TEST(SetTest, Assign_Sorted_Checked) {
+  std::vector<int> items = {5, 1, 3, 1};
+  Set<int> s;
+  s.assign_sorted(items.begin(), items.end(), true);
+  EXPECT_EQ(s.size(), 3UL);
+  EXPECT_TRUE(s.contains(1));
+  EXPECT_TRUE(s.contains(5));
+}
+
+TEST(SetTest, Transparent_Lookup) {
+  Set<std::string, std::less<>> s = {"alpha", "beta"};
+  EXPECT_TRUE(s.contains(std::string_view("alpha")));
+  EXPECT_TRUE(s.contains("beta"));
+  EXPECT_FALSE(s.contains("gamma"));
+  EXPECT_EQ(*s.find(std::string_view("beta")), "beta");
+  EXPECT_EQ(s.find("delta"), s.end());
+}
+
+TEST(SetTest, Custom_Compare) {
+  Set<int, std::greater<int>> s = {1, 3, 2};
+  std::vector<int> order;
+  for (auto it = s.begin(); it != s.end(); ++it) {
+    order.push_back(*it);
+  }
+  EXPECT_EQ(order, (std::vector<int>{3, 2, 1}));
+}
+
+// find возвращает итератор именно на найденный ключ, а не на минимум поддерева
+TEST(SetTest, Find_Iterates_From_Key) {
+  Set<int> s = {50, 30, 70, 20, 40, 60, 80};
+  std::vector<int> tail;
+  for (auto it = s.find(30); it != s.end(); ++it) {
+    tail.push_back(*it);
+  }
+  EXPECT_EQ(tail, (std::vector<int>{30, 40, 50, 60, 70, 80}));
+
+  s.erase(s.find(30));
+  EXPECT_TRUE(s.contains(20));
+  EXPECT_FALSE(s.contains(30));
+}
+
+// Удаление корня с одним потомком обновляет корень дерева
+TEST(SetTest, Erase_Root) {
+  Set<int> s = {10, 20, 30};
+  s.erase(s.find(10));
+  EXPECT_EQ(s.size(), 2UL);
+  EXPECT_TRUE(s.contains(20));
+  EXPECT_TRUE(s.contains(30));
+  EXPECT_FALSE(s.contains(10));
+  EXPECT_EQ(*s.begin(), 20);
+}
+
+TEST(SetTest, Bounds) {
+  Set<int> s = {50, 30, 70, 20, 40, 60, 80};
+  EXPECT_EQ(*s.lower_bound(40), 40);
+  EXPECT_EQ(*s.lower_bound(41), 50);
+  EXPECT_EQ(*s.upper_bound(40), 50);
+  EXPECT_EQ(*s.lower_bound(0), 20);
+  EXPECT_TRUE(s.lower_bound(81) == s.end());
+  EXPECT_TRUE(s.upper_bound(80) == s.end());
+
+  auto equal = s.equal_range(60);
+  EXPECT_EQ(*equal.first, 60);
+  EXPECT_EQ(*equal.second, 70);
+  equal = s.equal_range(65);
+  EXPECT_TRUE(equal.first == equal.second);
+
+  const Set<int>& cs = s;
+  EXPECT_EQ(*cs.lower_bound(55), 60);
+  EXPECT_EQ(*cs.upper_bound(20), 30);
+}
+
+TEST(SetTest, Range) {
+  Set<int> s;
+  for (int i = 0; i < 100; ++i) s.insert((i * 37) % 100);
+  std::vector<int> keys;
+  for (int key : s.range(25, 31)) keys.push_back(key);
+  EXPECT_EQ(keys, (std::vector<int>{25, 26, 27, 28, 29, 30}));
+
+  EXPECT_TRUE(s.range(40, 40).empty());
+  EXPECT_TRUE(s.range(50, 10).empty());
+
+  const Set<int>& cs = s;
+  int count = 0;
+  for (int key : cs.range(90, 1000)) count += key >= 90;
+  EXPECT_EQ(count, 10);
+}
+
+TEST(SetTest, Ranked_Set_Order_Statistics) {
+  RankedSet<int> s;
+  for (int i = 0; i < 300; ++i) s.insert((i * 101) % 300);
+  for (int key = 0; key < 300; key += 4) s.erase(s.find(key));
+  s.insert(4);
+
+  std::vector<int> sorted;
+  for (int key : s) sorted.push_back(key);
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    ASSERT_EQ(*s.select(i), sorted[i]);
+    EXPECT_EQ(s.rank(sorted[i]), i);
+  }
+  EXPECT_TRUE(s.select(sorted.size()) == s.end());
+
+  std::vector<int> tail;
+  for (auto it = s.nth(sorted.size() - 3); it != s.end(); ++it) {
+    tail.push_back(*it);
+  }
+  EXPECT_EQ(tail, (std::vector<int>{297, 298, 299}));
+  EXPECT_EQ(s.count_range(10, 20), 8UL);
+
+  RankedSet<int> copy(s);
+  const RankedSet<int>& ccopy = copy;
+  EXPECT_EQ(*ccopy.select(5), sorted[5]);
+
+  std::vector<int> keys = {1, 2, 3, 4, 5, 6, 7};
+  copy.assign_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(*copy.nth(3), 4);
+  EXPECT_EQ(copy.rank(6), 5UL);
+}
+
+TEST(SetTest, Insert_With_Hint) {
+  Set<int> s;
+  auto it = s.end();
+  // Возрастающие ключи подвешиваются к наибольшему узлу без спуска
+  for (int i = 0; i < 100000; i += 4) it = s.insert(it, i);
+  EXPECT_EQ(*it, 99996);
+  EXPECT_EQ(s.size(), 25000UL);
+
+  it = s.insert(s.find(8), 10);
+  EXPECT_EQ(*it, 10);
+  // Итератор нового правого листа продолжает обход с предков hint
+  it = s.insert(s.find(10), 11);
+  EXPECT_EQ(*it, 11);
+  ++it;
+  EXPECT_EQ(*it, 12);
+  it = s.emplace_hint(s.end(), 5);
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(*s.insert(s.begin(), 3), 3);
+  EXPECT_EQ(s.size(), 25004UL);
+
+  s.erase(s.find(99996));
+  s.insert(99995);
+  EXPECT_EQ(*s.insert(s.end(), 99999), 99999);
+  int previous = -1;
+  std::size_t count = 0;
+  for (int key : s) {
+    EXPECT_LT(previous, key);
+    previous = key;
+    ++count;
+  }
+  EXPECT_EQ(count, s.size());
+  EXPECT_EQ(previous, 99999);
+
+  Set<int> copy(s);
+  copy.insert(100000);
+  EXPECT_TRUE(copy.contains(100000));
+  EXPECT_FALSE(s.contains(100000));
+}
+
+// Подсказка - следующий ключ (lower_bound) или предыдущий с правым
+// поддеревом: узел встает рядом с соседом без спуска от корня
+TEST(SetTest, Insert_With_Adjacent_Hint) {
+  RankedSet<int> s;
+  std::vector<int> keys;
+  for (int i = 0; i < 64; ++i) keys.push_back(i * 10);
+  s.assign_sorted(keys.begin(), keys.end());
+
+  for (int i = 0; i < 64; ++i) {
+    int key = i * 10 - 5;
+    auto it = s.insert(s.lower_bound(key), key);
+    ASSERT_EQ(*it, key);
+    ASSERT_EQ(*++it, i * 10);
+  }
+  for (int i = 0; i < 64; ++i) {
+    auto it = s.insert(s.find(i * 10), i * 10 + 3);
+    ASSERT_EQ(*it, i * 10 + 3);
+  }
+  EXPECT_EQ(*s.insert(s.find(20), 20), 20);
+  EXPECT_EQ(*s.insert(s.find(20), 24), 24);
+  EXPECT_EQ(*s.insert(s.find(20), 7), 7);
+  EXPECT_EQ(s.size(), 194UL);
+  EXPECT_TRUE(s.validateForTesting());
+  EXPECT_EQ(s.rank(0), 1UL);
+  EXPECT_EQ(*s.select(3), 5);
+  EXPECT_EQ(*s.begin(), -5);
+  EXPECT_EQ(*s.rbegin(), 633);
+}
+
+TEST(SetTest, Assign_Parallel) {
+  std::vector<int> keys;
+  for (int i = 0; i < 100000; ++i) keys.push_back((i * 7919) % 60000);
+  ThreadPool pool(2);
+  RankedSet<int> s{-5};
+  s.assign_parallel(keys.begin(), keys.end(), pool);
+  EXPECT_EQ(s.size(), 60000UL);
+  EXPECT_FALSE(s.contains(-5));
+  int expected = 0;
+  for (int key : s) EXPECT_EQ(key, expected++);
+  EXPECT_EQ(*s.select(12345), 12345);
+  EXPECT_EQ(s.rank(30000), 30000UL);
+  EXPECT_EQ(*s.insert(s.end(), 60000), 60000);
+  EXPECT_TRUE(s.validateForTesting());
+}
+
+TEST(SetTest, Iterators_Follow_Parent_Links) {
+  static_assert(std::is_trivially_copyable<Set<int>::iterator>::value);
+
+  RankedSet<int> s;
+  std::set<int> expected;
+  std::mt19937 gen(21);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 5000);
+    if (gen() % 3 == 0) {
+      auto it = s.find(key);
+      if (it != s.end()) s.erase(it);
+      expected.erase(key);
+    } else if (gen() % 2 == 0) {
+      s.insert(s.lower_bound(key), key);
+      expected.insert(key);
+    } else {
+      s.insert(key);
+      expected.insert(key);
+    }
+  }
+  ASSERT_TRUE(s.validateForTesting());
+  ASSERT_EQ(s.size(), expected.size());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin()));
+  EXPECT_TRUE(std::equal(s.rbegin(), s.rend(), expected.rbegin()));
+  EXPECT_EQ(*--s.end(), *expected.rbegin());
+
+  // Удаление других элементов не трогает узел итератора
+  auto middle = s.nth(s.size() / 2);
+  int key = *middle;
+  for (auto it = s.begin(); it != s.end();) {
+    auto next = std::next(it);
+    if (it != middle) s.erase(it);
+    it = next;
+  }
+  EXPECT_EQ(*middle, key);
+  EXPECT_EQ(s.size(), 1UL);
+  EXPECT_TRUE(s.validateForTesting());
+
+  const Set<int> cs{3, 1, 2};
+  std::vector<int> backward(cs.rbegin(), cs.rend());
+  EXPECT_EQ(backward, (std::vector<int>{3, 2, 1}));
+  Set<int>::const_iterator last = --cs.end();
+  EXPECT_EQ(*last, 3);
+
+  Set<int> copy(cs);
+  copy.insert(0);
+  EXPECT_TRUE(copy.validateForTesting());
+  std::vector<int> sorted = {1, 4, 9};
+  copy.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_TRUE(copy.validateForTesting());
+  EXPECT_EQ(*copy.rbegin(), 9);
+}
+
+TEST(SetTest, Erase_By_Key_And_Range) {
+  Set<int> s;
+  for (int i = 0; i < 100; ++i) s.insert(i);
+  EXPECT_EQ(s.erase(50), 1UL);
+  EXPECT_EQ(s.erase(50), 0UL);
+  EXPECT_EQ(s.erase(1000), 0UL);
+  EXPECT_FALSE(s.contains(50));
+
+  auto it = s.erase(s.find(10), s.find(20));
+  EXPECT_EQ(*it, 20);
+  EXPECT_EQ(s.size(), 89UL);
+  EXPECT_EQ(*std::prev(it), 9);
+  it = s.erase(s.find(90), s.end());
+  EXPECT_TRUE(it == s.end());
+  EXPECT_EQ(*s.rbegin(), 89);
+  EXPECT_TRUE(s.erase(s.begin(), s.begin()) == s.begin());
+  EXPECT_TRUE(s.validateForTesting());
+
+  EXPECT_TRUE(s.erase(s.begin(), s.end()) == s.end());
+  EXPECT_TRUE(s.empty());
+  s.insert(7);
+  EXPECT_EQ(*s.begin(), 7);
+  EXPECT_TRUE(s.validateForTesting());
+}
+
+TEST(SetTest, Degenerate_Left_Chain) {
+  // Убывающие ключи образуют цепочку левых ссылок: копирование и удаление
+  // идут по ней без рекурсии
+  RankedSet<int> s;
+  for (int i = 30000; i > 0; --i) s.insert(i);
+  RankedSet<int> copy(s);
+  EXPECT_TRUE(copy.validateForTesting());
+  EXPECT_EQ(*copy.select(0), 1);
+  EXPECT_EQ(copy.erase(1), 1UL);
+  EXPECT_EQ(copy.rank(30000), 29998UL);
+  copy = s;
+  EXPECT_EQ(copy.size(), 30000UL);
+}
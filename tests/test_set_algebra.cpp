@@ -0,0 +1,156 @@
+//
+// Тесты объединения, пересечения и разностей Set и Multiset
+//
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+namespace {
+
+template <typename Tree>
+std::vector<int> keysOf(const Tree& tree) {
+  std::vector<int> keys;
+  for (int key : tree) keys.push_back(key);
+  return keys;
+}
+
+// Ожидаемые результаты всех четырех операций по std::
+struct Expected {
+  std::vector<int> united;
+  std::vector<int> common;
+  std::vector<int> difference;
+  std::vector<int> symmetric;
+};
+
+Expected expectedFor(const std::vector<int>& a, const std::vector<int>& b) {
+  Expected result;
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                 std::back_inserter(result.united));
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(result.common));
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                      std::back_inserter(result.difference));
+  std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                std::back_inserter(result.symmetric));
+  return result;
+}
+
+}  // namespace
+
+TEST(SetAlgebraTest, Set_Operations_Match_Std) {
+  RankedSet<int> a;
+  RankedSet<int> b;
+  std::mt19937 gen(23);
+  for (int i = 0; i < 3000; ++i) a.insert(static_cast<int>(gen() % 5000));
+  for (int i = 0; i < 2000; ++i) b.insert(static_cast<int>(gen() % 5000));
+  Expected expected = expectedFor(keysOf(a), keysOf(b));
+
+  RankedSet<int> united = set_union(a, b);
+  EXPECT_EQ(keysOf(united), expected.united);
+  EXPECT_TRUE(united.validateForTesting());
+  EXPECT_EQ(*united.select(100), expected.united[100]);
+  EXPECT_EQ(keysOf(set_intersection(a, b)), expected.common);
+  EXPECT_EQ(keysOf(set_difference(a, b)), expected.difference);
+  RankedSet<int> symmetric = symmetric_difference(a, b);
+  EXPECT_EQ(keysOf(symmetric), expected.symmetric);
+  EXPECT_TRUE(symmetric.validateForTesting());
+  symmetric.insert(-1);
+  EXPECT_EQ(*symmetric.begin(), -1);
+
+  RankedSet<int> empty;
+  EXPECT_EQ(keysOf(set_union(a, empty)), keysOf(a));
+  EXPECT_TRUE(set_intersection(empty, a).empty());
+  EXPECT_EQ(keysOf(set_difference(a, a)), std::vector<int>{});
+}
+
+TEST(SetAlgebraTest, Multiset_Counts_Duplicates) {
+  Multiset<int> a{1, 1, 1, 2, 3, 3, 5};
+  Multiset<int> b{1, 3, 3, 3, 4, 5, 5};
+  Expected expected = expectedFor(keysOf(a), keysOf(b));
+
+  Multiset<int> united = set_union(a, b);
+  EXPECT_EQ(keysOf(united), expected.united);
+  EXPECT_EQ(united.size(), expected.united.size());
+  EXPECT_EQ(united.count(3), 3UL);
+  EXPECT_EQ(keysOf(set_intersection(a, b)), expected.common);
+  EXPECT_EQ(keysOf(set_difference(a, b)), expected.difference);
+  EXPECT_EQ(keysOf(symmetric_difference(a, b)), expected.symmetric);
+}
+
+TEST(SetAlgebraTest, Parallel_Operations) {
+  ThreadPool pool(3);
+  std::vector<int> keys_a;
+  std::vector<int> keys_b;
+  for (int i = 0; i < 60000; ++i) {
+    keys_a.push_back(i * 3);
+    keys_b.push_back(i * 5 / 2);
+  }
+  Set<int> a;
+  Set<int> b;
+  a.assign_sorted(keys_a.begin(), keys_a.end());
+  b.assign_sorted(keys_b.begin(), keys_b.end());
+  keys_b.erase(std::unique(keys_b.begin(), keys_b.end()), keys_b.end());
+  Expected expected = expectedFor(keys_a, keys_b);
+
+  Set<int> united = set_union(pool, a, b);
+  EXPECT_EQ(keysOf(united), expected.united);
+  EXPECT_TRUE(united.validateForTesting());
+  EXPECT_EQ(keysOf(set_intersection(pool, a, b)), expected.common);
+  EXPECT_EQ(keysOf(set_difference(pool, b, a)),
+            expectedFor(keys_b, keys_a).difference);
+  EXPECT_EQ(keysOf(symmetric_difference(pool, a, b)), expected.symmetric);
+
+  // Равные ключи по обе стороны границы диапазона попадают в один диапазон
+  std::vector<int> repeated_a;
+  std::vector<int> repeated_b;
+  for (int i = 0; i < 40000; ++i) {
+    repeated_a.push_back(i / 7);
+    repeated_b.push_back(i / 5);
+  }
+  Multiset<int> ma;
+  Multiset<int> mb;
+  ma.assign_sorted(repeated_a.begin(), repeated_a.end());
+  mb.assign_sorted(repeated_b.begin(), repeated_b.end());
+  Expected repeated = expectedFor(repeated_a, repeated_b);
+  EXPECT_EQ(keysOf(set_union(pool, ma, mb)), repeated.united);
+  EXPECT_EQ(keysOf(set_intersection(pool, ma, mb)), repeated.common);
+  EXPECT_EQ(keysOf(set_difference(pool, ma, mb)), repeated.difference);
+  EXPECT_EQ(keysOf(symmetric_difference(pool, ma, mb)), repeated.symmetric);
+}
+
+TEST(SetAlgebraTest, Merge_Reuses_Nodes) {
+  RankedSet<int> a{1, 3, 5, 7};
+  RankedSet<int> b{2, 3, 6, 8, 9};
+  const int* moved = &*b.find(6);
+  a.merge(b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(keysOf(a), (std::vector<int>{1, 2, 3, 5, 6, 7, 8, 9}));
+  EXPECT_EQ(&*a.find(6), moved);
+  EXPECT_TRUE(a.validateForTesting());
+  EXPECT_EQ(a.rank(8), 6UL);
+  b.insert(4);
+  a.merge(b);
+  EXPECT_EQ(a.size(), 9UL);
+  a.merge(a);
+  EXPECT_EQ(a.size(), 9UL);
+
+  // Разные пулы: ключи копируются
+  Set<int, std::less<int>, PoolAllocator<int>> c{1, 2};
+  Set<int, std::less<int>, PoolAllocator<int>> d{2, 3};
+  c.merge(d);
+  EXPECT_EQ(keysOf(c), (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(d.empty());
+
+  Multiset<int> ma{1, 2, 2, 4};
+  Multiset<int> mb{2, 3, 4};
+  ma.merge(mb);
+  EXPECT_TRUE(mb.empty());
+  EXPECT_EQ(keysOf(ma), (std::vector<int>{1, 2, 2, 2, 3, 4, 4}));
+  EXPECT_EQ(ma.size(), 7UL);
+}
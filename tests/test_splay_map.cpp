@@ -0,0 +1,132 @@
+//
+// Тесты SplayMap
+//
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+TEST(SplayMapTest, Basic_Interface) {
+  SplayMap<int, std::string> map{{2, "two"}, {1, "one"}, {2, "dos"}};
+  EXPECT_EQ(map.size(), 2UL);
+  EXPECT_EQ(map.at(2), "two");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+
+  map[3] = "three";
+  EXPECT_FALSE(map.insert(3, "tres").second);
+  EXPECT_FALSE(map.insert_or_assign(3, "tres").second);
+  EXPECT_EQ(map.at(3), "tres");
+  EXPECT_TRUE(map.emplace(5, "five").second);
+  EXPECT_FALSE(map.emplace(5, "cinco").second);
+  EXPECT_TRUE(map.try_emplace(4, 2, 'x').second);
+  EXPECT_EQ(map.find(4)->second, "xx");
+
+  std::vector<int> keys;
+  for (const auto& item : map) keys.push_back(item.first);
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4, 5}));
+  auto last = map.end();
+  --last;
+  EXPECT_EQ(last->first, 5);
+
+  EXPECT_EQ(map.lower_bound(3)->first, 3);
+  EXPECT_EQ(map.upper_bound(3)->first, 4);
+  EXPECT_EQ(map.upper_bound(5), map.end());
+  const auto& cmap = map;
+  EXPECT_EQ(cmap.lower_bound(0)->first, 1);
+  EXPECT_EQ(cmap.at(1), "one");
+  EXPECT_TRUE(cmap.contains(4));
+
+  EXPECT_EQ(map.erase(2), 1UL);
+  EXPECT_EQ(map.erase(2), 0UL);
+  map.erase(map.find(1));
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.begin()->first, 3);
+  EXPECT_TRUE(map.validateForTesting());
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(SplayMapTest, Matches_Std_Map) {
+  std::mt19937 random(5);
+  SplayMap<int, int> map;
+  std::map<int, int> reference;
+  for (int i = 0; i < 30000; ++i) {
+    int key = static_cast<int>(random() % 3000);
+    switch (random() % 4) {
+      case 0:
+        EXPECT_EQ(map.erase(key), reference.erase(key));
+        break;
+      case 1: {
+        auto it = map.lower_bound(key);
+        auto expected = reference.lower_bound(key);
+        ASSERT_EQ(it == map.end(), expected == reference.end());
+        if (it != map.end()) {
+          EXPECT_EQ(*it, *expected);
+        }
+        break;
+      }
+      default:
+        EXPECT_EQ(map.insert({key, i}).second,
+                  reference.insert({key, i}).second);
+    }
+  }
+  EXPECT_TRUE(map.validateForTesting());
+  ASSERT_EQ(map.size(), reference.size());
+  auto expected = reference.begin();
+  for (const auto& item : map) {
+    EXPECT_EQ(item, *expected);
+    ++expected;
+  }
+}
+
+TEST(SplayMapTest, Lookups_Move_Key_To_Root) {
+  SplayMap<int, int> map;
+  std::mt19937 random(8);
+  for (int i = 0; i < 10000; ++i) map.insert(static_cast<int>(random()), i);
+  int key = map.begin()->first;
+  map.insert(-1, 0);
+  EXPECT_EQ(map.depth_of(-1), 0);
+  EXPECT_GT(map.depth_of(key), 0);
+
+  // Константный поиск дерево не меняет
+  const auto& cmap = map;
+  EXPECT_NE(cmap.find(key), cmap.end());
+  EXPECT_GT(map.depth_of(key), 0);
+
+  EXPECT_EQ(map.at(key), map.find(key)->second);
+  EXPECT_EQ(map.depth_of(key), 0);
+  EXPECT_GT(map.depth_of(-1), 0);
+  EXPECT_EQ(map.depth_of(-2), -1);
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+TEST(SplayMapTest, Degenerate_Chain_And_Copies) {
+  // Возрастающие ключи вытягивают дерево в цепочку длины n
+  SplayMap<int, int> map;
+  for (int i = 0; i < 200000; ++i) map.insert(i, i);
+  EXPECT_EQ(map.depth_of(0), 199999);
+
+  SplayMap<int, int> copy(map);
+  EXPECT_EQ(copy.depth_of(0), 199999);
+  EXPECT_TRUE(copy.validateForTesting());
+  EXPECT_EQ(copy.find(0)->second, 0);
+  EXPECT_EQ(copy.depth_of(0), 0);
+  EXPECT_EQ(map.depth_of(0), 199999);
+
+  SplayMap<int, int> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 200000UL);
+  copy = moved;
+  EXPECT_EQ(copy.size(), 200000UL);
+  moved = std::move(map);
+  EXPECT_EQ(moved.depth_of(0), 199999);
+  moved.swap(copy);
+  EXPECT_EQ(moved.depth_of(0), 0);
+  copy.clear();
+  EXPECT_TRUE(copy.validateForTesting());
+}
@@ -0,0 +1,92 @@
+//
+// Тесты пула потоков и параллельной сортировки
+//
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+TEST(ThreadPoolTest, Parallel_For_Visits_Each_Index_Once) {
+  for (std::size_t threads : {0, 1, 4}) {
+    ThreadPool pool(threads);
+    EXPECT_EQ(pool.size(), threads);
+    std::vector<std::atomic<int>> visits(10000);
+    pool.parallel_for(visits.size(), [&](std::size_t i) { ++visits[i]; });
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(),
+                            [](const std::atomic<int>& v) { return v == 1; }));
+  }
+  EXPECT_GE(ThreadPool::hardware_threads(), 1UL);
+}
+
+// Вложенный parallel_for из задачи пула не ждет свободных потоков
+TEST(ThreadPoolTest, Nested_Parallel_For_And_Submit) {
+  ThreadPool pool(2);
+  std::atomic<int> total{0};
+  pool.parallel_for(8, [&](std::size_t) {
+    pool.parallel_for(100, [&](std::size_t) { ++total; });
+  });
+  EXPECT_EQ(total, 800);
+
+  std::atomic<int> submitted{0};
+  {
+    ThreadPool local(3);
+    for (int i = 0; i < 50; ++i) local.submit([&] { ++submitted; });
+  }
+  EXPECT_EQ(submitted, 50);
+}
+
+TEST(ThreadPoolTest, Parallel_For_Rethrows) {
+  ThreadPool pool(3);
+  std::atomic<int> calls{0};
+  EXPECT_THROW(pool.parallel_for(1000,
+                                 [&](std::size_t i) {
+                                   ++calls;
+                                   if (i == 500) {
+                                     throw std::runtime_error("failed");
+                                   }
+                                 }),
+               std::runtime_error);
+  // Остальные итерации все равно выполнены, и пул остается рабочим
+  EXPECT_EQ(calls, 1000);
+  pool.parallel_for(10, [&](std::size_t) { ++calls; });
+  EXPECT_EQ(calls, 1010);
+}
+
+TEST(ThreadPoolTest, Parallel_Sort_Is_Stable) {
+  std::mt19937 random(3);
+  std::vector<std::pair<int, int>> items(300000);
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    items[i] = {static_cast<int>(random() % 1000), static_cast<int>(i)};
+  }
+  auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+    return a.first < b.first;
+  };
+  std::vector<std::pair<int, int>> expected = items;
+  std::stable_sort(expected.begin(), expected.end(), by_key);
+
+  ThreadPool pool(3);
+  parallel_sort(pool, items.begin(), items.end(), by_key);
+  EXPECT_EQ(items, expected);
+
+  std::vector<int> small = {3, 1, 2};
+  parallel_sort(pool, small.begin(), small.end(), std::less<int>());
+  EXPECT_EQ(small, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(ThreadPoolTest, Parallel_Build_Depth) {
+  ThreadPool pool(3);
+  // Около четырех поддеревьев на поток, и в каждом не меньше 4096 узлов
+  EXPECT_EQ(parallel_build_depth(pool, 1000000, true), 4UL);
+  EXPECT_EQ(parallel_build_depth(pool, 3 * 4096, true), 2UL);
+  EXPECT_EQ(parallel_build_depth(pool, 4095, true), 0UL);
+  EXPECT_EQ(parallel_build_depth(pool, 1000000, false), 0UL);
+  static_assert(kConcurrentAllocator<std::allocator<int>>);
+  static_assert(!kConcurrentAllocator<PoolAllocator<int>>);
+}
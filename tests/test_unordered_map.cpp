@@ -0,0 +1,185 @@
+//
+// Тесты UnorderedMap и общей хеш-таблицы
+//
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+namespace {
+
+// Все ключи попадают в одну цепочку групп: так проверяются надгробия
+struct CollidingHash {
+  std::size_t operator()(int) const { return 0; }
+};
+
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view key) const {
+    return std::hash<std::string_view>()(key);
+  }
+};
+
+}  // namespace
+
+TEST(UnorderedMapTest, Basic_Interface) {
+  UnorderedMap<int, std::string> map{{1, "one"}, {2, "two"}, {1, "uno"}};
+  EXPECT_EQ(map.size(), 2UL);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+
+  map[3] = "three";
+  EXPECT_EQ(map.size(), 3UL);
+  EXPECT_FALSE(map.insert(3, "tres").second);
+  EXPECT_FALSE(map.insert_or_assign(3, "tres").second);
+  EXPECT_EQ(map.at(3), "tres");
+  EXPECT_TRUE(map.try_emplace(4, 2, 'x').second);
+  EXPECT_EQ(map.find(4)->second, "xx");
+  EXPECT_TRUE(map.emplace(5, "five").second);
+
+  EXPECT_EQ(map.erase(2), 1UL);
+  EXPECT_EQ(map.erase(2), 0UL);
+  map.erase(map.find(5));
+  EXPECT_FALSE(map.contains(5));
+  EXPECT_EQ(map.size(), 3UL);
+
+  std::size_t visited = 0;
+  for (const auto& item : map) {
+    EXPECT_EQ(map.at(item.first), item.second);
+    ++visited;
+  }
+  EXPECT_EQ(visited, map.size());
+  EXPECT_TRUE(map.validateForTesting());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(UnorderedMapTest, Matches_Std_Unordered_Map) {
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> keys(0, 3000);
+  UnorderedMap<int, int> map;
+  std::unordered_map<int, int> reference;
+  for (int i = 0; i < 20000; ++i) {
+    int key = keys(random);
+    if (random() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), reference.erase(key));
+    } else {
+      EXPECT_EQ(map.insert({key, i}).second,
+                reference.insert({key, i}).second);
+    }
+  }
+  EXPECT_TRUE(map.validateForTesting());
+  ASSERT_EQ(map.size(), reference.size());
+  for (const auto& item : reference) {
+    ASSERT_TRUE(map.contains(item.first));
+    EXPECT_EQ(map.at(item.first), item.second);
+  }
+}
+
+TEST(UnorderedMapTest, Erase_In_Full_Group_Keeps_Probe_Chain) {
+  UnorderedMap<int, int, CollidingHash> map;
+  map.reserve(40);
+  for (int i = 0; i < 40; ++i) map[i] = i;
+  EXPECT_TRUE(map.validateForTesting());
+
+  // Первые ключи лежат в заполненной группе, их удаление оставляет
+  // надгробия, и поиск остальных ключей продолжается дальше
+  for (int i = 0; i < 40; i += 2) map.erase(i);
+  EXPECT_TRUE(map.validateForTesting());
+  for (int i = 0; i < 40; ++i) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+  std::size_t buckets = map.bucket_count();
+  for (int i = 0; i < 40; i += 2) map[i] = -i;
+  EXPECT_EQ(map.bucket_count(), buckets);
+  EXPECT_EQ(map.size(), 40UL);
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+TEST(UnorderedMapTest, Load_Factor_And_Reserve) {
+  UnorderedMap<int, int> map;
+  EXPECT_EQ(map.bucket_count(), 0UL);
+  EXPECT_FLOAT_EQ(map.load_factor(), 0.0f);
+  EXPECT_THROW(map.max_load_factor(0.0f), std::invalid_argument);
+  EXPECT_THROW(map.max_load_factor(1.5f), std::invalid_argument);
+
+  map.max_load_factor(0.5f);
+  map.reserve(100);
+  std::size_t buckets = map.bucket_count();
+  EXPECT_GE(buckets * 0.5, 100.0);
+  for (int i = 0; i < 100; ++i) map[i] = i;
+  EXPECT_EQ(map.bucket_count(), buckets);
+  EXPECT_LE(map.load_factor(), 0.5f);
+
+  map.max_load_factor(0.875f);
+  map.rehash(0);
+  EXPECT_LT(map.bucket_count(), buckets);
+  EXPECT_EQ(map.size(), 100UL);
+  EXPECT_TRUE(map.validateForTesting());
+}
+
+TEST(UnorderedMapTest, Heterogeneous_Lookup) {
+  UnorderedMap<std::string, int, StringHash, std::equal_to<>> map;
+  map["apple"] = 1;
+  map["pear"] = 2;
+  std::string_view key = "pear";
+  EXPECT_TRUE(map.contains(key));
+  EXPECT_EQ(map.find(key)->second, 2);
+  EXPECT_EQ(map.at(std::string_view("apple")), 1);
+  EXPECT_EQ(map.erase(key), 1UL);
+  EXPECT_FALSE(map.contains(std::string_view("pear")));
+}
+
+TEST(UnorderedMapTest, Merge_Insert_Many_Copy_And_Move) {
+  UnorderedMap<int, int> map{{1, 10}, {2, 20}};
+  UnorderedMap<int, int> other{{2, 200}, {3, 300}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 3UL);
+  EXPECT_EQ(map.at(2), 20);
+  EXPECT_EQ(other.size(), 1UL);
+  EXPECT_EQ(other.at(2), 200);
+
+  auto results = map.insert_many(std::pair<const int, int>(4, 40),
+                                 std::pair<const int, int>(1, 0));
+  ASSERT_EQ(results.size(), 2UL);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_EQ(results[0].first->second, 40);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(results[1].first->second, 10);
+
+  UnorderedMap<int, int> copy(map);
+  map.clear();
+  EXPECT_EQ(copy.size(), 4UL);
+  EXPECT_TRUE(copy.validateForTesting());
+  UnorderedMap<int, int> moved(std::move(copy));
+  EXPECT_EQ(moved.at(4), 40);
+  map = moved;
+  EXPECT_EQ(map.size(), 4UL);
+  map.swap(other);
+  EXPECT_EQ(map.size(), 1UL);
+}
+
+TEST(UnorderedMapTest, Standard_Algorithms) {
+  UnorderedMap<int, std::string> map{{2, "two"}, {1, "one"}, {3, "three"}};
+  EXPECT_EQ(std::distance(map.begin(), map.end()), 3);
+  std::vector<std::pair<const int, std::string>> items(map.begin(),
+                                                       map.end());
+  ASSERT_EQ(items.size(), 3UL);
+  const UnorderedMap<int, std::string>& view = map;
+  auto it = std::find_if(view.begin(), view.end(),
+                         [](const auto& item) { return item.first == 3; });
+  ASSERT_NE(it, view.end());
+  EXPECT_EQ(it->second, "three");
+  std::for_each(map.begin(), map.end(), [](auto& item) { item.second += "!"; });
+  EXPECT_EQ(map.at(1), "one!");
+}
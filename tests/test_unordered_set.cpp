@@ -0,0 +1,91 @@
+//
+// Тесты UnorderedSet
+//
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "all_tests.h"
+
+using namespace s21;
+
+TEST(UnorderedSetTest, Basic_Interface) {
+  UnorderedSet<std::string> set{"pear", "apple", "fig", "apple"};
+  EXPECT_EQ(set.size(), 3UL);
+  EXPECT_TRUE(set.contains("fig"));
+  EXPECT_FALSE(set.contains("plum"));
+
+  auto result = set.insert("kiwi");
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(*result.first, "kiwi");
+  EXPECT_FALSE(set.insert("fig").second);
+  EXPECT_TRUE(set.emplace(3, 'z').second);
+
+  set.erase(set.find("fig"));
+  EXPECT_EQ(set.erase("zzz"), 1UL);
+  EXPECT_FALSE(set.contains("fig"));
+  EXPECT_EQ(set.size(), 3UL);
+  EXPECT_TRUE(set.validateForTesting());
+
+  auto results = set.insert_many("apple", "plum");
+  EXPECT_FALSE(results[0].second);
+  EXPECT_TRUE(results[1].second);
+  EXPECT_EQ(*results[1].first, "plum");
+
+  UnorderedSet<std::string> other{"plum", "lime"};
+  set.merge(other);
+  EXPECT_EQ(set.size(), 5UL);
+  EXPECT_EQ(other.size(), 1UL);
+  EXPECT_TRUE(other.contains("plum"));
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(UnorderedSetTest, Matches_Std_Unordered_Set) {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> keys(0, 5000);
+  UnorderedSet<int> set;
+  std::unordered_set<int> reference;
+  for (int i = 0; i < 30000; ++i) {
+    int key = keys(random);
+    if (random() % 2 == 0) {
+      EXPECT_EQ(set.erase(key), reference.erase(key));
+    } else {
+      EXPECT_EQ(set.insert(key).second, reference.insert(key).second);
+    }
+  }
+  EXPECT_TRUE(set.validateForTesting());
+  ASSERT_EQ(set.size(), reference.size());
+  std::size_t visited = 0;
+  for (int key : set) {
+    EXPECT_EQ(reference.count(key), 1UL);
+    ++visited;
+  }
+  EXPECT_EQ(visited, reference.size());
+
+  UnorderedSet<int> copy(set);
+  EXPECT_TRUE(copy.validateForTesting());
+  EXPECT_EQ(copy.size(), set.size());
+}
+
+TEST(UnorderedSetTest, Standard_Algorithms) {
+  UnorderedSet<int> set{5, 1, 4, 2, 3};
+  static_assert(std::is_same_v<
+                std::iterator_traits<UnorderedSet<int>::iterator>::
+                    iterator_category,
+                std::forward_iterator_tag>);
+  EXPECT_EQ(std::distance(set.begin(), set.end()), 5);
+  std::vector<int> keys(set.begin(), set.end());
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4, 5}));
+  EXPECT_NE(std::find(set.begin(), set.end(), 4), set.end());
+  EXPECT_EQ(std::count_if(set.begin(), set.end(),
+                          [](int key) { return key % 2 == 0; }),
+            2);
+}